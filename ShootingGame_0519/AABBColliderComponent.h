@@ -39,6 +39,10 @@ public:
     const Vector3& GetLocalOffset() const { return m_LocalOffset; }
     
     //AABBBounds GetWorldAABB() const;
+
+    //ivnupj
+    std::shared_ptr<Component> Clone() const override { return std::make_shared<AABBColliderComponent>(*this); }
+
 private:
 
     //AAs̑傫ꂼݒłϐ
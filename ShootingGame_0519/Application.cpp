@@ -2,6 +2,10 @@
 #include <iostream>
 #include "Application.h"
 #include "renderer.h"
+#include "InstancedModelRenderer.h"
+#include "ParticleRenderer.h"
+#include "Logger.h"
+#include "FrameArena.h"
 #include "DebugGlobals.h"
 #include "TransitionManager.h"
 #include "system/imgui/imgui_impl_win32.h"
@@ -37,6 +41,12 @@ void Application::Run()
 
 bool Application::InitApp()
 {
+    // OXbh̊Jn
+    Logger::Init();
+
+    // t[pꎞ̊m
+    FrameArena::Init();
+
     // EBhȄ.
     if (!InitWnd())
     {
@@ -53,8 +63,12 @@ bool Application::InitApp()
 void Application::UninitApp()
 {
     Game::GameUninit(); // Q[̌㏈
+    InstancedModelRenderer::Uninit(); // CX^Xobt@̉
+    ParticleRenderer::Uninit(); // p[eBNpobt@̉
     Renderer::Uninit(); // DirectX̃\[X
     UninitWnd(); // EBhĚ㏈
+    FrameArena::Uninit(); // t[pꎞ̉
+    Logger::Uninit(); // c̃OoăOXbh~
 }
 
 void Application::MainLoop()
@@ -92,6 +106,9 @@ void Application::MainLoop()
             Game::GameUpdate(m_DeltaTime);
             //TransitionManager::Update(m_DeltaTime);
             Game::GameDraw(m_DeltaTime);
+
+            //̃t[̈ꎞ܂Ƃ߂ĉ
+            FrameArena::Reset();
         }
     }
 
@@ -0,0 +1,367 @@
+﻿#include "AssetArchive.h"
+#include "Lz4Block.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const uint8_t* AssetArchive::m_base = nullptr;
+uint64_t AssetArchive::m_mappedBytes = 0;
+const AssetArchiveEntry* AssetArchive::m_entries = nullptr;
+size_t AssetArchive::m_entryCount = 0;
+const char* AssetArchive::m_names = nullptr;
+uint64_t AssetArchive::m_namesSize = 0;
+
+void* AssetArchive::m_fileHandle = nullptr;
+void* AssetArchive::m_mappingHandle = nullptr;
+
+std::atomic<uint64_t> AssetArchive::m_mappedLoads{ 0 };
+std::atomic<uint64_t> AssetArchive::m_decompressedLoads{ 0 };
+std::atomic<uint64_t> AssetArchive::m_looseLoads{ 0 };
+
+namespace
+{
+    //wchar_t の文字列を UTF-8 にする（Windows の UTF-16 と、それ以外の UTF-32 の両方）
+    std::string ToUtf8(const std::wstring& text)
+    {
+        std::string out;
+        out.reserve(text.size());
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            uint32_t c = static_cast<uint32_t>(text[i]);
+            if (c >= 0xD800 && c < 0xDC00 && i + 1 < text.size())
+            {
+                const uint32_t low = static_cast<uint32_t>(text[i + 1]);
+                if (low >= 0xDC00 && low < 0xE000)
+                {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                    ++i;
+                }
+            }
+
+            if (c < 0x80)
+            {
+                out += static_cast<char>(c);
+            }
+            else if (c < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (c >> 6));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else if (c < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (c >> 12));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (c >> 18));
+                out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+        return out;
+    }
+
+    //std::string のパスは UTF-8 として扱う（Assimp から来るパスも UTF-8）
+    std::filesystem::path PathFromUtf8(const std::string& path)
+    {
+#ifdef _WIN32
+        const int length = ::MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()), nullptr, 0);
+        std::wstring wide(static_cast<size_t>(length > 0 ? length : 0), L'\0');
+        if (length > 0)
+        {
+            ::MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()), wide.data(), length);
+        }
+        return std::filesystem::path(wide);
+#else
+        return std::filesystem::path(path);
+#endif
+    }
+}
+
+std::string NormalizeAssetPath(const std::string& path)
+{
+    std::vector<std::string> parts;
+    std::string part;
+    auto flush = [&]()
+        {
+            if (part.empty() || part == ".") {}
+            else if (part == ".." && !parts.empty() && parts.back() != "..") { parts.pop_back(); }
+            else { parts.push_back(part); }
+            part.clear();
+        };
+
+    for (char c : path)
+    {
+        if (c == '/' || c == '\\') { flush(); continue; }
+        part += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+    flush();
+
+    std::string out;
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        if (i > 0) { out += '/'; }
+        out += parts[i];
+    }
+    return out;
+}
+
+std::string NormalizeAssetPath(const std::wstring& path)
+{
+    return NormalizeAssetPath(ToUtf8(path));
+}
+
+std::string AssetPathToUtf8(const std::wstring& path)
+{
+    return ToUtf8(path);
+}
+
+uint64_t HashAssetPath(const std::string& normalizedPath)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : normalizedPath)
+    {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool AssetArchive::Mount(const std::filesystem::path& path)
+{
+    Unmount();
+
+    const uint8_t* base = nullptr;
+    uint64_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { return false; }
+
+    LARGE_INTEGER fileSize{};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (mapping)
+    {
+        base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!base)
+    {
+        if (mapping) { CloseHandle(mapping); }
+        CloseHandle(file);
+        return false;
+    }
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+
+    struct stat st{};
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);  //マップはファイルを閉じても残る
+    if (mapped == MAP_FAILED) { return false; }
+    base = static_cast<const uint8_t*>(mapped);
+    size = static_cast<uint64_t>(st.st_size);
+#endif
+
+    m_base = base;
+    m_mappedBytes = size;
+
+    //ヘッダーと索引が、ファイルの中に収まっているか
+    AssetArchiveHeader header{};
+    bool valid = size >= sizeof(header);
+    if (valid)
+    {
+        std::memcpy(&header, base, sizeof(header));
+        valid = std::memcmp(header.magic, kAssetArchiveMagic, sizeof(header.magic)) == 0 &&
+                header.version == kAssetArchiveVersion &&
+                header.fileSize == size &&
+                header.indexOffset % alignof(AssetArchiveEntry) == 0 &&
+                header.indexOffset <= size &&
+                header.entryCount <= (size - header.indexOffset) / sizeof(AssetArchiveEntry) &&
+                header.namesOffset <= size &&
+                header.namesSize <= size - header.namesOffset;
+    }
+    if (!valid)
+    {
+        Unmount();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const AssetArchiveEntry*>(base + header.indexOffset);
+    m_entryCount = header.entryCount;
+    m_names = reinterpret_cast<const char*>(base + header.namesOffset);
+    m_namesSize = header.namesSize;
+    return true;
+}
+
+void AssetArchive::Unmount()
+{
+    if (m_base)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_base);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+#else
+        munmap(const_cast<uint8_t*>(m_base), static_cast<size_t>(m_mappedBytes));
+#endif
+    }
+
+    m_base = nullptr;
+    m_mappedBytes = 0;
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_names = nullptr;
+    m_namesSize = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+const AssetArchiveEntry* AssetArchive::Find(const std::string& normalizedPath)
+{
+    if (!m_base) { return nullptr; }
+
+    const uint64_t hash = HashAssetPath(normalizedPath);
+    const AssetArchiveEntry* end = m_entries + m_entryCount;
+    const AssetArchiveEntry* it = std::lower_bound(m_entries, end, hash,
+        [](const AssetArchiveEntry& entry, uint64_t h) { return entry.hash < h; });
+
+    //ハッシュが同じものが並んでいれば、パスで見分ける
+    for (; it != end && it->hash == hash; ++it)
+    {
+        if (static_cast<uint64_t>(it->nameOffset) + it->nameLength > m_namesSize) { continue; }
+        if (it->nameLength == normalizedPath.size() &&
+            std::memcmp(m_names + it->nameOffset, normalizedPath.data(), normalizedPath.size()) == 0)
+        {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetArchive::Contains(const std::string& path)
+{
+    return Find(NormalizeAssetPath(path)) != nullptr;
+}
+
+bool AssetArchive::Exists(const std::string& path)
+{
+    if (Contains(path)) { return true; }
+    std::error_code ec;
+    return std::filesystem::is_regular_file(PathFromUtf8(path), ec);
+}
+
+bool AssetArchive::LoadEntry(const AssetArchiveEntry& entry, AssetView& out)
+{
+    if (entry.offset > m_mappedBytes || entry.storedSize > m_mappedBytes - entry.offset) { return false; }
+    const uint8_t* stored = m_base + entry.offset;
+
+    out.storage.clear();
+    if ((entry.flags & kAssetEntryLz4) == 0)
+    {
+        if (entry.storedSize != entry.size) { return false; }
+        out.data = stored;
+        out.size = static_cast<size_t>(entry.size);
+        m_mappedLoads.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    out.storage.resize(static_cast<size_t>(entry.size));
+    if (!Lz4DecompressBlock(stored, static_cast<size_t>(entry.storedSize), out.storage.data(), out.storage.size()))
+    {
+        out.storage.clear();
+        return false;
+    }
+    out.data = out.storage.data();
+    out.size = out.storage.size();
+    m_decompressedLoads.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AssetArchive::LoadLooseFile(const std::filesystem::path& path, uint64_t offset, uint64_t size, AssetView& out)
+{
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs) { return false; }
+
+    const std::streamoff fileSize = ifs.tellg();
+    if (fileSize < 0 || offset > static_cast<uint64_t>(fileSize)) { return false; }
+    const uint64_t length = (std::min)(size, static_cast<uint64_t>(fileSize) - offset);
+    ifs.seekg(static_cast<std::streamoff>(offset));
+
+    out.storage.resize(static_cast<size_t>(length));
+    if (length > 0 && !ifs.read(reinterpret_cast<char*>(out.storage.data()), static_cast<std::streamsize>(length)))
+    {
+        out.storage.clear();
+        return false;
+    }
+    out.data = out.storage.data();
+    out.size = out.storage.size();
+    m_looseLoads.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AssetArchive::Load(const std::string& path, AssetView& out)
+{
+    if (const AssetArchiveEntry* entry = Find(NormalizeAssetPath(path)))
+    {
+        return LoadEntry(*entry, out);
+    }
+    return LoadLooseFile(PathFromUtf8(path), 0, kAssetReadToEnd, out);
+}
+
+bool AssetArchive::Load(const std::wstring& path, AssetView& out)
+{
+    if (const AssetArchiveEntry* entry = Find(NormalizeAssetPath(path)))
+    {
+        return LoadEntry(*entry, out);
+    }
+    return LoadLooseFile(std::filesystem::path(path), 0, kAssetReadToEnd, out);
+}
+
+bool AssetArchive::LoadRange(const std::string& path, uint64_t offset, uint64_t size, AssetView& out)
+{
+    const AssetArchiveEntry* entry = Find(NormalizeAssetPath(path));
+    if (!entry)
+    {
+        return LoadLooseFile(PathFromUtf8(path), offset, size, out);
+    }
+
+    //圧縮エントリは一度全部展開してから切り出す
+    if (offset > entry->size || !LoadEntry(*entry, out)) { return false; }
+    const size_t length = static_cast<size_t>((std::min)(size, entry->size - offset));
+    if (out.storage.empty())
+    {
+        out.data += offset;
+        out.size = length;
+        return true;
+    }
+
+    out.storage.erase(out.storage.begin() + static_cast<ptrdiff_t>(offset + length), out.storage.end());
+    out.storage.erase(out.storage.begin(), out.storage.begin() + static_cast<ptrdiff_t>(offset));
+    out.data = out.storage.data();
+    out.size = out.storage.size();
+    return true;
+}
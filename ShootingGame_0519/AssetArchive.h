@@ -0,0 +1,129 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------
+// Asset/ をまとめたアーカイブ（Asset.pak）の読み込み
+// ・起動時に 1 回だけファイルを開いてメモリにマップし、以降の読み込みはマップ上の場所を返すだけにする
+// ・索引はパスのハッシュで並べてあり、二分探索で引く（ハッシュが同じならパス文字列で見分ける）
+// ・各エントリは 4KB 境界に置く。無圧縮のエントリはコピー無しで、LZ4 圧縮のエントリは展開して渡す
+// ・マウントしていない・アーカイブに無いパスは、今まで通りファイルから読む
+// アーカイブは Tools/AssetPacker で作る。D3D とロガーには触らないので、ツールからもそのまま使える
+//
+// ファイルの並び:
+//   AssetArchiveHeader | AssetArchiveEntry × entryCount（hash の昇順） | パス文字列 | (4KB 境界) エントリの中身 ...
+//------------------------------------------------------------
+
+constexpr char     kAssetArchiveMagic[4] = { 'S', 'G', 'P', 'K' };
+constexpr uint32_t kAssetArchiveVersion = 1;
+constexpr uint64_t kAssetArchiveAlignment = 4096;
+
+//エントリの flags
+constexpr uint32_t kAssetEntryLz4 = 1u << 0;    //LZ4 ブロック形式で圧縮している
+
+//範囲読み込みで「最後まで」を表す size
+constexpr uint64_t kAssetReadToEnd = ~0ull;
+
+#pragma pack(push, 1)
+struct AssetArchiveHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t indexOffset;       //AssetArchiveEntry の配列
+    uint64_t namesOffset;       //パス文字列（正規化済み・終端無し）を詰めたもの
+    uint64_t namesSize;
+    uint64_t fileSize;          //途中で切れたファイルを見分ける
+};
+
+struct AssetArchiveEntry
+{
+    uint64_t hash;              //HashAssetPath(正規化したパス)
+    uint64_t offset;            //ファイル先頭から（4KB 境界）
+    uint64_t storedSize;        //アーカイブ内のバイト数（圧縮後）
+    uint64_t size;              //元のバイト数
+    uint32_t nameOffset;        //namesOffset からの位置
+    uint32_t nameLength;
+    uint32_t flags;
+    uint32_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(AssetArchiveHeader) == 48, "AssetArchiveHeader のサイズ");
+static_assert(sizeof(AssetArchiveEntry) == 48, "AssetArchiveEntry のサイズ");
+
+//区切りを '/' に揃え、"." と ".." を畳み、ASCII を小文字にする（Windows と同じく大文字小文字を区別しない）
+std::string NormalizeAssetPath(const std::string& path);
+std::string NormalizeAssetPath(const std::wstring& path);
+
+//ワイド文字のパスを UTF-8 にする（正規化はしない。Load(std::string) や AsyncFileSystem に渡す用）
+std::string AssetPathToUtf8(const std::wstring& path);
+
+//正規化したパスの 64bit FNV-1a
+uint64_t HashAssetPath(const std::string& normalizedPath);
+
+//読み込んだファイルの中身
+//無圧縮のエントリはマップ上を指す（Unmount まで有効）。圧縮エントリとファイルから読んだものは storage に持つ
+struct AssetView
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> storage;
+
+    bool IsMapped() const { return data != nullptr && storage.empty(); }
+};
+
+class AssetArchive
+{
+public:
+    //アーカイブを開いてマップする（既にマウントしていれば外してから）。開けない・形式が違えば false
+    static bool Mount(const std::filesystem::path& path);
+    static void Unmount();
+    static bool IsMounted() { return m_base != nullptr; }
+
+    //アーカイブにあるか
+    static bool Contains(const std::string& path);
+    //アーカイブかファイルにあるか
+    static bool Exists(const std::string& path);
+
+    //アーカイブにあればそこから、無ければファイルから読む
+    static bool Load(const std::string& path, AssetView& out);
+    static bool Load(const std::wstring& path, AssetView& out);
+
+    //offset から size バイトだけ読む（中身より先は切り詰める。offset が中身より先なら false）
+    //無圧縮のエントリはマップ上を指し、ファイルはその範囲だけを読む
+    static bool LoadRange(const std::string& path, uint64_t offset, uint64_t size, AssetView& out);
+
+    //------------------------------統計------------------------------
+    static size_t GetEntryCount() { return m_entryCount; }
+    static uint64_t GetMappedBytes() { return m_mappedBytes; }
+    static uint64_t GetMappedLoads() { return m_mappedLoads.load(); }              //コピー無しで渡した数
+    static uint64_t GetDecompressedLoads() { return m_decompressedLoads.load(); }  //展開して渡した数
+    static uint64_t GetLooseLoads() { return m_looseLoads.load(); }                //ファイルから読んだ数
+
+private:
+    static const AssetArchiveEntry* Find(const std::string& normalizedPath);
+    static bool LoadEntry(const AssetArchiveEntry& entry, AssetView& out);
+    static bool LoadLooseFile(const std::filesystem::path& path, uint64_t offset, uint64_t size, AssetView& out);
+
+    static const uint8_t* m_base;
+    static uint64_t m_mappedBytes;
+    static const AssetArchiveEntry* m_entries;
+    static size_t m_entryCount;
+    static const char* m_names;
+    static uint64_t m_namesSize;
+
+    //マップを外すときに閉じるハンドル（Windows: ファイルとマッピング / それ以外: 使わない）
+    static void* m_fileHandle;
+    static void* m_mappingHandle;
+
+    //Load は別スレッドからも呼ばれる（マウント・アンマウントはメインスレッドだけ）
+    static std::atomic<uint64_t> m_mappedLoads;
+    static std::atomic<uint64_t> m_decompressedLoads;
+    static std::atomic<uint64_t> m_looseLoads;
+};
@@ -0,0 +1,45 @@
+﻿#include "AssetIOSystem.h"
+#include <cstring>
+
+size_t AssetIOStream::Read(void* buffer, size_t size, size_t count)
+{
+    if (size == 0 || count == 0) { return 0; }
+
+    //読めるだけの要素数（途中で切れる要素は読まない）
+    const size_t available = (m_view.size - m_position) / size;
+    const size_t elements = count < available ? count : available;
+    std::memcpy(buffer, m_view.data + m_position, elements * size);
+    m_position += elements * size;
+    return elements;
+}
+
+aiReturn AssetIOStream::Seek(size_t offset, aiOrigin origin)
+{
+    size_t target = 0;
+    switch (origin)
+    {
+    case aiOrigin_SET: target = offset; break;
+    case aiOrigin_CUR: target = m_position + offset; break;
+    case aiOrigin_END: target = m_view.size - offset; break;   //Assimp は END からの offset を正の値で渡す
+    default: return aiReturn_FAILURE;
+    }
+    if (target > m_view.size) { return aiReturn_FAILURE; }
+
+    m_position = target;
+    return aiReturn_SUCCESS;
+}
+
+bool AssetIOSystem::Exists(const char* file) const
+{
+    return file && AssetArchive::Exists(file);
+}
+
+Assimp::IOStream* AssetIOSystem::Open(const char* file, const char* mode)
+{
+    //書き込みで開くことはない（書き出しは使っていない）
+    if (!file || !mode || std::strchr(mode, 'w') || std::strchr(mode, 'a')) { return nullptr; }
+
+    AssetView view;
+    if (!AssetArchive::Load(file, view)) { return nullptr; }
+    return new AssetIOStream(std::move(view));
+}
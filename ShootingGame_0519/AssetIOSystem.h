@@ -0,0 +1,37 @@
+﻿#pragma once
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include "AssetArchive.h"
+
+//------------------------------------------------------------
+// Assimp のファイル読み込みを AssetArchive 経由にする
+// モデル本体だけでなく、.obj から参照される .mtl なども Assimp はここを通して開く
+// 使い方: importer.SetIOHandler(new AssetIOSystem);（Importer が delete する）
+//------------------------------------------------------------
+
+//AssetView を読むだけのストリーム（書き込みはしない）
+class AssetIOStream : public Assimp::IOStream
+{
+public:
+    explicit AssetIOStream(AssetView&& view) : m_view(std::move(view)) {}
+
+    size_t Read(void* buffer, size_t size, size_t count) override;
+    size_t Write(const void*, size_t, size_t) override { return 0; }
+    aiReturn Seek(size_t offset, aiOrigin origin) override;
+    size_t Tell() const override { return m_position; }
+    size_t FileSize() const override { return m_view.size; }
+    void Flush() override {}
+
+private:
+    AssetView m_view;
+    size_t m_position = 0;
+};
+
+class AssetIOSystem : public Assimp::IOSystem
+{
+public:
+    bool Exists(const char* file) const override;
+    char getOsSeparator() const override { return '/'; }
+    Assimp::IOStream* Open(const char* file, const char* mode = "rb") override;
+    void Close(Assimp::IOStream* stream) override { delete stream; }
+};
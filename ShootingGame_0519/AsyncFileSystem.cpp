@@ -0,0 +1,500 @@
+﻿#include "AsyncFileSystem.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ASYNC_FILE_SYSTEM_IO_URING 1
+#include <linux/io_uring.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#define ASYNC_FILE_SYSTEM_IO_URING 0
+#endif
+
+FileIoBackend AsyncFileSystem::m_backend = FileIoBackend::Immediate;
+std::vector<std::thread> AsyncFileSystem::m_threads;
+bool AsyncFileSystem::m_stopping = false;
+
+std::mutex AsyncFileSystem::m_mutex;
+std::condition_variable AsyncFileSystem::m_workAvailable;
+std::condition_variable AsyncFileSystem::m_workCompleted;
+std::priority_queue<AsyncFileSystem::Pending, std::vector<AsyncFileSystem::Pending>, AsyncFileSystem::PendingOrder> AsyncFileSystem::m_pending;
+std::vector<AsyncFileSystem::Completed> AsyncFileSystem::m_completed;
+uint64_t AsyncFileSystem::m_nextId = 1;
+
+std::atomic<size_t> AsyncFileSystem::m_outstanding{ 0 };
+std::atomic<uint64_t> AsyncFileSystem::m_completedCount{ 0 };
+std::atomic<uint64_t> AsyncFileSystem::m_bytesRead{ 0 };
+std::atomic<uint64_t> AsyncFileSystem::m_submitCount{ 0 };
+
+#if ASYNC_FILE_SYSTEM_IO_URING
+namespace
+{
+    //liburing を使わずに、システムコールと共有リングを直接扱う最小限のラッパー
+    class IoUring
+    {
+    public:
+        bool Init(unsigned entries)
+        {
+            io_uring_params params{};
+            m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (m_fd < 0) { return false; }
+
+            m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMap) { m_sqRingSize = m_cqRingSize = (std::max)(m_sqRingSize, m_cqRingSize); }
+
+            m_sqRing = mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+            m_cqRing = singleMap ? m_sqRing
+                                 : mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+            m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+            if (m_sqRing == MAP_FAILED || m_cqRing == MAP_FAILED || sqes == MAP_FAILED)
+            {
+                if (sqes != MAP_FAILED) { munmap(sqes, m_sqesSize); }
+                Uninit();
+                return false;
+            }
+            m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+            uint8_t* sq = static_cast<uint8_t*>(m_sqRing);
+            m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+            m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            m_sqEntries = params.sq_entries;
+            m_sqLocalTail = *m_sqTail;
+
+            uint8_t* cq = static_cast<uint8_t*>(m_cqRing);
+            m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        void Uninit()
+        {
+            if (m_sqes) { munmap(m_sqes, m_sqesSize); }
+            if (m_cqRing && m_cqRing != MAP_FAILED && m_cqRing != m_sqRing) { munmap(m_cqRing, m_cqRingSize); }
+            if (m_sqRing && m_sqRing != MAP_FAILED) { munmap(m_sqRing, m_sqRingSize); }
+            if (m_fd >= 0) { close(m_fd); }
+            *this = IoUring();
+        }
+
+        unsigned GetDepth() const { return m_sqEntries; }
+
+        //読み込みを 1 件積む（投げるのは Submit）。SQ に空きが無ければ false
+        bool PrepareRead(int fd, void* buffer, unsigned length, uint64_t offset, uint64_t userData)
+        {
+            const unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+            if (m_sqLocalTail - head >= m_sqEntries) { return false; }
+
+            const unsigned index = m_sqLocalTail & m_sqMask;
+            io_uring_sqe& sqe = m_sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<uint64_t>(buffer);
+            sqe.len = length;
+            sqe.off = offset;
+            sqe.user_data = userData;
+            m_sqArray[index] = index;
+            ++m_sqLocalTail;
+            ++m_toSubmit;
+            return true;
+        }
+
+        //積んだ分を投げ、minComplete 件終わるまで待つ
+        bool Submit(unsigned minComplete)
+        {
+            __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+            for (;;)
+            {
+                const long submitted = syscall(__NR_io_uring_enter, m_fd, m_toSubmit, minComplete,
+                                               minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+                if (submitted >= 0)
+                {
+                    m_toSubmit -= static_cast<unsigned>(submitted);
+                    return true;
+                }
+                if (errno != EINTR) { return false; }
+            }
+        }
+
+        bool PopCompletion(io_uring_cqe& out)
+        {
+            const unsigned head = *m_cqHead;
+            if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) { return false; }
+            out = m_cqes[head & m_cqMask];
+            __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+    private:
+        int m_fd = -1;
+        void* m_sqRing = nullptr;
+        void* m_cqRing = nullptr;
+        size_t m_sqRingSize = 0;
+        size_t m_cqRingSize = 0;
+        io_uring_sqe* m_sqes = nullptr;
+        size_t m_sqesSize = 0;
+
+        unsigned* m_sqHead = nullptr;
+        unsigned* m_sqTail = nullptr;
+        unsigned* m_sqArray = nullptr;
+        unsigned m_sqMask = 0;
+        unsigned m_sqEntries = 0;
+        unsigned m_sqLocalTail = 0;
+        unsigned m_toSubmit = 0;
+
+        unsigned* m_cqHead = nullptr;
+        unsigned* m_cqTail = nullptr;
+        unsigned m_cqMask = 0;
+        io_uring_cqe* m_cqes = nullptr;
+    };
+
+    constexpr unsigned kIoUringDepth = 64;
+    constexpr uint64_t kMaxReadPerSqe = 1u << 30;   //sqe.len は 32bit なので、大きなファイルは分けて読む
+
+    IoUring s_ring;
+}
+#endif
+
+void AsyncFileSystem::Init(int workerCount, bool preferIoUring)
+{
+    Uninit();
+
+#if ASYNC_FILE_SYSTEM_IO_URING
+    if (preferIoUring && s_ring.Init(kIoUringDepth))
+    {
+        m_backend = FileIoBackend::IoUring;
+        m_threads.emplace_back(&AsyncFileSystem::IoUringMain);
+        return;
+    }
+#else
+    (void)preferIoUring;
+#endif
+
+    //読み込み待ちが主なので、コア数より少なめで良い
+    if (workerCount <= 0)
+    {
+        const int cores = static_cast<int>(std::thread::hardware_concurrency());
+        workerCount = (std::max)(2, (std::min)(4, cores));
+    }
+    m_backend = FileIoBackend::ThreadPool;
+    for (int i = 0; i < workerCount; ++i)
+    {
+        m_threads.emplace_back(&AsyncFileSystem::WorkerMain);
+    }
+}
+
+void AsyncFileSystem::Uninit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (std::thread& thread : m_threads)
+    {
+        if (thread.joinable()) { thread.join(); }
+    }
+    m_threads.clear();
+
+#if ASYNC_FILE_SYSTEM_IO_URING
+    s_ring.Uninit();
+#endif
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending = {};
+    m_completed.clear();
+    m_outstanding.store(0, std::memory_order_release);
+    m_backend = FileIoBackend::Immediate;
+    m_stopping = false;
+}
+
+const char* AsyncFileSystem::GetBackendName()
+{
+    switch (m_backend)
+    {
+    case FileIoBackend::ThreadPool: return "thread pool";
+    case FileIoBackend::IoUring:    return "io_uring";
+    default:                        return "immediate";
+    }
+}
+
+uint64_t AsyncFileSystem::Read(FileReadRequest request)
+{
+    std::vector<Pending> pendings(1);
+    pendings[0].request = std::move(request);
+    return Enqueue(pendings);
+}
+
+void AsyncFileSystem::ReadBatch(std::vector<FileReadRequest> requests, std::function<void()> onBatchComplete)
+{
+    if (requests.empty())
+    {
+        if (onBatchComplete) { onBatchComplete(); }
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->remaining = requests.size();
+    batch->onComplete = std::move(onBatchComplete);
+
+    std::vector<Pending> pendings(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        pendings[i].request = std::move(requests[i]);
+        pendings[i].batch = batch;
+    }
+    Enqueue(pendings);
+}
+
+uint64_t AsyncFileSystem::Enqueue(std::vector<Pending>& pendings)
+{
+    uint64_t firstId = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        firstId = m_nextId;
+        for (Pending& pending : pendings)
+        {
+            pending.id = m_nextId;
+            pending.sequence = m_nextId;
+            ++m_nextId;
+        }
+        m_outstanding.fetch_add(pendings.size(), std::memory_order_acq_rel);
+
+        if (m_backend != FileIoBackend::Immediate)
+        {
+            for (Pending& pending : pendings) { m_pending.push(std::move(pending)); }
+        }
+    }
+
+    if (m_backend == FileIoBackend::Immediate)
+    {
+        for (Pending& pending : pendings) { ReadNow(pending); }
+        return firstId;
+    }
+
+    m_submitCount.fetch_add(1, std::memory_order_relaxed);
+    m_workAvailable.notify_all();
+    return firstId;
+}
+
+bool AsyncFileSystem::PopPending(Pending& out)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workAvailable.wait(lock, [] { return m_stopping || !m_pending.empty(); });
+    if (m_stopping) { return false; }
+
+    //pop で並べ直すときに見るのは優先度と順番だけなので、中身は先に取り出してよい
+    out = std::move(const_cast<Pending&>(m_pending.top()));
+    m_pending.pop();
+    return true;
+}
+
+void AsyncFileSystem::Complete(Pending& pending, bool ok, AssetView&& view)
+{
+    Completed completed;
+    completed.result.id = pending.id;
+    completed.result.path = std::move(pending.request.path);
+    completed.result.ok = ok;
+    if (ok) { completed.result.view = std::move(view); }
+    completed.onComplete = std::move(pending.request.onComplete);
+    completed.batch = std::move(pending.batch);
+
+    m_completedCount.fetch_add(1, std::memory_order_relaxed);
+    m_bytesRead.fetch_add(completed.result.view.size, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completed.push_back(std::move(completed));
+    }
+    m_workCompleted.notify_all();
+}
+
+void AsyncFileSystem::ReadNow(Pending& pending)
+{
+    AssetView view;
+    const bool ok = AssetArchive::LoadRange(pending.request.path, pending.request.offset, pending.request.size, view);
+    Complete(pending, ok, std::move(view));
+}
+
+size_t AsyncFileSystem::Poll()
+{
+    std::vector<Completed> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        completed.swap(m_completed);
+    }
+
+    for (Completed& c : completed)
+    {
+        if (c.onComplete) { c.onComplete(c.result); }
+        if (c.batch && --c.batch->remaining == 0 && c.batch->onComplete)
+        {
+            c.batch->onComplete();
+        }
+        //コールバックの中で積んだ要求があっても、WaitAll はそれも待つ
+        m_outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return completed.size();
+}
+
+void AsyncFileSystem::WaitAll()
+{
+    while (m_outstanding.load(std::memory_order_acquire) > 0)
+    {
+        if (Poll() > 0) { continue; }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workCompleted.wait(lock, [] { return !m_completed.empty() || m_outstanding.load(std::memory_order_acquire) == 0; });
+    }
+}
+
+void AsyncFileSystem::WorkerMain()
+{
+    Pending pending;
+    while (PopPending(pending))
+    {
+        ReadNow(pending);
+    }
+}
+
+void AsyncFileSystem::IoUringMain()
+{
+#if ASYNC_FILE_SYSTEM_IO_URING
+    //投げている読み込み 1 件分（user_data はこの配列の添字）
+    struct Slot
+    {
+        Pending pending;
+        int fd = -1;
+        AssetView view;
+        uint64_t offset = 0;    //ファイル上の読み始め
+        uint64_t done = 0;
+        bool busy = false;
+    };
+
+    std::vector<Slot> slots(s_ring.GetDepth());
+    size_t inFlight = 0;
+
+    auto submitRemaining = [](Slot& slot, size_t index)
+        {
+            const uint64_t remaining = slot.view.storage.size() - slot.done;
+            return s_ring.PrepareRead(slot.fd, slot.view.storage.data() + slot.done,
+                                      static_cast<unsigned>((std::min)(remaining, kMaxReadPerSqe)),
+                                      slot.offset + slot.done, index);
+        };
+
+    auto finish = [&](Slot& slot, bool ok)
+        {
+            close(slot.fd);
+            slot.fd = -1;
+            slot.busy = false;
+            --inFlight;
+            slot.view.data = slot.view.storage.data();
+            slot.view.size = slot.view.storage.size();
+            Complete(slot.pending, ok, std::move(slot.view));
+            slot.view = AssetView();
+        };
+
+    for (;;)
+    {
+        //空いているスロットの分だけ、優先度順に取り出す
+        std::vector<Pending> batch;
+        {
+            //Uninit の後も、投げてある分は読み終わるまで回す（カーネルがバッファに書き込んでいる）
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (inFlight == 0)
+            {
+                m_workAvailable.wait(lock, [] { return m_stopping || !m_pending.empty(); });
+                if (m_stopping) { break; }
+            }
+            while (!m_stopping && inFlight + batch.size() < slots.size() && !m_pending.empty())
+            {
+                batch.push_back(std::move(const_cast<Pending&>(m_pending.top())));
+                m_pending.pop();
+            }
+        }
+
+        for (Pending& pending : batch)
+        {
+            //アーカイブにあるものは読み込みが要らない（圧縮エントリはここで展開する）
+            if (AssetArchive::Contains(pending.request.path))
+            {
+                ReadNow(pending);
+                continue;
+            }
+
+            const int fd = open(pending.request.path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat st{};
+            if (fd < 0 || fstat(fd, &st) != 0 || pending.request.offset > static_cast<uint64_t>(st.st_size))
+            {
+                if (fd >= 0) { close(fd); }
+                Complete(pending, false, AssetView());
+                continue;
+            }
+
+            const uint64_t length = (std::min)(pending.request.size, static_cast<uint64_t>(st.st_size) - pending.request.offset);
+            size_t index = 0;
+            while (slots[index].busy) { ++index; }
+            Slot& slot = slots[index];
+            slot.pending = std::move(pending);
+            slot.fd = fd;
+            slot.offset = slot.pending.request.offset;
+            slot.done = 0;
+            slot.view.storage.resize(static_cast<size_t>(length));
+            slot.busy = true;
+            ++inFlight;
+
+            if (length == 0 || !submitRemaining(slot, index))
+            {
+                finish(slot, length == 0);
+            }
+        }
+
+        if (inFlight == 0) { continue; }
+
+        //まとめて投げて、少なくとも 1 件終わるまで待つ
+        //失敗したときは何も投げられていない（前に投げた分はカーネルが読んでいる）ので、バッファはそのままにして次の周でやり直す
+        m_submitCount.fetch_add(1, std::memory_order_relaxed);
+        if (!s_ring.Submit(1))
+        {
+            std::this_thread::yield();
+        }
+
+        io_uring_cqe cqe{};
+        while (s_ring.PopCompletion(cqe))
+        {
+            const size_t index = static_cast<size_t>(cqe.user_data);
+            Slot& slot = slots[index];
+            if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+            {
+                if (!submitRemaining(slot, index)) { finish(slot, false); }
+                continue;
+            }
+            //0 は途中でファイルが縮んだとき
+            if (cqe.res <= 0)
+            {
+                finish(slot, false);
+                continue;
+            }
+
+            slot.done += static_cast<uint64_t>(cqe.res);
+            if (slot.done < slot.view.storage.size())
+            {
+                //短く読めたときは残りを投げ直す
+                if (!submitRemaining(slot, index)) { finish(slot, false); }
+                continue;
+            }
+            finish(slot, true);
+        }
+    }
+#endif
+}
@@ -0,0 +1,145 @@
+﻿#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AssetArchive.h"
+
+//------------------------------------------------------------
+// ファイルの非同期読み込み（AssetArchive の上に載せる）
+// ・Read / ReadBatch で要求を積むと、バックグラウンドで読み、完了したものを Poll でコールバックする
+// ・コールバックは Poll を呼んだスレッド（メインスレッド）で呼ぶので、D3D のリソース作成やキャッシュへの登録をそのまま書ける
+// ・優先度の高い要求から、同じ優先度なら積んだ順に読む
+// ・アーカイブにあるパスはマップ上のビュー（圧縮エントリは展開したもの）を返し、無いものはファイルから読む
+//
+// 読み込み方:
+//   IoUring    Linux の io_uring。1 本の I/O スレッドがまとめて投げ、まとめて受け取る
+//   ThreadPool ワーカースレッドがそれぞれ同期読み込みする（Windows と、io_uring が使えないとき）
+// Init していなければ、Read を呼んだスレッドでその場で読み、次の Poll でコールバックする
+//------------------------------------------------------------
+
+enum class FileReadPriority : uint8_t
+{
+    Low = 0,        //先読み
+    Normal,
+    High,           //今のシーンですぐ使う
+};
+
+enum class FileIoBackend : uint8_t
+{
+    Immediate = 0,  //Init 前・Uninit 後
+    ThreadPool,
+    IoUring,
+};
+
+struct FileReadResult
+{
+    uint64_t id = 0;
+    std::string path;
+    bool ok = false;
+    AssetView view;         //コールバックの間だけ有効（残すなら storage ごと move する）
+};
+
+using FileReadCallback = std::function<void(FileReadResult& result)>;
+
+struct FileReadRequest
+{
+    std::string path;                       //UTF-8（Asset/ からの相対パスのままで良い）
+    uint64_t offset = 0;
+    uint64_t size = kAssetReadToEnd;        //既定はファイル全体
+    FileReadPriority priority = FileReadPriority::Normal;
+    FileReadCallback onComplete;
+};
+
+class AsyncFileSystem
+{
+public:
+    //workerCount は ThreadPool のときのスレッド数（0 ならコア数から決める）
+    //preferIoUring が false、または io_uring が使えない環境では ThreadPool になる
+    static void Init(int workerCount = 0, bool preferIoUring = true);
+    //読み込み中のものは読み終わるまで待つ。まだ Poll していない完了と、始まっていない要求はコールバックせずに捨てる
+    static void Uninit();
+
+    static FileIoBackend GetBackend() { return m_backend; }
+    static const char* GetBackendName();
+
+    //要求を積んで id を返す
+    static uint64_t Read(FileReadRequest request);
+    //まとめて積む（ワーカーを起こすのも 1 回）。全部のコールバックが終わった後に onBatchComplete を呼ぶ
+    static void ReadBatch(std::vector<FileReadRequest> requests, std::function<void()> onBatchComplete = {});
+
+    //完了したものをコールバックする（メインスレッドから毎フレーム）。コールバックした数を返す
+    static size_t Poll();
+    //積んだものが全部コールバックされるまで、Poll しながら待つ（ロード画面・ツール用）
+    static void WaitAll();
+
+    //積んだがまだコールバックしていない数
+    static size_t GetOutstandingCount() { return m_outstanding.load(std::memory_order_acquire); }
+
+    //------------------------------統計------------------------------
+    static uint64_t GetCompletedCount() { return m_completedCount.load(std::memory_order_relaxed); }
+    static uint64_t GetBytesRead() { return m_bytesRead.load(std::memory_order_relaxed); }
+    static uint64_t GetSubmitCount() { return m_submitCount.load(std::memory_order_relaxed); }    //io_uring_enter / ワーカーを起こした回数
+
+private:
+    struct Batch
+    {
+        size_t remaining = 0;
+        std::function<void()> onComplete;
+    };
+
+    struct Pending
+    {
+        uint64_t id = 0;
+        uint64_t sequence = 0;      //同じ優先度の中で積んだ順
+        FileReadRequest request;
+        std::shared_ptr<Batch> batch;
+    };
+
+    //priority_queue の先頭が「優先度が高く、先に積んだもの」になる順序
+    struct PendingOrder
+    {
+        bool operator()(const Pending& a, const Pending& b) const
+        {
+            if (a.request.priority != b.request.priority) { return a.request.priority < b.request.priority; }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    struct Completed
+    {
+        FileReadResult result;
+        FileReadCallback onComplete;
+        std::shared_ptr<Batch> batch;
+    };
+
+    static uint64_t Enqueue(std::vector<Pending>& pendings);
+    static bool PopPending(Pending& out);
+    static void Complete(Pending& pending, bool ok, AssetView&& view);
+    static void ReadNow(Pending& pending);
+
+    static void WorkerMain();
+    static void IoUringMain();
+
+    static FileIoBackend m_backend;
+    static std::vector<std::thread> m_threads;
+    static bool m_stopping;
+
+    static std::mutex m_mutex;
+    static std::condition_variable m_workAvailable;
+    static std::condition_variable m_workCompleted;
+    static std::priority_queue<Pending, std::vector<Pending>, PendingOrder> m_pending;
+    static std::vector<Completed> m_completed;
+    static uint64_t m_nextId;
+
+    static std::atomic<size_t> m_outstanding;
+    static std::atomic<uint64_t> m_completedCount;
+    static std::atomic<uint64_t> m_bytesRead;
+    static std::atomic<uint64_t> m_submitCount;
+};
@@ -7,6 +7,15 @@ struct VSInput
     float2 texcoord : TEXCOORD;
 };
 
+// k_ifpBVertexPacking.h  PackedVertex + _FXg[j̓
+struct VSPackedInput
+{
+    float3 pos      : POSITION;
+    float2 normal   : NORMAL;   // ʑ̎ʑiR16G16_SNORMj
+    float4 col      : COLOR;    // ʃXg[iR8G8B8A8_UNORMBlȐFȂ stride 0 őS_lj
+    float2 texcoord : TEXCOORD; // R16G16_FLOAT
+};
+
 // VS  PS ւ̏o
 struct VSOutput
 {
@@ -42,4 +51,24 @@ VSOutput VSMain(VSInput vin)
     return output;
 }
 
+// ʑ̎ʑ̖@߂iVertexPacking.cpp  DecodeOctahedralNormal ƓvZj
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+VSOutput VSMainPacked(VSPackedInput vin)
+{
+    VSOutput output;
+    float4 worldPos = mul(float4(vin.pos, 1), gWorld);
+    float4 viewPos = mul(worldPos, gView);
+    output.posH = mul(viewPos, gProj);
 
+    output.col = vin.col;
+    output.normal = normalize(mul(DecodeOctahedral(vin.normal), (float3x3) gWorld));
+    output.texcoord = vin.texcoord;
+    return output;
+}
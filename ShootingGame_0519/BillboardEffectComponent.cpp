@@ -111,7 +111,7 @@ void BillboardEffectComponent::Draw(float dt)
 
     DirectX::SimpleMath::Vector4 color(1, 1, 1, 1);
 
-    Renderer::DrawBillboard(m_textureSrv,
+    Renderer::DrawBillboard(m_textureSrv.get(),
                             pos,
                             m_size,
                             color,
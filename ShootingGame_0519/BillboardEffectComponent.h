@@ -3,6 +3,7 @@
 #include <d3d11.h>
 #include <string>
 #include <SimpleMath.h>
+#include "TextureManager.h"
 
 /// <summary>
 /// r{[hł̃GtFNgoۂ̏̍\
@@ -65,6 +66,6 @@ private:
     DirectX::SimpleMath::Vector4 m_color = DirectX::SimpleMath::Vector4(1, 1, 1, 1);
 
  
-    ID3D11ShaderResourceView* m_textureSrv = nullptr;
+    TextureHandle m_textureSrv;
 };
 
@@ -28,7 +28,7 @@ void BoxComponent::Draw(float /*alpha*/)
     Renderer::SetDepthEnable(false);
 
     // [hsiGameObject ̃XP[/]/sړ܂ށj
-    Matrix4x4 world = GetOwner()->GetTransform().GetMatrix();
+    Matrix4x4 world = GetOwner()->GetLocalMatrix();
     Renderer::SetWorldMatrix(&world);
 
     ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
@@ -9,7 +9,7 @@
 class Building : public GameObject
 {
 public:
-    Building() = default;
+    Building() { SetTag(TAG_BUILDING); }
     ~Building() override = default;
 
     void Initialize() override;     //
@@ -7,6 +7,7 @@
 #include "ModelCache.h"
 #include "PushOutComponent.h"
 #include "Building.h"
+#include "Logger.h"
 #include <random>
 #include <cmath>
 
@@ -82,10 +83,12 @@ int BuildingSpawner::RandomSpawn(const BuildingConfig& cfg)
             col->SetEnabled(false);
             obj->AddComponent(col);
             col->isStatic = true;
+            col->SetLayer(LAYER_BUILDING);
 
             //fǂݍ݂
             auto mc = std::make_shared<ModelComponent>();
             mc->LoadModel(cfg.modelPath);
+            mc->SetInstanced(true);
             obj->AddComponent(mc);
 
             obj->Initialize();
@@ -107,9 +110,7 @@ int BuildingSpawner::RandomSpawn(const BuildingConfig& cfg)
         if (!placed)
         {
             //zusis񐔏j: OoȂǂđs
-            char buf[256];
-            sprintf_s(buf, "WARN: BuildingSpawner failed to place building %d (attempts=%d)\n", i, cfg.maxAttemptsPerBuilding);
-            OutputDebugStringA(buf);
+            LOG_WARN("BuildingSpawner failed to place building %d (attempts=%d)", i, cfg.maxAttemptsPerBuilding);
             //ɒu֐i
         }
     } 
@@ -163,9 +164,7 @@ int BuildingSpawner::Spawn(const BuildingConfig& cfg)
         {
             // ł́udȂ肻ȂXLbvvƂĂ
             // KvȂ烍OoċzuAȂǂɕςĂ OK
-            char buf[256];
-            sprintf_s(buf, "WARN: BuildingSpawner::Spawn overlap at index %d, skip.\n", i);
-            OutputDebugStringA(buf);
+            LOG_WARN("BuildingSpawner::Spawn overlap at index %d, skip.", i);
             continue;
         }
 
@@ -187,10 +186,12 @@ int BuildingSpawner::Spawn(const BuildingConfig& cfg)
         col->SetEnabled(false);
         obj->AddComponent(col);
         col->isStatic = true;
+        col->SetLayer(LAYER_BUILDING);
 
         // fǂݍ
         auto mc = std::make_shared<ModelComponent>();
         mc->LoadModel(cfg.modelPath);
+        mc->SetInstanced(true);
         obj->AddComponent(mc);
 
         auto push = std::make_shared<PushOutComponent>();
@@ -4,13 +4,75 @@
 #include "CollisionManager.h"
 #include "SphereComponent.h"
 #include "PushOutComponent.h"
+#include "HomingComponent.h"
 #include "Renderer.h" // optional: for debug draw
 #include <iostream>
 
+ObjectPool<Bullet> Bullet::s_pool;
+
+std::shared_ptr<Bullet> Bullet::Spawn()
+{
+    Handle<Bullet> handle;
+    bool created = false;
+    auto bullet = s_pool.Acquire(handle, created);
+
+    if (!created)
+    {
+        //ėpFR|[lg͎c܂܏Ԃ
+        bullet->Revive();
+    }
+
+    bullet->m_poolHandle = handle;
+    bullet->Initialize();
+    return bullet;
+}
+
+void Bullet::ClearPool()
+{
+    s_pool.Clear();
+}
+
+void Bullet::Uninit()
+{
+    //v[oeȂR|[lgcăv[֕Ԃ
+    if (s_pool.IsValid(m_poolHandle))
+    {
+        Retire();
+        SetScene(nullptr);
+        s_pool.Release(m_poolHandle);
+        m_poolHandle = Handle<Bullet>();
+        return;
+    }
+
+    GameObject::Uninit();
+}
+
+std::shared_ptr<HomingComponent> Bullet::GetOrAddHoming()
+{
+    if (!m_homing)
+    {
+        m_homing = AddComponent<HomingComponent>();
+    }
+    return m_homing;
+}
+
 void Bullet::Initialize()
 {
+    //2ڈȍ~iv[̍ėpj͏Ԃ߂
+    if (m_built)
+    {
+        m_bulletComp->Reset();
+        m_bulletComp->SetLifetime(5.0f);
+        if (m_homing)
+        {
+            m_homing->Reset();
+        }
+        return;
+    }
+    m_built = true;
+
     //BulletComponentǉĉ^S
-    auto m_bulletComp = std::make_shared<BulletComponent>();
+    m_bulletComp = std::make_shared<BulletComponent>();
     if (m_bulletComp)
     {
         m_bulletComp->SetLifetime(5.0f);
@@ -26,6 +88,9 @@ void Bullet::Initialize()
     if (m_collider)
     {
         m_collider->SetSize(Vector3(m_radius * 2.0f, m_radius * 2.0f, m_radius * 2.0f));
+
+        //e 1 t[œG蔲Ȃ悤ɁAړƔ肷
+        m_collider->SetContinuous(m_radius);
     }
 
     auto push = std::make_shared<PushOutComponent>();
@@ -46,7 +111,7 @@ void Bullet::Draw(float alpha)
     //std::cout << "Bullet::Draw called" << std::endl;
 
     //[hsZbg
-    Matrix4x4 world = GetTransform().GetMatrix();
+    Matrix4x4 world = GetLocalMatrix();
     Renderer::SetWorldMatrix(&world);
 
     Renderer::SetDepthEnable(true);
@@ -2,18 +2,20 @@
 #include "GameObject.h"
 #include "BulletComponent.h"
 #include "Primitive.h"
+#include "ObjectPool.h"
 #include <memory>
 #include <SimpleMath.h>
 
 using namespace DirectX::SimpleMath;
 
 class OBBColliderComponent; //O錾
+class HomingComponent;
 
 class Bullet : public GameObject
 {
 public:
 
-    Bullet() {};
+    Bullet() { SetTag(TAG_BULLET); }
     ~Bullet() override = default;
 
     //
@@ -28,6 +30,19 @@ public:
     //Փ˔
     void OnCollision(GameObject* other) override;
 
+    //V[OꂽƂ̏iv[oe̓v[֕Ԃj
+    void Uninit() override;
+
+    //v[eoiv[ȂVj
+    //oe Initialize ς݂ŁAʒu BulletComponent ̐ݒ͌Ăяoōs
+    static std::shared_ptr<Bullet> Spawn();
+
+    //v[̒eSĔjiV[Ij
+    static void ClearPool();
+
+    //z[~OpR|[lgi񂾂ǉAȍ~͎g񂷁j
+    std::shared_ptr<HomingComponent> GetOrAddHoming();
+
     //e̔ãZb^[
     void SetRadius(float r) { m_radius = r; }
 
@@ -40,6 +55,16 @@ private:
 
     //R|[lgێ
     std::shared_ptr<OBBColliderComponent> m_collider;   
+    std::shared_ptr<BulletComponent> m_bulletComp;
+    std::shared_ptr<HomingComponent> m_homing;
+
+    //R|[lgE`pbV쐬ς݂iv[ōėpƂ͍蒼Ȃj
+    bool m_built = false;
+
+    //v[̃Xbg
+    Handle<Bullet> m_poolHandle;
+
+    static ObjectPool<Bullet> s_pool;
 
 };
 
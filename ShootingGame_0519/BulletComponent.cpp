@@ -2,6 +2,7 @@
 #include "GameObject.h"
 #include "IScene.h"
 #include "Enemy.h"
+#include "ColliderComponent.h"
 #include <iostream>
 
 using namespace DirectX::SimpleMath;
@@ -26,6 +27,42 @@ void BulletComponent::Initialize()
 
 }
 
+void BulletComponent::Reset()
+{
+    m_velocity = Vector3::Zero;
+    m_speed = 40.0f;
+    m_age = 0.0f;
+    m_lifetime = 3.0f;
+    m_ownerType = BulletType::UNKNOW;
+    m_color = Vector4(1, 1, 1, 1);
+
+    if (m_collider)
+    {
+        m_collider->ClearSweep();
+        m_collider->SetLayer(LAYER_DEFAULT);
+    }
+}
+
+void BulletComponent::SetBulletType(BulletType t)
+{
+    m_ownerType = t;
+
+    //˒i Update OjɌĂ΂̂ŁAłRC_[擾
+    if (!m_collider && GetOwner())
+    {
+        m_collider = GetOwner()->GetComponent<ColliderComponent>().get();
+    }
+    if (!m_collider) { return; }
+
+    //wcƂ̃C[ɂāA□̒eƂ̔Ȃ
+    switch (t)
+    {
+    case BulletType::PLAYER: m_collider->SetLayer(LAYER_PLAYER_BULLET); break;
+    case BulletType::ENEMY:  m_collider->SetLayer(LAYER_ENEMY_BULLET);  break;
+    default:                 m_collider->SetLayer(LAYER_DEFAULT);       break;
+    }
+}
+
 void BulletComponent::Update(float dt)
 {
     //I[i[Ȃ΍XVȂ
@@ -46,9 +83,24 @@ void BulletComponent::Update(float dt)
                 s->RemoveObject(owner);
             }
         }
+
+        if (m_collider)
+        {
+            m_collider->ClearSweep();
+        }
         return; // ȍ~̍XV͂Ȃ
     }
 
+    //ړÖʒuRC_[ɓniړƓ蔻肷邽߁j
+    if (!m_collider)
+    {
+        m_collider = GetOwner()->GetComponent<ColliderComponent>().get();
+    }
+    if (m_collider)
+    {
+        m_collider->SetSweepStart(m_collider->GetCenter());
+    }
+
     //ړiHoming ͊OR|[lg velocity 𒲐Oj
     Vector3 pos = GetOwner()->GetPosition();
     pos += m_velocity * m_speed * dt;
@@ -6,6 +6,7 @@
 using namespace DirectX::SimpleMath;
 
 class GameObject; // O錾
+class ColliderComponent;
 
 class BulletComponent : public Component
 {
@@ -24,6 +25,9 @@ public:
     //֐
     void Initialize() override;
 
+    //v[ōėpƂɏԂ֖߂
+    void Reset();
+
     //XV֐
     void Update(float dt) override;
 
@@ -41,8 +45,8 @@ public:
     void SetLifetime(float sec) { m_lifetime = sec; }
     float GetLifetime() const { return m_lifetime; }
 
-    //e̎
-    void SetBulletType(BulletType t) { m_ownerType = t; }
+    //e̎ށiRC_[̃C[킹Đ؂ւj
+    void SetBulletType(BulletType t);
     BulletType GetBulletType() const { return m_ownerType; }
 
     //Fiځj
@@ -66,4 +70,7 @@ private:
 
     //--------------ڊ֘A------------------
     Vector4 m_color = Vector4(1, 1, 1, 1);  //F(RGBA)
+
+    //--------------AՓ˔------------------
+    ColliderComponent* m_collider = nullptr; //ړÖʒuni Update Ŏ擾j
 };
@@ -31,6 +31,10 @@ public:
     void SetClockwise(bool cw) { m_Clockwise = cw; }
     void SetRotateToTangent(bool v) { m_RotateToTangent = v; }
     void SetStartAngle(float rad) { m_Angle = rad; }
+
+    //ivnupj
+    std::shared_ptr<Component> Clone() const override { return std::make_shared<CirculPatrolComponent>(*this); }
+
 private:
 
     Vector3 m_Center = Vector3::Zero;      //鎞̒S_([hW)
@@ -10,6 +10,19 @@ enum ColliderType
     SPHERE
 };
 
+//蔻̃C[
+//iǂ̃C[m𔻒肷邩 CollisionManager ̃C[\Ō߂j
+enum CollisionLayer : uint8_t
+{
+    LAYER_DEFAULT,
+    LAYER_PLAYER,
+    LAYER_ENEMY,
+    LAYER_PLAYER_BULLET,
+    LAYER_ENEMY_BULLET,
+    LAYER_BUILDING,
+    LAYER_COUNT
+};
+
 //---------------------------------------------------------------
 //  RC_[R|[lgNX
 //  ̃NX͓̂蔻̃f[^`邾
@@ -42,9 +55,37 @@ public:
 
     bool IsStatic() const { return isStatic; }
 
+    //C[̃ZbgEQbg֐
+    void SetLayer(CollisionLayer layer) { m_layer = layer; }
+    CollisionLayer GetLayer() const { return m_layer; }
+    uint32_t GetLayerBit() const { return 1u << m_layer; }
+
+    //---------------AՓ˔iȒê蔲h~j---------------
+    //radius > 0 ŗLBړO̒S -> ݂̒S 𔼌a radius ̋ő|Ĕ肷
+    void SetContinuous(float radius) { m_sweepRadius = radius; }
+    //̃t[̈ړO̒SZbgiړ鑤t[Ăԁj
+    void SetSweepStart(const Vector3& start) { m_sweepStart = start; m_hasSweep = (m_sweepRadius > 0.0f); }
+    void ClearSweep() { m_hasSweep = false; }
+
+    bool HasSweep() const { return m_hasSweep; }
+    const Vector3& GetSweepStart() const { return m_sweepStart; }
+    float GetSweepRadius() const { return m_sweepRadius; }
+
+    //CollisionManager ̓o^z̈ʒui-1 = o^BCollisionManager  O(1) œo^E邽߂Ɏgj
+    int GetRegistryIndex() const { return m_registryIndex; }
+    void SetRegistryIndex(int index) { m_registryIndex = index; }
+
 protected:
     ColliderType m_Type;
     bool m_hitThisFrame = false; //t[̏Փˏ
 	bool m_enabled = true;       //蔻̗L/ 
+    CollisionLayer m_layer = LAYER_DEFAULT; //C[
+
+    //AՓ˔p
+    Vector3 m_sweepStart = Vector3::Zero; //ړO̒S
+    float m_sweepRadius = 0.0f;           //|鋅̔ai0 = j
+    bool m_hasSweep = false;              //̃t[̑|邩
+
+    int m_registryIndex = -1;             //CollisionManager::m_Colliders ̈ʒu
    
 };
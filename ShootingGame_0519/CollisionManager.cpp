@@ -2,11 +2,13 @@
 #include <algorithm>    
 #include <cmath>
 #include <cfloat>       
+#include <cstring>
 #include <DirectXMath.h>
 #include <SimpleMath.h> 
 #include "Player.h"
 #include "CollisionManager.h"
 #include "Collision.h"
+#include "SweptCollision.h"
 #include "CollisionResolver.h"
 #include "DebugGlobals.h"
 #include "renderer.h"
@@ -14,12 +16,57 @@
 #include "MoveComponent.h"
 #include "PushOutComponent.h"
 #include "IMovable.h"
+#include "Logger.h"
+#include "FrameArena.h"
 
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
 
 std::vector<ColliderComponent*> CollisionManager::m_Colliders;
 bool CollisionManager::m_hitThisFrame = false;
+SpatialIndex CollisionManager::m_broadPhase;
+
+namespace
+{
+    constexpr uint32_t LayerBit(CollisionLayer layer) { return 1u << layer; }
+    constexpr uint32_t kAllLayers = (1u << LAYER_COUNT) - 1;
+
+    //GetCenter() を中心にしてコライダーを包む球の半径
+    float BoundingRadius(ColliderComponent* col)
+    {
+        switch (col->GetColliderType())
+        {
+        case ColliderType::SPHERE:
+            return static_cast<SphereColliderComponent*>(col)->GetRadius();
+        case ColliderType::AABB:
+        {
+            auto a = static_cast<AABBColliderComponent*>(col);
+            return ((a->GetMax() - a->GetMin()) * 0.5f).Length();
+        }
+        case ColliderType::OBB:
+            return (static_cast<OBBColliderComponent*>(col)->GetSize() * 0.5f).Length();
+        }
+        return 0.0f;
+    }
+}
+
+//既定のレイヤー表
+//・建物同士、同じ陣営の弾同士は判定しない
+//・撃った側と自分の陣営の弾も判定しない（OnCollision で無視されていて、押し出しだけ起きていた）
+uint32_t CollisionManager::m_layerMatrix[LAYER_COUNT] =
+{
+    /* DEFAULT       */ kAllLayers,
+    /* PLAYER        */ kAllLayers & ~LayerBit(LAYER_PLAYER_BULLET),
+    /* ENEMY         */ kAllLayers & ~LayerBit(LAYER_ENEMY_BULLET),
+    /* PLAYER_BULLET */ kAllLayers & ~LayerBit(LAYER_PLAYER) & ~LayerBit(LAYER_PLAYER_BULLET),
+    /* ENEMY_BULLET  */ kAllLayers & ~LayerBit(LAYER_ENEMY) & ~LayerBit(LAYER_ENEMY_BULLET),
+    /* BUILDING      */ kAllLayers & ~LayerBit(LAYER_BUILDING),
+};
+
+uint32_t CollisionManager::m_pairTests[LAYER_COUNT][LAYER_COUNT] = {};
+uint32_t CollisionManager::m_pairHits[LAYER_COUNT][LAYER_COUNT] = {};
+uint32_t CollisionManager::m_layerCulled = 0;
+uint32_t CollisionManager::m_staticCulled = 0;
 
 void CollisionManager::RegisterCollider(ColliderComponent* collider)
 {
@@ -28,15 +75,15 @@ void CollisionManager::RegisterCollider(ColliderComponent* collider)
     if (!collider->GetOwner())
     {
         //ログ表示
-        std::cout << "コライダーの所持者が存在しません" << std::endl;
+        LOG_WARN("コライダーの所持者が存在しません");
         return;
     }
 
-    //重複防止
-    if (std::find(m_Colliders.begin(), m_Colliders.end(), collider) == m_Colliders.end())
-    {
-        m_Colliders.push_back(collider);
-    }
+    //重複防止（登録済みならコライダー側に位置が入っている）
+    if (collider->GetRegistryIndex() >= 0) { return; }
+
+    collider->SetRegistryIndex(static_cast<int>(m_Colliders.size()));
+    m_Colliders.push_back(collider);
 }
 
 void CollisionManager::UnregisterCollider(ColliderComponent* collider)
@@ -46,18 +93,76 @@ void CollisionManager::UnregisterCollider(ColliderComponent* collider)
         return;
     }
 
-    auto it = std::find(m_Colliders.begin(), m_Colliders.end(), collider);
-    if (it != m_Colliders.end())
+    int index = collider->GetRegistryIndex();
+    if (index < 0 || index >= static_cast<int>(m_Colliders.size()) || m_Colliders[index] != collider)
     {
-        m_Colliders.erase(it);
+        return;
     }
+
+    //末尾のコライダーを空いた位置に移して詰める（順番は変わるが探索も移動も無し）
+    ColliderComponent* last = m_Colliders.back();
+    m_Colliders[index] = last;
+    last->SetRegistryIndex(index);
+    m_Colliders.pop_back();
+    collider->SetRegistryIndex(-1);
 }
 
 void CollisionManager::Clear()
 {
+    for (auto* col : m_Colliders)
+    {
+        col->SetRegistryIndex(-1);
+    }
     m_Colliders.clear();
 }
 
+void CollisionManager::SetLayerCollision(CollisionLayer a, CollisionLayer b, bool enable)
+{
+    if (a >= LAYER_COUNT || b >= LAYER_COUNT) { return; }
+
+    if (enable)
+    {
+        m_layerMatrix[a] |= LayerBit(b);
+        m_layerMatrix[b] |= LayerBit(a);
+    }
+    else
+    {
+        m_layerMatrix[a] &= ~LayerBit(b);
+        m_layerMatrix[b] &= ~LayerBit(a);
+    }
+}
+
+const char* CollisionManager::GetLayerName(CollisionLayer layer)
+{
+    switch (layer)
+    {
+    case LAYER_DEFAULT:       return "Default";
+    case LAYER_PLAYER:        return "Player";
+    case LAYER_ENEMY:         return "Enemy";
+    case LAYER_PLAYER_BULLET: return "PlayerBullet";
+    case LAYER_ENEMY_BULLET:  return "EnemyBullet";
+    case LAYER_BUILDING:      return "Building";
+    default:                  return "?";
+    }
+}
+
+uint32_t CollisionManager::GetPairTestCount(CollisionLayer a, CollisionLayer b)
+{
+    if (a >= LAYER_COUNT || b >= LAYER_COUNT) { return 0; }
+    return (a <= b) ? m_pairTests[a][b] : m_pairTests[b][a];
+}
+
+uint32_t CollisionManager::GetPairHitCount(CollisionLayer a, CollisionLayer b)
+{
+    if (a >= LAYER_COUNT || b >= LAYER_COUNT) { return 0; }
+    return (a <= b) ? m_pairHits[a][b] : m_pairHits[b][a];
+}
+
+void CollisionManager::SetBroadPhaseBounds(const Vector3& min, const Vector3& max, float cellSize)
+{
+    m_broadPhase.SetBounds(min, max, cellSize);
+}
+
 void CollisionManager::CheckCollisions()
 {
     //全コライダーを未ヒット状態にする
@@ -66,133 +171,140 @@ void CollisionManager::CheckCollisions()
         col->SetHitThisFrame(false);
     }
 
+    //統計をリセット
+    std::memset(m_pairTests, 0, sizeof(m_pairTests));
+    std::memset(m_pairHits, 0, sizeof(m_pairHits));
+    m_layerCulled = 0;
+    m_staticCulled = 0;
+
     //判定する物の収集を行う
-    std::vector<CollisionInfoLite>  hitPairs;
+    //（フレーム内だけで使うのでフレームアリーナから確保）
+    FrameVector<CollisionInfoLite>  hitPairs;
 
     //サイズ取得
     size_t count = m_Colliders.size();
-       
-    //サイズ分回す
+
+    //-----------------連続判定しない物同士：全組み合わせ-----------------
     for (size_t i = 0; i < count; ++i)
     {
-        //
         ColliderComponent* colA = m_Colliders[i];
-        //コライダーが付いていなければ
-        if(!colA){ continue; }
-
-        GameObject* ownerA = colA->GetOwner();
-        //所有者がいなければ
-        if(!ownerA){ continue; }
+        //コライダーが付いていない・掃引する物は下でまとめて見る
+        if (!colA || colA->HasSweep()) { continue; }
 
         //今の当たり判定の一個先から回す
         for (size_t j = i + 1; j < count; ++j)
         {
             ColliderComponent* colB = m_Colliders[j];
-            //コライダーが付いていなければ
-            if (!colB){ continue; }
+            if (!colB || colB->HasSweep()) { continue; }
 
-            GameObject* ownerB = colB->GetOwner();
-            //所有者がいなければ
-            if (!ownerB){ continue; }
-            
-            bool hit = false;
+            TestPair(colA, colB, hitPairs);
+        }
+    }
 
-            //コライダーの種類(AABB or OBB)を取得
-            auto typeA = colA->GetColliderType();
-            auto typeB = colB->GetColliderType();
+    //-----------------連続判定する物：掃引した範囲の箱に重なる相手だけ-----------------
+    //全コライダーの外接球（掃引する物は移動前後を含む球）をグリッドに入れ、掃引の箱で引く
+    FrameVector<Vector3> centers(count);
+    FrameVector<float> radii(count, 0.0f);
+    bool anySweep = false;
+    for (size_t i = 0; i < count; ++i)
+    {
+        ColliderComponent* col = m_Colliders[i];
+        if (!col) { continue; }
 
-            //-----------------------------------------
-            // 衝突判定 ： AABB vs AABB
-            //-----------------------------------------
-            if (typeA == ColliderType::AABB && typeB == ColliderType::AABB)
-            {
-                auto a = static_cast<AABBColliderComponent*>(colA);
-                auto b = static_cast<AABBColliderComponent*>(colB);
-                hit = Collision::IsAABBHit(a->GetMin(), a->GetMax(), b->GetMin(), b->GetMax());
-            }
-            //-----------------------------------------
-            // 衝突判定 ： OBB vs OBB
-            //-----------------------------------------
-            else if (typeA == ColliderType::OBB && typeB == ColliderType::OBB)
-            {
-                auto a = static_cast<OBBColliderComponent*>(colA);
-                auto b = static_cast<OBBColliderComponent*>(colB);
-
-                //各データを取得する
-                Vector3 centerA = a->GetCenter();
-                Vector3 centerB = b->GetCenter();
-                Matrix  rotA = a->GetRotationMatrix();
-                Matrix  rotB = b->GetRotationMatrix();
-                Vector3 halfA = a->GetSize() * 0.5f;
-                Vector3 halfB = b->GetSize() * 0.5f;
-
-                //
-                Vector3 axesA[3] = { rotA.Right(), rotA.Up(), rotA.Forward() };
-                Vector3 axesB[3] = { rotB.Right(), rotB.Up(), rotB.Forward() };
-
-                hit = Collision::IsOBBHit(centerA, axesA, halfA, centerB, axesB, halfB);
-            }
-            else if (typeA == ColliderType::SPHERE && typeB == ColliderType::OBB)
-            {
-                auto s = static_cast<SphereColliderComponent*>(colA);
-                auto o = static_cast<OBBColliderComponent*>(colB);
-                hit = Collision::IsSphereVsOBBHit(s, o);
-            }
-            else if (typeA == ColliderType::OBB && typeB == ColliderType::SPHERE)
-            {
-                auto o = static_cast<OBBColliderComponent*>(colA);
-                auto s = static_cast<SphereColliderComponent*>(colB);
-                hit = Collision::IsSphereVsOBBHit(s, o);
-            }
+        if (col->HasSweep())
+        {
+            Vector3 p0 = col->GetSweepStart();
+            Vector3 p1 = col->GetCenter();
+            centers[i] = (p0 + p1) * 0.5f;
+            radii[i] = (p1 - p0).Length() * 0.5f + col->GetSweepRadius();
+            anySweep = true;
+        }
+        else
+        {
+            centers[i] = col->GetCenter();
+            radii[i] = BoundingRadius(col);
+        }
+    }
 
-            //-----------------------------------------
-            // 衝突判定 ： AABB vs OBB
-            //-----------------------------------------
-            else
+    if (anySweep)
+    {
+        m_broadPhase.RebuildSpheres(centers.data(), radii.data(), count);
+
+        FrameVector<uint32_t> candidates;
+        for (size_t i = 0; i < count; ++i)
+        {
+            ColliderComponent* colA = m_Colliders[i];
+            if (!colA || !colA->HasSweep()) { continue; }
+
+            Vector3 p0 = colA->GetSweepStart();
+            Vector3 p1 = colA->GetCenter();
+            Vector3 r(colA->GetSweepRadius());
+            Vector3 boxMin = Vector3::Min(p0, p1) - r;
+            Vector3 boxMax = Vector3::Max(p0, p1) + r;
+
+            candidates.clear();
+            m_broadPhase.QueryBoxIndices(boxMin, boxMax, candidates);
+
+            for (uint32_t j : candidates)
             {
-                AABBColliderComponent* aabb = nullptr;
-                OBBColliderComponent* obb = nullptr;
-                if (typeA == ColliderType::AABB)
-                {
-                    aabb = static_cast<AABBColliderComponent*>(colA);
-                    obb  = static_cast<OBBColliderComponent*>(colB); 
-                }
-                else
-                {
-                    aabb = static_cast<AABBColliderComponent*>(colB); 
-                    obb  = static_cast<OBBColliderComponent*>(colA);
-                }
-
-                // AABB と OBB 双方の Get* は null-safe 実装を期待
-                hit = Collision::IsAABBvsOBBHit(
-                    aabb->GetMin(), aabb->GetMax(),
-                    obb->GetCenter(), obb->GetRotationMatrix(),
-                    obb->GetSize() * 0.5f);
+                ColliderComponent* colB = m_Colliders[j];
+                if (j == i || !colB) { continue; }
+
+                //両方掃引する組は番号の小さい側から 1 回だけ見る
+                //（小さい側の箱は自分の掃引を、相手の球は相手の掃引を包むので取りこぼさない）
+                if (colB->HasSweep() && j < i) { continue; }
+
+                //全組み合わせのときと同じく番号の小さい側を A にする
+                if (j < i) { TestPair(colB, colA, hitPairs); }
+                else       { TestPair(colA, colB, hitPairs); }
             }
+        }
+    }
 
+    //掃引した物は、一番早く触れた相手にだけ当てる（手前の敵を抜けて奥に当たらないように）
+    //コライダーごとに最も早いペアを覚え、掃引する側すべてにとって最も早いペアだけを残す
+    //（弾同士のペアは両方の弾で比べる。同じ時刻なら先に積んだペア）
+    FrameVector<int> earliest(count, -1);
+    for (size_t k = 0; k < hitPairs.size(); ++k)
+    {
+        const CollisionInfoLite& info = hitPairs[k];
+        if (!info.sweeper) { continue; }
 
+        ColliderComponent* members[2] = { info.a, info.b };
+        for (ColliderComponent* c : members)
+        {
+            if (!c->HasSweep()) { continue; }
 
-            //-----------------------------------------
-            // 結果を送る(ログも出す)
-            //-----------------------------------------
-            if (hit)
+            int& best = earliest[c->GetRegistryIndex()];
+            if (best < 0 || info.toi < hitPairs[best].toi)
             {
-                //コリジョンイベント通知
-                //判定フェーズでは通知しないで入れておく。
-                CollisionInfoLite info;
-                info.a = colA;
-                info.b = colB;
-                hitPairs.push_back(info);
+                best = static_cast<int>(k);
             }
-            else
+        }
+    }
+
+    for (size_t k = 0; k < hitPairs.size(); ++k)
+    {
+        CollisionInfoLite& info = hitPairs[k];
+        if (!info.sweeper) { continue; }
+
+        bool keep = true;
+        ColliderComponent* members[2] = { info.a, info.b };
+        for (ColliderComponent* c : members)
+        {
+            if (c->HasSweep() && earliest[c->GetRegistryIndex()] != static_cast<int>(k))
             {
-                //当たっていない場合のログ（デバッグ時のみ有効にするといい）
-                //std::cout << "当たっていません "<< std::endl;
+                keep = false;
             }
-        
+        }
+
+        if (!keep)
+        {
+            info.a = nullptr;
+            info.b = nullptr;
         }
     }
-    
+
     for (const auto& p : hitPairs)
     {
         //
@@ -271,6 +383,17 @@ void CollisionManager::CheckCollisions()
             resolved = false;
         }
 
+        //連続判定で当たった弾は、フレーム終了時に重なっていなくても（すり抜けていても）通知する
+        if (!resolved && p.sweeper)
+        {
+            colA->SetHitThisFrame(true);
+            colB->SetHitThisFrame(true);
+
+            ownerA->OnCollision(ownerB);
+            ownerB->OnCollision(ownerA);
+            continue;
+        }
+
         //押し出しがいらないなら
         if (!resolved){ continue; }
         
@@ -333,7 +456,7 @@ void CollisionManager::CheckCollisions()
             }
             else
             {
-                std::cout << "PushOutComponent missing on A\n";
+                LOG_WARN("PushOutComponent missing on A");
             }
 
             if (pushBComp)
@@ -342,7 +465,7 @@ void CollisionManager::CheckCollisions()
             }
             else
             {
-                std::cout << "PushOutComponent missing on B\n";
+                LOG_WARN("PushOutComponent missing on B");
             }
 
 
@@ -374,7 +497,7 @@ void CollisionManager::DebugDrawAllColliders(DebugRenderer& dr)
 {
     if (m_Colliders.empty()) 
     {
-        std::cout << "コライダーに何も登録されていません " << std::endl;
+        LOG_WARN("コライダーに何も登録されていません");
         return;
     }
 
@@ -398,10 +521,8 @@ void CollisionManager::DebugDrawAllColliders(DebugRenderer& dr)
             Vector3 fullSize = (mx - mn);
             Vector3 halfSize = fullSize * 0.5f;
 
-            char buf[256];
-            sprintf_s(buf, "DB G: AABB center=(%f,%f,%f) fullSize=(%f,%f,%f)\n",
+            LOG_DEBUG("AABB center=(%f,%f,%f) fullSize=(%f,%f,%f)",
                 center.x, center.y, center.z, fullSize.x, fullSize.y, fullSize.z);
-            OutputDebugStringA(buf);
 
             fullSize = halfSize * 2.0f;
             dr.AddBox(center, fullSize, Matrix::Identity, color);
@@ -414,10 +535,8 @@ void CollisionManager::DebugDrawAllColliders(DebugRenderer& dr)
             Vector3 halfSize = fullSize * 0.5f;
             Matrix rot = o->GetRotationMatrix();
 
-            char buf[256];
-            sprintf_s(buf, "DBG: OBB center=(%f,%f,%f) fullSize=(%f,%f,%f)\n",
+            LOG_DEBUG("OBB center=(%f,%f,%f) fullSize=(%f,%f,%f)",
                 center.x, center.y, center.z, fullSize.x, fullSize.y, fullSize.z);
-            OutputDebugStringA(buf);
 
             dr.AddBox(center, halfSize, rot, color);
         }
@@ -429,6 +548,182 @@ void CollisionManager::DebugDrawAllColliders(DebugRenderer& dr)
 }
 
 
+void CollisionManager::TestPair(ColliderComponent* colA, ColliderComponent* colB, FrameVector<CollisionInfoLite>& hitPairs)
+{
+    //所有者がいなければ
+    GameObject* ownerA = colA->GetOwner();
+    GameObject* ownerB = colB->GetOwner();
+    if (!ownerA || !ownerB) { return; }
+
+    //形状を見る前にレイヤー・static で弾く
+    CollisionLayer layerA = colA->GetLayer();
+    if (!(m_layerMatrix[layerA] & colB->GetLayerBit()))
+    {
+        ++m_layerCulled;
+        return;
+    }
+    //動かない物同士は当たっても何も起きない
+    if (colA->IsStatic() && colB->IsStatic())
+    {
+        ++m_staticCulled;
+        return;
+    }
+
+    CollisionLayer layerB = colB->GetLayer();
+    CollisionLayer lo = (layerA <= layerB) ? layerA : layerB;
+    CollisionLayer hi = (layerA <= layerB) ? layerB : layerA;
+    ++m_pairTests[lo][hi];
+
+    bool hit = false;
+    float toi = -1.0f;
+
+    //コライダーの種類(AABB or OBB)を取得
+    auto typeA = colA->GetColliderType();
+    auto typeB = colB->GetColliderType();
+
+    //-----------------------------------------
+    // 衝突判定 ： 連続判定（速い弾）
+    //-----------------------------------------
+    if (colA->HasSweep() || colB->HasSweep())
+    {
+        hit = CheckSweep(colA, colB, toi);
+    }
+    //-----------------------------------------
+    // 衝突判定 ： AABB vs AABB
+    //-----------------------------------------
+    else if (typeA == ColliderType::AABB && typeB == ColliderType::AABB)
+    {
+        auto a = static_cast<AABBColliderComponent*>(colA);
+        auto b = static_cast<AABBColliderComponent*>(colB);
+        hit = Collision::IsAABBHit(a->GetMin(), a->GetMax(), b->GetMin(), b->GetMax());
+    }
+    //-----------------------------------------
+    // 衝突判定 ： OBB vs OBB
+    //-----------------------------------------
+    else if (typeA == ColliderType::OBB && typeB == ColliderType::OBB)
+    {
+        auto a = static_cast<OBBColliderComponent*>(colA);
+        auto b = static_cast<OBBColliderComponent*>(colB);
+
+        //各データを取得する
+        Vector3 centerA = a->GetCenter();
+        Vector3 centerB = b->GetCenter();
+        Matrix  rotA = a->GetRotationMatrix();
+        Matrix  rotB = b->GetRotationMatrix();
+        Vector3 halfA = a->GetSize() * 0.5f;
+        Vector3 halfB = b->GetSize() * 0.5f;
+
+        //
+        Vector3 axesA[3] = { rotA.Right(), rotA.Up(), rotA.Forward() };
+        Vector3 axesB[3] = { rotB.Right(), rotB.Up(), rotB.Forward() };
+
+        hit = Collision::IsOBBHit(centerA, axesA, halfA, centerB, axesB, halfB);
+    }
+    else if (typeA == ColliderType::SPHERE && typeB == ColliderType::OBB)
+    {
+        auto s = static_cast<SphereColliderComponent*>(colA);
+        auto o = static_cast<OBBColliderComponent*>(colB);
+        hit = Collision::IsSphereVsOBBHit(s, o);
+    }
+    else if (typeA == ColliderType::OBB && typeB == ColliderType::SPHERE)
+    {
+        auto o = static_cast<OBBColliderComponent*>(colA);
+        auto s = static_cast<SphereColliderComponent*>(colB);
+        hit = Collision::IsSphereVsOBBHit(s, o);
+    }
+
+    //-----------------------------------------
+    // 衝突判定 ： AABB vs OBB
+    //-----------------------------------------
+    else
+    {
+        AABBColliderComponent* aabb = nullptr;
+        OBBColliderComponent* obb = nullptr;
+        if (typeA == ColliderType::AABB)
+        {
+            aabb = static_cast<AABBColliderComponent*>(colA);
+            obb  = static_cast<OBBColliderComponent*>(colB); 
+        }
+        else
+        {
+            aabb = static_cast<AABBColliderComponent*>(colB); 
+            obb  = static_cast<OBBColliderComponent*>(colA);
+        }
+
+        // AABB と OBB 双方の Get* は null-safe 実装を期待
+        hit = Collision::IsAABBvsOBBHit(
+            aabb->GetMin(), aabb->GetMax(),
+            obb->GetCenter(), obb->GetRotationMatrix(),
+            obb->GetSize() * 0.5f);
+    }
+
+
+
+    //-----------------------------------------
+    // 結果を送る(ログも出す)
+    //-----------------------------------------
+    if (hit)
+    {
+        ++m_pairHits[lo][hi];
+
+        //コリジョンイベント通知
+        //判定フェーズでは通知しないで入れておく。
+        CollisionInfoLite info;
+        info.a = colA;
+        info.b = colB;
+        if (toi >= 0.0f)
+        {
+            info.sweeper = colA->HasSweep() ? colA : colB;
+            info.toi = toi;
+        }
+        hitPairs.push_back(info);
+    }
+}
+
+bool CollisionManager::CheckSweep(ColliderComponent* colA, ColliderComponent* colB, float& outT)
+{
+    //両方とも動いている（弾同士）：B から見た A の相対移動にして球同士で判定
+    if (colA->HasSweep() && colB->HasSweep())
+    {
+        Vector3 moveA = colA->GetCenter() - colA->GetSweepStart();
+        Vector3 moveB = colB->GetCenter() - colB->GetSweepStart();
+        Vector3 start = colA->GetSweepStart();
+
+        return Collision::SweepSphereVsSphere(start, start + (moveA - moveB), colA->GetSweepRadius(),
+                                              colB->GetSweepStart(), colB->GetSweepRadius(), outT);
+    }
+
+    ColliderComponent* mover = colA->HasSweep() ? colA : colB;
+    ColliderComponent* other = colA->HasSweep() ? colB : colA;
+
+    Vector3 p0 = mover->GetSweepStart();
+    Vector3 p1 = mover->GetCenter();
+    float r = mover->GetSweepRadius();
+
+    switch (other->GetColliderType())
+    {
+    case ColliderType::SPHERE:
+    {
+        auto s = static_cast<SphereColliderComponent*>(other);
+        return Collision::SweepSphereVsSphere(p0, p1, r, s->GetCenter(), s->GetRadius(), outT);
+    }
+    case ColliderType::AABB:
+    {
+        auto a = static_cast<AABBColliderComponent*>(other);
+        return Collision::SweepSphereVsAABB(p0, p1, r, a->GetMin(), a->GetMax(), outT);
+    }
+    case ColliderType::OBB:
+    {
+        auto o = static_cast<OBBColliderComponent*>(other);
+        Vector3 axes[3];
+        ExtractAxesFromRotation(o->GetRotationMatrix(), axes);
+        return Collision::SweepSphereVsOBB(p0, p1, r, o->GetCenter(), axes, o->GetSize() * 0.5f, outT);
+    }
+    }
+
+    return false;
+}
+
 void CollisionManager::KillInwardVelocity(GameObject* obj,
                                           const DirectX::SimpleMath::Vector3& normal)
 {
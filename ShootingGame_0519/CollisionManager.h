@@ -3,6 +3,8 @@
 #include <memory>
 #include "ColliderComponent.h"
 #include "DebugRenderer.h"
+#include "FrameArena.h"
+#include "SpatialIndex.h"
 
 class DebugRenderer;
 
@@ -11,6 +13,10 @@ struct CollisionInfoLite
 {
     ColliderComponent* a = nullptr;
     ColliderComponent* b = nullptr;
+
+    //AՓ˔œꍇF|ƁAŏɐGꂽ (0..1)
+    ColliderComponent* sweeper = nullptr;
+    float toi = -1.0f;
 };
 
 class CollisionManager
@@ -18,9 +24,10 @@ class CollisionManager
 public:
 
     //蔻肵RC_[t[̃Xgɒǉ
+    //iXg̈ʒuRC_[Ɏ̂ŁAo^E폜Ƃ O(1)j
     static void RegisterCollider(ColliderComponent* collider);
 
-    //蔻o^ĂXg폜
+    //蔻o^ĂXg폜iƓւċl߂̂ŁAXg̏Ԃ͕ςj
     static void UnregisterCollider(ColliderComponent* collider);
 
     //Ot[܂łɓo^Ă
@@ -29,17 +36,58 @@ public:
 
     //m_Colliders ɓo^ꂽRC_[̑Sgݍ킹𔻒肷֐
     //肪OnCollisionĂяo
+    //iÃRC_[͑Sgݍ킹ł͂ȂA|͈͂̔ɏdȂ鑊肾j
     static void CheckCollisions();
 
+    //ȂTɎgObh͈̔́ivCGAɍ킹ČĂԁBĂ΂Ȃ 1 ZőSj
+    static void SetBroadPhaseBounds(const DirectX::SimpleMath::Vector3& min,
+                                    const DirectX::SimpleMath::Vector3& max, float cellSize = 32.0f);
+
     static void DebugDrawAllColliders(DebugRenderer& dr);
 
+    //-----------------C[\-----------------
+    //C[ a  b ̑gݍ킹𔻒肷邩ǂݒ肷iΏ́j
+    static void SetLayerCollision(CollisionLayer a, CollisionLayer b, bool enable);
+
+    //C[ a  b 𔻒肷邩ǂ
+    static bool ShouldCollide(CollisionLayer a, CollisionLayer b) { return (m_layerMatrix[a] & (1u << b)) != 0; }
+
+    static const char* GetLayerName(CollisionLayer layer);
+
+    //-----------------vi߂ CheckCollisions 1 񕪁j-----------------
+    //C[̑gݍ킹Ƃ̌`󔻒̉񐔁E񐔁isj
+    static uint32_t GetPairTestCount(CollisionLayer a, CollisionLayer b);
+    static uint32_t GetPairHitCount(CollisionLayer a, CollisionLayer b);
+
+    //`󔻒̑OɒeyA̐iC[\ŏO / Ƃ staticj
+    static uint32_t GetLayerCulledCount() { return m_layerCulled; }
+    static uint32_t GetStaticCulledCount() { return m_staticCulled; }
+
 private:
 
     static void KillInwardVelocity(GameObject* obj,
                             const DirectX::SimpleMath::Vector3& normal);
 
+    //|ł̔iǂ炩 SetContinuous ĂyApj
+    static bool CheckSweep(ColliderComponent* colA, ColliderComponent* colB, float& outT);
+
+    //1 yA̔iC[Estatic ŒeAv𐔂A hitPairs ɐςށj
+    static void TestPair(ColliderComponent* colA, ColliderComponent* colB, FrameVector<CollisionInfoLite>& hitPairs);
+
     //蔻sIuWFNg̃Xg
     static std::vector<ColliderComponent*> m_Colliders;
     static bool m_hitThisFrame;
+
+    //ȂTpiCheckCollisions ̂тɑSRC_[̊Oڋō蒼j
+    static SpatialIndex m_broadPhase;
+
+    //C[\im_layerMatrix[a] ̃rbg b Ă a  b 𔻒肷j
+    static uint32_t m_layerMatrix[LAYER_COUNT];
+
+    //vi[̃C[][傫̃C[] ɐj
+    static uint32_t m_pairTests[LAYER_COUNT][LAYER_COUNT];
+    static uint32_t m_pairHits[LAYER_COUNT][LAYER_COUNT];
+    static uint32_t m_layerCulled;
+    static uint32_t m_staticCulled;
 };
 
@@ -3,6 +3,7 @@
 // PlayerEnemÿꓮ𐧍삷邤ŋKƂȂNX
 // pĎg(jWvA_bVAhȂ)
 //---------------------------------------------------------
+#include <memory>
 
 class GameObject; //O錾
 
@@ -16,6 +17,10 @@ public:
     virtual void Draw(float alpha) {};  //Q[[vDraw
     virtual void Uninit() {};
 
+    //vnu畡ƂɎgiLf[^͎QƂ̂܂܁ACX^XƂ̏ԂRs[j
+    //ɑΉĂȂR|[lg nullptr Ԃ
+    virtual std::shared_ptr<Component> Clone() const { return nullptr; }
+
     //R|[lgNX(GameObjectȂ)QƁAێdg
     //jR|[lgł̍XVŐeIuWFNg̈ʒu
     //@@xύXꍇm_owerg
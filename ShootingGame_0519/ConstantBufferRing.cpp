@@ -0,0 +1,78 @@
+﻿#include "ConstantBufferRing.h"
+#include <cstring>
+
+void ConstantBufferRing::Reset(uint32_t capacity)
+{
+    m_capacity = capacity & ~(kConstantBufferAlignment - 1);
+    m_head = 0;
+    m_needDiscard = true;
+    m_generation = 0;
+
+    m_frameBytes = 0;
+    m_frameAllocations = 0;
+    m_frameWraps = 0;
+    m_peakFrameBytes = 0;
+}
+
+void ConstantBufferRing::BeginFrame()
+{
+    if (m_frameBytes > m_peakFrameBytes) { m_peakFrameBytes = m_frameBytes; }
+
+    //前のフレームの分は DISCARD でドライバが別のメモリに逃がすので、先頭から使い直せる
+    m_head = 0;
+    m_needDiscard = true;
+
+    m_frameBytes = 0;
+    m_frameAllocations = 0;
+    m_frameWraps = 0;
+}
+
+bool ConstantBufferRing::Allocate(uint32_t size, ConstantBufferAllocation& out)
+{
+    if (size == 0 || size > kConstantBufferMaxBindBytes) { return false; }
+
+    const uint32_t aligned = AlignConstantBufferSize(size);
+    if (aligned > m_capacity) { return false; }
+
+    //末尾に入りきらなければ先頭に戻る。書き込み済みの場所は描画待ちかもしれないので DISCARD で Map させる
+    if (m_head + aligned > m_capacity)
+    {
+        m_head = 0;
+        m_needDiscard = true;
+        ++m_frameWraps;
+    }
+
+    out.offset = m_head;
+    out.size = aligned;
+    out.firstConstant = m_head / 16;
+    out.numConstants = aligned / 16;
+    out.discard = m_needDiscard;
+    if (out.discard) { ++m_generation; }
+
+    m_needDiscard = false;
+    m_head += aligned;
+    m_frameBytes += aligned;
+    ++m_frameAllocations;
+    return true;
+}
+
+bool ConstantSlotShadows::Remember(uint32_t slot, void* fallbackBuffer, const void* data, uint32_t size, bool vs, bool ps)
+{
+    if (slot >= kSlotCount || size > sizeof(m_slots[slot].data)) { return false; }
+
+    ConstantSlotShadow& shadow = m_slots[slot];
+    shadow.fallbackBuffer = fallbackBuffer;
+    shadow.size = size;
+    shadow.vs = vs;
+    shadow.ps = ps;
+    std::memcpy(shadow.data, data, size);
+    return true;
+}
+
+void ConstantSlotShadows::Clear()
+{
+    for (auto& shadow : m_slots)
+    {
+        shadow = ConstantSlotShadow();
+    }
+}
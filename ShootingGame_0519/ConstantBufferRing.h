@@ -0,0 +1,128 @@
+﻿#pragma once
+#include <cstdint>
+
+//------------------------------------------------------------
+// 定数バッファのフレーム内リング（サブアロケータ）
+// 大きな動的バッファ 1 本を 256 バイト単位で前から切り出し、描画ごとに別の場所へ定数を書く
+// ・フレームの最初と、末尾まで使い切って先頭に戻ったときだけ WRITE_DISCARD で Map し、
+//   それ以外は WRITE_NO_OVERWRITE で Map する（GPU がまだ読む場所には書かない）
+// ・割り当て位置は *SetConstantBuffers1 に渡す定数（16 バイト）単位でも返す
+// ・DISCARD で Map するとそれまでに書いた場所は全部消えるので、スロットに最後に書いた値を
+//   ConstantSlotShadows に覚えておき、DISCARD のたびにバインド中のスロットを書き直す
+// バッファの作成と Map は Renderer の担当で、ここは位置の計算だけ（Tools/ConstantBufferRingCheck で確認できる）
+//------------------------------------------------------------
+
+//*SetConstantBuffers1 のオフセットとサイズは 16 定数（256 バイト）の倍数でなければならない
+constexpr uint32_t kConstantBufferAlignment = 256;
+//1 回のバインドでシェーダーから見える最大サイズ（D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT 個の定数）
+constexpr uint32_t kConstantBufferMaxBindBytes = 4096 * 16;
+
+//size を 256 バイトの倍数に切り上げる
+constexpr uint32_t AlignConstantBufferSize(uint32_t size)
+{
+    return (size + kConstantBufferAlignment - 1) & ~(kConstantBufferAlignment - 1);
+}
+
+//割り当て結果
+struct ConstantBufferAllocation
+{
+    uint32_t offset = 0;            //バッファ先頭からのバイト数
+    uint32_t size = 0;              //256 バイトに切り上げたサイズ
+    uint32_t firstConstant = 0;     //offset / 16（*SetConstantBuffers1 の pFirstConstant）
+    uint32_t numConstants = 0;      //size / 16（*SetConstantBuffers1 の pNumConstants）
+    bool discard = false;           //true なら WRITE_DISCARD で Map する
+};
+
+class ConstantBufferRing
+{
+public:
+    explicit ConstantBufferRing(uint32_t capacity = 0) { Reset(capacity); }
+
+    //容量を決め直して空にする（256 の倍数に切り下げる）
+    void Reset(uint32_t capacity);
+
+    //フレームの最初に呼ぶ。次の割り当ては DISCARD になる
+    void BeginFrame();
+
+    //Map に失敗したときなど、バッファの中身が当てにならなくなったら次を DISCARD にする
+    void RequestDiscard() { m_needDiscard = true; }
+
+    //size バイトを切り出す。0 バイトや、容量・1 回のバインドの上限を超える大きさなら false
+    //（呼び出し側は従来の UpdateSubresource の経路を使う）
+    bool Allocate(uint32_t size, ConstantBufferAllocation& out);
+
+    uint32_t GetCapacity() const { return m_capacity; }
+    uint32_t GetHead() const { return m_head; }
+
+    //DISCARD の割り当てを返した回数。退避したバインドの位置がまだ中身を保っているかの判定に使う
+    //（退避したときと値が違えば、その間に DISCARD で消えている）
+    uint32_t GetGeneration() const { return m_generation; }
+
+    //今のフレームの統計（先頭に戻った分も含む）
+    uint32_t GetFrameBytes() const { return m_frameBytes; }
+    uint32_t GetFrameAllocations() const { return m_frameAllocations; }
+    uint32_t GetFrameWraps() const { return m_frameWraps; }
+
+    //BeginFrame までに終わったフレームで一番多く使ったバイト数（容量を決める目安）
+    uint32_t GetPeakFrameBytes() const { return m_peakFrameBytes; }
+
+private:
+    uint32_t m_capacity = 0;
+    uint32_t m_head = 0;
+    bool m_needDiscard = true;
+    uint32_t m_generation = 0;
+
+    uint32_t m_frameBytes = 0;
+    uint32_t m_frameAllocations = 0;
+    uint32_t m_frameWraps = 0;
+    uint32_t m_peakFrameBytes = 0;
+};
+
+//スロットに最後に書いた定数（256 バイトまで）
+struct ConstantSlotShadow
+{
+    void* fallbackBuffer = nullptr;     //リングが使えないときに更新する個別バッファ（Renderer では ID3D11Buffer*）
+    uint32_t size = 0;                  //0 ならまだ何も書いていない
+    bool vs = false;
+    bool ps = false;
+    alignas(16) uint8_t data[kConstantBufferAlignment];
+};
+
+//スロット b0～b5 に最後に書いた値を覚えておき、リングが DISCARD で消えたときに書き直す
+//（カメラやライトのように毎フレーム・毎描画は設定されない値も、消えた場所を指したままにしない）
+class ConstantSlotShadows
+{
+public:
+    static constexpr uint32_t kSlotCount = 6;
+    static constexpr uint32_t kNoSlot = ~0u;
+
+    //slot に書いた値を覚える。範囲外のスロットや 256 バイトを超える値は覚えない（false）
+    bool Remember(uint32_t slot, void* fallbackBuffer, const void* data, uint32_t size, bool vs, bool ps);
+
+    const ConstantSlotShadow& Get(uint32_t slot) const { return m_slots[slot]; }
+    void Set(uint32_t slot, const ConstantSlotShadow& shadow) { if (slot < kSlotCount) { m_slots[slot] = shadow; } }
+    void Clear();
+
+    //覚えているスロットを skipSlot 以外すべて write(slot, shadow) で書き直す。書き直した数を返す
+    //write の中でさらに DISCARD になっても、書き直しを入れ子にはしない（その場で 0 を返す）
+    template<typename WriteFunc>
+    uint32_t RewriteAll(uint32_t skipSlot, WriteFunc&& write)
+    {
+        if (m_rewriting) { return 0; }
+
+        m_rewriting = true;
+        uint32_t count = 0;
+        for (uint32_t slot = 0; slot < kSlotCount; ++slot)
+        {
+            if (slot == skipSlot || m_slots[slot].size == 0) { continue; }
+            write(slot, m_slots[slot]);
+            ++count;
+        }
+        m_rewriting = false;
+        return count;
+    }
+
+private:
+    ConstantSlotShadow m_slots[kSlotCount];
+    bool m_rewriting = false;
+};
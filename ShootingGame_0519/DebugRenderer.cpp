@@ -1,4 +1,5 @@
 ﻿#include "DebugRenderer.h"
+#include "renderer.h"
 #include <d3dcompiler.h>
 #include <cassert>
 #include <fstream>
@@ -215,8 +216,8 @@ void DebugRenderer::Draw(const Matrix& view, const Matrix& proj)
     ID3D11VertexShader* prevVS = nullptr;
     ID3D11PixelShader* prevPS = nullptr;
     ID3D11InputLayout* prevIL = nullptr;
-    ID3D11Buffer* prevVSCB[4] = { nullptr, nullptr, nullptr, nullptr }; // adjust count if you need more slots
-    ID3D11Buffer* prevPSCB[4] = { nullptr, nullptr, nullptr, nullptr };
+    SavedConstantBuffers prevVSCB;     // Renderer の定数リングはオフセット付きでバインドされている
+    SavedConstantBuffers prevPSCB;
     ID3D11BlendState* prevBlend = nullptr;
     FLOAT               prevBlendFactor[4] = { 0,0,0,0 };
     UINT                prevSampleMask = 0xFFFFFFFF;
@@ -229,8 +230,8 @@ void DebugRenderer::Draw(const Matrix& view, const Matrix& proj)
     m_context->VSGetShader(&prevVS, nullptr, nullptr);
     m_context->PSGetShader(&prevPS, nullptr, nullptr);
     m_context->IAGetInputLayout(&prevIL);
-    m_context->VSGetConstantBuffers(0, _countof(prevVSCB), prevVSCB);
-    m_context->PSGetConstantBuffers(0, _countof(prevPSCB), prevPSCB);
+    Renderer::GetConstantBuffers(false, 0, 4, prevVSCB); // adjust count if you need more slots
+    Renderer::GetConstantBuffers(true, 0, 4, prevPSCB);
     m_context->OMGetBlendState(&prevBlend, prevBlendFactor, &prevSampleMask);
     m_context->IAGetPrimitiveTopology(&prevTopo);
     m_context->IAGetVertexBuffers(0, 1, prevVBs, prevStrides, prevOffsets);
@@ -280,15 +281,15 @@ void DebugRenderer::Draw(const Matrix& view, const Matrix& proj)
     m_context->OMSetBlendState(prevBlend, prevBlendFactor, prevSampleMask);
 
     // Restore constant buffers (slot 0..N as we saved)
-    m_context->VSSetConstantBuffers(0, _countof(prevVSCB), prevVSCB);
-    m_context->PSSetConstantBuffers(0, _countof(prevPSCB), prevPSCB);
+    Renderer::SetConstantBuffers(prevVSCB);
+    Renderer::SetConstantBuffers(prevPSCB);
 
     // Release references we acquired via Get*
     if (prevVS) prevVS->Release();
     if (prevPS) prevPS->Release();
     if (prevIL) prevIL->Release();
-    for (auto& p : prevVSCB) if (p) p->Release();
-    for (auto& p : prevPSCB) if (p) p->Release();
+    prevVSCB.Release();
+    prevPSCB.Release();
     if (prevBlend) prevBlend->Release();
     for (auto& p : prevVBs) if (p) p->Release();
 
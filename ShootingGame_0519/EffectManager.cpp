@@ -1,56 +1,99 @@
 #include "EffectManager.h"
-#include "GameObject.h"
 #include "BillboardEffectComponent.h"
+#include "ParticleRenderer.h"
+#include "TextureManager.h"
+#include "MemoryTracker.h"
 #include "renderer.h"
 
-std::vector<std::shared_ptr<GameObject>> EffectManager::m_effectObjects;
+std::vector<EffectManager::ParticleAtlas> EffectManager::m_atlases;
 
 void EffectManager::Init()
 {
-	m_effectObjects.clear();
+	m_atlases.clear();
 }
 
 void EffectManager::Update(float dt)
 {
-	for (auto& effect : m_effectObjects)
+	for (auto& atlas : m_atlases)
 	{
-		if (effect)
-		{
-			effect->Update(dt);
-		}
+		atlas.particles->Update(dt);
 	}
-	RemoveFinishedEffects();
 }
 
 void EffectManager::Draw3D(float dt)
 {
-	for (auto& obj : m_effectObjects)
+	//AgXƂ 1 ̕`
+	ParticleRenderer::Begin();
+	for (auto& atlas : m_atlases)
+	{
+		ParticleRenderer::Draw(*atlas.particles, atlas.texture.get(), atlas.cols, atlas.rows, atlas.isAdditive);
+	}
+	ParticleRenderer::End();
+}
+
+void EffectManager::Uninit()
+{
+	m_atlases.clear();
+}
+
+EffectManager::ParticleAtlas* EffectManager::GetAtlas(const std::string& texturePath, int cols, int rows, bool isAdditive)
+{
+	//eNX`E@Ȃ瓯obt@ɂ܂Ƃ߂
+	for (auto& atlas : m_atlases)
 	{
-		if (obj)
+		if (atlas.isAdditive == isAdditive && atlas.texturePath == texturePath)
 		{
-			obj->Draw(dt);
+			return &atlas;
 		}
 	}
+
+	TextureHandle texture = TextureManager::Load(texturePath);
+	if (!texture)
+	{
+		return nullptr;
+	}
+
+	ParticleAtlas atlas;
+	atlas.texturePath = texturePath;
+	atlas.isAdditive = isAdditive;
+	atlas.cols = (cols > 0) ? cols : 1;
+	atlas.rows = (rows > 0) ? rows : 1;
+	atlas.texture = texture;
+
+	MemoryScope memoryScope(MemoryCategory::Effect);
+	atlas.particles = std::make_unique<ParticleBuffer>(kMaxParticlesPerAtlas, atlas.cols * atlas.rows);
+	atlas.particles->SetDrag(3.0f);
+
+	m_atlases.push_back(std::move(atlas));
+	return &m_atlases.back();
 }
 
-void EffectManager::Uninit()
+void EffectManager::SpawnParticles(const std::string& texturePath, int cols, int rows, bool isAdditive,
+								   const ParticleEmitParams& params)
 {
-	m_effectObjects.clear();
+	ParticleAtlas* atlas = GetAtlas(texturePath, cols, rows, isAdditive);
+	if (!atlas)
+	{
+		return;
+	}
+
+	atlas->particles->Emit(params);
 }
 
 void EffectManager::SpawnBillboardEffect(const BillboardEffectConfig& config,
 								         const DirectX::SimpleMath::Vector3& pos)
 {
-	auto effe = std::make_shared<GameObject>();
-	effe->SetPosition(pos);
+	//~܂܂܃R}肷 1 Ƃďo
+	ParticleEmitParams params;
+	params.position = pos;
+	params.count = 1;
+	params.lifeMin = config.duration;
+	params.lifeMax = config.duration;
+	params.sizeStart = config.size;
+	params.sizeEnd = config.size;
+	params.color = config.color;
 
-	//r{[h̃GtFNgR|[lgǉ
-	auto fx = std::make_shared<BillboardEffectComponent>();
-	fx->SetConfig(config);
-	effe->AddComponent(fx);
-
-	effe->Initialize();
-	m_effectObjects.push_back(effe);
+	SpawnParticles(config.texturePath, config.cols, config.rows, config.isAdditive, params);
 }
 
 void EffectManager::SpawnExplosion(const DirectX::SimpleMath::Vector3& pos)
@@ -64,28 +107,30 @@ void EffectManager::SpawnExplosion(const DirectX::SimpleMath::Vector3& pos)
 	config.isAdditive = true;
 	config.color = DirectX::SimpleMath::Vector4(1, 1, 1, 1);
 
+	//S̑傫Ȕ
 	SpawnBillboardEffect(config, pos);
+
+	//ɔюU鏬ȉΉԁiAgXȂ̂ŕ`͒Sƈꏏ 1 ōςށj
+	ParticleEmitParams sparks;
+	sparks.position = pos;
+	sparks.count = 10;
+	sparks.speedMin = 15.0f;
+	sparks.speedMax = 35.0f;
+	sparks.lifeMin = 0.25f;
+	sparks.lifeMax = 0.45f;
+	sparks.sizeStart = 8.0f;
+	sparks.sizeEnd = 2.0f;
+	sparks.color = DirectX::XMFLOAT4(1.0f, 0.85f, 0.6f, 1.0f);
+
+	SpawnParticles(config.texturePath, config.cols, config.rows, config.isAdditive, sparks);
 }
 
-void EffectManager::RemoveFinishedEffects()
+size_t EffectManager::GetParticleCount()
 {
-	m_effectObjects.erase(
-		std::remove_if(m_effectObjects.begin(), m_effectObjects.end(),
-			[](const std::shared_ptr<GameObject>& obj)
-			{
-				if (!obj)
-				{
-					return true;
-				}
-
-				auto fx = obj->GetComponent<BillboardEffectComponent>();
-				if (!fx)
-				{
-					return true;
-				}
-
-				return fx->IsFinished();
-			}),
-		m_effectObjects.end());
+	size_t total = 0;
+	for (const auto& atlas : m_atlases)
+	{
+		total += atlas.particles->GetCount();
+	}
+	return total;
 }
-
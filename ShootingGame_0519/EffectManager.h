@@ -1,11 +1,19 @@
 #pragma once
 #include <memory>
+#include <string>
 #include <vector>
+#include <d3d11.h>
 #include <SimpleMath.h>
+#include "ParticleSystem.h"
+#include "TextureManager.h"
 
 struct BillboardEffectConfig;
-class GameObject;
 
+//------------------------------------------------------------
+// GtFNg̊ǗNX
+// GtFNgׂ͂ăp[eBNƂĈAXvCgV[giAgXjƂ
+// 1  ParticleBuffer ɂ܂Ƃ߂čXVE`悷iGameObject ͍Ȃj
+//------------------------------------------------------------
 class EffectManager
 {
 public:
@@ -17,11 +25,29 @@ public:
     //----------Spawn֐-------------
     static void SpawnBillboardEffect(const BillboardEffectConfig& config, const DirectX::SimpleMath::Vector3& pos);
     static void SpawnExplosion(const DirectX::SimpleMath::Vector3& pos);
+    static void SpawnParticles(const std::string& texturePath, int cols, int rows, bool isAdditive,
+                               const ParticleEmitParams& params);
     //static void SpawnSmoke(const DirectX::SimpleMath::Vector3& pos, float size);
     //static void SpawnBulletTrail(const DirectX::SimpleMath::Vector3& from, const DirectX::SimpleMath::Vector3& to);
 
+    //Ă闱̑ifobO\pj
+    static size_t GetParticleCount();
+
 private:
+    //AgX 1 ̃p[eBN
+    struct ParticleAtlas
+    {
+        std::string texturePath;
+        bool isAdditive = true;
+        int cols = 1;
+        int rows = 1;
+        TextureHandle texture;
+        std::unique_ptr<ParticleBuffer> particles;
+    };
+
+    //AgX 1 ̍ő嗱
+    static constexpr size_t kMaxParticlesPerAtlas = 65536;
 
-	static std::vector<std::shared_ptr<GameObject>> m_effectObjects;
-	static void RemoveFinishedEffects();
+	static std::vector<ParticleAtlas> m_atlases;
+	static ParticleAtlas* GetAtlas(const std::string& texturePath, int cols, int rows, bool isAdditive);
 };
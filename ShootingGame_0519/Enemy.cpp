@@ -13,8 +13,6 @@ void Enemy::Update(float dt)
 {
     auto hp = GetComponent<HitPointComponent>();
     GameObject::Update(dt);
-
-	std::cout << "Enemy Pos: " << GetPosition().x << ", " << GetPosition().y << ", " << GetPosition().z << "\n";
 }
 
 //Փˎ̏
@@ -8,7 +8,7 @@
 class Enemy : public GameObject
 {
 public:
-    Enemy() = default;
+    Enemy() { SetTag(TAG_ENEMY); }
     ~Enemy() override = default;
 
     //
@@ -32,13 +32,13 @@ void EnemyAIComponent::Initialize()
 Vector3 EnemyAIComponent::ComputeFlee(const Vector3& pos)
 {
 	//vC[IuWFNg݂ȂȂ
-    if(m_target == nullptr)
+    if(ResolveTarget() == nullptr)
     {
         return Vector3::Zero;
     }
 
 	//vC[瓦vZ(^[QbgPos - gPos)
-    Vector3 toPlayer = m_target->GetPosition() - pos;
+    Vector3 toPlayer = ResolveTarget()->GetPosition() - pos;
     float dist2 = toPlayer.LengthSquared();
     if (dist2 < 1e-6f)
     {
@@ -91,13 +91,13 @@ Vector3 EnemyAIComponent::ComputeFlee(const Vector3& pos)
 Vector3 EnemyAIComponent::ComputeFleeVelocity(const Vector3& pos) const
 {
 	//^[QbgIuWFNg݂ȂȂ
-    if (!m_target)
+    if (!ResolveTarget())
     {
         return Vector3::Zero;
     }
 
 	//^[Qbg瓦vZ
-	Vector3 toPlayer = m_target->GetPosition() - pos;   //^[Qbg̈ʒu - g̈ʒu
+	Vector3 toPlayer = ResolveTarget()->GetPosition() - pos;   //^[Qbg̈ʒu - g̈ʒu
 
 	//^[QbgƓʒuɂꍇ͓Ȃ
     if (toPlayer.LengthSquared() < 1e-6f)
@@ -362,9 +362,9 @@ void EnemyAIComponent::Update(float dt)
     Vector3 desiredVel = desiredFleeVel + steeringFromForces;
 
     Vector3 toPlayer = Vector3::Zero;
-    if (m_target != nullptr)
+    if (ResolveTarget() != nullptr)
     {
-        toPlayer = m_target->GetPosition() - pos;
+        toPlayer = ResolveTarget()->GetPosition() - pos;
     }
 
     if (toPlayer.LengthSquared() > 1e-6f)
@@ -465,9 +465,9 @@ void EnemyAIComponent::Update(float dt)
 
         Vector3 dir = Vector3::Zero;
 
-        if (m_target != nullptr)
+        if (ResolveTarget() != nullptr)
         {
-            Vector3 toP = m_target->GetPosition() - currentPos;
+            Vector3 toP = ResolveTarget()->GetPosition() - currentPos;
             if (toP.LengthSquared() > 1e-6f)
             {
                 toP.Normalize();
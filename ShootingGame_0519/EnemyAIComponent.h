@@ -1,5 +1,6 @@
 #pragma once
 #include "Component.h"
+#include "GameObject.h"
 #include <SimpleMath.h>
 
 class PlayAreaComponent;
@@ -19,7 +20,7 @@ public:
     void SetLookahead(float l) { m_lookahead = l; }
     void SetFeelerCount(int n) { m_feelerCount = n; }
 	void SetFeelerSpread(float a) { m_feelerSpread = a; }
-	void SetTarget(GameObject* player) { m_target = player; }
+	void SetTarget(GameObject* player) { m_target = player ? player->GetHandle() : GameObjectHandle(); }
 
 	void SetPlayArea(PlayAreaComponent* playArea) { m_playArea = playArea; }
 
@@ -30,6 +31,9 @@ public:
 		m_baseHeight = (minY + maxY) * 0.5f;
 	}
 
+	//ivnupj
+	std::shared_ptr<Component> Clone() const override { return std::make_shared<EnemyAIComponent>(*this); }
+
 private:
 	//͂vZ֐
     DirectX::SimpleMath::Vector3 ComputeFlee(const DirectX::SimpleMath::Vector3& pos);
@@ -73,5 +77,8 @@ private:
 
 	DirectX::SimpleMath::Vector3 m_velocity = { 0,0,0 };    //݂̑x
 
-	GameObject* m_target = nullptr;  //vC[IuWFNgւ̃|C^
+	GameObjectHandle m_target;  //vC[IuWFNgւ̃nh
+
+	//^[QbgɋȂ nullptr
+	GameObject* ResolveTarget() const { return GameObject::Resolve(m_target); }
 };
\ No newline at end of file
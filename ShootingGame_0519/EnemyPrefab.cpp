@@ -0,0 +1,266 @@
+﻿#include "EnemyPrefab.h"
+#include <sstream>
+#include "Enemy.h"
+#include "ModelComponent.h"
+#include "HitPointCompornent.h"
+#include "SphereColliderComponent.h"
+#include "OBBColliderComponent.h"
+#include "AABBColliderComponent.h"
+#include "PushOutComponent.h"
+#include "PatrolComponent.h"
+#include "CircularPatrolComponent.h"
+#include "FixedTurretComponent.h"
+#include "EnemyAIComponent.h"
+#include "Logger.h"
+
+namespace
+{
+    //コメントを落として、空行なら false
+    bool StripLine(std::string& line)
+    {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+        return line.find_first_not_of(" \t\r") != std::string::npos;
+    }
+}
+
+bool EnemyPrefab::ParseLine(const std::string& line, std::string& error)
+{
+    std::istringstream ss(line);
+    std::string key;
+    ss >> key;
+
+    //----------オブジェクト自体の設定-------------
+    if (key == "scale")
+    {
+        if (!(ss >> m_scale.x >> m_scale.y >> m_scale.z)) { error = "scale x y z"; return false; }
+        return true;
+    }
+    if (key == "hp")
+    {
+        if (!(ss >> m_initialHP)) { error = "hp n"; return false; }
+        return true;
+    }
+    if (key == "radius")
+    {
+        if (!(ss >> m_boundingRadius)) { error = "radius r"; return false; }
+        return true;
+    }
+
+    //----------コンポーネント-------------
+    if (key == "model")
+    {
+        std::string path, option;
+        if (!(ss >> path)) { error = "model path [instanced]"; return false; }
+        ss >> option;
+
+        //読み込みはここで 1 回だけ（キャッシュ済みなら共有するだけ）
+        auto model = std::make_shared<ModelComponent>();
+        model->LoadModel(path);
+        model->SetInstanced(option == "instanced");
+        m_components.push_back(model);
+        return true;
+    }
+    if (key == "hitpoint")
+    {
+        int maxHP = 1;
+        float invincible = 0.0f;
+        if (!(ss >> maxHP >> invincible)) { error = "hitpoint max invincibleSec"; return false; }
+
+        auto hp = std::make_shared<HitPointComponent>(maxHP);
+        hp->SetInvincibilityOnHit(invincible);
+        m_components.push_back(hp);
+        return true;
+    }
+    if (key == "sphere")
+    {
+        float radius = 1.0f;
+        DirectX::SimpleMath::Vector3 offset = DirectX::SimpleMath::Vector3::Zero;
+        if (!(ss >> radius)) { error = "sphere r [ox oy oz]"; return false; }
+        ss >> offset.x >> offset.y >> offset.z;
+
+        auto col = std::make_shared<SphereColliderComponent>();
+        col->SetRadius(radius);
+        col->SetLocalOffset(offset);
+        col->SetLayer(LAYER_ENEMY);
+        m_components.push_back(col);
+        return true;
+    }
+    if (key == "obb" || key == "aabb")
+    {
+        DirectX::SimpleMath::Vector3 size;
+        if (!(ss >> size.x >> size.y >> size.z)) { error = key + " sx sy sz"; return false; }
+
+        if (key == "obb")
+        {
+            auto col = std::make_shared<OBBColliderComponent>();
+            col->SetSize(size);
+            col->SetLayer(LAYER_ENEMY);
+            m_components.push_back(col);
+        }
+        else
+        {
+            auto col = std::make_shared<AABBColliderComponent>();
+            col->SetSize(size);
+            col->SetLayer(LAYER_ENEMY);
+            m_components.push_back(col);
+        }
+        return true;
+    }
+    if (key == "pushout")
+    {
+        float mass = 1.0f;
+        if (!(ss >> mass)) { error = "pushout mass"; return false; }
+
+        auto push = std::make_shared<PushOutComponent>();
+        push->SetMass(mass);
+        m_components.push_back(push);
+        return true;
+    }
+    if (key == "patrol")
+    {
+        float speed = 0.0f, arrival = 0.0f;
+        int pingPong = 0, loop = 1, face = 1;
+        if (!(ss >> speed >> arrival >> pingPong >> loop >> face))
+        {
+            error = "patrol speed arrival pingPong loop face";
+            return false;
+        }
+
+        auto patrol = std::make_shared<PatrolComponent>();
+        patrol->SetSpeed(speed);
+        patrol->SetArrivalThreshold(arrival);
+        patrol->SetPingPong(pingPong != 0);
+        patrol->SetUseSpline(true);
+        patrol->SetLoop(loop != 0);
+        patrol->SetFaceMovement(face != 0);
+        m_components.push_back(patrol);
+        return true;
+    }
+    if (key == "circle")
+    {
+        float angularSpeed = 0.0f;
+        int clockwise = 1;
+        if (!(ss >> angularSpeed >> clockwise)) { error = "circle angularSpeed clockwise"; return false; }
+
+        auto circ = std::make_shared<CirculPatrolComponent>();
+        circ->SetAngularSpeed(angularSpeed);
+        circ->SetClockwise(clockwise != 0);
+        m_components.push_back(circ);
+        return true;
+    }
+    if (key == "turret")
+    {
+        float cooldown = 1.0f, bulletSpeed = 0.0f;
+        if (!(ss >> cooldown >> bulletSpeed)) { error = "turret cooldown bulletSpeed"; return false; }
+
+        auto turt = std::make_shared<FixedTurretComponent>();
+        turt->SetCooldown(cooldown);
+        turt->SetBulletSpeed(bulletSpeed);
+        m_components.push_back(turt);
+        return true;
+    }
+    if (key == "flee")
+    {
+        float maxSpeed = 0.0f, maxForce = 0.0f, strength = 0.0f, lookahead = 0.0f, spread = 0.0f;
+        int feelers = 0;
+        if (!(ss >> maxSpeed >> maxForce >> strength >> lookahead >> feelers >> spread))
+        {
+            error = "flee maxSpeed maxForce strength lookahead feelerCount feelerSpread";
+            return false;
+        }
+
+        auto ai = std::make_shared<EnemyAIComponent>();
+        ai->SetMaxSpeed(maxSpeed);
+        ai->SetMaxForce(maxForce);
+        ai->SetFleeStrength(strength);
+        ai->SetLookahead(lookahead);
+        ai->SetFeelerCount(feelers);
+        ai->SetFeelerSpread(spread);
+        m_components.push_back(ai);
+        return true;
+    }
+
+    error = "不明な項目 '" + key + "'";
+    return false;
+}
+
+std::shared_ptr<Enemy> EnemyPrefab::Instantiate() const
+{
+    auto enemy = std::make_shared<Enemy>();
+    enemy->SetScale(m_scale);
+    enemy->SetInitialHP(m_initialHP);
+    enemy->SetBoundingRadius(m_boundingRadius);
+
+    //設定済みのコンポーネントをコピーするだけ（モデル・経路などの共有データは参照のまま）
+    for (const auto& comp : m_components)
+    {
+        enemy->AddComponent(comp->Clone());
+    }
+
+    return enemy;
+}
+
+void EnemyPrefab::Load(std::istream& in, const std::string& sourceName,
+    std::vector<std::pair<std::string, std::shared_ptr<const EnemyPrefab>>>& outPrefabs)
+{
+    std::shared_ptr<EnemyPrefab> current;
+    std::string currentName;
+    std::string line;
+    int lineNo = 0;
+
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        if (!StripLine(line)) { continue; }
+
+        std::istringstream ss(line);
+        std::string key;
+        ss >> key;
+
+        if (key == "prefab")
+        {
+            if (current)
+            {
+                LOG_WARN("EnemyPrefab: %s(%d) '%s' に end がありません", sourceName.c_str(), lineNo, currentName.c_str());
+                outPrefabs.emplace_back(currentName, current);
+            }
+
+            currentName.clear();
+            ss >> currentName;
+            current = std::make_shared<EnemyPrefab>();
+            continue;
+        }
+
+        if (key == "end")
+        {
+            if (current)
+            {
+                outPrefabs.emplace_back(currentName, current);
+                current.reset();
+            }
+            continue;
+        }
+
+        if (!current)
+        {
+            LOG_WARN("EnemyPrefab: %s(%d) prefab の外に書かれています", sourceName.c_str(), lineNo);
+            continue;
+        }
+
+        std::string error;
+        if (!current->ParseLine(line, error))
+        {
+            LOG_WARN("EnemyPrefab: %s(%d) %s", sourceName.c_str(), lineNo, error.c_str());
+        }
+    }
+
+    if (current)
+    {
+        LOG_WARN("EnemyPrefab: %s '%s' に end がありません", sourceName.c_str(), currentName.c_str());
+        outPrefabs.emplace_back(currentName, current);
+    }
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SimpleMath.h>
+#include "Component.h"
+
+class Enemy;
+
+//------------------------------------------------------------
+// 敵のプレハブ（テンプレート）
+// ・テキストの 1 行が 1 コンポーネント（またはオブジェクト自体の設定）に対応する
+// ・読み込み時に設定済みのコンポーネントを 1 組だけ作っておき、Instantiate() はそれを Clone() するだけ
+// ・モデルデータや焼き済み経路などの重いデータはコンポーネントが shared_ptr で参照するので複製されない
+// ・読み込み後は変更しない（複数のスポナーから const で共有してよい）
+//
+// 書式（# 以降はコメント）
+//   scale x y z                    オブジェクトの大きさ
+//   hp n                           Enemy 自体の HP
+//   radius r                       Raycast 用の半径
+//   model path [instanced]         ModelComponent
+//   hitpoint max invincibleSec     HitPointComponent
+//   sphere r [ox oy oz]            SphereColliderComponent（レイヤーは LAYER_ENEMY）
+//   obb sx sy sz / aabb sx sy sz   OBB / AABBColliderComponent（同上）
+//   pushout mass                   PushOutComponent
+//   patrol speed arrival pingPong loop face   PatrolComponent（経路は生成時に渡す）
+//   circle angularSpeed clockwise  CirculPatrolComponent（中心・半径は生成時に渡す）
+//   turret cooldown bulletSpeed    FixedTurretComponent（狙う相手は生成時に渡す）
+//   flee maxSpeed maxForce strength lookahead feelerCount feelerSpread   EnemyAIComponent
+//------------------------------------------------------------
+class EnemyPrefab
+{
+public:
+	//1 行を解釈してテンプレートに足す。解釈できなければ false（error に理由）
+	bool ParseLine(const std::string& line, std::string& error);
+
+	//テンプレートから敵を 1 体作る（シーンへの登録・Initialize は呼び出し側で行う）
+	std::shared_ptr<Enemy> Instantiate() const;
+
+	size_t GetComponentCount() const { return m_components.size(); }
+
+	//"prefab 名前" ～ "end" のブロックを読み込む
+	//読み込めたプレハブを名前付きで outPrefabs に追加し、読めなかった行は警告して飛ばす
+	static void Load(std::istream& in, const std::string& sourceName,
+		std::vector<std::pair<std::string, std::shared_ptr<const EnemyPrefab>>>& outPrefabs);
+
+private:
+	//オブジェクト自体の設定
+	DirectX::SimpleMath::Vector3 m_scale = { 1.0f, 1.0f, 1.0f };
+	int   m_initialHP = 1;
+	float m_boundingRadius = 1.0f;
+
+	//設定済みのコンポーネント（Instantiate で Clone する。追加した順に並ぶ）
+	std::vector<std::shared_ptr<const Component>> m_components;
+};
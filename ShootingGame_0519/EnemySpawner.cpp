@@ -1,7 +1,6 @@
 #include "EnemySpawner.h"
 #include "GameScene.h"
 #include "Enemy.h"
-#include "ModelComponent.h"
 #include "OBBColliderComponent.h"
 #include "PatrolComponent.h"
 #include "CircularPatrolComponent.h"
@@ -10,483 +9,245 @@
 #include "HitPointCompornent.h"
 #include "PushOutComponent.h"
 #include "SphereColliderComponent.h"
+#include "Logger.h"
+#include "AssetArchive.h"
+#include <sstream>
 
-EnemySpawner::EnemySpawner(GameScene* scene) : m_scene(scene)
-{
-    patrolCfg.waypoints = 
-    {
-        {0,0,0}, {100,0,0}, {100,0,100}, {0,0,100}
-    };
-}
-
-/// <summary>
-/// ߂n_𓮂G̃X|[p֐
-/// </summary>
-/// <param name="cfg">G̐ݒ̓ꂽRtBO</param>
-/// <param name="pos">G̃X|[ʒu</param>
-/// <returns></returns>
-std::shared_ptr<GameObject> EnemySpawner::SpawnPatrolEnemy(const PatrolConfig& cfg, 
-                                                           const DirectX::SimpleMath::Vector3& pos)
+namespace
 {
-    //Enemy𐶐Aݒs
-    auto enemy = std::make_shared<Enemy>();
-    enemy->SetScene(m_scene);
-    enemy->SetPosition(pos);
-    enemy->SetScale({ 4.0f, 4.0f, 4.0f });
-
-    //f̐ݒsAComponentt
-    auto model = std::make_shared<ModelComponent>();
-    model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
-    enemy->AddComponent(model);
-
-    //PatrolEnemy̐ݒsAComponentt
-    auto patrol = std::make_shared<PatrolComponent>();
-    if (!cfg.waypoints.empty())
+    //Asset/Prefab/Enemy.txt ǂ߂ȂƂp̍ŏ̃vnui EnemyPrefab.hj
+    //l̐̓t@C̕B̓EF[ut@CƂ̊EF[uiECjo邾ɂĂ
+    //iɖނ̗\ WaveScheduler::Prepare xĊOj
+    const char* const kDefaultPrefabs =
+        "prefab patrol\n"
+        "model Asset/Model/Enemy/EnemyFighterjet.obj instanced\n"
+        "patrol 65 0.5 1 1 1\n"
+        "hitpoint 1 0\n"
+        "sphere 3\n"
+        "pushout 1\n"
+        "end\n"
+        "prefab turret\n"
+        "model Asset/Model/Enemy/EnemyFighterjet.obj instanced\n"
+        "turret 1 80\n"
+        "hitpoint 1 0\n"
+        "aabb 3 3 3\n"
+        "pushout 1\n"
+        "end\n";
+
+    //EnemyArchetype ̏ɕׂ
+    const char* const kArchetypeNames[] = { "patrol", "circle", "turret", "flee" };
+
+    //̔ԍ͈͊O̔ԍZbgŃ[v
+    size_t WrapIndex(int id, size_t count)
     {
-        patrol->SetWaypoints(cfg.waypoints);
+        int n = static_cast<int>(count);
+        return static_cast<size_t>(((id % n) + n) % n);
     }
-    patrol->SetSpeed(cfg.speed);
-    patrol->SetArrivalThreshold(cfg.arrival);
-    patrol->SetPingPong(cfg.pingPong);
-
-    //XvCp̐ݒǉ
-    patrol->SetUseSpline(true);
-    patrol->SetSplineTension(5.0f);
-    patrol->SetLoop(true);
-    patrol->SetFaceMovement(true);
-
-    //R|[lgǉ(G̓)
-    enemy->AddComponent(patrol);
-
-    //HPݒ
-    auto hp = std::make_shared<HitPointComponent>(1);
-    hp->SetInvincibilityOnHit(0.0f);
-
-    //R|[lgǉ(HP)
-    enemy->AddComponent(hp);
-
-    //蔻̐ݒsAComponentt
-    auto col = std::make_shared<SphereColliderComponent>();
-    col->SetRadius(7.5f);                       // aBTCYɍ킹Ē
-    col->SetLocalOffset(Vector3(0.0f, 0.0f, 0.0f)); // ڒSȂItZbg
-    enemy->AddComponent(col);
-
-    auto push = std::make_shared<PushOutComponent>();
-    push->SetMass(5.0f);
-    enemy->AddComponent(push);
-   
-    //
-    enemy->Initialize();
-
-    //V[ɓo^
-    m_scene->AddObject(enemy); 
-
-    return enemy;
-}
-
-std::shared_ptr<GameObject> EnemySpawner::SpawnCircleEnemy(const CircleConfig& cfg, const DirectX::SimpleMath::Vector3& pos)
-{
-    //Enemy𐶐Aݒs
-    auto enemy = std::make_shared<Enemy>();
-    enemy->SetScene(m_scene);
-    enemy->SetPosition(pos);
-
-    enemy->SetInitialHP(3);
-
-    //f̐ݒsAComponentt
-    auto model = std::make_shared<ModelComponent>();
-    model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
-    enemy->AddComponent(model);
-
-    //蔻̐ݒsAComponentt
-    auto col = std::make_shared<OBBColliderComponent>();
-    col->SetSize({ 3,3,3 });
-    enemy->AddComponent(col);
-
-    //CirculPatrolEnemy̐ݒsAComponentt
-    auto circ = std::make_shared<CirculPatrolComponent>();
-    circ->SetCenter(cfg.center);
-    circ->SetRadius(cfg.radius);
-    circ->SetAngularSpeed(cfg.angularSpeed);
-    circ->SetClockwise(cfg.clockwise);
-    enemy->AddComponent(circ);
-
-    //HPݒ
-    auto hp = std::make_shared<HitPointComponent>(1);
-    hp->SetInvincibilityOnHit(0.0f);
-
-    //R|[lgǉ(HP)
-    enemy->AddComponent(hp);
-
-    auto push = std::make_shared<PushOutComponent>();
-    enemy->AddComponent(push);
-
-    m_scene->AddObject(enemy);
-
-    return enemy;
 }
 
-std::shared_ptr<GameObject> EnemySpawner::SpawnTurretEnemy(const TurretConfig& cfg, const DirectX::SimpleMath::Vector3& pos)
+EnemySpawner::EnemySpawner(GameScene* scene) : m_scene(scene)
 {
-    //Enemy𐶐Aݒs
-    auto enemy = std::make_shared<Enemy>();
-    enemy->SetScene(m_scene);
-    enemy->SetPosition(pos);
-    enemy->SetInitialHP(3);
-
-    //f̐ݒsAComponentt
-    auto model = std::make_shared<ModelComponent>();
-    model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
-    enemy->AddComponent(model);
-
-    //蔻̐ݒsAComponentt
-    auto col = std::make_shared<AABBColliderComponent>();
-    col->SetSize({ 3,3,3 });
-    enemy->AddComponent(col);
-
-    //TurretEnemy̐ݒsAComponentt
-    auto turt = std::make_shared<FixedTurretComponent>();
-    turt->SetCooldown(turretCfg.coolTime);
-    turt->SetBulletSpeed(turretCfg.bulletSpeed);
-    turt->SetTarget(turretCfg.target);
-    enemy->AddComponent(turt);
-
-    //HPݒ
-    auto hp = std::make_shared<HitPointComponent>(1);
-    hp->SetInvincibilityOnHit(0.0f);
-
-    //R|[lgǉ(HP)
-    enemy->AddComponent(hp);
-
-    auto push = std::make_shared<PushOutComponent>();
-    push->SetMass(15.0f);
-    enemy->AddComponent(push);
-
-    m_scene->AddObject(enemy);
-
-    return enemy;
+    //vnut@CĂ悤ɁAgݍ݂̃vnuɓǂł
+    std::istringstream defaults(kDefaultPrefabs);
+    LoadPrefabs(defaults, "(built-in)");
 }
 
-std::shared_ptr<GameObject> EnemySpawner::SpawnFleeEnemy(const FleeConfig& cfg,
-    const DirectX::SimpleMath::Vector3& pos)
+std::shared_ptr<const SplinePath> EnemySpawner::GetPatrolPath(size_t index)
 {
-    using namespace DirectX::SimpleMath;
+    if (index >= patrolWaypointSets.size()) { return nullptr; }
 
-    //Enemy𐶐Aݒs
-    auto enemy = std::make_shared<Enemy>();
-    enemy->SetScene(m_scene);
-    enemy->SetPosition(pos);
-    enemy->SetScale({ 3.0f, 3.0f, 3.0f });
-    enemy->SetInitialHP(3);
-    enemy->SetBoundingRadius(3.0f); //Raycastp̔aiGameScene::Raycast gj
-
-    //f
-    auto model = std::make_shared<ModelComponent>();
-    model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
-    enemy->AddComponent(model);
-
-    //RC_[
-    auto col = std::make_shared<OBBColliderComponent>();
-    col->SetSize({ 3,3,3 });
-    enemy->AddComponent(col);
-
-    //AIR|[lg
-    auto ai = std::make_shared<EnemyAIComponent>();
-    ai->SetMaxSpeed(cfg.maxSpeed);
-    ai->SetMaxForce(cfg.maxForce);
-    ai->SetFleeStrength(cfg.fleeStrength);
-    ai->SetLookahead(cfg.lookahead);
-    ai->SetFeelerCount(cfg.feelerCount);
-    ai->SetFeelerSpread(cfg.feelerSpread);
-
-    if (auto p = cfg.player.lock())
+    if (m_patrolPaths.size() < patrolWaypointSets.size())
     {
-        ai->SetTarget(p.get());
+        m_patrolPaths.resize(patrolWaypointSets.size());
     }
 
-    //PlayArea n
-    if (m_scene && m_scene->GetPlayArea()) 
+    //̓G̓[vœ̂Ń[vŏĂ
+    if (!m_patrolPaths[index])
     {
-        ai->SetPlayArea(m_scene->GetPlayArea());
+        const auto& set = patrolWaypointSets[index];
+        std::vector<DirectX::XMFLOAT3> points(set.begin(), set.end());
+        m_patrolPaths[index] = SplinePath::Bake(points, true);
     }
 
-    enemy->AddComponent(ai);
-
-    enemy->Initialize();
-
-    m_scene->AddObject(enemy);
-
-    return enemy;
+    return m_patrolPaths[index];
 }
 
-void EnemySpawner::EnsurePatrolCount()
+std::vector<std::weak_ptr<GameObject>>& EnemySpawner::GetSpawnedList(EnemyArchetype type)
 {
-    //Ăweak_ptrQƂɕϊ
-    std::vector<std::shared_ptr<GameObject>> live;
-
-    for (auto& w : m_spawnedPatrols) 
+    switch (type)
     {
-        //ptrĂ邩ǂ
-        if (auto sp = w.lock()) 
-        {
-            live.push_back(sp);
-        }
+    case EnemyArchetype::Circle: return m_spawnedCircles;
+    case EnemyArchetype::Turret: return m_spawnedTurrets;
+    case EnemyArchetype::Flee:   return m_spawnedFlees;
+    default:                     return m_spawnedPatrols;
     }
+}
 
-    //ɂ
-    m_spawnedPatrols.clear();
-
-    for (auto& s : live)
+bool EnemySpawner::LoadPrefabs(const std::string& path)
+{
+    AssetView view;
+    if (!AssetArchive::Load(path, view))
     {
-        //NĂzɖ߂
-        m_spawnedPatrols.push_back(s);
+        LOG_WARN("EnemySpawner: %s J܂igݍ݂̃vnug܂j", path.c_str());
+        return false;
     }
 
-    int current = (int)live.size();
-    int want = patrolCfg.spawnCount;
-
-    //̐w萔菭ȂȂ
-    if (current < want) 
-    {
-        int baseIndex = current;
-
-        for (int i = 0; i < want - current; ++i)
-        {
-            int slot = baseIndex + i;
-            //TCNăEFC|CgZbgIԁiZbg 2 Ȃ 0/1/0/1...j
-            const auto& selectedWaypoints = patrolWaypointSets[slot % patrolWaypointSets.size()];
-
-            PatrolConfig localCfg = patrolCfg;           //Rs[ĕҏW
-            localCfg.waypoints = selectedWaypoints;      //̓GpɃEFC|CgZbg
+    std::istringstream file(std::string(reinterpret_cast<const char*>(view.data), view.size));
+    return LoadPrefabs(file, path);
+}
 
-            // spawnPos ͓KX߂Bŏ̃EFC|CgɒuȂ:
-            DirectX::SimpleMath::Vector3 spawnPos = selectedWaypoints.front();
+bool EnemySpawner::LoadPrefabs(std::istream& in, const std::string& sourceName)
+{
+    std::vector<std::pair<std::string, std::shared_ptr<const EnemyPrefab>>> loaded;
+    EnemyPrefab::Load(in, sourceName, loaded);
 
-            auto e = SpawnPatrolEnemy(localCfg, spawnPos);
-            m_spawnedPatrols.push_back(e);
-        }
-    }
-    else if (current > want)
+    //Oނƈv̂ւiĂȂނ͍̂܂܁j
+    for (auto& [name, prefab] : loaded)
     {
-        // ]蕪폜ij
-        int removeCount = current - want;
-        for (int i = 0; i < removeCount; ++i)
+        EnemyArchetype type;
+        if (!ParseArchetype(name, type))
         {
-            if (auto sp = m_spawnedPatrols.back().lock()) 
-            {
-                // V[̍폜L[֓iFinishFrameCleanup ƍ킹j
-                m_scene->m_DeleteObjects.push_back(sp); //  APIBȂ m_scene->m_DeleteObjects.push_back(sp) s
-            }
-            m_spawnedPatrols.pop_back();
+            LOG_WARN("EnemySpawner: %s sȃvnu '%s'", sourceName.c_str(), name.c_str());
+            continue;
         }
+        m_prefabs[static_cast<int>(type)] = prefab;
     }
+
+    return !loaded.empty();
 }
 
-void EnemySpawner::EnsureTurretCount()
+const EnemyPrefab* EnemySpawner::GetPrefab(EnemyArchetype type) const
 {
-    //Ăweak_ptrQƂɕϊ
-    std::vector<std::shared_ptr<GameObject>> live;
+    int i = static_cast<int>(type);
+    return (i >= 0 && i < static_cast<int>(EnemyArchetype::Count)) ? m_prefabs[i].get() : nullptr;
+}
 
-    for (auto& w : m_spawnedTurrets)
+void EnemySpawner::WarmUp(EnemyArchetype type, int pathId)
+{
+    //f̓vnu̓ǂݍݎɓǂł̂ŁAoHŏĂĂ
+    if (type == EnemyArchetype::Patrol && !patrolWaypointSets.empty())
     {
-        //ptrĂ邩ǂ
-        if (auto sp = w.lock()) 
-        {
-            live.push_back(sp);
-        }
+        GetPatrolPath(WrapIndex(pathId, patrolWaypointSets.size()));
     }
+}
 
-    //ɂ
-    m_spawnedTurrets.clear();
-
-    for (auto& s : live)
+std::shared_ptr<GameObject> EnemySpawner::Build(EnemyArchetype type, int pathId)
+{
+    const EnemyPrefab* prefab = GetPrefab(type);
+    if (!prefab)
     {
-        //NĂzɖ߂
-        m_spawnedTurrets.push_back(s);
+        LOG_WARN("EnemySpawner::Build no prefab for '%s'", GetArchetypeName(type));
+        return nullptr;
     }
 
-    int current = (int)live.size();
-    int want = turretCfg.spawnCount;
+    //Lf[^̓vnû܂܁ACX^XƂ̏ԂG
+    auto enemy = prefab->Instantiate();
+    enemy->SetScene(m_scene);
 
-    //̐w萔菭ȂȂ
-    if (current < want) 
+    // 1 ̂ƂɈႤݒiʒuEoHE_j
+    switch (type)
     {
-        int baseIndex = current;
-
-        for (int i = 0; i < want - current; ++i)
+    case EnemyArchetype::Patrol:
+        if (!patrolWaypointSets.empty())
         {
-            int slot = baseIndex + i;
-
-            //TCNăEFC|CgZbgI
-            const auto& selectedPos = TurretPosSets[slot % TurretPosSets.size()];
+            size_t set = WrapIndex(pathId, patrolWaypointSets.size());
+            enemy->SetPosition(patrolWaypointSets[set].front());
 
-            TurretConfig localCfg = turretCfg;           //Rs[ĕҏW
-            localCfg.pos = selectedPos;      //̓GpɃEFC|CgZbg
-
-            auto e = SpawnTurretEnemy(localCfg, localCfg.pos);
-            m_spawnedTurrets.push_back(e);
-        }
-    }
-    else if (current > want)
-    {
-        // ]蕪폜ij
-        int removeCount = current - want;
-        for (int i = 0; i < removeCount; ++i)
-        {
-            if (auto sp = m_spawnedTurrets.back().lock())
+            //EFC|Cg̓Rs[AĂς݂̌oHL
+            if (auto patrol = enemy->GetComponent<PatrolComponent>())
             {
-                // V[̍폜L[֓iFinishFrameCleanup ƍ킹j
-                m_scene->m_DeleteObjects.push_back(sp); //  APIBȂ m_scene->m_DeleteObjects.push_back(sp) s
+                patrol->SetPath(GetPatrolPath(set));
             }
-            m_spawnedTurrets.pop_back();
-        }
-    }
-}
-
-void EnemySpawner::EnsureCircleCount()
-{
-    //Ăweak_ptrQƂɕϊ
-    std::vector<std::shared_ptr<GameObject>> live;
-    for (auto& w : m_spawnedCircles)
-    {
-        //ptrĂ邩ǂ
-        if (auto sp = w.lock())
-        {
-            live.push_back(sp);
         }
-    }
-    
-    //ɂ
-    m_spawnedCircles.clear();
-
-    for (auto& s : live)
-    {
-        //NĂzɖ߂
-        m_spawnedCircles.push_back(s);
-    }
-
-
-    int current = (int)live.size();
-    int want = circleCfg.spawnCount;
+        break;
 
-    if (current < want)
+    case EnemyArchetype::Circle:
     {
-        int baseIndex = current;
-
-        //~ɔzu
-        for (int i = 0; i < want - current; ++i)
+        DirectX::SimpleMath::Vector3 center = circleCfg.center;
+        float radius = circleCfg.radius;
+        if (!circlePatrolRadiusSets.empty())
         {
-            int slot = baseIndex + i;
-
-            int idx = current + i;
-
-            CircleConfig localCfg = circleCfg;           //Rs[ĕҏW
-
-            //aIԁiZbg 2 Ȃ 0/1/0/1...j
-            const auto& selectedRadius = circlePatrolRadiusSets[slot % patrolWaypointSets.size()];
-            localCfg.radius = selectedRadius;
-
-            //SWIԁiZbg 2 Ȃ 0/1/0/1...j
-            const auto& selectedCenter = circlePatrolCenterSets[slot % patrolWaypointSets.size()];
-            localCfg.center = selectedCenter;
-
-            float ang = (2.0f * DirectX::XM_PI * idx) / want;
-            float x = circleCfg.center.x + cosf(ang) * circleCfg.radius;
-            float z = circleCfg.center.z + sinf(ang) * circleCfg.radius;
-
-            auto e = SpawnCircleEnemy(localCfg, { x, 0.0f, z });
-            m_spawnedCircles.push_back(e);
+            radius = circlePatrolRadiusSets[WrapIndex(pathId, circlePatrolRadiusSets.size())];
         }
-    }
-    else if (current > want)
-    {
-        int removeCount = current - want;
-        for (int i = 0; i < removeCount; ++i)
+        if (!circlePatrolCenterSets.empty())
         {
-            if (auto sp = m_spawnedCircles.back().lock()) 
-            {
-                m_scene->m_DeleteObjects.push_back(sp);
-            }
-            m_spawnedCircles.pop_back();
+            center = circlePatrolCenterSets[WrapIndex(pathId, circlePatrolCenterSets.size())];
         }
-    }
-}
 
-void EnemySpawner::EnsureFleeCount()
-{
-    // Ă weak_ptr 𐮗
-    std::vector<std::shared_ptr<GameObject>> live;
-    for (auto& w : m_spawnedFlees)
-    {
-        if (auto sp = w.lock())
+        if (auto circ = enemy->GetComponent<CirculPatrolComponent>())
         {
-            live.push_back(sp);
+            circ->SetCenter(center);
+            circ->SetRadius(radius);
         }
-    }
 
-    m_spawnedFlees.clear();
-    for (auto& s : live)
-    {
-        m_spawnedFlees.push_back(s);
+        //~ +X n߂
+        enemy->SetPosition({ center.x + radius, 0.0f, center.z });
+        break;
     }
 
-    int current = static_cast<int>(live.size());
-    int want = fleeCfg.spawnCount;
-
-    if (current < want)
-    {
-        int baseIndex = current;
+    case EnemyArchetype::Turret:
+        enemy->SetPosition(TurretPosSets.empty()
+            ? turretCfg.pos : TurretPosSets[WrapIndex(pathId, TurretPosSets.size())]);
 
-        for (int i = 0; i < want - current; ++i)
+        if (auto turt = enemy->GetComponent<FixedTurretComponent>())
         {
-            int idx = baseIndex + i;
-
-            // Ƃ肠KȃX|[ʒui_ɉ~`zuj
-            DirectX::SimpleMath::Vector3 center = { 0.0f, 3.0f, 0.0f };
-            float radius = 50.0f;
-            float ang = (2.0f * DirectX::XM_PI * idx) / max(want, 1);
-            float x = center.x + cosf(ang) * radius;
-            float z = center.z + sinf(ang) * radius;
-            DirectX::SimpleMath::Vector3 spawnPos(x, center.y, z);
-
-            auto e = SpawnFleeEnemy(fleeCfg, {0.0f,20.0f,0.0f});
-            m_spawnedFlees.push_back(e);
+            turt->SetTarget(turretCfg.target.lock().get());
         }
-    }
-    else if (current > want)
-    {
-        int removeCount = current - want;
-        for (int i = 0; i < removeCount; ++i)
+        break;
+
+    case EnemyArchetype::Flee:
+        enemy->SetPosition({ 0.0f, 20.0f, 0.0f });
+
+        if (auto ai = enemy->GetComponent<EnemyAIComponent>())
         {
-            if (auto sp = m_spawnedFlees.back().lock())
+            if (auto p = fleeCfg.player.lock())
             {
-                m_scene->m_DeleteObjects.push_back(sp);
+                ai->SetTarget(p.get());
+            }
+
+            //PlayArea n
+            if (m_scene && m_scene->GetPlayArea())
+            {
+                ai->SetPlayArea(m_scene->GetPlayArea());
             }
-            m_spawnedFlees.pop_back();
         }
+        break;
+
+    default:
+        break;
     }
+
+    //
+    enemy->Initialize();
+
+    return enemy;
 }
 
+void EnemySpawner::Activate(EnemyArchetype type, const std::shared_ptr<GameObject>& enemy)
+{
+    if (!enemy) { return; }
 
-void EnemySpawner::ApplyPatrolSettingsToAll()
+    m_scene->AddObject(enemy);
+    GetSpawnedList(type).push_back(enemy);
+}
+
+bool EnemySpawner::ParseArchetype(const std::string& name, EnemyArchetype& out)
 {
-    for (auto& w : m_spawnedPatrols)
+    for (int i = 0; i < static_cast<int>(EnemyArchetype::Count); ++i)
     {
-        //ptrĂ
-        if (auto sp = w.lock())
+        if (name == kArchetypeNames[i])
         {
-            //ptrComponentĂ
-            auto patrol = sp->GetComponent<PatrolComponent>();
-            if (patrol)
-            {
-                //猻iKł̐ݒ
-                patrol->SetWaypoints(patrolCfg.waypoints);
-                patrol->SetSpeed(patrolCfg.speed);
-                patrol->SetArrivalThreshold(patrolCfg.arrival);
-                patrol->SetPingPong(patrolCfg.pingPong);
-            }
+            out = static_cast<EnemyArchetype>(i);
+            return true;
         }
     }
+    return false;
+}
+
+const char* EnemySpawner::GetArchetypeName(EnemyArchetype type)
+{
+    int i = static_cast<int>(type);
+    return (i >= 0 && i < static_cast<int>(EnemyArchetype::Count)) ? kArchetypeNames[i] : "unknown";
 }
 
 void EnemySpawner::ApplyCircleSettingsToAll()
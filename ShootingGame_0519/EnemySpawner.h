@@ -1,19 +1,23 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <string>
+#include <istream>
 #include <SimpleMath.h>
 #include "GameObject.h"
+#include "SplinePath.h"
+#include "EnemyPrefab.h"
 
 class EnemyAIComponent;
 
-//w肵ʒu񂷂PatrolEnemy̏ݒ
-struct PatrolConfig
+//EF[ut@CȂǂw肷G̎
+enum class EnemyArchetype
 {
-	int spawnCount = 4;
-	float speed    = 65.0f;
-	float arrival = 0.5f;
-	bool pingPong = true;
-	std::vector<DirectX::SimpleMath::Vector3> waypoints;
+	Patrol,
+	Circle,
+	Turret,
+	Flee,
+	Count
 };
 
 //w肵aŉ~`ɏ񂷂CirclePatrolEnemy̏ݒ
@@ -57,19 +61,11 @@ public:
 	EnemySpawner(GameScene* scene);
 
 	//ݒIuWFNg
-	PatrolConfig patrolCfg;
 	CircleConfig circleCfg;
 	TurretConfig turretCfg;
 	FleeConfig   fleeCfg;
 
-	//ݐݒɍ킹Đ͔js
-	void EnsurePatrolCount();
-	void EnsureCircleCount();
-	void EnsureTurretCount();
-	void EnsureFleeCount();
-
 	//̓Gɐݒf
-	void ApplyPatrolSettingsToAll();
 	void ApplyCircleSettingsToAll();
 	void ApplyTurretSettingsToAll();
 	void ApplyFleeSettingsToAll();
@@ -77,9 +73,34 @@ public:
 	// S
 	void DestroyAll();
 
+	//----------vnu-------------
+
+	//vnut@Cǂݍ݁AĂނւigݍ݂̃vnu̓RXgN^œǂށj
+	bool LoadPrefabs(const std::string& path);
+	bool LoadPrefabs(std::istream& in, const std::string& sourceName);
+
+	const EnemyPrefab* GetPrefab(EnemyArchetype type) const;
+
+	//----------EF[upiWaveScheduler gj-------------
+
+	//Ăς݌oHȂǂ̋Lf[^ɍĂ
+	void WarmUp(EnemyArchetype type, int pathId);
+
+	//vnu 1 ̍AʒuEoHȂǂ̌ʐݒiV[ɂ͓Ȃj
+	//pathId : Patrol ͌oHZbgACircle ͔a/SZbgATurret ͈ʒuZbg̔ԍi͈͊O̓[vj
+	std::shared_ptr<GameObject> Build(EnemyArchetype type, int pathId);
+
+	//Build GV[ɓo^
+	void Activate(EnemyArchetype type, const std::shared_ptr<GameObject>& enemy);
+
+	//"patrol" Ȃǂ̖O <-> 
+	static bool ParseArchetype(const std::string& name, EnemyArchetype& out);
+	static const char* GetArchetypeName(EnemyArchetype type);
+
 	void SetWaypoints(std::vector<DirectX::SimpleMath::Vector3> waypoint)
 	{
 		patrolWaypointSets.push_back(waypoint);
+		m_patrolPaths.push_back(nullptr);
 	}
 
 	void SetRadius(float radius)
@@ -102,6 +123,12 @@ private:
 
 	//PatrolEnemÿړԒn_̔z
 	std::vector<std::vector<DirectX::SimpleMath::Vector3>> patrolWaypointSets;
+
+	//patrolWaypointSets Ƃ̏Ăς݌oHiZbggGŋLj
+	std::vector<std::shared_ptr<const SplinePath>> m_patrolPaths;
+
+	//Zbgԍ index ̌oHԂi񂾂Ăj
+	std::shared_ptr<const SplinePath> GetPatrolPath(size_t index);
 	
 	//CirclePatrolEnemy̔a̔z
 	std::vector<float> circlePatrolRadiusSets;
@@ -118,10 +145,10 @@ private:
 	std::vector<std::weak_ptr<GameObject>> m_spawnedTurrets;
 	std::vector<std::weak_ptr<GameObject>> m_spawnedFlees;
 
-	//EnemyFactory֐
-	std::shared_ptr<GameObject> SpawnPatrolEnemy(const PatrolConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
-	std::shared_ptr<GameObject> SpawnCircleEnemy(const CircleConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
-	std::shared_ptr<GameObject> SpawnTurretEnemy(const TurretConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
-	std::shared_ptr<GameObject> SpawnFleeEnemy  (const FleeConfig& cfg,   const DirectX::SimpleMath::Vector3& pos);
+	//ނɑΉ鐶ς݃Xg
+	std::vector<std::weak_ptr<GameObject>>& GetSpawnedList(EnemyArchetype type);
+
+	//ނƂ̃vnuiǂݍ݌͕ύXȂBG͂ Clone R|[lgj
+	std::shared_ptr<const EnemyPrefab> m_prefabs[static_cast<int>(EnemyArchetype::Count)];
 
 };
\ No newline at end of file
@@ -13,7 +13,7 @@ void FixedTurretComponent::Update(float dt)
     if (!GetOwner()) { return; }
 
     //^[Qbg݂ȂꍇPlayer擾
-    if (auto sp = m_target.lock())
+    if (GameObject* sp = GameObject::Resolve(m_target))
     {
         Vector3 myPos = GetOwner()->GetPosition();
 
@@ -47,10 +47,11 @@ void FixedTurretComponent::Shoot(const Vector3& dir)
     auto owner = GetOwner();
     if (!owner) { return; }
 
-    auto bullet = std::make_shared<Bullet>();
+    //v[oiInitialize ς݁j
+    auto bullet = Bullet::Spawn();
     bullet->SetPosition(owner->GetPosition() + Vector3(0, 3.0f, 0));
 
-    auto bc = bullet->AddComponent<BulletComponent>();
+    auto bc = bullet->GetComponent<BulletComponent>();
 
     // xNg𐳋Kēn
     Vector3 nd = dir;
@@ -66,8 +67,6 @@ void FixedTurretComponent::Shoot(const Vector3& dir)
     bc->SetVelocity(nd);
     bc->SetSpeed(m_bulletSpeed);
     bc->SetBulletType(BulletComponent::ENEMY);
-    
-    bullet->Initialize();
 
     if (auto scene = owner->GetScene())
     {
@@ -18,12 +18,15 @@ public:
 
     void Update(float dt) override;
 
-    void SetTarget(std::weak_ptr<GameObject> t) { m_target = t; }
+    void SetTarget(GameObject* t) { m_target = t ? t->GetHandle() : GameObjectHandle(); }
     void SetCooldown(float cd) { m_cooldown = cd; }
     void SetBulletSpeed(float sp) { m_bulletSpeed = sp; }
 
+    //ivnupj
+    std::shared_ptr<Component> Clone() const override { return std::make_shared<FixedTurretComponent>(*this); }
+
 private:
-    std::weak_ptr<GameObject> m_target;
+    GameObjectHandle m_target;
     float m_cooldown = 1.0f;   // ˊԊu
     float m_timer = 0.0f;
     float m_bulletSpeed = 50.0f;
@@ -10,7 +10,7 @@ void FloorComponent::Initialize()
     // eNX`w肳ĂȂ烍[h
     if (m_mode == GridMode::Textured &&!m_texture.empty())
     {
-        ID3D11ShaderResourceView* srv = TextureManager::Load(m_texture);
+        TextureHandle srv = TextureManager::Load(m_texture);
         if (srv) { m_gridSRV = srv; }
     }
 
@@ -66,7 +66,7 @@ void FloorComponent::Draw(float alpha)
     //eNX`oCh
     if (m_gridSRV)
     {
-        Renderer::SetTexture(m_gridSRV);
+        Renderer::SetTexture(m_gridSRV.get());
     }
     else
     {
@@ -60,7 +60,7 @@ private:
     std::string m_texture;
     float m_tileU = 1.0f;
     float m_tileV = 1.0f;
-    ID3D11ShaderResourceView* m_gridSRV = nullptr;
+    TextureHandle m_gridSRV;
 
     Primitive m_prim;           //NX
     std::shared_ptr<AABBColliderComponent> m_collider; // LGameObjectvectorɂ邪֋Xێ
@@ -0,0 +1,138 @@
+﻿#include "FrameArena.h"
+#include "Logger.h"
+#include <cstdlib>
+#include <cstring>
+
+unsigned char* FrameArena::m_base = nullptr;
+size_t FrameArena::m_capacity = 0;
+size_t FrameArena::m_offset = 0;
+unsigned char* FrameArena::m_lastAllocation = nullptr;
+size_t FrameArena::m_highWater = 0;
+uint32_t FrameArena::m_frameIndex = 0;
+
+std::vector<FrameArena::OverflowBlock> FrameArena::m_overflow;
+size_t FrameArena::m_overflowBytes = 0;
+
+#if FRAME_ARENA_DEBUG
+int FrameArena::m_liveAllocations = 0;
+#endif
+
+void FrameArena::Init(size_t capacity)
+{
+    if (m_base) { return; }
+
+    m_base = static_cast<unsigned char*>(::operator new(capacity));
+    m_capacity = capacity;
+    m_offset = 0;
+    m_lastAllocation = nullptr;
+    m_highWater = 0;
+    m_frameIndex = 0;
+}
+
+void FrameArena::Uninit()
+{
+    Reset();
+
+    ::operator delete(m_base);
+    m_base = nullptr;
+    m_capacity = 0;
+    m_overflow.shrink_to_fit();
+}
+
+void FrameArena::Reset()
+{
+    size_t used = m_offset + m_overflowBytes;
+
+    //ハイウォーターマークの更新
+    if (used > m_highWater)
+    {
+        m_highWater = used;
+#if FRAME_ARENA_DEBUG
+        LOG_INFO("FrameArena high-water mark: %zu / %zu bytes", m_highWater, m_capacity);
+#endif
+    }
+
+    if (m_overflowBytes > 0)
+    {
+        LOG_WARN("FrameArena overflow: %zu bytes from heap (capacity %zu)", m_overflowBytes, m_capacity);
+    }
+
+#if FRAME_ARENA_DEBUG
+    //フレームをまたいで生きているコンテナがある
+    if (m_liveAllocations != 0)
+    {
+        LOG_WARN("FrameArena: %d allocation(s) escaped frame %u", m_liveAllocations, m_frameIndex);
+    }
+    m_liveAllocations = 0;
+
+    //持ち出されたポインタを使うと気付けるように塗りつぶす
+    if (m_base) { std::memset(m_base, 0xCD, m_offset); }
+#endif
+
+    for (const auto& block : m_overflow)
+    {
+        ::operator delete(block.ptr, std::align_val_t(block.alignment));
+    }
+    m_overflow.clear();
+    m_overflowBytes = 0;
+
+    m_offset = 0;
+    m_lastAllocation = nullptr;
+    ++m_frameIndex;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+    if (!m_base) { Init(); }
+
+#if FRAME_ARENA_DEBUG
+    ++m_liveAllocations;
+#endif
+
+    //アライメントを合わせて先頭から切り出す
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_base);
+    uintptr_t aligned = (base + m_offset + (alignment - 1)) & ~(static_cast<uintptr_t>(alignment) - 1);
+    size_t newOffset = static_cast<size_t>(aligned - base) + size;
+
+    if (newOffset <= m_capacity)
+    {
+        m_offset = newOffset;
+        m_lastAllocation = reinterpret_cast<unsigned char*>(aligned);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    //容量不足：今フレームだけヒープから借りる
+    size_t heapAlign = (alignment > alignof(std::max_align_t)) ? alignment : alignof(std::max_align_t);
+    void* p = ::operator new(size, std::align_val_t(heapAlign));
+    m_overflow.push_back({ p, heapAlign });
+    m_overflowBytes += size;
+    return p;
+}
+
+void FrameArena::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr) { return; }
+
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+
+    //今フレームの使用範囲より後ろを指している = 前のフレームで確保した物（巻き戻すと今フレームの確保を壊す）
+    if (Owns(ptr) && p >= m_base + m_offset)
+    {
+#if FRAME_ARENA_DEBUG
+        LOG_WARN("FrameArena: pointer from a previous frame was freed (frame %u)", m_frameIndex);
+#endif
+        return;
+    }
+
+#if FRAME_ARENA_DEBUG
+    --m_liveAllocations;
+#endif
+
+    //このフレームで最後に確保したブロックならその分だけ巻き戻す（それ以外は Reset まで何もしない）
+    //終端が今の使用位置と一致するだけでは、前のフレームの物を今フレームの確保と取り違えることがある
+    if (p == m_lastAllocation && p + size == m_base + m_offset)
+    {
+        m_offset = static_cast<size_t>(p - m_base);
+        m_lastAllocation = nullptr;
+    }
+}
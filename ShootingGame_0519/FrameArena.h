@@ -0,0 +1,101 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <new>
+
+//------------------------------------------------------------
+// 1フレームだけ使う一時メモリ用のリニア（バンプ）アロケータ
+// ・確保は先頭から詰めていくだけ、解放はフレーム終了時の Reset() でまとめて行う
+// ・FrameVector<T> などの「フレーム内で作って捨てる」コンテナ専用
+// ・メインスレッド専用（ロックしない）
+//
+// FRAME_ARENA_DEBUG が有効な場合
+// ・Reset() 時点で解放されていない確保が残っていたら警告する（フレーム外へのポインタ持ち出し検出）
+// ・Reset() で使った領域を 0xCD で埋め、持ち出したポインタからの読み込みが壊れた値になるようにする
+// ・使用量の最大値（ハイウォーターマーク）が更新されたらログに出す
+//------------------------------------------------------------
+
+#ifndef FRAME_ARENA_DEBUG
+#if defined(DEBUG) || defined(_DEBUG)
+#define FRAME_ARENA_DEBUG 1
+#else
+#define FRAME_ARENA_DEBUG 0
+#endif
+#endif
+
+class FrameArena
+{
+public:
+    //既定の容量
+    static constexpr size_t kDefaultCapacity = 4 * 1024 * 1024;
+
+    static void Init(size_t capacity = kDefaultCapacity);
+    static void Uninit();
+
+    //フレーム終了時に呼ぶ。このフレームで確保したメモリを全部無効にする
+    static void Reset();
+
+    static void* Allocate(size_t size, size_t alignment);
+    static void Deallocate(void* ptr, size_t size);
+
+    static size_t GetUsed() { return m_offset; }
+    static size_t GetCapacity() { return m_capacity; }
+    static size_t GetHighWater() { return m_highWater; }
+    static uint32_t GetFrameIndex() { return m_frameIndex; }
+
+private:
+    static bool Owns(const void* ptr)
+    {
+        auto p = reinterpret_cast<uintptr_t>(ptr);
+        auto base = reinterpret_cast<uintptr_t>(m_base);
+        return m_base && p >= base && p < base + m_capacity;
+    }
+
+    static unsigned char* m_base;
+    static size_t m_capacity;
+    static size_t m_offset;
+    static unsigned char* m_lastAllocation;    //このフレームで最後に切り出した先頭（巻き戻すと nullptr）
+    static size_t m_highWater;
+    static uint32_t m_frameIndex;
+
+    //容量を超えた分はヒープから取り、Reset() でまとめて返す
+    struct OverflowBlock { void* ptr; size_t alignment; };
+    static std::vector<OverflowBlock> m_overflow;
+    static size_t m_overflowBytes;
+
+#if FRAME_ARENA_DEBUG
+    static int m_liveAllocations;
+#endif
+};
+
+//STL コンテナ用のアロケータ（状態を持たないので、どのインスタンス同士でも互換）
+template<typename T>
+class FrameAllocator
+{
+public:
+    using value_type = T;
+
+    FrameAllocator() noexcept = default;
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(FrameArena::Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        FrameArena::Deallocate(ptr, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+//フレーム内だけで使う vector（関数のローカル変数として使い、メンバには持たないこと）
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -7,12 +7,45 @@
 #include "TransitionManager.h"
 #include "DebugUI.h"
 #include "EffectManager.h"
+#include "MemoryTracker.h"
+#include "TextureManager.h"
+#include "ModelComponent.h"
+#include "AssetArchive.h"
+#include "AsyncFileSystem.h"
+#include "Logger.h"
 
 void Game::GameInit()
 {
     //J[\\Œ
     //Application::HideCursorAndClip(); 
 
+    //TuVXeƂ̖̃ڈi GameUpdate Ōx邾ŁAmۂ͎~߂Ȃj
+    constexpr int64_t MB = 1024 * 1024;
+    MemoryTracker::SetBudget(MemoryCategory::Texture, 0, 256 * MB);
+    MemoryTracker::SetBudget(MemoryCategory::Model, 16 * MB, 128 * MB);
+    MemoryTracker::SetBudget(MemoryCategory::Sound, 64 * MB, 0);
+    MemoryTracker::SetBudget(MemoryCategory::Effect, 32 * MB, 16 * MB);
+    MemoryTracker::SetBudget(MemoryCategory::Scene, 64 * MB, 0);
+
+    //gĂȂeNX`EfcĂi̓V[؂ւŌÂɎ̂Ăj
+    TextureManager::SetBudget(192 * MB);
+    ModelComponent::SetModelCacheBudget(96 * MB);
+
+    //Asset/ ܂Ƃ߂A[JCuJi΍܂Œʂ Asset/ ̃t@Cʂɓǂށj
+    if (AssetArchive::Mount("Asset.pak"))
+    {
+        LOG_INFO("AssetArchive: Asset.pak mounted (%zu entries, %llu MB)", AssetArchive::GetEntryCount(),
+            static_cast<unsigned long long>(AssetArchive::GetMappedBytes() / MB));
+    }
+    else
+    {
+        LOG_INFO("AssetArchive: Asset.pak not found, loading loose files");
+    }
+
+    //AZbg̔񓯊ǂݍ݁ĩR[obN GameUpdate  Poll ŌĂԁj
+    AsyncFileSystem::Init();
+    LOG_INFO("AsyncFileSystem: %s", AsyncFileSystem::GetBackendName());
+
     //DirectX̃_[
     Renderer::Init();
     
@@ -33,13 +66,31 @@ void Game::GameUninit()
     // fobOUȈI
     DebugUI::DisposeUI();
 
+    //ǂݍݒ̂̂҂Ď~߂i܂͂ĂȂ̓R[obNȂj
+    AsyncFileSystem::Uninit();
+
     SceneManager::Uninit(); //V[}l[W[̏I
 
+    EffectManager::Uninit(); //GtFNg̏I
+
+    ModelComponent::UninitModelCache();
+    TextureManager::Uninit();
+
     Sound::Uninit();
+
+    //}bvwĂr[͂܂łɑSĂ
+    LOG_INFO("AssetArchive: loads mapped=%llu decompressed=%llu loose=%llu",
+        static_cast<unsigned long long>(AssetArchive::GetMappedLoads()),
+        static_cast<unsigned long long>(AssetArchive::GetDecompressedLoads()),
+        static_cast<unsigned long long>(AssetArchive::GetLooseLoads()));
+    AssetArchive::Unmount();
 }
 
 void Game::GameUpdate(float deltaTime)
 {
+    //ǂݏIAZbgŎ󂯎ieNX`̍쐬Ȃǂ͂̃Xbhōsj
+    AsyncFileSystem::Poll();
+
     Sound::Update(deltaTime);
 
     SceneManager::Update(deltaTime); //V[}l[W[̏I 
@@ -48,6 +99,14 @@ void Game::GameUpdate(float deltaTime)
 
     TransitionManager::Update(deltaTime);
 
+    MemoryBudgetAlert alerts[kMemoryCategoryCount * 2];
+    int alertCount = MemoryTracker::CheckBudgets(alerts);
+    for (int i = 0; i < alertCount; ++i)
+    {
+        LOG_WARN("Memory budget exceeded: %s %s %lld KB / %lld KB", GetMemoryCategoryName(alerts[i].category),
+            alerts[i].gpu ? "GPU" : "CPU", static_cast<long long>(alerts[i].bytes / 1024),
+            static_cast<long long>(alerts[i].budget / 1024));
+    }
 }
 
 void Game::GameDraw(float deltaTime)
@@ -1,4 +1,50 @@
 #include "GameObject.h"
+#include <algorithm>
+
+uint64_t GameObject::m_transformCacheHits = 0;
+uint64_t GameObject::m_transformCacheMisses = 0;
+
+HandleTable<GameObject>& GameObject::Handles()
+{
+    //ÓIIuWFNgiV[v[j̔jɏȂ悤AĉȂ
+    static HandleTable<GameObject>* s_handles = new HandleTable<GameObject>();
+    return *s_handles;
+}
+
+GameObject::GameObject()
+{
+    m_handle = Handles().Add(this);
+}
+
+GameObject::~GameObject()
+{
+    DetachHierarchy();
+    Handles().Remove(m_handle);
+}
+
+GameObject* GameObject::Resolve(GameObjectHandle handle)
+{
+    return Handles().Get(handle);
+}
+
+void GameObject::Revive()
+{
+    Handles().Remove(m_handle);
+    m_handle = Handles().Add(this);
+    m_uninitialized = false;
+
+    m_transform = SRT();
+    m_prevTransform = SRT();
+    m_prevPosition = Vector3::Zero;
+    MarkTransformDirty(true);
+}
+
+void GameObject::Retire()
+{
+    //̃IuWFNgwĂnh𖳌ɂ
+    Handles().Remove(m_handle);
+    m_handle = GameObjectHandle();
+}
 
 void GameObject::Initialize()
 {
@@ -33,6 +79,11 @@ void GameObject::Uninit()
     if (m_uninitialized) { return; }// dh~
     m_uninitialized = true;
 
+    //ȍ~̃IuWFNgwnh͉łȂ
+    Retire();
+
+    DetachHierarchy();
+
     for (auto& comp : m_components)
     {
         if (comp)
@@ -52,45 +103,124 @@ void GameObject::AddComponent(std::shared_ptr<Component> comp)
     m_components.push_back(comp);
 }
 
-DirectX::SimpleMath::Matrix GameObject::GetWorldMatrix() const
+void GameObject::MarkTransformDirty(bool rotation)
 {
-    using namespace DirectX::SimpleMath;
-    // g̃[Js
-    Matrix world = m_transform.GetMatrix();
+    m_localDirty = true;
+    if (rotation)
+    {
+        m_rotationDirty = true;
+    }
+    MarkWorldDirty();
+}
+
+void GameObject::MarkWorldDirty()
+{
+    //ɖȂqɂȂĂiq̍sƂ͕Ke蒼߁j
+    if (m_worldDirty) { return; }
+
+    m_worldDirty = true;
+    for (GameObject* child : m_children)
+    {
+        child->MarkWorldDirty();
+    }
+}
+
+void GameObject::SetParent(GameObject* parent)
+{
+    if (parent == m_parent || parent == this) { return; }
+
+    if (m_parent)
+    {
+        auto& siblings = m_parent->m_children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
+
+    m_parent = parent;
+    if (m_parent)
+    {
+        m_parent->m_children.push_back(this);
+    }
+
+    //eς̂Ń[hs蒼iɖłq܂Ŋmɓ`j
+    m_worldDirty = false;
+    MarkWorldDirty();
+}
+
+void GameObject::DetachHierarchy()
+{
+    SetParent(nullptr);
+
+    for (GameObject* child : m_children)
+    {
+        child->m_parent = nullptr;
+        child->m_worldDirty = false;
+        child->MarkWorldDirty();
+    }
+    m_children.clear();
+}
+
+const DirectX::SimpleMath::Matrix& GameObject::GetLocalMatrix() const
+{
+    if (m_localDirty)
+    {
+        m_localMatrix = m_transform.GetMatrix();
+        m_localDirty = false;
+        ++m_transformCacheMisses;
+    }
+    else
+    {
+        ++m_transformCacheHits;
+    }
+    return m_localMatrix;
+}
+
+const DirectX::SimpleMath::Matrix& GameObject::GetRotationMatrix() const
+{
+    if (m_rotationDirty)
+    {
+        m_rotationMatrix = DirectX::SimpleMath::Matrix::CreateFromYawPitchRoll(
+            m_transform.rot.y, m_transform.rot.x, m_transform.rot.z);
+        m_rotationDirty = false;
+        ++m_transformCacheMisses;
+    }
+    else
+    {
+        ++m_transformCacheHits;
+    }
+    return m_rotationMatrix;
+}
+
+const DirectX::SimpleMath::Matrix& GameObject::GetWorldMatrix() const
+{
+    if (!m_worldDirty)
+    {
+        ++m_transformCacheHits;
+        return m_worldMatrix;
+    }
 
     // eȂẽ[hs|ieq ̏j
-    const GameObject* p = m_parent;
-    while (p)
+    if (m_parent)
     {
-        // e̍s擾č|ies * qsj
-        world = p->m_transform.GetMatrix() * world;
-        p = p->m_parent;
+        m_worldMatrix = m_parent->GetWorldMatrix() * GetLocalMatrix();
     }
-    return world;
+    else
+    {
+        m_worldMatrix = GetLocalMatrix();
+    }
+    m_worldDirty = false;
+    ++m_transformCacheMisses;
+    return m_worldMatrix;
 }
 
-// [hOiZ/̒`̓GWƂɈقȂj
-// SimpleMath::Matrix::Forward() gƍs Forward xNg܂B
-//  Forward() gȂȂ牺 Transform gtH[obNpB
+// xNg̓LbV[hs̍so
+// i] Vector3::Transform(, world) ƓA_Ƃĕϊʁsړ܂ށj
 DirectX::SimpleMath::Vector3 GameObject::GetForward() const
 {
     using namespace DirectX::SimpleMath;
-    Matrix world = GetWorldMatrix();
-
-#if defined(__has_member) // (just a harmless guard, not necessary)
-#endif
-
-    // try using Matrix::Forward() if available
-    // (FollowCameraComponent łl .Invert().Forward() gĂߌ݊)
-    Vector3 f;
-#ifdef DIRECTX_SIMPLEMATH_HAS_FORWARDFUNC
-    f = world.Forward();
-#else
-    // tH[obNF[J̐ (0,0,1) ܂ (0,0,-1) ̂ǂ炪GWŎgĂ邩ɂ
-    // ł DirectX ̉Enz肵 -Z Ȍꍇ (0,0,-1) gƂłB
-    // FollowCameraComponent ŎgĂɍ킹邽߉ -Z ɂĂ܂B
-    f = Vector3::Transform(Vector3(0.0f, 0.0f, -1.0f), world);
-#endif
+    const Matrix& world = GetWorldMatrix();
+
+    // [J (0,0,-1) ϊ
+    Vector3 f(world._41 - world._31, world._42 - world._32, world._43 - world._33);
 
     if (f.LengthSquared() > 1e-6f) f.Normalize();
     else f = Vector3::Forward; // SiSimpleMath::Vector3::Forward  (0,0,-1) ˑj
@@ -100,13 +230,11 @@ DirectX::SimpleMath::Vector3 GameObject::GetForward() const
 DirectX::SimpleMath::Vector3 GameObject::GetRight() const
 {
     using namespace DirectX::SimpleMath;
-    Matrix world = GetWorldMatrix();
-    Vector3 r;
-#ifdef DIRECTX_SIMPLEMATH_HAS_RIGHTFUNC
-    r = world.Right();
-#else
-    r = Vector3::Transform(Vector3(1.0f, 0.0f, 0.0f), world);
-#endif
+    const Matrix& world = GetWorldMatrix();
+
+    // [J (1,0,0) ϊ
+    Vector3 r(world._41 + world._11, world._42 + world._12, world._43 + world._13);
+
     if (r.LengthSquared() > 1e-6f) r.Normalize();
     else r = Vector3::Right;
     return r;
@@ -115,13 +243,11 @@ DirectX::SimpleMath::Vector3 GameObject::GetRight() const
 DirectX::SimpleMath::Vector3 GameObject::GetUp() const
 {
     using namespace DirectX::SimpleMath;
-    Matrix world = GetWorldMatrix();
-    Vector3 u;
-#ifdef DIRECTX_SIMPLEMATH_HAS_UPFUNC
-    u = world.Up();
-#else
-    u = Vector3::Transform(Vector3(0.0f, 1.0f, 0.0f), world);
-#endif
+    const Matrix& world = GetWorldMatrix();
+
+    // [J (0,1,0) ϊ
+    Vector3 u(world._41 + world._21, world._42 + world._22, world._43 + world._23);
+
     if (u.LengthSquared() > 1e-6f) u.Normalize();
     else u = Vector3::Up;
     return u;
@@ -6,14 +6,31 @@
 #include "Model.h"       
 #include "Component.h"
 #include "IScene.h"
+#include "Handle.h"
 
 class Component;
+class GameObject;
+
+//GameObject wtnhiUninit ς݁Ejς݂̃IuWFNg͉łȂj
+using GameObjectHandle = Handle<GameObject>;
+
+//IuWFNg̎ށirbg}XNōi荞ނ߁Adynamic_cast Ɏނ𔻒łj
+enum ObjectTag : uint32_t
+{
+    TAG_NONE     = 0,
+    TAG_PLAYER   = 1u << 0,
+    TAG_ENEMY    = 1u << 1,
+    TAG_BUILDING = 1u << 2,
+    TAG_BULLET   = 1u << 3,
+    TAG_OTHER    = 1u << 4,
+    TAG_ALL      = 0xFFFFFFFFu,
+};
 
 class GameObject
 {
 public:
-    GameObject() = default;
-    virtual ~GameObject() = default;
+    GameObject();
+    virtual ~GameObject();
 
     virtual void Initialize();
     virtual void Update(float dt);   
@@ -31,10 +48,10 @@ public:
 
     void AddComponent(std::shared_ptr<Component> comp);
 
-    //ʒuE]E傫̃Zb^[
-    void SetPosition(const Vector3& pos) { m_transform.pos = pos;}
-    void SetRotation(const Vector3& rot) { m_transform.rot = rot; }
-    void SetScale(const Vector3& scl) { m_transform.scale = scl; }
+    //ʒuE]E傫̃Zb^[is̃LbV𖳌ɂj
+    void SetPosition(const Vector3& pos) { m_transform.pos = pos; MarkTransformDirty(false); }
+    void SetRotation(const Vector3& rot) { m_transform.rot = rot; MarkTransformDirty(true); }
+    void SetScale(const Vector3& scl) { m_transform.scale = scl; MarkTransformDirty(false); }
 
     //ʒuE]E傫̃Zb^[
     const Vector3& GetPosition() { return m_transform.pos; }
@@ -49,15 +66,45 @@ public:
     //܂Ƃ߂ăgXtH[̃Qb^[Zb^[
     const SRT& GetTransform() const { return m_transform; }
 
-    //
-    DirectX::SimpleMath::Matrix  GetWorldMatrix() const;  //[hϊsԂ
+    //s̓LbVĂASet* ŕςƂ蒼
+    const DirectX::SimpleMath::Matrix& GetLocalMatrix() const;     //g SRT sie܂܂Ȃj
+    const DirectX::SimpleMath::Matrix& GetRotationMatrix() const;  //g̉]̍s
+    const DirectX::SimpleMath::Matrix& GetWorldMatrix() const;     //[hϊsԂ
     DirectX::SimpleMath::Vector3 GetForward() const;      //[hO(Kς)
     DirectX::SimpleMath::Vector3 GetRight() const;        //[hE(Kς)
     DirectX::SimpleMath::Vector3 GetUp() const;           //[h(Kς)
 
+    //eq֌WieƎq̃[hs蒼j
+    void SetParent(GameObject* parent);
+    GameObject* GetParent() const { return m_parent; }
+
+    //sLbV̓viLbV̂܂ܕԂ / 蒼񐔁j
+    static uint64_t GetTransformCacheHits() { return m_transformCacheHits; }
+    static uint64_t GetTransformCacheMisses() { return m_transformCacheMisses; }
+    static void ResetTransformCacheStats() { m_transformCacheHits = 0; m_transformCacheMisses = 0; }
+
     //Փ˒ʒm
     virtual void OnCollision(GameObject* other) {}
 
+    //V[ł̊ǗiGameScene  O(1) ŒǉE폜邽߂Ɏgj
+    struct SceneSlot
+    {
+        int  index = -1;             //V[̃IuWFNgz̈ʒui-1 = zɋȂj
+        bool pendingAdd = false;     //ǉ҂̔zɋ
+        bool pendingRemove = false;  //폜\ς
+    };
+    SceneSlot& GetSceneSlot() { return m_sceneSlot; }
+
+    //IuWFNg̎ށihNX̃RXgN^Őݒ肷j
+    void SetTag(uint32_t tag) { m_tag = tag; }
+    uint32_t GetTag() const { return m_tag; }
+
+    //̃IuWFNgwnhiUninit ͖j
+    GameObjectHandle GetHandle() const { return m_handle; }
+
+    //nh O(1) ŃIuWFNgiȂ nullptrj
+    static GameObject* Resolve(GameObjectHandle handle);
+
     template<typename T>
     std::shared_ptr<T> GetComponent() const
     {
@@ -72,13 +119,47 @@ public:
         return nullptr;
     }
 
+protected:
+    //v[ėpƂɌĂԁiVnh𔭍sAgXtH[Ԃɖ߂j
+    //R|[lg͂̂܂܎c
+    void Revive();
+
+    //R|[lg͎c܂܁Anhɂiv[֕ԂƂpj
+    void Retire();
+
 private:
+    static HandleTable<GameObject>& Handles();
+
+    //gXtH[ςƂɌĂԁirotation : ]ςj
+    void MarkTransformDirty(bool rotation);
+
+    //Ǝq̃[hs𖳌ɂ
+    void MarkWorldDirty();
+
+    //eq֌WׂĐ؂ijEUninit j
+    void DetachHierarchy();
+
     std::vector<std::shared_ptr<Component>> m_components;
     bool m_uninitialized = false;
+    GameObjectHandle m_handle;
+    uint32_t m_tag = TAG_OTHER;
+    SceneSlot m_sceneSlot;
     SRT m_transform;
     Vector3 m_localPosition; // ݂ʒu
     GameObject* m_parent = nullptr; // eIuWFNgieȂꍇ nullptrj]
+    std::vector<GameObject*> m_children; // qIuWFNgi[hs̖`邽߁j
     SRT m_prevTransform; //  ԗpɒǉ
     Vector3 m_prevPosition = Vector3::Zero;
     IScene* m_scene = nullptr;
+
+    //--------------sLbV------------------
+    mutable DirectX::SimpleMath::Matrix m_localMatrix;
+    mutable DirectX::SimpleMath::Matrix m_rotationMatrix;
+    mutable DirectX::SimpleMath::Matrix m_worldMatrix;
+    mutable bool m_localDirty = true;
+    mutable bool m_rotationDirty = true;
+    mutable bool m_worldDirty = true;
+
+    static uint64_t m_transformCacheHits;
+    static uint64_t m_transformCacheMisses;
 };
\ No newline at end of file
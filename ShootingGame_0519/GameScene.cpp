@@ -17,6 +17,9 @@
 #include "PushOutComponent.h"
 #include "SphereColliderComponent.h"
 #include "EffectManager.h"
+#include "HomingGuidance.h"
+#include "InstancedModelRenderer.h"
+#include "FrameArena.h"
 
 void GameScene::DebugCollisionMode()
 {
@@ -73,31 +76,65 @@ void GameScene::DebugSetAimDistance()
     ImGui::End();
 }
 
-static bool RaySphereIntersect(const DirectX::SimpleMath::Vector3& rayOrigin,
-    const DirectX::SimpleMath::Vector3& rayDir,
-    const DirectX::SimpleMath::Vector3& sphereCenter,
-    float sphereRadius,
-    float& outT)
+void GameScene::DebugCollisionStats()
 {
-    using namespace DirectX::SimpleMath;
-    Vector3 m = rayOrigin - sphereCenter;
-    float b = m.Dot(rayDir);
-    float c = m.LengthSquared() - sphereRadius * sphereRadius;
-
-    if (c > 0.0f && b > 0.0f) { return false; }
+    ImGui::Begin("CollisionStats");
 
-    float discr = b * b - c;
-    if (discr < 0.0f) { return false; }
+    ImGui::Text("Culled by layer : %u", CollisionManager::GetLayerCulledCount());
+    ImGui::Text("Culled static   : %u", CollisionManager::GetStaticCulledCount());
+    ImGui::Separator();
 
-    float t = -b - sqrtf(discr);
-    if (t < 0.0f)
+    //形状判定まで進んだペアだけ出す（tests / hits）
+    for (int a = 0; a < LAYER_COUNT; ++a)
     {
-        t = -b + sqrtf(discr);
+        for (int b = a; b < LAYER_COUNT; ++b)
+        {
+            auto la = static_cast<CollisionLayer>(a);
+            auto lb = static_cast<CollisionLayer>(b);
+            uint32_t tests = CollisionManager::GetPairTestCount(la, lb);
+            if (tests == 0) { continue; }
+
+            ImGui::Text("%s - %s : %u / %u",
+                CollisionManager::GetLayerName(la), CollisionManager::GetLayerName(lb),
+                tests, CollisionManager::GetPairHitCount(la, lb));
+        }
     }
-    if (t < 0.0f) { return false; }
 
-    outT = t;
-    return true;
+    ImGui::End();
+}
+
+void GameScene::DebugTransformCacheStats()
+{
+    ImGui::Begin("TransformCache");
+
+    //前回表示してからの回数（毎フレーム表示するので 1 フレーム分）
+    uint64_t hits = GameObject::GetTransformCacheHits();
+    uint64_t misses = GameObject::GetTransformCacheMisses();
+    uint64_t total = hits + misses;
+
+    ImGui::Text("Hits   : %llu", static_cast<unsigned long long>(hits));
+    ImGui::Text("Misses : %llu", static_cast<unsigned long long>(misses));
+    ImGui::Text("Hit rate : %.1f %%", total ? 100.0 * static_cast<double>(hits) / static_cast<double>(total) : 0.0);
+
+    ImGui::End();
+
+    GameObject::ResetTransformCacheStats();
+}
+
+void GameScene::DebugWaveScheduler()
+{
+    if (!m_waveScheduler) { return; }
+
+    ImGui::Begin("WaveScheduler");
+
+    ImGui::Text("Time     : %.1f", m_waveScheduler->GetTime());
+    ImGui::Text("Spawned  : %d / %d", m_waveScheduler->GetSpawnedCount(), m_waveScheduler->GetTotalCount());
+    ImGui::Text("Ready    : %d", m_waveScheduler->GetReadyCount());
+    ImGui::Text("Frame    : %.3f ms", m_waveScheduler->GetLastFrameMs());
+    ImGui::Text("Deferred : %u", m_waveScheduler->GetDeferredFrames());
+    ImGui::Text("Late     : %u", m_waveScheduler->GetLateBuilds());
+
+    ImGui::End();
 }
 
 bool GameScene::Raycast(const DirectX::SimpleMath::Vector3& origin,
@@ -117,67 +154,8 @@ bool GameScene::Raycast(const DirectX::SimpleMath::Vector3& origin,
     }
     ndir.Normalize();
 
-    float bestT = std::numeric_limits<float>::infinity();
-    std::shared_ptr<GameObject> bestObj;
-
-    for (auto& obj : m_GameObjects)
-    {
-        if (!obj) { continue; }
-        if (obj.get() == ignore) { continue; }
-
-        if (predicate)
-        {
-            if (!predicate(obj.get()))
-            {
-                continue;
-            }
-        }
-
-        float t;
-        float radius = 0.0f;
-
-        bool hasSphere = false;
-
-        {
-            Enemy* e = dynamic_cast<Enemy*>(obj.get());
-            if (e)
-            {
-                radius = e->GetBoundingRadius();
-                hasSphere = true;
-            }
-        }
-
-        if (hasSphere)
-        {
-            if (RaySphereIntersect(origin, ndir, obj->GetPosition(), radius, t))
-            {
-                if (t >= 0.0f && t <= maxDistance && t < bestT)
-                {
-                    bestT = t;
-                    bestObj = obj;
-                }
-            }
-        }
-        else
-        {
-
-        }
-    }
-
-    if (bestObj)
-    {
-        outHit.hitObject = bestObj;
-        outHit.distance = bestT;
-        outHit.position = origin + ndir * bestT;
-        outHit.normal = (outHit.position - bestObj->GetPosition());
-        if (outHit.normal.LengthSquared() > 1e-6f)
-        {
-            outHit.normal.Normalize();
-        }
-        return true;
-    }
-
-    return false;
+    //Enemy の簡易球だけが対象
+    return m_spatialIndex.Raycast(origin, ndir, maxDistance, TAG_ENEMY, ignore, predicate, outHit);
 }
 
 bool GameScene::RaycastForAI(const DirectX::SimpleMath::Vector3& origin,
@@ -193,77 +171,8 @@ bool GameScene::RaycastForAI(const DirectX::SimpleMath::Vector3& origin,
         return false;
     ndir.Normalize();
 
-    float bestT = std::numeric_limits<float>::infinity();
-    std::shared_ptr<GameObject> bestObj;
-
-    for (auto& obj : m_GameObjects)
-    {
-        if (!obj) continue;
-        if (obj.get() == ignore) continue;
-
-        //コライダーを持っていないなら無視
-        auto obb = obj->GetComponent<OBBColliderComponent>();
-        auto aabb = obj->GetComponent<AABBColliderComponent>();
-        bool hasCollider = (obb || aabb);
-
-        //Enemy の簡易球 or Building の AABB など…
-        float radius = 0.0f;
-        bool hasSphere = false;
-
-        if (auto e = dynamic_cast<Enemy*>(obj.get()))
-        {
-            radius = e->GetBoundingRadius();
-            if (radius > 0.0f) hasSphere = true;
-        }
-        else if (hasCollider)
-        {
-            //コライダーからざっくり半径を作る（対角長の半分）
-            //きっちりした Ray vs OBB/AABB は後で実装でもOK
-            Vector3 center = obj->GetPosition();
-            Vector3 extents;
-
-            if (obb)
-            {
-                extents = obb->GetSize() * 0.5f; // size が全長なら半分で半径相当
-            }
-            else // AABB
-            {
-                Vector3 size = aabb->GetSize();
-                extents = size * 0.5f;
-            }
-
-            radius = extents.Length(); // 対角線の長さ ≒ おおざっぱな半径
-            hasSphere = (radius > 0.0f);
-        }
-
-        if (!hasSphere) continue;
-
-        float t;
-        if (RaySphereIntersect(origin, ndir, obj->GetPosition(), radius, t))
-        {
-            if (t >= 0.0f && t <= maxDistance && t < bestT)
-            {
-                bestT = t;
-                bestObj = obj;
-            }
-        }
-    }
-
-    if (bestObj)
-    {
-        outHit.hitObject = bestObj;
-        outHit.distance = bestT;
-        outHit.position = origin + ndir * bestT;
-
-        // 簡易法線（中心からの方向）
-        outHit.normal = outHit.position - bestObj->GetPosition();
-        if (outHit.normal.LengthSquared() > 1e-6f)
-            outHit.normal.Normalize();
-
-        return true;
-    }
-
-    return false;
+    //Enemy の簡易球 or コライダーの対角長の半分を半径にした球（コライダーが無いものは対象外）
+    return m_spatialIndex.Raycast(origin, ndir, maxDistance, TAG_ALL, ignore, nullptr, outHit);
 }
 
 void GameScene::Init()
@@ -275,6 +184,12 @@ void GameScene::Init()
     
     DebugUI::RedistDebugFunction([this]() {DebugSetAimDistance();});
 
+    DebugUI::RedistDebugFunction([this]() {DebugCollisionStats();});
+
+    DebugUI::RedistDebugFunction([this]() {DebugTransformCacheStats();});
+
+    DebugUI::RedistDebugFunction([this]() {DebugWaveScheduler();});
+
     //DebugRendererの初期化
     m_debugRenderer = std::make_unique<DebugRenderer>();
     m_debugRenderer->Initialize(Renderer::GetDevice(), Renderer::GetDeviceContext(),
@@ -283,6 +198,8 @@ void GameScene::Init()
     m_playArea = std::make_shared<PlayAreaComponent>();
     m_playArea->SetScene(this); // PlayArea がシーンを利用する場合
     m_playArea->SetBounds({ -300.0f, -1.0f, -300.0f }, { 300.0f, 200.0f, 300.0f });
+    m_spatialIndex.SetBounds(m_playArea->GetBoundsMin(), m_playArea->GetBoundsMax());
+    CollisionManager::SetBroadPhaseBounds(m_playArea->GetBoundsMin(), m_playArea->GetBoundsMax());
     m_playArea->SetGroundY(-7.0f);
     
     m_FollowCamera = std::make_shared<CameraObject>();
@@ -305,13 +222,9 @@ void GameScene::Init()
 
     //-------------------------敵生成--------------------------------
     m_enemySpawner = std::make_unique<EnemySpawner>(this);
-    m_enemySpawner->patrolCfg.spawnCount = 1;
-	m_enemySpawner->circleCfg.spawnCount = 0;
-    m_enemySpawner->turretCfg.spawnCount = 1;
-    m_enemySpawner->fleeCfg.spawnCount = 0;
-
-    enemyCount = m_enemySpawner->patrolCfg.spawnCount + m_enemySpawner->circleCfg.spawnCount + m_enemySpawner->turretCfg.spawnCount;
+    m_enemySpawner->LoadPrefabs("Asset/Prefab/Enemy.txt");
 
+    //ここで登録する経路・位置セットを、ウェーブファイルの経路番号で参照する
     m_enemySpawner->SetWaypoints(
         { { 80.0f, 20.0f,  0.0f }, 
           { 40.0f, 20.0f,-80.0f }, 
@@ -344,13 +257,26 @@ void GameScene::Init()
           {  62.0f, 120.0f,  -62.5f },
           {-125.0f, 120.0f,   62.5f } });
 
-    m_enemySpawner->EnsurePatrolCount();
 	m_enemySpawner->turretCfg.target = m_player;
 	m_enemySpawner->turretCfg.bulletSpeed = 80.0f;
     m_enemySpawner->SetTurretPos({ 100.0f,100.0f,0.0f });
     m_enemySpawner->SetTurretPos({ -100.0f,100.0f,0.0f });
 
-	m_enemySpawner->EnsureTurretCount();
+    //-------------------------ウェーブ--------------------------------
+    m_waveScheduler = std::make_unique<WaveScheduler>(m_enemySpawner.get());
+
+    if (!m_waveScheduler->Load("Asset/Wave/Stage01.txt"))
+    {
+        //ファイルが無いときは巡回 1 体 + 砲台 1 体だけ出す
+        m_waveScheduler->SetEntries({
+            { 0.0f, EnemyArchetype::Patrol, 1, 0 },
+            { 0.0f, EnemyArchetype::Turret, 1, 0 } });
+    }
+
+    m_waveScheduler->Prepare();
+
+    //まだ出ていない敵も含めた総数（途中のウェーブ間で全滅扱いにならないように）
+    enemyCount = m_waveScheduler->GetTotalCount();
     //------------------スカイドーム作成-------------------------
 
     m_SkyDome = std::make_shared<SkyDome>("Asset/SkyDome/SkyDome_03.png");
@@ -499,16 +425,17 @@ void GameScene::Init()
     m_miniMap->SetRotateWithPlayer(true);
     m_miniMap->SetIconSize(10.0f);
 
-    m_miniMap->SetBackgroundSRV(m_miniMapBgSRV);
-	m_miniMap->SetPlayerIconSRV(m_miniMapPlayerSRV);
-    m_miniMap->SetEnemyIconSRV(m_miniMapEnemySRV);
-    m_miniMap->SetBuildingIconSRV(m_miniMapBuildingSRV);
+    m_miniMap->SetBackgroundSRV(m_miniMapBgSRV.get());
+	m_miniMap->SetPlayerIconSRV(m_miniMapPlayerSRV.get());
+    m_miniMap->SetEnemyIconSRV(m_miniMapEnemySRV.get());
+    m_miniMap->SetBuildingIconSRV(m_miniMapBuildingSRV.get());
 
     m_miniMap->SetPlayer(m_player.get()); // m_playerがshared_ptr<GameObject>想定
 
     //---------------------------------------------
 	
     m_GameObjects.insert(m_GameObjects.begin(), m_SkyDome);
+    RebuildObjectIndices();
 
     m_FollowCamera->GetFollowCameraComponent()->SetTarget(m_player.get());
 
@@ -574,9 +501,18 @@ void GameScene::Update(float deltatime)
     //フレーム先頭で前フレームの登録を消す
     CollisionManager::Clear();
 
+    //出現時刻になった敵を追加要求に積む
+    if (m_waveScheduler)
+    {
+        m_waveScheduler->Update(deltatime);
+    }
+
     //新規オブジェクトをGameSceneのオブジェクト配列に追加する
     SetSceneObject();
 
+    //近傍検索用のインデックスを作り直す（このフレームの Raycast・ターゲット検索・ミニマップで使う）
+    m_spatialIndex.Rebuild(m_GameObjects);
+
     auto PlayerMove = m_player->GetComponent<MoveComponent>();
     if (PlayerMove)
     {
@@ -631,6 +567,10 @@ void GameScene::Update(float deltatime)
         if (obj) obj->Update(deltatime);
     }
 
+    //追尾弾の誘導をまとめて計算（各 HomingComponent が積んだ要求を処理し、曲がった向きでこのフレームの移動をやり直す）
+    //当たり判定の登録より前に呼ぶこと
+    HomingGuidance::Solve(deltatime);
+
     for (auto& obj : m_GameObjects)
     {
         if (!obj) continue;
@@ -657,25 +597,12 @@ void GameScene::Update(float deltatime)
 
     if (m_miniMap)
     {
-        std::vector<GameObject*> enemies;
-        std::vector<GameObject*> buildings;
+        //毎フレーム作り直す一時リストなのでフレームアリーナから確保
+        FrameVector<GameObject*> enemies;
+        FrameVector<GameObject*> buildings;
 
-        for (std::shared_ptr<GameObject> obj : m_GameObjects)
-        {
-            if (!obj)
-            {
-                continue;
-            }
-
-            if (auto enemy = std::dynamic_pointer_cast<Enemy>(obj))
-            { 
-                enemies.push_back(obj.get());
-            }
-            else if (auto building = std::dynamic_pointer_cast<Building>(obj))
-            { 
-                buildings.push_back(obj.get());
-            }
-        }
+        m_spatialIndex.Collect(TAG_ENEMY, enemies);
+        m_spatialIndex.Collect(TAG_BUILDING, buildings);
 
         m_miniMap->SetEnemies(enemies);
         m_miniMap->SetBuildings(buildings);
@@ -723,6 +650,9 @@ void GameScene::DrawWorld(float deltatime)
         obj->Draw(deltatime);
     }
 
+    // インスタンシング対象のモデル（敵・建物）をまとめて描画
+    InstancedModelRenderer::Flush();
+
     // コリジョンデバッグ描画（ワールド空間なのでここに入れる）
     if (isCollisionDebugMode)
     {
@@ -802,6 +732,9 @@ void GameScene::DrawUI(float deltatime)
 
 void GameScene::Uninit()
 {
+    //組み立て済みでまだ出していない敵もここで捨てる
+    m_waveScheduler.reset();
+
     if (m_enemySpawner)
     {
         m_enemySpawner.reset();
@@ -822,6 +755,16 @@ void GameScene::Uninit()
         // GameObject::Uninit を実装しておくこと（下で例示）
         obj->Uninit();
         obj->SetScene(nullptr);
+        obj->GetSceneSlot() = GameObject::SceneSlot();
+    }
+
+    //追加待ちのまま残っている物も同じように解放する（スロットを戻さないと、プールから再利用したときに AddObject できない）
+    for (auto& obj : m_AddObjects)
+    {
+        if (!obj) { continue; }
+        obj->Uninit();
+        obj->SetScene(nullptr);
+        obj->GetSceneSlot() = GameObject::SceneSlot();
     }
 
     //テクスチャオブジェクト解放
@@ -833,11 +776,16 @@ void GameScene::Uninit()
     }
 
     //vectors をクリアして shared_ptr の参照カウントを下げる
+    m_spatialIndex.Clear();
     m_GameObjects.clear();
     m_TextureObjects.clear();
     m_AddObjects.clear();
     m_DeleteObjects.clear();
 
+    //シーン内で使い回していた弾を破棄
+    Bullet::ClearPool();
+    HomingGuidance::Clear();
+
     //個別メンバ（player, camera, etc.）を reset
     m_player.reset();
     m_FollowCamera.reset();
@@ -845,6 +793,14 @@ void GameScene::Uninit()
     m_reticleObj.reset();
     m_reticleTex.reset();
     m_reticle.reset();
+
+    //ミニマップのテクスチャも手放す（シーンのオブジェクトは残るので、持ったままだとキャッシュから捨てられない）
+    m_miniMap = nullptr;
+    m_miniMapUi.reset();
+    m_miniMapBgSRV.reset();
+    m_miniMapPlayerSRV.reset();
+    m_miniMapEnemySRV.reset();
+    m_miniMapBuildingSRV.reset();
 }
 
 void GameScene::AddObject(std::shared_ptr<GameObject> obj)
@@ -854,22 +810,23 @@ void GameScene::AddObject(std::shared_ptr<GameObject> obj)
         return; 
     }
 
-    //既にシーン内にいるかpendingにいるかチェック
-    auto itInScene = std::find_if(m_GameObjects.begin(), m_GameObjects.end(),
-       [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == obj.get(); });
-    
-    //既に実体がある
-    if (itInScene != m_GameObjects.end())
+    auto& slot = obj->GetSceneSlot();
+
+    //既にシーン内にいる
+    if (slot.index >= 0)
     {
         return;
     }
 
-    auto itPending = std::find_if(m_AddObjects.begin(), m_AddObjects.end(),
-        [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == obj.get(); });
-    
-    // 追加予定にすでにある
-    if (itPending != m_AddObjects.end())
+    //追加予定にすでにある
+    if (slot.pendingAdd)
     {
+        //追加前に削除予約されていた物（プールから再利用された弾など）は予約を取り消す
+        if (slot.pendingRemove)
+        {
+            slot.pendingRemove = false;
+            obj->SetScene(this);
+        }
         return;
     }
 
@@ -877,6 +834,7 @@ void GameScene::AddObject(std::shared_ptr<GameObject> obj)
     obj->SetScene(this);
     
     //実際に配列にプッシュする
+    slot.pendingAdd = true;
     m_AddObjects.push_back(obj);
 }
 
@@ -887,12 +845,8 @@ void GameScene::AddTextureObject(std::shared_ptr<GameObject> obj)
         return;
     }
 
-    //既にシーン内にいるかpendingにいるかチェック
-    auto itInScene = std::find_if(m_GameObjects.begin(), m_GameObjects.end(),
-        [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == obj.get(); });
-
-    //既に実体がある
-    if (itInScene != m_GameObjects.end())
+    //既に3Dオブジェクトとしてシーン内にいる
+    if (obj->GetSceneSlot().index >= 0)
     {
         return;
     }
@@ -909,6 +863,11 @@ void GameScene::RemoveObject(GameObject* obj)
     //ポインタがないなら処理終わり
     if (!obj) { return; }
 
+    auto& slot = obj->GetSceneSlot();
+
+    //二重登録防止
+    if (slot.pendingRemove) { return; }
+
     //------------------------------
 	// コライダー登録解除
     //------------------------------
@@ -918,75 +877,113 @@ void GameScene::RemoveObject(GameObject* obj)
     }
 
     //------------------------------
-    // m_AddObjectsにいるか確認
-    // いるなら取り消す
+    // m_AddObjectsにいるなら取り消す
+    // （Uninit は他の削除と同じく FinishFrameCleanup で行う。呼び出し元がまだその Update の中にいることがある）
     //------------------------------
-   auto itPending = std::find_if(m_AddObjects.begin(), m_AddObjects.end(),
-       [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == obj; });
-   if (itPending != m_AddObjects.end())
-   {
-       m_AddObjects.erase(itPending);
-       return;
-   }
+    if (slot.pendingAdd)
+    {
+        slot.pendingRemove = true;
+        return;
+    }
+
     //---------------------------------
-    // m_GameObjectsにいるか確認
-    // いるならm_DeleteObjects に登録
+    // m_GameObjectsにいるならm_DeleteObjects に登録
     // ---------------------------------
-    auto itInScene = std::find_if(m_GameObjects.begin(), m_GameObjects.end(),
-        [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == obj; });
-    if (itInScene != m_GameObjects.end())
-    {
-        // 二重登録防止
-        auto already = std::find_if(m_DeleteObjects.begin(), m_DeleteObjects.end(),
-            [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == obj; });
-        if (already == m_DeleteObjects.end())
-        {
-            m_DeleteObjects.push_back(*itInScene);
-        }
-        return;
+    if (slot.index >= 0 && slot.index < static_cast<int>(m_GameObjects.size()) &&
+        m_GameObjects[slot.index].get() == obj)
+    {
+        slot.pendingRemove = true;
+        m_DeleteObjects.push_back(m_GameObjects[slot.index]);
     }
 }
 
 void GameScene::FinishFrameCleanup()
 {
+    //配列を詰めると位置がずれるので、インデックスは次の Update で作り直すまで空にしておく
+    m_spatialIndex.Clear();
+
+    //追加前に削除予約された物を追加待ちから外して Uninit する（プールの弾はここでプールに返る）
+    if (!m_AddObjects.empty())
+    {
+        std::vector<std::shared_ptr<GameObject>> cancelled;
+        size_t write = 0;
+        for (size_t read = 0; read < m_AddObjects.size(); ++read)
+        {
+            auto& obj = m_AddObjects[read];
+            if (obj && obj->GetSceneSlot().pendingRemove)
+            {
+                obj->GetSceneSlot() = GameObject::SceneSlot();
+                cancelled.push_back(std::move(obj));
+                continue;
+            }
+            if (write != read)
+            {
+                m_AddObjects[write] = std::move(obj);
+            }
+            ++write;
+        }
+        m_AddObjects.resize(write);
+
+        //Uninit の中で AddObject されても m_AddObjects を走査中にしないよう、外してから呼ぶ
+        for (auto& obj : cancelled)
+        {
+            obj->Uninit();
+            obj->SetScene(nullptr);
+        }
+    }
+
+    if (m_DeleteObjects.empty()) { return; }
+
+    bool removed = false;
+
     //m_DeleteObjectsにあるアイテムを削除
+    //（m_GameObjects の該当スロットを空にするだけで、詰めるのは最後に1回）
     for (auto& delSp : m_DeleteObjects)
     {
         if (!delSp){ continue; }
 
-        //m_GameObjects から探す
-        auto it = std::find_if(m_GameObjects.begin(), m_GameObjects.end(),
-            [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == delSp.get(); });
+        auto& slot = delSp->GetSceneSlot();
 
-        if (it != m_GameObjects.end())
+        if (slot.index >= 0 && slot.index < static_cast<int>(m_GameObjects.size()) &&
+            m_GameObjects[slot.index] == delSp)
         {
-            if (auto enemy = std::dynamic_pointer_cast<Enemy>(*it))
+            if (auto enemy = std::dynamic_pointer_cast<Enemy>(delSp))
             {
                 enemyCount -= 1;
             }
 
             //Uninit
-            (*it)->Uninit();
+            delSp->Uninit();
 
             //シーン参照を切る
-            (*it)->SetScene(nullptr);
+            delSp->SetScene(nullptr);
 
-            m_GameObjects.erase(it);
+            m_GameObjects[slot.index].reset();
+            slot.index = -1;
+            slot.pendingRemove = false;
+            removed = true;
         }
+    }
 
-        //m_AddObjectsにまだあるなら削除
-        auto itPending = std::find_if(m_AddObjects.begin(), m_AddObjects.end(),
-            [&](const std::shared_ptr<GameObject>& sp) { return sp.get() == delSp.get(); });
-        if (itPending != m_AddObjects.end())
+    m_DeleteObjects.clear();
+
+    //空いたスロットを詰める（描画順を保つため前から順にずらす）
+    if (removed)
+    {
+        size_t write = 0;
+        for (size_t read = 0; read < m_GameObjects.size(); ++read)
         {
-            // 追加前に削除予定だったオブジェクトなら Uninit して erase
-            (*itPending)->Uninit();
-            (*itPending)->SetScene(nullptr);
-            m_AddObjects.erase(itPending);
+            if (!m_GameObjects[read]) { continue; }
+
+            if (write != read)
+            {
+                m_GameObjects[write] = std::move(m_GameObjects[read]);
+            }
+            m_GameObjects[write]->GetSceneSlot().index = static_cast<int>(write);
+            ++write;
         }
+        m_GameObjects.resize(write);
     }
-
-    m_DeleteObjects.clear();
 }
 
 
@@ -994,9 +991,39 @@ void GameScene::SetSceneObject()
 { 
     if (!m_AddObjects.empty())
     { 
-        //一括追加
+        //一括追加（追加前に削除された物は追加待ちに残し、FinishFrameCleanup で Uninit する）
         m_GameObjects.reserve(m_GameObjects.size() + m_AddObjects.size()); 
-        m_GameObjects.insert(m_GameObjects.end(), std::make_move_iterator(m_AddObjects.begin()), std::make_move_iterator(m_AddObjects.end())); 
-        m_AddObjects.clear();
+        size_t keep = 0;
+        for (size_t read = 0; read < m_AddObjects.size(); ++read)
+        {
+            auto& obj = m_AddObjects[read];
+            auto& slot = obj->GetSceneSlot();
+
+            if (slot.pendingRemove)
+            {
+                if (keep != read)
+                {
+                    m_AddObjects[keep] = std::move(obj);
+                }
+                ++keep;
+                continue;
+            }
+
+            slot.pendingAdd = false;
+            slot.index = static_cast<int>(m_GameObjects.size());
+            m_GameObjects.push_back(std::move(obj));
+        }
+        m_AddObjects.resize(keep);
     } 
 }
+
+void GameScene::RebuildObjectIndices()
+{
+    for (size_t i = 0; i < m_GameObjects.size(); ++i)
+    {
+        if (m_GameObjects[i])
+        {
+            m_GameObjects[i]->GetSceneSlot().index = static_cast<int>(i);
+        }
+    }
+}
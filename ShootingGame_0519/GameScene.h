@@ -15,10 +15,12 @@
 #include "DebugUI.h"
 #include "HPBar.h"
 #include "EnemySpawner.h"
+#include "WaveScheduler.h"
 #include "BuildingSpawner.h"
 #include "PlayAreaComponent.h"
 #include "MoveComponent.h"
 #include "MiniMapComponent.h"
+#include "SpatialIndex.h"
 
 //---------------------------------
 //IScenepGameScene
@@ -56,6 +58,15 @@ public:
 
 	//[hύXp֐
 	void DebugSetAimDistance();
+
+	//蔻̃C[ʓv\p֐
+	void DebugCollisionStats();
+
+	//sLbV̓v\p֐
+	void DebugTransformCacheStats();
+
+	//EF[u̐is󋵕\p֐
+	void DebugWaveScheduler();
 	
 	//IuWFNg̒ǉv֐
 	void AddObject(std::shared_ptr<GameObject> obj) override;
@@ -87,6 +98,8 @@ public:
 
 	const std::vector<std::shared_ptr<GameObject>>& GetObjects() const override { return m_GameObjects; }
 
+	const SpatialIndex* GetSpatialIndex() const override { return &m_spatialIndex; }
+
 	PlayAreaComponent* GetPlayArea() const { return m_playArea.get(); }
 
 	//폜\̃IuWFNg̔z
@@ -103,6 +116,9 @@ private:
 
 	std::unique_ptr<EnemySpawner> m_enemySpawner;
 
+	//EF[ut@Cɏ] m_enemySpawner œGo
+	std::unique_ptr<WaveScheduler> m_waveScheduler;
+
 	std::unique_ptr<BuildingSpawner> m_buildingSpawner;
 
 	std::unique_ptr<DebugRenderer> m_debugRenderer;
@@ -131,6 +147,9 @@ private:
 	//SceneUpdateɒǉ\łIuWFNg̔z̒ǉȂǂs֐
 	void SetSceneObject();
 
+	//m_GameObjects ɒڑ}ƂɊeIuWFNg̔zʒuU蒼
+	void RebuildObjectIndices();
+
 	void SetReticleByCenter(const POINT& screenPos)
 	{
 		if (!m_reticleTex) { return; }
@@ -178,6 +197,9 @@ private:
 
 	std::shared_ptr<PlayAreaComponent> m_playArea;
 
+	//ߖTp̋ԃCfbNXit[蒼j
+	SpatialIndex m_spatialIndex;
+
 	std::shared_ptr<MoveComponent> m_playerMove;
 	
 	//--------------~j}bv֘A--------------
@@ -185,9 +207,9 @@ private:
 	std::shared_ptr<GameObject> m_miniMapUi;
 	MiniMapComponent* m_miniMap = nullptr;
 
-	ID3D11ShaderResourceView* m_miniMapBgSRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapPlayerSRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapEnemySRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapBuildingSRV = nullptr;
+	TextureHandle m_miniMapBgSRV;
+	TextureHandle m_miniMapPlayerSRV;
+	TextureHandle m_miniMapEnemySRV;
+	TextureHandle m_miniMapBuildingSRV;
 
 };
@@ -2,6 +2,7 @@
 #include "Input.h"
 #include "Renderer.h"
 #include "Application.h"
+#include "Logger.h"
 #include <Windows.h>
 
 HPBar::HPBar(const std::wstring& framePath, const std::wstring& gaugePath, float width, float height)
@@ -21,18 +22,18 @@ void HPBar::Initialize()
 
     if (!m_frameTex || !m_gaugeTex)
     {
-        OutputDebugStringA("HPBar: TextureComponent 쐬s\n");
+        LOG_WARN("HPBar: TextureComponent 쐬s");
         return;
     }
 
     if (!m_frameTex->LoadTexture(m_framePath))
     {
-        OutputDebugStringA("HPBar: g̉摜 Ǎs\n");
+        LOG_WARN("HPBar: g̉摜 Ǎs");
     }
 
     if (!m_gaugeTex->LoadTexture(m_gaugePath))
     {
-        OutputDebugStringA("HPBar: Q[W̉摜 Ǎs\n");
+        LOG_WARN("HPBar: Q[W̉摜 Ǎs");
     }
 
     //CAEgf
@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------
+// 世代付きハンドル（index + generation）
+// ・index でスロットを O(1) で引き、generation が一致しなければ「もう居ない」と判定する
+// ・スロットは解放後に再利用されるが、そのたびに generation が進むので古いハンドルは無効になる
+// ・生ポインタや weak_ptr の代わりに「他のオブジェクトを指す」用途で使う
+//------------------------------------------------------------
+template<typename T>
+struct Handle
+{
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsNull() const { return index == kInvalidIndex; }
+
+    bool operator==(const Handle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const Handle& o) const { return !(*this == o); }
+};
+
+//ハンドル -> ポインタの対応表
+template<typename T>
+class HandleTable
+{
+public:
+    //登録してハンドルを発行する
+    Handle<T> Add(T* object)
+    {
+        uint32_t index;
+        if (!m_free.empty())
+        {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({});
+        }
+
+        Slot& slot = m_slots[index];
+        slot.object = object;
+
+        Handle<T> h;
+        h.index = index;
+        h.generation = slot.generation;
+        return h;
+    }
+
+    //登録解除（このハンドルと、同じスロットを指す古いハンドルは全部無効になる）
+    void Remove(Handle<T> h)
+    {
+        if (!IsValid(h)) { return; }
+
+        Slot& slot = m_slots[h.index];
+        slot.object = nullptr;
+        ++slot.generation;
+        m_free.push_back(h.index);
+    }
+
+    bool IsValid(Handle<T> h) const
+    {
+        return h.index < m_slots.size()
+            && m_slots[h.index].generation == h.generation
+            && m_slots[h.index].object != nullptr;
+    }
+
+    //無効なハンドルなら nullptr
+    T* Get(Handle<T> h) const
+    {
+        return IsValid(h) ? m_slots[h.index].object : nullptr;
+    }
+
+    size_t GetLiveCount() const { return m_slots.size() - m_free.size(); }
+
+private:
+    struct Slot
+    {
+        T* object = nullptr;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free;
+};
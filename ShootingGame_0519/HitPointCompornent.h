@@ -38,6 +38,9 @@ public:
     void SetOnHealed(std::function<void(int)> cb) { m_onHealed = std::move(cb); }
     void SetOnDeath(std::function<void()> cb) { m_onDeath = std::move(cb); }
 
+    //ivnupj
+    std::shared_ptr<Component> Clone() const override { return std::make_shared<HitPointComponent>(*this); }
+
 private:
 	int   m_hp;       //݂HP
 	int   m_maxHp;    //őHP
@@ -1,5 +1,6 @@
 #pragma once
 #include "Component.h"
+#include "GameObject.h"
 #include <SimpleMath.h>
 #include <memory>
 
@@ -15,7 +16,7 @@ public:
     ~HomingComponent() override = default;
 
     //------------Set֐--------------
-    void SetTarget(const std::weak_ptr<GameObject>& t) { m_target = t; }
+    void SetTarget(GameObject* t) { m_target = t ? t->GetHandle() : GameObjectHandle(); m_enabled = true; }
     void SetTimeToIntercept(float t) { m_timeToIntercept = t; }
     void SetMaxAcceleration(float a) { m_maxAcceleration = a; }
     void SetLifeTime(float sec) { m_lifeTime = sec; }
@@ -24,7 +25,7 @@ public:
     void SetAimBiasDecay(float d) { m_aimBiasDecay = d; }
 
     //------------Get֐--------------
-    std::weak_ptr<GameObject> GetTarget() const { return m_target; }
+    GameObject* GetTarget() const { return GameObject::Resolve(m_target); }
     float GetTimeToIntercept() const { return m_timeToIntercept; }
     float GetMaxAcceleration() const { return m_maxAcceleration; }
 
@@ -32,16 +33,18 @@ public:
     void Initialize() override;
     void Update(float dt) override;
 
+    //v[ŒeėpƂɌĂԁiSetTarget ܂ŉȂԂɖ߂j
+    void Reset();
+
 private:
     //--------------ǔ֘A------------------
-    std::weak_ptr<GameObject> m_target;
+    GameObjectHandle m_target;
+    bool m_enabled = true;
     float m_timeToIntercept = 1.5f;   // ftHg 1 bŖڎw
     float m_maxAcceleration = 400.0f;   // 0 = A>0 Ő
     float m_lifeTime = 5.0f;          // Homing ̎ioptionalj
     float m_age = 0.0f;               // oߎ
 
-    Vector3 m_prevTargetPos = Vector3::Zero;
-    bool m_havePrevTargetPos = false;
     float m_maxTurnRateDeg = 120.0f;
 
     Vector3 m_aimBias = Vector3::Zero;      // ˎ̃_oCAXixNgj
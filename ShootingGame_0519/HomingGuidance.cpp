@@ -0,0 +1,141 @@
+﻿#include "HomingGuidance.h"
+#include "GameObject.h"
+#include "BulletComponent.h"
+#include "Logger.h"
+
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+//デバッグビルドでは SIMD 版の結果を従来の計算と突き合わせる
+#ifndef HOMING_VALIDATE
+#if defined(DEBUG) || defined(_DEBUG)
+#define HOMING_VALIDATE 1
+#else
+#define HOMING_VALIDATE 0
+#endif
+#endif
+
+std::vector<HomingGuidance::Request>     HomingGuidance::m_requests;
+std::vector<HomingGuidance::Resolved>    HomingGuidance::m_resolved;
+std::vector<HomingInput>                 HomingGuidance::m_inputs;
+std::vector<HomingOutput>                HomingGuidance::m_outputs;
+std::vector<HomingGuidance::TargetTrack> HomingGuidance::m_tracks;
+uint32_t HomingGuidance::m_tick = 1;
+
+void HomingGuidance::Submit(GameObjectHandle owner, GameObjectHandle target,
+                            const Vector3& aimBias, float maxTurn, float fallbackTime)
+{
+    Request r;
+    r.owner = owner;
+    r.target = target;
+    r.aimBias = aimBias;
+    r.maxTurn = maxTurn;
+    r.fallbackTime = fallbackTime;
+    m_requests.push_back(r);
+}
+
+void HomingGuidance::Clear()
+{
+    m_requests.clear();
+    m_resolved.clear();
+    m_tracks.clear();
+}
+
+const Vector3& HomingGuidance::GetTargetVelocity(GameObjectHandle target, const Vector3& targetPos, float dt)
+{
+    if (target.index >= m_tracks.size())
+    {
+        m_tracks.resize(target.index + 1);
+    }
+
+    TargetTrack& track = m_tracks[target.index];
+
+    //このフレームで既に計算済みなら使い回す（同じ敵を何発追っていても 1 回だけ）
+    if (track.generation == target.generation && track.velocityTick == m_tick)
+    {
+        return track.velocity;
+    }
+
+    //前のフレームにも追っていた同じターゲットなら位置の差分から速度を求める
+    if (track.generation == target.generation && track.seenTick + 1 == m_tick && dt > 1e-6f)
+    {
+        track.velocity = (targetPos - track.lastPosition) / dt;
+    }
+    else
+    {
+        track.velocity = Vector3::Zero;
+    }
+
+    track.generation = target.generation;
+    track.lastPosition = targetPos;
+    track.seenTick = m_tick;
+    track.velocityTick = m_tick;
+    return track.velocity;
+}
+
+void HomingGuidance::Solve(float dt)
+{
+    ++m_tick;
+
+    if (m_requests.empty()) { return; }
+
+    //--------------入力を集める（ハンドルが無効になった弾・ターゲットは飛ばす）------------------
+    m_inputs.clear();
+    m_resolved.clear();
+    for (const Request& r : m_requests)
+    {
+        GameObject* owner = GameObject::Resolve(r.owner);
+        GameObject* target = GameObject::Resolve(r.target);
+        if (!owner || !target) { continue; }
+
+        //BulletComponent は弾の最初のコンポーネントなので、探すのは 1 回の比較で済む
+        BulletComponent* bullet = owner->GetComponent<BulletComponent>().get();
+        if (!bullet) { continue; }
+
+        //このフレームの移動前の位置から解く（移動は下でやり直す）
+        HomingInput in;
+        in.position = owner->GetPrevPosition();
+        in.direction = bullet->GetVelocity();
+        in.speed = bullet->GetSpeed();
+        in.targetPosition = target->GetPosition();
+        in.targetVelocity = GetTargetVelocity(r.target, in.targetPosition, dt);
+        in.aimBias = r.aimBias;
+        in.maxTurn = r.maxTurn;
+        in.fallbackTime = r.fallbackTime;
+        m_inputs.push_back(in);
+
+        //書き戻し先
+        m_resolved.push_back({ owner, bullet });
+    }
+    m_requests.clear();
+
+    //--------------一括計算------------------
+    m_outputs.resize(m_inputs.size());
+    SolveBatch(m_inputs.data(), m_outputs.data(), m_inputs.size());
+
+#if HOMING_VALIDATE
+    for (size_t i = 0; i < m_inputs.size(); ++i)
+    {
+        HomingOutput ref;
+        SolveScalar(m_inputs[i], ref);
+        float err = (ref.direction - m_outputs[i].direction).Length();
+        if (err > 1e-3f)
+        {
+            LOG_WARN("HomingGuidance: SIMD result differs from scalar by %f (missile %zu)", err, i);
+        }
+    }
+#endif
+
+    //--------------書き戻しと移動のやり直し------------------
+    //BulletComponent::Update() は古い向きで動かしているので、移動前の位置から解いた速度で動かし直す
+    //（当たり判定の登録はこの後なので、移動した線分の始点はそのまま使える）
+    for (size_t i = 0; i < m_resolved.size(); ++i)
+    {
+        const Resolved& r = m_resolved[i];
+        r.bullet->SetVelocity(m_outputs[i].direction);
+        r.bullet->SetSpeed(m_outputs[i].speed);
+        r.owner->SetPosition(m_inputs[i].position + m_outputs[i].direction * (m_outputs[i].speed * dt));
+    }
+
+    m_resolved.clear();
+}
@@ -0,0 +1,96 @@
+﻿#pragma once
+#include <vector>
+#include <DirectXMath.h>
+#include <SimpleMath.h>
+#include "Handle.h"
+
+class GameObject;
+class BulletComponent;
+using GameObjectHandle = Handle<GameObject>;
+
+//------------------------------------------------------------
+// 追尾弾の誘導計算をまとめて行うクラス
+// ・HomingComponent::Update() から Submit() で要求を積み、シーン更新の後に Solve() で一括計算する
+// ・弾は BulletComponent::Update() で古い向きのまま動いているので、Solve() で移動前の位置から解いた速度で動かし直す
+//   （曲がった向きが同じフレームの移動と当たり判定に反映される）
+// ・ターゲットの速度は「ターゲットごとに 1 フレーム 1 回」だけ位置の差分から求める
+// ・迎撃時間の二次方程式と旋回制限は 4 発ずつ SIMD で解く
+// ・SolveScalar() は従来の 1 発ずつの計算（SIMD 版の検証用の基準。迎撃時間の解の公式だけ桁落ちしない形に直してある）
+// ・計算部分は HomingGuidanceSolve.cpp にあり、Tools/HomingGuidanceCheck で SolveScalar() と突き合わせられる
+//------------------------------------------------------------
+
+//誘導計算 1 発分の入力
+struct HomingInput
+{
+    DirectX::SimpleMath::Vector3 position;
+    DirectX::SimpleMath::Vector3 direction;     //現在の進行方向（正規化前でもよい）
+    float speed = 0.0f;
+    DirectX::SimpleMath::Vector3 targetPosition;
+    DirectX::SimpleMath::Vector3 targetVelocity;
+    DirectX::SimpleMath::Vector3 aimBias;       //強さを掛けた後のバイアス
+    float maxTurn = 0.0f;                       //このフレームで曲がれる最大角（ラジアン）
+    float fallbackTime = 1.0f;                  //迎撃時間が解けないときに使う時間
+};
+
+//誘導計算 1 発分の出力
+struct HomingOutput
+{
+    DirectX::SimpleMath::Vector3 direction;
+    float speed = 0.0f;
+};
+
+class HomingGuidance
+{
+public:
+    //誘導要求を積む（owner が BulletComponent を持つ弾であること。Solve() までにプールへ返った弾はハンドルが無効になるので無視される）
+    static void Submit(GameObjectHandle owner, GameObjectHandle target,
+                       const DirectX::SimpleMath::Vector3& aimBias, float maxTurn, float fallbackTime);
+
+    //積まれた要求を一括で計算し、BulletComponent へ書き戻してこのフレームの移動をやり直す
+    static void Solve(float dt);
+
+    //シーン終了時などに要求とターゲットの履歴を捨てる
+    static void Clear();
+
+    //----------計算部分（GameObject に依存しない）-------------
+    static void SolveBatch(const HomingInput* inputs, HomingOutput* outputs, size_t count);
+    static void SolveScalar(const HomingInput& input, HomingOutput& output);
+
+private:
+    struct Request
+    {
+        GameObjectHandle owner;
+        GameObjectHandle target;
+        DirectX::SimpleMath::Vector3 aimBias;
+        float maxTurn = 0.0f;
+        float fallbackTime = 1.0f;
+    };
+
+    //ターゲットごとの位置履歴（handle.index で引く）
+    struct TargetTrack
+    {
+        uint32_t generation = 0;
+        uint32_t seenTick = 0;      //最後に位置を記録したフレーム
+        uint32_t velocityTick = 0;  //velocity を計算したフレーム
+        DirectX::SimpleMath::Vector3 lastPosition;
+        DirectX::SimpleMath::Vector3 velocity;
+    };
+
+    static const DirectX::SimpleMath::Vector3& GetTargetVelocity(GameObjectHandle target,
+                                                                 const DirectX::SimpleMath::Vector3& targetPos,
+                                                                 float dt);
+
+    //Solve() の中だけで使う、ハンドルを引いた結果（m_inputs と同じ並び）
+    struct Resolved
+    {
+        GameObject* owner = nullptr;
+        BulletComponent* bullet = nullptr;
+    };
+
+    static std::vector<Request>      m_requests;
+    static std::vector<Resolved>     m_resolved;
+    static std::vector<HomingInput>  m_inputs;
+    static std::vector<HomingOutput> m_outputs;
+    static std::vector<TargetTrack>  m_tracks;
+    static uint32_t m_tick;
+};
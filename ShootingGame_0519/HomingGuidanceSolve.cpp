@@ -0,0 +1,380 @@
+﻿#include "HomingGuidance.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//------------------------------------------------------------
+// HomingGuidance の計算部分（SolveBatch / SolveScalar）
+// GameObject やコンポーネントに依存しないので、Tools/HomingGuidanceCheck からこのファイルだけをリンクして確かめられる
+//------------------------------------------------------------
+
+using namespace DirectX;
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    //敵と弾の速さの二乗の和に対して a（速さの二乗の差）がこの比より小さければ同じ速さとみなす
+    //（a が丸め誤差だけになったときに二次方程式を解くと、SIMD 版と 1 発ずつの計算で答えがばらばらになる）
+    constexpr float kSameSpeedRatio = 1e-5f;
+
+    //4 発分の 3 次元ベクトル（成分ごとに 4 レーン）
+    struct Vec3x4
+    {
+        XMVECTOR x, y, z;
+    };
+
+    inline XMVECTOR Dot(const Vec3x4& a, const Vec3x4& b)
+    {
+        return XMVectorMultiplyAdd(a.x, b.x, XMVectorMultiplyAdd(a.y, b.y, XMVectorMultiply(a.z, b.z)));
+    }
+
+    inline Vec3x4 Add(const Vec3x4& a, const Vec3x4& b)
+    {
+        return { XMVectorAdd(a.x, b.x), XMVectorAdd(a.y, b.y), XMVectorAdd(a.z, b.z) };
+    }
+
+    inline Vec3x4 Sub(const Vec3x4& a, const Vec3x4& b)
+    {
+        return { XMVectorSubtract(a.x, b.x), XMVectorSubtract(a.y, b.y), XMVectorSubtract(a.z, b.z) };
+    }
+
+    inline Vec3x4 Scale(const Vec3x4& a, XMVECTOR s)
+    {
+        return { XMVectorMultiply(a.x, s), XMVectorMultiply(a.y, s), XMVectorMultiply(a.z, s) };
+    }
+
+    //a + b * s
+    inline Vec3x4 MulAdd(const Vec3x4& a, const Vec3x4& b, XMVECTOR s)
+    {
+        return { XMVectorMultiplyAdd(b.x, s, a.x), XMVectorMultiplyAdd(b.y, s, a.y), XMVectorMultiplyAdd(b.z, s, a.z) };
+    }
+
+    inline Vec3x4 Cross(const Vec3x4& a, const Vec3x4& b)
+    {
+        return {
+            XMVectorSubtract(XMVectorMultiply(a.y, b.z), XMVectorMultiply(a.z, b.y)),
+            XMVectorSubtract(XMVectorMultiply(a.z, b.x), XMVectorMultiply(a.x, b.z)),
+            XMVectorSubtract(XMVectorMultiply(a.x, b.y), XMVectorMultiply(a.y, b.x)),
+        };
+    }
+
+    //mask が立っているレーンだけ b、それ以外は a
+    inline Vec3x4 Select(const Vec3x4& a, const Vec3x4& b, XMVECTOR mask)
+    {
+        return { XMVectorSelect(a.x, b.x, mask), XMVectorSelect(a.y, b.y, mask), XMVectorSelect(a.z, b.z, mask) };
+    }
+
+    //長さがほぼ 0 のレーンは fallback に置き換えてから正規化する
+    inline Vec3x4 NormalizeOr(const Vec3x4& v, const Vec3x4& fallback, XMVECTOR epsilon)
+    {
+        XMVECTOR len2 = Dot(v, v);
+        XMVECTOR tiny = XMVectorLess(len2, epsilon);
+        Vec3x4 r = Select(v, fallback, tiny);
+        len2 = XMVectorSelect(len2, Dot(fallback, fallback), tiny);
+        return Scale(r, XMVectorReciprocalSqrt(len2));
+    }
+
+    //inputs[base + lane] の成分を 4 レーンに並べる（端数は最後の 1 発を繰り返す）
+    template<typename Getter>
+    inline Vec3x4 Gather3(const HomingInput* in, size_t base, size_t count, Getter get)
+    {
+        size_t i0 = base, i1 = std::min(base + 1, count - 1), i2 = std::min(base + 2, count - 1), i3 = std::min(base + 3, count - 1);
+        const Vector3& a = get(in[i0]);
+        const Vector3& b = get(in[i1]);
+        const Vector3& c = get(in[i2]);
+        const Vector3& d = get(in[i3]);
+        return { XMVectorSet(a.x, b.x, c.x, d.x), XMVectorSet(a.y, b.y, c.y, d.y), XMVectorSet(a.z, b.z, c.z, d.z) };
+    }
+
+    template<typename Getter>
+    inline XMVECTOR Gather1(const HomingInput* in, size_t base, size_t count, Getter get)
+    {
+        size_t i1 = std::min(base + 1, count - 1), i2 = std::min(base + 2, count - 1), i3 = std::min(base + 3, count - 1);
+        return XMVectorSet(get(in[base]), get(in[i1]), get(in[i2]), get(in[i3]));
+    }
+
+    bool SolveInterceptTime(const Vector3& relPos,
+        const Vector3& targetVel,
+        float projSpeed,
+        float& outT)
+    {
+        float vv = targetVel.Dot(targetVel);
+        float ss = projSpeed * projSpeed;
+        float a = vv - ss;
+        float b = 2.0f * relPos.Dot(targetVel);
+        float c = relPos.Dot(relPos);
+
+        if (fabsf(a) < 1e-6f + kSameSpeedRatio * (vv + ss))
+        {
+            if (fabsf(b) < 1e-6f)
+            {
+                return false;
+            }
+            float t = -c / b;
+            if (t > 0.0f)
+            {
+                outT = t;
+                return true;
+            }
+            return false;
+        }
+
+        float disc = b * b - 4.0f * a * c;
+        if (disc < 0.0f)
+        {
+            return false;
+        }
+
+        // 桁落ちしない形で 2 つの解を求める（(-b ± sqrtD) / 2a = q / a, c / q）
+        float sqrtD = std::sqrt(disc);
+        float q = -0.5f * (b + (b < 0.0f ? -sqrtD : sqrtD));
+        float t1 = q / a;
+        float t2 = (q != 0.0f) ? c / q : 0.0f;
+
+        float t = FLT_MAX;
+        if (t1 > 0.0f) t = std::min(t, t1);
+        if (t2 > 0.0f) t = std::min(t, t2);
+
+        if (t == FLT_MAX)
+        {
+            return false;
+        }
+
+        outT = t;
+        return true;
+    }
+}
+
+void HomingGuidance::SolveBatch(const HomingInput* inputs, HomingOutput* outputs, size_t count)
+{
+    const XMVECTOR vZero = XMVectorZero();
+    const XMVECTOR vOne = XMVectorReplicate(1.0f);
+    const XMVECTOR vNegOne = XMVectorReplicate(-1.0f);
+    const XMVECTOR vEps = XMVectorReplicate(1e-6f);
+    const XMVECTOR vSameSpeed = XMVectorReplicate(kSameSpeedRatio);
+    const XMVECTOR vAxisEps = XMVectorReplicate(1e-12f);
+    const XMVECTOR vFltMax = XMVectorReplicate(FLT_MAX);
+    const XMVECTOR vMinTime = XMVectorReplicate(0.001f);
+    const XMVECTOR vMinSpeed = XMVectorReplicate(1e-3f);
+    const XMVECTOR vPi = XMVectorReplicate(XM_PI);
+    const Vec3x4 unitZ = { vZero, vZero, vOne };
+
+    for (size_t base = 0; base < count; base += 4)
+    {
+        //--------------4 発分を SoA に並べる------------------
+        Vec3x4 pos = Gather3(inputs, base, count, [](const HomingInput& h) -> const Vector3& { return h.position; });
+        Vec3x4 dir = Gather3(inputs, base, count, [](const HomingInput& h) -> const Vector3& { return h.direction; });
+        Vec3x4 tgt = Gather3(inputs, base, count, [](const HomingInput& h) -> const Vector3& { return h.targetPosition; });
+        Vec3x4 tvel = Gather3(inputs, base, count, [](const HomingInput& h) -> const Vector3& { return h.targetVelocity; });
+        Vec3x4 bias = Gather3(inputs, base, count, [](const HomingInput& h) -> const Vector3& { return h.aimBias; });
+        XMVECTOR speed = Gather1(inputs, base, count, [](const HomingInput& h) { return h.speed; });
+        XMVECTOR maxTurn = Gather1(inputs, base, count, [](const HomingInput& h) { return h.maxTurn; });
+        XMVECTOR fallbackT = Gather1(inputs, base, count, [](const HomingInput& h) { return h.fallbackTime; });
+
+        dir = NormalizeOr(dir, unitZ, vEps);
+
+        //--------------迎撃時間（a t^2 + b t + c = 0）------------------
+        Vec3x4 rel = Sub(tgt, pos);
+        XMVECTOR vv = Dot(tvel, tvel);
+        XMVECTOR ss = XMVectorMultiply(speed, speed);
+        XMVECTOR a = XMVectorSubtract(vv, ss);
+        XMVECTOR b = XMVectorScale(Dot(rel, tvel), 2.0f);
+        XMVECTOR c = Dot(rel, rel);
+
+        XMVECTOR aTiny = XMVectorLess(XMVectorAbs(a), XMVectorMultiplyAdd(XMVectorAdd(vv, ss), vSameSpeed, vEps));
+        XMVECTOR bTiny = XMVectorLess(XMVectorAbs(b), vEps);
+
+        // a ≒ 0 : 一次方程式 t = -c / b
+        XMVECTOR safeB = XMVectorSelect(b, vOne, bTiny);
+        XMVECTOR tLinear = XMVectorDivide(XMVectorNegate(c), safeB);
+        XMVECTOR linearOk = XMVectorAndCInt(XMVectorGreater(tLinear, vZero), bTiny);
+
+        // 二次方程式：正の解のうち小さい方（桁落ちしない q / a, c / q の形）
+        XMVECTOR disc = XMVectorSubtract(XMVectorMultiply(b, b), XMVectorMultiply(XMVectorScale(a, 4.0f), c));
+        XMVECTOR sqrtD = XMVectorSqrt(XMVectorMax(disc, vZero));
+        XMVECTOR signedSqrtD = XMVectorSelect(sqrtD, XMVectorNegate(sqrtD), XMVectorLess(b, vZero));
+        XMVECTOR q = XMVectorScale(XMVectorAdd(b, signedSqrtD), -0.5f);
+        XMVECTOR qZero = XMVectorEqual(q, vZero);
+        XMVECTOR t1 = XMVectorDivide(q, XMVectorSelect(a, vOne, aTiny));
+        XMVECTOR t2 = XMVectorSelect(XMVectorDivide(c, XMVectorSelect(q, vOne, qZero)), vZero, qZero);
+        XMVECTOR tQuad = XMVectorMin(XMVectorSelect(vFltMax, t1, XMVectorGreater(t1, vZero)),
+                                     XMVectorSelect(vFltMax, t2, XMVectorGreater(t2, vZero)));
+        XMVECTOR quadOk = XMVectorAndInt(XMVectorGreaterOrEqual(disc, vZero), XMVectorLess(tQuad, vFltMax));
+
+        XMVECTOR tSolved = XMVectorSelect(tQuad, tLinear, aTiny);
+        XMVECTOR solved = XMVectorSelect(quadOk, linearOk, aTiny);
+        XMVECTOR t = XMVectorSelect(XMVectorMax(fallbackT, vMinTime), tSolved, solved);
+
+        //--------------迎撃方向 + 発射時のバイアス------------------
+        Vec3x4 desired = Sub(MulAdd(tgt, tvel, t), pos);
+        desired = Select(desired, dir, XMVectorLess(Dot(desired, desired), vEps));
+        desired = Add(desired, bias);
+        desired = NormalizeOr(desired, dir, vEps);
+
+        //--------------旋回制限------------------
+        // θ <= maxTurn は cosθ >= cos(maxTurn) と同じ（θ は 0..π なので maxTurn も π で頭打ち）
+        XMVECTOR turn = XMVectorClamp(maxTurn, vZero, vPi);
+        XMVECTOR sinT, cosT;
+        XMVectorSinCos(&sinT, &cosT, turn);
+
+        XMVECTOR dot = XMVectorClamp(Dot(dir, desired), vNegOne, vOne);
+        XMVECTOR reachable = XMVectorGreaterOrEqual(dot, cosT);
+
+        // Rodrigues の回転：軸 k は dir と直交するので v*cosθ + (k × v)*sinθ だけ残る
+        Vec3x4 axis = Cross(dir, desired);
+        XMVECTOR axisLen2 = Dot(axis, axis);
+        XMVECTOR degenerate = XMVectorLess(axisLen2, vAxisEps);
+        axis = Scale(axis, XMVectorReciprocalSqrt(XMVectorSelect(axisLen2, vOne, degenerate)));
+
+        Vec3x4 rotated = MulAdd(Scale(dir, cosT), Cross(axis, dir), sinT);
+        rotated = NormalizeOr(rotated, unitZ, vEps);
+
+        //ほぼ真後ろを向いているときは線形補間で少しだけ寄せる（まれなので該当するときだけ acos を使う）
+        XMVECTOR needLerp = XMVectorAndCInt(degenerate, reachable);
+        if (!XMVector4EqualInt(needLerp, XMVectorFalseInt()))
+        {
+            XMVECTOR theta = XMVectorACos(dot);
+            XMVECTOR alpha = XMVectorDivide(maxTurn, XMVectorAdd(theta, vEps));
+            Vec3x4 lerped = NormalizeOr(MulAdd(dir, Sub(desired, dir), alpha), unitZ, vEps);
+            rotated = Select(rotated, lerped, degenerate);
+        }
+
+        Vec3x4 newDir = Select(rotated, desired, reachable);
+        XMVECTOR newSpeed = XMVectorMax(speed, vMinSpeed);
+
+        //--------------書き出し------------------
+        XMFLOAT4A ox, oy, oz, os;
+        XMStoreFloat4A(&ox, newDir.x);
+        XMStoreFloat4A(&oy, newDir.y);
+        XMStoreFloat4A(&oz, newDir.z);
+        XMStoreFloat4A(&os, newSpeed);
+
+        const float* px = &ox.x;
+        const float* py = &oy.x;
+        const float* pz = &oz.x;
+        const float* ps = &os.x;
+        size_t lanes = std::min<size_t>(4, count - base);
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            outputs[base + l].direction = Vector3(px[l], py[l], pz[l]);
+            outputs[base + l].speed = ps[l];
+        }
+    }
+}
+
+void HomingGuidance::SolveScalar(const HomingInput& input, HomingOutput& output)
+{
+    Vector3 pos = input.position;
+    Vector3 dir = input.direction;
+    float speed = input.speed;
+
+    // フォールバックで dir がゼロに近いときは正規化可能な値を作る
+    if (dir.LengthSquared() < 1e-6f)
+    {
+        dir = Vector3::UnitZ;
+    }
+    else
+    {
+        dir.Normalize();
+    }
+
+    Vector3 targetPos = input.targetPosition;
+    Vector3 targetVel = input.targetVelocity;
+
+    // intercept time を計算（解析解）
+    Vector3 rel = targetPos - pos;
+    float tIntercept = 0.0f;
+    bool haveT = SolveInterceptTime(rel, targetVel, speed, tIntercept);
+
+    float t = 0.0f;
+    if (haveT)
+    {
+        t = tIntercept;
+    }
+    else
+    {
+        t = input.fallbackTime;
+        if (t < 0.001f)
+        {
+            t = 0.001f;
+        }
+    }
+
+    // 迎撃点（将来の目標位置）
+    Vector3 interceptPos = targetPos + targetVel * t;
+
+    // ---------- desiredVec（迎撃方向）計算 ----------
+    Vector3 desiredVec = interceptPos - pos;
+    if (desiredVec.LengthSquared() < 1e-6f)
+    {
+        // ほとんどその場にいるなら現在の向きを維持
+        desiredVec = dir;
+    }
+
+    // 発射時のランダムバイアス（強さは呼び出し側で掛けてある）
+    desiredVec = desiredVec + input.aimBias;
+
+    // 正規化（以降は方向ベクトルとして使う）
+    if (desiredVec.LengthSquared() < 1e-6f)
+    {
+        desiredVec = dir;
+    }
+    desiredVec.Normalize();
+
+    // ---------- 角度制限（1フレームあたりの回転上限） ----------
+    float maxTurnRad = input.maxTurn;
+
+    // 現在方向 dir と desiredVec の角度を求める（数値安全に clamp）
+    float dot = dir.Dot(desiredVec);
+    if (dot > 1.0f) { dot = 1.0f; }
+    if (dot < -1.0f) { dot = -1.0f; }
+    float theta = std::acos(dot); // 0..pi
+
+    Vector3 newDir;
+    if (theta <= maxTurnRad)
+    {
+        // 今フレーム内で到達可能なら直接 desiredVec を使う
+        newDir = desiredVec;
+    }
+    else
+    {
+        // Rodrigues の回転で dir を maxTurnRad だけ回転させる
+        Vector3 axis = dir.Cross(desiredVec);
+        float axisLen2 = axis.LengthSquared();
+        if (axisLen2 < 1e-12f)
+        {
+            // ほぼ同一直線上 or 逆向き。線形補間で少しだけ寄せる
+            float alpha = maxTurnRad / (theta + 1e-6f);
+            Vector3 tmp = dir + (desiredVec - dir) * alpha;
+            if (tmp.LengthSquared() < 1e-6f)
+            {
+                tmp = Vector3::UnitZ;
+            }
+            tmp.Normalize();
+            newDir = tmp;
+        }
+        else
+        {
+            axis.Normalize();
+            float cosT = std::cos(maxTurnRad);
+            float sinT = std::sin(maxTurnRad);
+
+            // Rodrigues' rotation: v_rot = v*cosθ + (k × v)*sinθ + k*(k·v)*(1 - cosθ)
+            Vector3 term1 = dir * cosT;
+            Vector3 term2 = axis.Cross(dir) * sinT;
+            Vector3 term3 = axis * (axis.Dot(dir) * (1.0f - cosT));
+            Vector3 rotated = term1 + term2 + term3;
+
+            if (rotated.LengthSquared() < 1e-6f)
+            {
+                rotated = Vector3::UnitZ;
+            }
+            rotated.Normalize();
+            newDir = rotated;
+        }
+    }
+
+    // 最低速度保証
+    output.direction = newDir;
+    output.speed = (speed < 1e-3f) ? 1e-3f : speed;
+}
@@ -51,4 +51,7 @@ public:
 	
 	//---------------V[ɂIuWFNgĂ֐------------------
 	virtual const std::vector<std::shared_ptr<GameObject>>& GetObjects() const = 0;
+
+	//---------------ߖTp̋ԃCfbNXiȂV[ nullptrj------------------
+	virtual const class SpatialIndex* GetSpatialIndex() const { return nullptr; }
 };
@@ -1,5 +1,6 @@
 #include "Input.h"
 #include "Application.h"
+#include "Logger.h"
 
 BYTE Input::m_CurrentKeys[256];
 BYTE Input::m_PreviousKeys[256];
@@ -25,7 +26,7 @@ void Input::Update()
     if (!GetKeyboardState(m_CurrentKeys))
     {
         // G[AOo͂Ȃ
-        OutputDebugStringA("L[Ă܂II\n");
+        LOG_WARN("L[Ă܂II");
     }
 
 
@@ -0,0 +1,78 @@
+﻿#include "InstanceBatch.h"
+#include <unordered_map>
+
+namespace
+{
+    //モデルリソースと LOD の組をまとめてハッシュのキーにする
+    struct BatchKey
+    {
+        const void* key;
+        uint32_t lod;
+        bool operator==(const BatchKey& o) const { return key == o.key && lod == o.lod; }
+    };
+
+    struct BatchKeyHash
+    {
+        size_t operator()(const BatchKey& k) const
+        {
+            return std::hash<const void*>()(k.key) * 31 + k.lod;
+        }
+    };
+}
+
+void BuildInstanceBatches(const std::vector<InstanceSubmission>& submissions,
+                          std::vector<InstanceBatch>& outBatches,
+                          std::vector<InstanceData>& outInstances)
+{
+    outBatches.clear();
+    outInstances.clear();
+
+    if (submissions.empty()) { return; }
+
+    //キー -> バッチ番号
+    std::unordered_map<BatchKey, size_t, BatchKeyHash> batchIndex;
+    batchIndex.reserve(16);
+
+    //1回目：キーごとのインスタンス数を数える
+    std::vector<size_t> submitToBatch(submissions.size());
+    for (size_t i = 0; i < submissions.size(); ++i)
+    {
+        BatchKey key{ submissions[i].key, submissions[i].lod };
+
+        auto it = batchIndex.find(key);
+        if (it == batchIndex.end())
+        {
+            it = batchIndex.emplace(key, outBatches.size()).first;
+
+            InstanceBatch batch;
+            batch.key = key.key;
+            batch.lod = key.lod;
+            outBatches.push_back(batch);
+        }
+
+        submitToBatch[i] = it->second;
+        outBatches[it->second].instanceCount++;
+    }
+
+    //2回目：各バッチの開始位置を決める
+    uint32_t offset = 0;
+    for (auto& batch : outBatches)
+    {
+        batch.firstInstance = offset;
+        offset += batch.instanceCount;
+    }
+
+    //3回目：バッチの並び順でインスタンスデータを書き込む
+    outInstances.resize(submissions.size());
+
+    std::vector<uint32_t> writePos(outBatches.size());
+    for (size_t b = 0; b < outBatches.size(); ++b)
+    {
+        writePos[b] = outBatches[b].firstInstance;
+    }
+
+    for (size_t i = 0; i < submissions.size(); ++i)
+    {
+        outInstances[writePos[submitToBatch[i]]++] = submissions[i].data;
+    }
+}
@@ -0,0 +1,43 @@
+﻿#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------
+// インスタンシング描画用の CPU 側データ
+// D3D・DirectXMath には触らないので、グループ分けとバッファへの詰め込みだけを単体で確認できる
+// （Tools/InstanceBatchCheck）
+//------------------------------------------------------------
+
+//1インスタンス分の GPU 転送データ
+//InstancedVertexShader.hlsl の INSTWORLD0～3 / INSTCOLOR と、Renderer の入力レイアウトのオフセットに並びを合わせること
+struct InstanceData
+{
+    float world[16];    //ワールド行列（XMFLOAT4X4 と同じ並び。転置しない行ベクトル形式のまま）
+    float color[4];     //インスタンスカラー
+};
+static_assert(offsetof(InstanceData, color) == 64 && sizeof(InstanceData) == 80, "入力レイアウトの INSTCOLOR のオフセットと合わない");
+
+//描画要求（1オブジェクト分）
+struct InstanceSubmission
+{
+    const void*  key = nullptr;  //モデルリソースの識別子（同じモデルなら同じ値）
+    uint32_t     lod = 0;        //描画する LOD（同じモデルでも LOD が違えば別のバッチ）
+    InstanceData data{};
+};
+
+//同じモデルリソースを参照するインスタンスのまとまり
+struct InstanceBatch
+{
+    const void* key = nullptr;      //モデルリソースの識別子
+    uint32_t lod = 0;               //LOD
+    uint32_t firstInstance = 0;     //インスタンスバッファ内の開始位置
+    uint32_t instanceCount = 0;     //インスタンス数
+};
+
+//描画要求をモデルリソースと LOD の組ごとにまとめ、インスタンスバッファにそのまま転送できる連続配列に詰める
+//・バッチの並びは各キーが最初に出てきた順
+//・バッチ内のインスタンスの並びは Submit された順
+void BuildInstanceBatches(const std::vector<InstanceSubmission>& submissions,
+                          std::vector<InstanceBatch>& outBatches,
+                          std::vector<InstanceData>& outInstances);
@@ -0,0 +1,148 @@
+﻿#include "InstancedModelRenderer.h"
+#include "renderer.h"
+#include "Logger.h"
+#include <cstring>
+
+std::vector<InstanceSubmission> InstancedModelRenderer::m_submissions;
+std::vector<InstanceBatch>      InstancedModelRenderer::m_batches;
+std::vector<InstanceData>       InstancedModelRenderer::m_instances;
+
+Microsoft::WRL::ComPtr<ID3D11Buffer> InstancedModelRenderer::m_instanceBuffer;
+size_t InstancedModelRenderer::m_capacity = 0;
+
+int InstancedModelRenderer::m_lastDrawCalls = 0;
+int InstancedModelRenderer::m_lastInstances = 0;
+int InstancedModelRenderer::m_lastTriangles = 0;
+
+void InstancedModelRenderer::Submit(const ModelComponent::ModelData* model, int lod, const Matrix4x4& world, const Color& color)
+{
+    if (!model) { return; }
+
+    InstanceSubmission s;
+    s.key = model;
+    s.lod = static_cast<uint32_t>(lod);
+    std::memcpy(s.data.world, &world, sizeof(s.data.world));   // SimpleMath::Matrix の 16 要素をそのまま（転置はシェーダー側の並びに合わせて不要）
+    s.data.color[0] = color.x;
+    s.data.color[1] = color.y;
+    s.data.color[2] = color.z;
+    s.data.color[3] = color.w;
+    m_submissions.push_back(s);
+}
+
+bool InstancedModelRenderer::EnsureCapacity(size_t instanceCount)
+{
+    if (m_instanceBuffer && instanceCount <= m_capacity) { return true; }
+
+    // 足りない場合は倍々で確保し直す（毎フレームの作り直しを避ける）
+    size_t newCapacity = (m_capacity > 0) ? m_capacity : 256;
+    while (newCapacity < instanceCount) { newCapacity *= 2; }
+
+    D3D11_BUFFER_DESC desc{};
+    desc.ByteWidth = static_cast<UINT>(sizeof(InstanceData) * newCapacity);
+    desc.Usage = D3D11_USAGE_DYNAMIC;
+    desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    HRESULT hr = Renderer::GetDevice()->CreateBuffer(&desc, nullptr, buffer.GetAddressOf());
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[InstancedModelRenderer] Failed to create instance buffer");
+        return false;
+    }
+
+    m_instanceBuffer = buffer;
+    m_capacity = newCapacity;
+    return true;
+}
+
+void InstancedModelRenderer::Flush()
+{
+    m_lastDrawCalls = 0;
+    m_lastInstances = 0;
+    m_lastTriangles = 0;
+
+    if (m_submissions.empty()) { return; }
+
+    // モデルごとにまとめてインスタンスデータを詰める
+    BuildInstanceBatches(m_submissions, m_batches, m_instances);
+    m_submissions.clear();
+
+    if (!EnsureCapacity(m_instances.size())) { return; }
+
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+
+    // インスタンスバッファへ転送（1フレーム1回）
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    if (FAILED(ctx->Map(m_instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) { return; }
+    std::memcpy(mapped.pData, m_instances.data(), sizeof(InstanceData) * m_instances.size());
+    ctx->Unmap(m_instanceBuffer.Get(), 0);
+
+    // 呼び出し元が設定していたシェーダー／レイアウトは最後に戻す
+    Microsoft::WRL::ComPtr<ID3D11InputLayout> prevLayout;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> prevVS;
+    Microsoft::WRL::ComPtr<ID3D11PixelShader> prevPS;
+    ctx->IAGetInputLayout(prevLayout.GetAddressOf());
+    ctx->VSGetShader(prevVS.GetAddressOf(), nullptr, nullptr);
+    ctx->PSGetShader(prevPS.GetAddressOf(), nullptr, nullptr);
+
+    ctx->IASetInputLayout(Renderer::m_instancedInputLayout.Get());
+    ctx->VSSetShader(Renderer::m_instancedVertexShader.Get(), nullptr, 0);
+    ctx->PSSetShader(Renderer::m_pixelShader.Get(), nullptr, 0);
+    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    UINT instStride = sizeof(InstanceData);
+    UINT instOffset = 0;
+    ctx->IASetVertexBuffers(1, 1, m_instanceBuffer.GetAddressOf(), &instStride, &instOffset);
+
+    for (const auto& batch : m_batches)
+    {
+        const auto* model = static_cast<const ModelComponent::ModelData*>(batch.key);
+
+        for (const auto& mesh : model->meshes)
+        {
+            MATERIAL cb;
+            cb.Diffuse = DirectX::XMFLOAT4(
+                mesh.material.Diffuse.x,
+                mesh.material.Diffuse.y,
+                mesh.material.Diffuse.z,
+                mesh.material.Diffuse.w
+            );
+            Renderer::SetMaterial(cb);
+
+            mesh.BindVertexStreams(ctx);
+            ctx->IASetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat, 0);
+
+            if (mesh.srvDiffuse)
+            {
+                ID3D11ShaderResourceView* srv = mesh.srvDiffuse.get();
+                ctx->PSSetShaderResources(0, 1, &srv);
+            }
+
+            const ModelComponent::MeshData::LodRange& range = mesh.GetLod(static_cast<int>(batch.lod));
+            ctx->DrawIndexedInstanced(range.indexCount, batch.instanceCount, range.indexStart, 0, batch.firstInstance);
+            m_lastDrawCalls++;
+            m_lastTriangles += static_cast<int>(range.indexCount / 3 * batch.instanceCount);
+        }
+
+        m_lastInstances += static_cast<int>(batch.instanceCount);
+    }
+
+    // 後続の通常描画のために元のシェーダー／レイアウトへ戻す
+    ID3D11Buffer* nullBuffer = nullptr;
+    UINT zero = 0;
+    ctx->IASetVertexBuffers(1, 1, &nullBuffer, &zero, &zero);
+    ctx->IASetVertexBuffers(2, 1, &nullBuffer, &zero, &zero);
+    ctx->IASetInputLayout(prevLayout.Get());
+    ctx->VSSetShader(prevVS.Get(), nullptr, 0);
+    ctx->PSSetShader(prevPS.Get(), nullptr, 0);
+}
+
+void InstancedModelRenderer::Uninit()
+{
+    m_submissions.clear();
+    m_batches.clear();
+    m_instances.clear();
+    m_instanceBuffer.Reset();
+    m_capacity = 0;
+}
@@ -0,0 +1,45 @@
+﻿#pragma once
+#include <vector>
+#include <d3d11.h>
+#include <wrl/client.h>
+#include "InstanceBatch.h"
+#include "ModelComponent.h"
+
+//------------------------------------------------------------
+// 同じモデルを使うオブジェクトをまとめて DrawIndexedInstanced で描画するクラス
+// ModelComponent::Draw() から Submit() で描画要求を積み、
+// シーンの 3D 描画の最後に Flush() で一括描画する
+//------------------------------------------------------------
+class InstancedModelRenderer
+{
+public:
+    //描画要求を積む
+    static void Submit(const ModelComponent::ModelData* model, int lod, const Matrix4x4& world, const Color& color);
+
+    //積まれた描画要求をモデルごとにまとめて描画し、要求をクリアする
+    //入力レイアウト・頂点シェーダー・ピクセルシェーダーは呼び出し前のものに戻す（マテリアルの定数は最後のメッシュのまま）
+    static void Flush();
+
+    //インスタンスバッファの解放
+    static void Uninit();
+
+    //直前の Flush() で発行したドローコール数 / インスタンス数 / 三角形数（デバッグ表示用）
+    static int GetLastDrawCallCount() { return m_lastDrawCalls; }
+    static int GetLastInstanceCount() { return m_lastInstances; }
+    static int GetLastTriangleCount() { return m_lastTriangles; }
+
+private:
+    //インスタンスバッファの容量が足りなければ作り直す
+    static bool EnsureCapacity(size_t instanceCount);
+
+    static std::vector<InstanceSubmission> m_submissions;
+    static std::vector<InstanceBatch>      m_batches;
+    static std::vector<InstanceData>       m_instances;
+
+    static Microsoft::WRL::ComPtr<ID3D11Buffer> m_instanceBuffer;
+    static size_t m_capacity;
+
+    static int m_lastDrawCalls;
+    static int m_lastInstances;
+    static int m_lastTriangles;
+};
@@ -0,0 +1,60 @@
+// VS ̓
+struct VSInput
+{
+    // _Ƃ̃f[^ik_BBasicVertexShader.hlsl  VSPackedInput Ɠj
+    float3 pos      : POSITION;
+    float4 col      : COLOR;
+    float2 normal   : NORMAL;   // ʑ̎ʑ
+    float2 texcoord : TEXCOORD;
+
+    // CX^XƂ̃f[^iInstanceData ƕт킹j
+    float4 world0   : INSTWORLD0;
+    float4 world1   : INSTWORLD1;
+    float4 world2   : INSTWORLD2;
+    float4 world3   : INSTWORLD3;
+    float4 instCol  : INSTCOLOR;
+};
+
+// VS  PS ւ̏o
+struct VSOutput
+{
+    float4 posH     : SV_POSITION;
+    float4 col      : COLOR;
+    float3 normal   : NORMAL;
+    float2 texcoord : TEXCOORD;
+};
+
+cbuffer ViewBuffer : register(b1)
+{
+    matrix gView;
+}
+cbuffer ProjBuffer : register(b2)
+{
+    matrix gProj;
+}
+
+// ʑ̎ʑ̖@߂iBasicVertexShader.hlsl Ɠj
+float3 DecodeOctahedral(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+VSOutput VSMain(VSInput vin)
+{
+    VSOutput output;
+
+    // CX^Xobt@̍ŝ܂ܕׂă[hsɂ
+    float4x4 world = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+
+    float4 worldPos = mul(float4(vin.pos, 1), world);
+    float4 viewPos = mul(worldPos, gView);
+    output.posH = mul(viewPos, gProj);
+
+    output.col = vin.col * vin.instCol;
+    output.normal = normalize(mul(DecodeOctahedral(vin.normal), (float3x3) world)); // [hԖ@
+    output.texcoord = vin.texcoord;
+    return output;
+}
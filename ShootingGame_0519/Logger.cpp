@@ -0,0 +1,259 @@
+﻿#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <Windows.h>
+
+std::atomic<Logger::Ring*> Logger::m_rings{ nullptr };
+std::thread Logger::m_thread;
+std::atomic<bool> Logger::m_running{ false };
+std::atomic<uint64_t> Logger::m_dropped{ 0 };
+
+namespace
+{
+    int64_t NowMilliseconds()
+    {
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    const char* LevelName(Logger::Level level)
+    {
+        switch (level)
+        {
+        case Logger::Level::Debug: return "DEBUG";
+        case Logger::Level::Info:  return "INFO";
+        case Logger::Level::Warn:  return "WARN";
+        case Logger::Level::Error: return "ERROR";
+        }
+        return "?";
+    }
+
+    //__FILE__ のフルパスからファイル名だけを取り出す
+    const char* FileName(const char* path)
+    {
+        if (!path) { return ""; }
+        const char* name = path;
+        for (const char* p = path; *p; ++p)
+        {
+            if (*p == '\\' || *p == '/') { name = p + 1; }
+        }
+        return name;
+    }
+}
+
+bool LogRateLimiter::Allow()
+{
+    if (m_maxPerSecond <= 0) { return true; }
+
+    //1秒ごとに窓をリセット
+    int64_t now = NowMilliseconds();
+    int64_t start = m_windowStart.load(std::memory_order_relaxed);
+    if (now - start >= 1000)
+    {
+        if (m_windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+        {
+            m_count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    if (m_count.fetch_add(1, std::memory_order_relaxed) < m_maxPerSecond)
+    {
+        return true;
+    }
+
+    m_suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::Init()
+{
+    if (m_running.exchange(true)) { return; }
+    m_thread = std::thread(&Logger::ThreadMain);
+}
+
+void Logger::Uninit()
+{
+    if (m_running.exchange(false) && m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    //スレッド停止後に残った分を書き出す
+    Drain();
+}
+
+void Logger::Flush()
+{
+    if (!m_running.load())
+    {
+        Drain();
+        return;
+    }
+
+    //ログスレッドが全リングを読み切るまで待つ
+    for (;;)
+    {
+        bool empty = true;
+        for (Ring* ring = m_rings.load(std::memory_order_acquire); ring; ring = ring->next)
+        {
+            if (ring->head.load(std::memory_order_acquire) != ring->tail.load(std::memory_order_acquire))
+            {
+                empty = false;
+                break;
+            }
+        }
+        if (empty) { return; }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+Logger::Ring* Logger::GetThreadRing()
+{
+    thread_local Ring* t_ring = nullptr;
+    if (t_ring) { return t_ring; }
+
+    //このスレッド用のリングを作ってリストの先頭に繋ぐ
+    Ring* ring = new Ring();
+    Ring* head = m_rings.load(std::memory_order_relaxed);
+    do
+    {
+        ring->next = head;
+    } while (!m_rings.compare_exchange_weak(head, ring, std::memory_order_release, std::memory_order_relaxed));
+
+    t_ring = ring;
+    return t_ring;
+}
+
+void Logger::Push(const Record& rec)
+{
+    Ring* ring = GetThreadRing();
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    uint32_t tail = ring->tail.load(std::memory_order_acquire);
+
+    //一杯なら捨てる（書き込み側は決して待たない）
+    if (head - tail >= kRingSize)
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->records[head & (kRingSize - 1)] = rec;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void Logger::WriteLines(Level level, const char* file, int line, LogRateLimiter& limiter, const char* text, size_t length)
+{
+    if (!text || !limiter.Allow()) { return; }
+
+    int suppressed = limiter.m_suppressed.exchange(0, std::memory_order_relaxed);
+
+    //ID3DBlob などは終端の '\0' までサイズに含むので、そこで止める
+    const char* p = text;
+    const char* end = text + strnlen(text, length);
+    while (p < end)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) { eol = end; }
+
+        size_t n = eol - p;
+        if (n > 0 && p[n - 1] == '\r') { --n; }
+        if (n > 0)
+        {
+            char buf[kStringBytes];
+            n = (std::min)(n, kStringBytes - 1);
+            std::memcpy(buf, p, n);
+            buf[n] = '\0';
+
+            Record rec;
+            rec.level = level;
+            rec.file = file;
+            rec.line = line;
+            rec.fmt = "%s";
+            rec.suppressed = suppressed;
+            rec.format = &FormatThunk<const char*>;
+            suppressed = 0;
+
+            size_t offset = 0;
+            size_t stringOffset = 0;
+            rec.strings[kStringBytes - 1] = '\0';
+            PackArg(rec, offset, stringOffset, static_cast<const char*>(buf));
+            Push(rec);
+        }
+        p = eol + 1;
+    }
+}
+
+bool Logger::Drain()
+{
+    bool any = false;
+
+    for (Ring* ring = m_rings.load(std::memory_order_acquire); ring; ring = ring->next)
+    {
+        uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint32_t head = ring->head.load(std::memory_order_acquire);
+
+        while (tail != head)
+        {
+            Output(ring->records[tail & (kRingSize - 1)]);
+            ++tail;
+            any = true;
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    return any;
+}
+
+void Logger::Output(const Record& rec)
+{
+    char message[512];
+    if (rec.format)
+    {
+        rec.format(message, sizeof(message), rec.fmt, rec.args, rec.strings);
+    }
+    else
+    {
+        message[0] = '\0';
+    }
+
+    char line[768];
+    if (rec.suppressed > 0)
+    {
+        sprintf_s(line, "[%s] %s (%s:%d) (+%d suppressed)\n",
+            LevelName(rec.level), message, FileName(rec.file), rec.line, rec.suppressed);
+    }
+    else
+    {
+        sprintf_s(line, "[%s] %s (%s:%d)\n",
+            LevelName(rec.level), message, FileName(rec.file), rec.line);
+    }
+
+    OutputDebugStringA(line);
+    std::fputs(line, stdout);
+}
+
+void Logger::ThreadMain()
+{
+    uint64_t reportedDrops = 0;
+
+    while (m_running.load())
+    {
+        if (!Drain())
+        {
+            //書くものが無ければ少し休む
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+
+        uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops)
+        {
+            char buf[128];
+            sprintf_s(buf, "[Logger] ring buffer full, dropped %llu message(s)\n",
+                static_cast<unsigned long long>(dropped - reportedDrops));
+            OutputDebugStringA(buf);
+            reportedDrops = dropped;
+        }
+    }
+}
@@ -0,0 +1,247 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+//------------------------------------------------------------
+// 非同期ロガー
+// ・呼び出し側はフォーマットせず、書式文字列と引数の生データをスレッドごとのリングバッファに積むだけ
+// ・フォーマットと出力（コンソール / OutputDebugStringA）はバックグラウンドスレッドで行う
+// ・LOG_COMPILE_LEVEL 未満のログはマクロごと消えるので、Release では実行コストが残らない
+// ・呼び出し箇所ごとに1秒あたりの出力数を制限する（毎フレーム呼ばれても流れ続けない）
+//
+// 注意：引数は値としてコピーされ、後でフォーマットされる。
+//       文字列（const char*）は中身をレコードにコピーするので std::string::c_str() もそのまま渡してよい
+//       （1 件あたり合計 kStringBytes まで。超えた分は切り詰める）
+//------------------------------------------------------------
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF   4
+
+//コンパイル時に残すログの最低レベル
+#ifndef LOG_COMPILE_LEVEL
+#if defined(DEBUG) || defined(_DEBUG)
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#else
+#define LOG_COMPILE_LEVEL LOG_LEVEL_WARN
+#endif
+#endif
+
+//呼び出し箇所ごとの出力数制限
+struct LogRateLimiter
+{
+    explicit LogRateLimiter(int maxPerSecond) : m_maxPerSecond(maxPerSecond) {}
+
+    //出力してよいなら true（抑制した数は m_suppressed に溜まる）
+    bool Allow();
+
+    const int m_maxPerSecond;
+    std::atomic<int64_t> m_windowStart{ 0 };
+    std::atomic<int> m_count{ 0 };
+    std::atomic<int> m_suppressed{ 0 };
+};
+
+class Logger
+{
+public:
+    enum class Level : uint8_t { Debug = 0, Info, Warn, Error };
+
+    //1件あたりの引数領域（これを超える引数はコンパイルエラー）
+    static constexpr size_t kArgBytes = 96;
+
+    //1件あたりの文字列引数のコピー領域（終端を含む合計）
+    static constexpr size_t kStringBytes = 128;
+
+    //スレッドごとのリングバッファの件数（2のべき乗）
+    static constexpr uint32_t kRingSize = 1024;
+
+    //バックグラウンドスレッドの開始 / 停止（停止時は残りを全部書き出す）
+    static void Init();
+    static void Uninit();
+
+    //積まれたログが書き出されるまで待つ（ログスレッドが動いていなければ呼び出しスレッドで書き出す）
+    static void Flush();
+
+    //リングバッファが一杯で捨てた件数
+    static uint64_t GetDroppedCount() { return m_dropped.load(std::memory_order_relaxed); }
+
+    template<typename... Args>
+    static void Write(Level level, const char* file, int line, LogRateLimiter& limiter, const char* fmt, Args... args)
+    {
+        static_assert((std::is_trivially_copyable_v<Args> && ...), "ログの引数はコピー可能な値のみ");
+        static_assert((sizeof(Args) + ... + 0) <= kArgBytes, "ログの引数が多すぎます");
+
+        if (!limiter.Allow()) { return; }
+
+        Record rec;
+        rec.level = level;
+        rec.file = file;
+        rec.line = line;
+        rec.fmt = fmt;
+        rec.suppressed = limiter.m_suppressed.exchange(0, std::memory_order_relaxed);
+        rec.format = &FormatThunk<Args...>;
+
+        //引数を先頭から順に詰める（文字列は中身を strings にコピーし、引数には strings 内の位置を入れる）
+        size_t offset = 0;
+        size_t stringOffset = 0;
+        rec.strings[kStringBytes - 1] = '\0';
+        (PackArg(rec, offset, stringOffset, args), ...);
+
+        Push(rec);
+    }
+
+    //複数行のテキスト（シェーダのコンパイルエラーなど）を1行1件で積む
+    //各行は kStringBytes までに切り詰める。出力数の制限は呼び出し1回を1件として数える
+    static void WriteLines(Level level, const char* file, int line, LogRateLimiter& limiter, const char* text, size_t length);
+
+private:
+    using FormatFunc = int(*)(char* out, size_t size, const char* fmt, const unsigned char* args, const char* strings);
+
+    //リングバッファに積む1件分（フォーマット前の生データ）
+    struct Record
+    {
+        Level level = Level::Info;
+        int line = 0;
+        int suppressed = 0;
+        const char* file = nullptr;
+        const char* fmt = nullptr;
+        FormatFunc format = nullptr;
+        alignas(16) unsigned char args[kArgBytes];
+        char strings[kStringBytes];
+    };
+
+    //単一生産者（書き込むスレッド）・単一消費者（ログスレッド）のロックフリーリング
+    struct Ring
+    {
+        Record records[kRingSize];
+        std::atomic<uint32_t> head{ 0 };   //次に書く位置（生産者だけが進める）
+        std::atomic<uint32_t> tail{ 0 };   //次に読む位置（消費者だけが進める）
+        Ring* next = nullptr;
+    };
+
+    template<typename T>
+    static constexpr bool IsStringArg = std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+    template<typename T>
+    static void PackArg(Record& rec, size_t& offset, size_t& stringOffset, T value)
+    {
+        if constexpr (IsStringArg<T>)
+        {
+            //入りきらない分は切り詰める（空きが無ければ領域末尾の終端を指す）
+            const char* s = value ? value : "(null)";
+            uintptr_t pos = kStringBytes - 1;
+            if (stringOffset < kStringBytes - 1)
+            {
+                size_t len = strnlen(s, kStringBytes - 1 - stringOffset);
+                std::memcpy(rec.strings + stringOffset, s, len);
+                rec.strings[stringOffset + len] = '\0';
+                pos = stringOffset;
+                stringOffset += len + 1;
+            }
+            std::memcpy(rec.args + offset, &pos, sizeof(pos));
+        }
+        else
+        {
+            std::memcpy(rec.args + offset, &value, sizeof(T));
+        }
+        offset += sizeof(T);
+    }
+
+    template<typename T>
+    static T ReadArg(const unsigned char* args, size_t& offset, const char* strings)
+    {
+        if constexpr (IsStringArg<T>)
+        {
+            uintptr_t pos;
+            std::memcpy(&pos, args + offset, sizeof(pos));
+            offset += sizeof(T);
+            return const_cast<T>(strings + pos);
+        }
+        else
+        {
+            T value;
+            std::memcpy(&value, args + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+    }
+
+    //ログスレッド側で引数を取り出してフォーマットする
+    template<typename... Args>
+    static int FormatThunk(char* out, size_t size, const char* fmt, const unsigned char* args, const char* strings)
+    {
+        size_t offset = 0;
+        std::tuple<Args...> pack{ ReadArg<Args>(args, offset, strings)... };  // {} 内は左から順に評価される
+        (void)offset;
+        return std::apply([&](auto... a) { return std::snprintf(out, size, fmt, a...); }, pack);
+    }
+
+    static void Push(const Record& rec);
+    static Ring* GetThreadRing();
+    static bool Drain();
+    static void Output(const Record& rec);
+    static void ThreadMain();
+
+    //登録済みリングの単方向リスト（追加のみ。スレッド終了後も解放しない）
+    static std::atomic<Ring*> m_rings;
+    static std::thread m_thread;
+    static std::atomic<bool> m_running;
+    static std::atomic<uint64_t> m_dropped;
+};
+
+//------------------------------------------------------------
+// ログマクロ
+// 例）LOG_WARN("BuildingSpawner failed to place building %d", i);
+//------------------------------------------------------------
+#define LOG_IMPL(level, maxPerSecond, ...)                                     \
+    do {                                                                       \
+        static LogRateLimiter s_logLimiter_(maxPerSecond);                     \
+        Logger::Write(level, __FILE__, __LINE__, s_logLimiter_, __VA_ARGS__);  \
+    } while (0)
+
+//呼び出し箇所ごとの1秒あたりの上限（指定しない場合）
+#define LOG_DEFAULT_RATE 10
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_IMPL(Logger::Level::Debug, LOG_DEFAULT_RATE, __VA_ARGS__)
+#define LOG_DEBUG_RATE(maxPerSecond, ...) LOG_IMPL(Logger::Level::Debug, maxPerSecond, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#define LOG_DEBUG_RATE(maxPerSecond, ...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_IMPL(Logger::Level::Info, LOG_DEFAULT_RATE, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_IMPL(Logger::Level::Warn, LOG_DEFAULT_RATE, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_IMPL(Logger::Level::Error, LOG_DEFAULT_RATE, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+//複数行のテキストを Error で1行ずつ出す（例：LOG_ERROR_LINES(blob->GetBufferPointer(), blob->GetBufferSize());）
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR_LINES(text, length)                                                                          \
+    do {                                                                                                       \
+        static LogRateLimiter s_logLimiter_(LOG_DEFAULT_RATE);                                                 \
+        Logger::WriteLines(Logger::Level::Error, __FILE__, __LINE__, s_logLimiter_, static_cast<const char*>(text), (length)); \
+    } while (0)
+#else
+#define LOG_ERROR_LINES(text, length) ((void)0)
+#endif
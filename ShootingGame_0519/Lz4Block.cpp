@@ -0,0 +1,144 @@
+﻿#include "Lz4Block.h"
+#include <cstring>
+
+namespace
+{
+    constexpr size_t kMinMatch = 4;
+    constexpr size_t kLastLiterals = 5;     //ブロックの最後の 5 バイトは必ずリテラル
+    constexpr size_t kMatchStartLimit = 12; //最後の一致はブロックの終わりから 12 バイトより前で始まる
+    constexpr size_t kMaxOffset = 65535;
+    constexpr int kHashBits = 16;
+
+    uint32_t Read32(const uint8_t* p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    uint32_t Hash(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - kHashBits);
+    }
+
+    //15 以上の長さは 255 を並べた後に残りを書く
+    void WriteLength(std::vector<uint8_t>& dst, size_t length)
+    {
+        while (length >= 255)
+        {
+            dst.push_back(255);
+            length -= 255;
+        }
+        dst.push_back(static_cast<uint8_t>(length));
+    }
+
+    //リテラル列と、続く一致（matchLength が 0 なら最後のリテラルだけ）を 1 つのシーケンスとして書く
+    void WriteSequence(std::vector<uint8_t>& dst, const uint8_t* literals, size_t literalLength,
+                       size_t offset, size_t matchLength)
+    {
+        const size_t matchCode = matchLength > 0 ? matchLength - kMinMatch : 0;
+        const uint8_t token = static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                                   (matchCode < 15 ? matchCode : 15));
+        dst.push_back(token);
+        if (literalLength >= 15) { WriteLength(dst, literalLength - 15); }
+        dst.insert(dst.end(), literals, literals + literalLength);
+
+        if (matchLength == 0) { return; }
+        dst.push_back(static_cast<uint8_t>(offset & 0xFF));
+        dst.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) { WriteLength(dst, matchCode - 15); }
+    }
+
+    //長さの続き（255 が続く間は足していく）。入力の終わりを超えたら false
+    bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+    {
+        uint8_t b;
+        do
+        {
+            if (ip >= end) { return false; }
+            b = *ip++;
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+}
+
+size_t Lz4CompressBlock(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst)
+{
+    dst.clear();
+    dst.reserve(srcSize + srcSize / 255 + 16);
+
+    size_t anchor = 0;
+    if (srcSize > kMatchStartLimit)
+    {
+        //位置 + 1 を入れる（0 は空き）
+        std::vector<uint32_t> table(size_t(1) << kHashBits, 0);
+        const size_t matchLimit = srcSize - kLastLiterals;
+        const size_t startLimit = srcSize - kMatchStartLimit;
+
+        size_t ip = 0;
+        while (ip < startLimit)
+        {
+            const uint32_t sequence = Read32(src + ip);
+            uint32_t& slot = table[Hash(sequence)];
+            const size_t candidate = slot;
+            slot = static_cast<uint32_t>(ip + 1);
+
+            if (candidate == 0 || ip - (candidate - 1) > kMaxOffset || Read32(src + candidate - 1) != sequence)
+            {
+                ++ip;
+                continue;
+            }
+
+            const size_t ref = candidate - 1;
+            size_t length = kMinMatch;
+            while (ip + length < matchLimit && src[ref + length] == src[ip + length]) { ++length; }
+
+            WriteSequence(dst, src + anchor, ip - anchor, ip - ref, length);
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    WriteSequence(dst, src + anchor, srcSize - anchor, 0, 0);
+    return dst.size();
+}
+
+bool Lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    const uint8_t* ip = src;
+    const uint8_t* const end = src + srcSize;
+    size_t op = 0;
+
+    while (ip < end)
+    {
+        const uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(ip, end, literalLength)) { return false; }
+        if (literalLength > static_cast<size_t>(end - ip) || literalLength > dstSize - op) { return false; }
+        if (literalLength > 0) { std::memcpy(dst + op, ip, literalLength); }
+        ip += literalLength;
+        op += literalLength;
+
+        //最後のシーケンスはリテラルだけで終わる
+        if (ip == end) { break; }
+
+        if (end - ip < 2) { return false; }
+        const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) { return false; }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(ip, end, matchLength)) { return false; }
+        matchLength += kMinMatch;
+        if (matchLength > dstSize - op) { return false; }
+
+        //重なる（offset < 長さ）ことがあるので 1 バイトずつ写す
+        const uint8_t* match = dst + op - offset;
+        for (size_t i = 0; i < matchLength; ++i) { dst[op + i] = match[i]; }
+        op += matchLength;
+    }
+
+    return op == dstSize;
+}
@@ -0,0 +1,17 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------
+// LZ4 のブロック形式（フレームヘッダ無し）の圧縮・展開
+// ・展開は AssetArchive が圧縮エントリを読むときに使う（入力・出力とも範囲を確かめるので壊れたデータでも外に書かない）
+// ・圧縮は Tools/AssetPacker が使う。ハッシュ 1 段の貪欲法で、速さより単純さを取っている
+// 形式は公式の LZ4 と同じなので、lz4 コマンドで作ったブロックも展開できる
+//------------------------------------------------------------
+
+//src を圧縮して dst に書く（dst は作り直す）。圧縮後のバイト数を返す
+size_t Lz4CompressBlock(const uint8_t* src, size_t srcSize, std::vector<uint8_t>& dst);
+
+//src を展開して dst にちょうど dstSize バイト書く。形式が壊れている・大きさが合わなければ false
+bool Lz4DecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
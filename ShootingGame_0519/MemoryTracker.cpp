@@ -0,0 +1,368 @@
+﻿#include "MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+int64_t MemoryTracker::m_cpuBudget[kMemoryCategoryCount] = {};
+int64_t MemoryTracker::m_gpuBudget[kMemoryCategoryCount] = {};
+bool MemoryTracker::m_cpuOver[kMemoryCategoryCount] = {};
+bool MemoryTracker::m_gpuOver[kMemoryCategoryCount] = {};
+
+std::unordered_map<std::string, MemorySnapshot> MemoryTracker::m_sceneEntries;
+MemorySnapshot MemoryTracker::m_currentEntry;
+bool MemoryTracker::m_hasCurrentEntry = false;
+
+namespace
+{
+    //静的初期化より前の new からも使われるので、定数で初期化できるものだけを置く
+    std::atomic<int64_t> g_cpuBytes[kMemoryCategoryCount] = {};
+    std::atomic<int64_t> g_cpuAllocations[kMemoryCategoryCount] = {};
+    std::atomic<int64_t> g_gpuBytes[kMemoryCategoryCount] = {};
+
+    thread_local MemoryCategory t_category = MemoryCategory::Other;
+
+    const char* const kCategoryNames[kMemoryCategoryCount] =
+    {
+        "Other", "Renderer", "Texture", "Model", "Sound", "Effect", "Scene",
+    };
+
+    size_t Index(MemoryCategory category)
+    {
+        size_t i = static_cast<size_t>(category);
+        return i < kMemoryCategoryCount ? i : 0;
+    }
+
+    //KB 単位（切り捨てで 0 にならないよう 1 KB 未満は小数で出す）
+    std::string FormatKB(int64_t bytes, bool sign)
+    {
+        char text[32];
+        double kb = static_cast<double>(bytes) / 1024.0;
+        std::snprintf(text, sizeof(text), sign ? "%+.1f" : "%.1f", kb);
+        return text;
+    }
+}
+
+#if MEMORY_TRACKING
+namespace
+{
+    //ブロックの先頭に置く情報（16 バイトにして new の既定のアライメントを保つ）
+    struct alignas(16) AllocationHeader
+    {
+        uint64_t size;
+        uint64_t category;
+    };
+
+    void* TrackedAlloc(size_t size) noexcept
+    {
+        auto* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+        if (!header) { return nullptr; }
+
+        size_t index = Index(t_category);
+        header->size = size;
+        header->category = index;
+        g_cpuBytes[index].fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        g_cpuAllocations[index].fetch_add(1, std::memory_order_relaxed);
+        return header + 1;
+    }
+
+    void TrackedFree(void* p) noexcept
+    {
+        if (!p) { return; }
+
+        auto* header = static_cast<AllocationHeader*>(p) - 1;
+        size_t index = static_cast<size_t>(header->category);
+        g_cpuBytes[index].fetch_sub(static_cast<int64_t>(header->size), std::memory_order_relaxed);
+        g_cpuAllocations[index].fetch_sub(1, std::memory_order_relaxed);
+        std::free(header);
+    }
+}
+
+//アライメント指定付きの new（align_val_t）は既定の実装のまま（数えない）
+void* operator new(size_t size)
+{
+    for (;;)
+    {
+        if (void* p = TrackedAlloc(size == 0 ? 1 : size)) { return p; }
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) { throw std::bad_alloc(); }
+        handler();
+    }
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try { return operator new(size); }
+    catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    try { return operator new(size); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+#endif
+
+const char* GetMemoryCategoryName(MemoryCategory category)
+{
+    return kCategoryNames[Index(category)];
+}
+
+MemoryScope::MemoryScope(MemoryCategory category)
+    : m_previous(t_category)
+{
+    t_category = category;
+}
+
+MemoryScope::~MemoryScope()
+{
+    t_category = m_previous;
+}
+
+int64_t MemorySnapshot::TotalCpu() const
+{
+    int64_t total = 0;
+    for (int64_t v : cpuBytes) { total += v; }
+    return total;
+}
+
+int64_t MemorySnapshot::TotalGpu() const
+{
+    int64_t total = 0;
+    for (int64_t v : gpuBytes) { total += v; }
+    return total;
+}
+
+int64_t MemoryDiff::TotalCpu() const
+{
+    int64_t total = 0;
+    for (int64_t v : cpuBytes) { total += v; }
+    return total;
+}
+
+int64_t MemoryDiff::TotalGpu() const
+{
+    int64_t total = 0;
+    for (int64_t v : gpuBytes) { total += v; }
+    return total;
+}
+
+MemoryCategory MemoryTracker::GetCurrentCategory()
+{
+    return t_category;
+}
+
+void MemoryTracker::AddGpuBytes(MemoryCategory category, int64_t bytes)
+{
+    g_gpuBytes[Index(category)].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+int64_t MemoryTracker::GetCpuBytes(MemoryCategory category)
+{
+    return g_cpuBytes[Index(category)].load(std::memory_order_relaxed);
+}
+
+int64_t MemoryTracker::GetCpuAllocations(MemoryCategory category)
+{
+    return g_cpuAllocations[Index(category)].load(std::memory_order_relaxed);
+}
+
+int64_t MemoryTracker::GetGpuBytes(MemoryCategory category)
+{
+    return g_gpuBytes[Index(category)].load(std::memory_order_relaxed);
+}
+
+int64_t MemoryTracker::EstimateTextureBytes(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t arraySize,
+                                            uint32_t bitsPerPixel, bool blockCompressed)
+{
+    //MipLevels = 0 は「1x1 まで全部」
+    if (mipLevels == 0)
+    {
+        mipLevels = 1;
+        for (uint32_t size = (std::max)(width, height); size > 1; size >>= 1) { ++mipLevels; }
+    }
+
+    int64_t bytes = 0;
+    uint32_t w = (std::max)(width, 1u);
+    uint32_t h = (std::max)(height, 1u);
+    for (uint32_t mip = 0; mip < mipLevels; ++mip)
+    {
+        if (blockCompressed)
+        {
+            //4x4 ピクセルで 1 ブロック（BC1 なら 4bpp × 16 = 8 バイト）
+            int64_t blocks = static_cast<int64_t>((w + 3) / 4) * ((h + 3) / 4);
+            bytes += blocks * bitsPerPixel * 2;
+        }
+        else
+        {
+            bytes += static_cast<int64_t>(w) * h * bitsPerPixel / 8;
+        }
+        w = (std::max)(w / 2, 1u);
+        h = (std::max)(h / 2, 1u);
+    }
+    return bytes * (std::max)(arraySize, 1u);
+}
+
+MemorySnapshot MemoryTracker::TakeSnapshot(const std::string& label)
+{
+    MemorySnapshot snapshot;
+    snapshot.label = label;
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+    {
+        snapshot.cpuBytes[i] = g_cpuBytes[i].load(std::memory_order_relaxed);
+        snapshot.cpuAllocations[i] = g_cpuAllocations[i].load(std::memory_order_relaxed);
+        snapshot.gpuBytes[i] = g_gpuBytes[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+MemoryDiff MemoryTracker::Diff(const MemorySnapshot& before, const MemorySnapshot& after)
+{
+    MemoryDiff diff;
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+    {
+        diff.cpuBytes[i] = after.cpuBytes[i] - before.cpuBytes[i];
+        diff.cpuAllocations[i] = after.cpuAllocations[i] - before.cpuAllocations[i];
+        diff.gpuBytes[i] = after.gpuBytes[i] - before.gpuBytes[i];
+    }
+    return diff;
+}
+
+std::string MemoryTracker::FormatDiff(const MemorySnapshot& before, const MemorySnapshot& after)
+{
+    MemoryDiff diff = Diff(before, after);
+
+    std::string text = "[" + before.label + "] -> [" + after.label + "]\n";
+    char line[160];
+    std::snprintf(line, sizeof(line), "  %-9s %12s %10s %10s %12s %10s\n",
+        "category", "CPU KB", "delta", "blocks", "GPU KB", "delta");
+    text += line;
+
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+    {
+        if (diff.cpuBytes[i] == 0 && diff.cpuAllocations[i] == 0 && diff.gpuBytes[i] == 0) { continue; }
+
+        std::snprintf(line, sizeof(line), "  %-9s %12s %10s %+10lld %12s %10s\n",
+            kCategoryNames[i],
+            FormatKB(after.cpuBytes[i], false).c_str(), FormatKB(diff.cpuBytes[i], true).c_str(),
+            static_cast<long long>(diff.cpuAllocations[i]),
+            FormatKB(after.gpuBytes[i], false).c_str(), FormatKB(diff.gpuBytes[i], true).c_str());
+        text += line;
+    }
+
+    std::snprintf(line, sizeof(line), "  %-9s %12s %10s %10s %12s %10s\n",
+        "total",
+        FormatKB(after.TotalCpu(), false).c_str(), FormatKB(diff.TotalCpu(), true).c_str(), "",
+        FormatKB(after.TotalGpu(), false).c_str(), FormatKB(diff.TotalGpu(), true).c_str());
+    text += line;
+    return text;
+}
+
+void MemoryTracker::SetBudget(MemoryCategory category, int64_t cpuBytes, int64_t gpuBytes)
+{
+    size_t i = Index(category);
+    m_cpuBudget[i] = cpuBytes;
+    m_gpuBudget[i] = gpuBytes;
+    m_cpuOver[i] = false;
+    m_gpuOver[i] = false;
+}
+
+int MemoryTracker::CheckBudgets(MemoryBudgetAlert* outAlerts)
+{
+    int count = 0;
+    auto check = [&](size_t i, bool gpu, int64_t bytes, int64_t budget, bool& over)
+        {
+            if (budget <= 0) { return; }
+
+            if (!over && bytes > budget)
+            {
+                over = true;
+                outAlerts[count++] = { static_cast<MemoryCategory>(i), gpu, bytes, budget };
+            }
+            else if (over && bytes < budget / 10 * 9)
+            {
+                over = false;
+            }
+        };
+
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+    {
+        check(i, false, g_cpuBytes[i].load(std::memory_order_relaxed), m_cpuBudget[i], m_cpuOver[i]);
+        check(i, true, g_gpuBytes[i].load(std::memory_order_relaxed), m_gpuBudget[i], m_gpuOver[i]);
+    }
+    return count;
+}
+
+MemorySceneReport MemoryTracker::OnSceneChange(const std::string& from, const std::string& to)
+{
+    MemorySceneReport report;
+    MemorySnapshot snapshot = TakeSnapshot(from.empty() ? std::string("start") : from + " Uninit");
+
+    if (!from.empty() && m_hasCurrentEntry)
+    {
+        report.hasResidual = true;
+        report.residual = Diff(m_currentEntry, snapshot);
+        report.text += "== " + from + ": after Uninit\n" + FormatDiff(m_currentEntry, snapshot);
+    }
+
+    auto it = m_sceneEntries.find(to);
+    if (it != m_sceneEntries.end())
+    {
+        report.revisit = true;
+        report.loop = Diff(it->second, snapshot);
+        report.text += "== " + to + ": since previous visit\n" + FormatDiff(it->second, snapshot);
+    }
+
+    snapshot.label = to + " enter";
+    m_sceneEntries[to] = snapshot;
+    m_currentEntry = snapshot;
+    m_hasCurrentEntry = true;
+    return report;
+}
+
+MemorySceneReport MemoryTracker::OnSceneLoaded(const std::string& name)
+{
+    MemorySceneReport report;
+    if (!m_hasCurrentEntry) { return report; }
+
+    MemorySnapshot snapshot = TakeSnapshot(name + " Init");
+    report.hasLoaded = true;
+    report.loaded = Diff(m_currentEntry, snapshot);
+    report.text = "== " + name + ": after Init\n" + FormatDiff(m_currentEntry, snapshot);
+    return report;
+}
+
+bool MemoryTracker::AppendReport(const std::string& text, const std::filesystem::path& path)
+{
+    std::ofstream file(path, std::ios::app);
+    if (!file) { return false; }
+
+    file << text << '\n';
+    return static_cast<bool>(file);
+}
+
+void MemoryTracker::Reset()
+{
+    for (size_t i = 0; i < kMemoryCategoryCount; ++i)
+    {
+        m_cpuBudget[i] = 0;
+        m_gpuBudget[i] = 0;
+        m_cpuOver[i] = false;
+        m_gpuOver[i] = false;
+    }
+    m_sceneEntries.clear();
+    m_currentEntry = MemorySnapshot();
+    m_hasCurrentEntry = false;
+}
@@ -0,0 +1,159 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+//------------------------------------------------------------
+// サブシステムごとのメモリ使用量の計測
+// ・CPU : グローバルな operator new / delete を差し替え、MemoryScope で付けたカテゴリごとにバイト数を数える
+//         （確保したときのカテゴリをブロックの先頭に持つので、どこで delete しても元のカテゴリから引かれる）
+// ・GPU : テクスチャや頂点バッファは new を通らないので、作った側が AddGpuBytes で明示的に計上する
+// ・シーン切り替えのたびにスナップショットを取り、解放し残した量と、同じシーンに戻ったときの増加量を報告する
+// ・カテゴリごとにソフトな予算を決めておくと、超えたときに CheckBudgets が 1 回だけ知らせる
+// D3D とロガーには触らないので、Tools/MemoryTrackerCheck で確認できる
+//------------------------------------------------------------
+
+//operator new の差し替え（既定では Debug だけ。Release で使うときはプロジェクト設定で MEMORY_TRACKING=1 にする）
+#ifndef MEMORY_TRACKING
+#if defined(DEBUG) || defined(_DEBUG)
+#define MEMORY_TRACKING 1
+#else
+#define MEMORY_TRACKING 0
+#endif
+#endif
+
+enum class MemoryCategory : uint8_t
+{
+    Other = 0,      //タグの無いもの
+    Renderer,       //Renderer の内部（シェーダー・定数バッファなど）
+    Texture,        //TextureManager
+    Model,          //ModelComponent の共有モデルデータ
+    Sound,          //SE キャッシュと BGM
+    Effect,         //EffectManager のパーティクル
+    Scene,          //シーンの Init / Update で作られるもの（GameObject など）
+    Count
+};
+
+constexpr size_t kMemoryCategoryCount = static_cast<size_t>(MemoryCategory::Count);
+
+const char* GetMemoryCategoryName(MemoryCategory category);
+
+//スコープの間、このスレッドの new を category に付ける（抜けると元のカテゴリに戻る）
+class MemoryScope
+{
+public:
+    explicit MemoryScope(MemoryCategory category);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryCategory m_previous;
+};
+
+//ある時点のカテゴリごとの使用量
+struct MemorySnapshot
+{
+    std::string label;
+    int64_t cpuBytes[kMemoryCategoryCount] = {};
+    int64_t cpuAllocations[kMemoryCategoryCount] = {};     //生きているブロック数
+    int64_t gpuBytes[kMemoryCategoryCount] = {};
+
+    int64_t TotalCpu() const;
+    int64_t TotalGpu() const;
+};
+
+//2 つのスナップショットの差（after - before）
+struct MemoryDiff
+{
+    int64_t cpuBytes[kMemoryCategoryCount] = {};
+    int64_t cpuAllocations[kMemoryCategoryCount] = {};
+    int64_t gpuBytes[kMemoryCategoryCount] = {};
+
+    int64_t TotalCpu() const;
+    int64_t TotalGpu() const;
+};
+
+//予算を超えたカテゴリ
+struct MemoryBudgetAlert
+{
+    MemoryCategory category = MemoryCategory::Other;
+    bool gpu = false;
+    int64_t bytes = 0;
+    int64_t budget = 0;
+};
+
+//シーン切り替え時の報告
+struct MemorySceneReport
+{
+    std::string text;               //MemoryReport.txt に書く内容
+
+    bool hasResidual = false;
+    MemoryDiff residual;            //前のシーンの Init 直前 → Uninit 直後（キャッシュに残した分と解放漏れ）
+
+    bool revisit = false;
+    MemoryDiff loop;                //前回そのシーンに入る直前 → 今回入る直前（一周して増えた分）
+
+    bool hasLoaded = false;
+    MemoryDiff loaded;              //シーンの Init 直前 → Init 直後
+};
+
+class MemoryTracker
+{
+public:
+    //operator new を差し替えているか（false なら CPU 側は常に 0）
+    static constexpr bool kHookEnabled = MEMORY_TRACKING != 0;
+
+    static MemoryCategory GetCurrentCategory();
+
+    //GPU リソースの計上（解放時は負の値を渡す）
+    static void AddGpuBytes(MemoryCategory category, int64_t bytes);
+
+    static int64_t GetCpuBytes(MemoryCategory category);
+    static int64_t GetCpuAllocations(MemoryCategory category);
+    static int64_t GetGpuBytes(MemoryCategory category);
+
+    //ミップマップと配列を含めたテクスチャのバイト数（ブロック圧縮は 4x4 ブロック単位で数える）
+    static int64_t EstimateTextureBytes(uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t arraySize,
+                                        uint32_t bitsPerPixel, bool blockCompressed);
+
+    //------------------------------スナップショット------------------------------
+    static MemorySnapshot TakeSnapshot(const std::string& label);
+    static MemoryDiff Diff(const MemorySnapshot& before, const MemorySnapshot& after);
+
+    //カテゴリごとの表（変化の無いカテゴリは省く）
+    static std::string FormatDiff(const MemorySnapshot& before, const MemorySnapshot& after);
+
+    //------------------------------予算------------------------------
+    //0 以下は予算なし
+    static void SetBudget(MemoryCategory category, int64_t cpuBytes, int64_t gpuBytes);
+
+    //今超えたものを outAlerts（kMemoryCategoryCount * 2 個分）に書いて数を返す
+    //超えている間は繰り返さず、予算の 9 割を下回ったらまた知らせるようにする
+    static int CheckBudgets(MemoryBudgetAlert* outAlerts);
+
+    //------------------------------シーン------------------------------
+    //前のシーンの Uninit の後、次のシーンの Init の前に呼ぶ（最初のシーンは from を空にする）
+    static MemorySceneReport OnSceneChange(const std::string& from, const std::string& to);
+    //次のシーンの Init の後に呼ぶ
+    static MemorySceneReport OnSceneLoaded(const std::string& name);
+
+    //報告をファイルの末尾に足す
+    static bool AppendReport(const std::string& text, const std::filesystem::path& path = "MemoryReport.txt");
+
+    //予算とシーンの記録を消す（計測中の値はそのまま）
+    static void Reset();
+
+private:
+    static int64_t m_cpuBudget[kMemoryCategoryCount];
+    static int64_t m_gpuBudget[kMemoryCategoryCount];
+    static bool m_cpuOver[kMemoryCategoryCount];
+    static bool m_gpuOver[kMemoryCategoryCount];
+
+    static std::unordered_map<std::string, MemorySnapshot> m_sceneEntries;   //シーン名 -> 前回 Init する直前
+    static MemorySnapshot m_currentEntry;                                   //今のシーンの Init 直前
+    static bool m_hasCurrentEntry;
+};
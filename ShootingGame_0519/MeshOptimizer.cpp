@@ -0,0 +1,351 @@
+﻿#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    //Forsyth 法で想定する LRU キャッシュの大きさ（スコア計算用。実際の GPU より少し大きめにとる）
+    constexpr int kForsythCacheSize = 32;
+
+    //頂点スコア：キャッシュ内の位置が新しいほど高く、残りの三角形が少ないほど高い（早く使い切らせる）
+    float VertexScore(int cachePos, uint32_t remaining)
+    {
+        if (remaining == 0) { return -1.0f; }
+
+        float score = 0.0f;
+        if (cachePos >= 0)
+        {
+            if (cachePos < 3)
+            {
+                //直前の三角形の頂点はわざと少し下げる（同じ辺ばかり回り込まないように）
+                score = 0.75f;
+            }
+            else
+            {
+                float s = 1.0f - static_cast<float>(cachePos - 3) / static_cast<float>(kForsythCacheSize - 3);
+                score = std::pow(s, 1.5f);
+            }
+        }
+
+        score += 2.0f / std::sqrt(static_cast<float>(remaining));
+        return score;
+    }
+
+    //FIFO キャッシュを模擬して、三角形ごとのミス数を数える
+    void SimulateFIFO(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize,
+        std::vector<uint8_t>* outMisses, uint32_t& outTotal)
+    {
+        //頂点ごとに「キャッシュに入った時刻」を持ち、現在時刻との差がキャッシュサイズ未満ならヒット
+        std::vector<uint32_t> insertedAt(vertexCount, 0);
+        uint32_t time = static_cast<uint32_t>(cacheSize) + 1;
+        uint32_t total = 0;
+
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+        {
+            uint8_t misses = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                uint32_t v = indices[t + k];
+                if (time - insertedAt[v] > static_cast<uint32_t>(cacheSize))
+                {
+                    insertedAt[v] = time++;
+                    ++misses;
+                }
+            }
+            total += misses;
+            if (outMisses) { outMisses->push_back(misses); }
+        }
+        outTotal = total;
+    }
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    const size_t triCount = indices.size() / 3;
+    if (triCount == 0 || vertexCount == 0) { return; }
+
+    //頂点 → 三角形の隣接リスト（CSR 形式。live[v] 個目までがまだ出力していない三角形）
+    std::vector<uint32_t> live(vertexCount, 0);
+    for (size_t i = 0; i < triCount * 3; ++i) { ++live[indices[i]]; }
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) { offsets[v + 1] = offsets[v] + live[v]; }
+
+    std::vector<uint32_t> adjacency(triCount * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triCount; ++t)
+        {
+            for (int k = 0; k < 3; ++k) { adjacency[cursor[indices[t * 3 + k]]++] = static_cast<uint32_t>(t); }
+        }
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) { vertexScore[v] = VertexScore(-1, live[v]); }
+
+    std::vector<float> triScore(triCount);
+    std::vector<uint8_t> emitted(triCount, 0);
+    int best = -1;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triCount; ++t)
+    {
+        triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        if (triScore[t] > bestScore)
+        {
+            bestScore = triScore[t];
+            best = static_cast<int>(t);
+        }
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(triCount * 3);
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(kForsythCacheSize + 3);
+    nextCache.reserve(kForsythCacheSize + 3);
+
+    size_t scan = 0;
+    for (size_t emittedCount = 0; emittedCount < triCount; ++emittedCount)
+    {
+        //キャッシュ内の頂点から続けられる三角形が無ければ、未出力の先頭から再開する
+        if (best < 0)
+        {
+            while (emitted[scan]) { ++scan; }
+            best = static_cast<int>(scan);
+        }
+
+        const uint32_t tri = static_cast<uint32_t>(best);
+        const uint32_t* v = &indices[tri * 3];
+        output.insert(output.end(), v, v + 3);
+        emitted[tri] = 1;
+
+        //出力した三角形を各頂点の隣接リストから外す
+        for (int k = 0; k < 3; ++k)
+        {
+            uint32_t* begin = &adjacency[offsets[v[k]]];
+            uint32_t* end = begin + live[v[k]];
+            uint32_t* it = std::find(begin, end, tri);
+            if (it != end)
+            {
+                *it = *(end - 1);
+                --live[v[k]];
+            }
+        }
+
+        //LRU キャッシュの先頭に今の 3 頂点を入れる
+        nextCache.assign(v, v + 3);
+        for (uint32_t c : cache)
+        {
+            if (c != v[0] && c != v[1] && c != v[2]) { nextCache.push_back(c); }
+        }
+        cache.swap(nextCache);
+
+        //キャッシュに触れた頂点のスコアを更新し、その頂点を使う三角形から次の候補を選ぶ
+        best = -1;
+        bestScore = -1.0f;
+        for (size_t i = 0; i < cache.size(); ++i)
+        {
+            uint32_t cv = cache[i];
+            int pos = (i < static_cast<size_t>(kForsythCacheSize)) ? static_cast<int>(i) : -1;
+
+            float score = VertexScore(pos, live[cv]);
+            float delta = score - vertexScore[cv];
+            vertexScore[cv] = score;
+
+            for (uint32_t a = 0; a < live[cv]; ++a)
+            {
+                uint32_t t = adjacency[offsets[cv] + a];
+                triScore[t] += delta;
+                if (pos >= 0 && triScore[t] > bestScore)
+                {
+                    bestScore = triScore[t];
+                    best = static_cast<int>(t);
+                }
+            }
+        }
+
+        //キャッシュからあふれた頂点は捨てる
+        if (cache.size() > static_cast<size_t>(kForsythCacheSize)) { cache.resize(kForsythCacheSize); }
+    }
+
+    indices.swap(output);
+}
+
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshPosition>& positions, float threshold)
+{
+    const size_t triCount = indices.size() / 3;
+    if (triCount < 2) { return; }
+
+    //まずキャッシュが途切れる所（3 頂点ともミス）で大きく区切る
+    std::vector<uint8_t> misses;
+    misses.reserve(triCount);
+    uint32_t totalMisses = 0;
+    SimulateFIFO(indices, positions.size(), kMeshCacheSizeFIFO, &misses, totalMisses);
+
+    std::vector<size_t> hardStarts;
+    for (size_t t = 0; t < triCount; ++t)
+    {
+        if (t == 0 || misses[t] == 3) { hardStarts.push_back(t); }
+    }
+    hardStarts.push_back(triCount);
+
+    //大きな区切りの中でも、区切った所からキャッシュが空で始まっても ACMR が threshold 倍に収まる所では細かく区切る
+    std::vector<size_t> clusterStarts;
+    std::vector<uint32_t> insertedAt(positions.size(), 0);
+    uint32_t time = kMeshCacheSizeFIFO + 1;
+    for (size_t h = 0; h + 1 < hardStarts.size(); ++h)
+    {
+        size_t begin = hardStarts[h];
+        size_t end = hardStarts[h + 1];
+
+        uint32_t clusterMisses = 0;
+        for (size_t t = begin; t < end; ++t) { clusterMisses += misses[t]; }
+        float limit = static_cast<float>(clusterMisses) / static_cast<float>(end - begin) * threshold;
+
+        clusterStarts.push_back(begin);
+        time += kMeshCacheSizeFIFO + 1;     //キャッシュを空にする
+        uint32_t running = 0;
+        size_t runStart = begin;
+        for (size_t t = begin; t < end; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                uint32_t v = indices[t * 3 + k];
+                if (time - insertedAt[v] > static_cast<uint32_t>(kMeshCacheSizeFIFO))
+                {
+                    insertedAt[v] = time++;
+                    ++running;
+                }
+            }
+
+            size_t count = t + 1 - runStart;
+            if (t + 1 < end && static_cast<float>(running) / static_cast<float>(count) <= limit)
+            {
+                clusterStarts.push_back(t + 1);
+                runStart = t + 1;
+                running = 0;
+                time += kMeshCacheSizeFIFO + 1;
+            }
+        }
+    }
+    clusterStarts.push_back(triCount);
+
+    //三角形ごとの重心と、面積で重み付けした法線（外積そのまま）
+    std::vector<MeshPosition> triCenter(triCount);
+    std::vector<MeshPosition> triNormal(triCount);
+    std::vector<float> triArea(triCount);
+    float meshCenter[3] = {};
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triCount; ++t)
+    {
+        const MeshPosition& p0 = positions[indices[t * 3]];
+        const MeshPosition& p1 = positions[indices[t * 3 + 1]];
+        const MeshPosition& p2 = positions[indices[t * 3 + 2]];
+        float e1[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+        float e2[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+        MeshPosition n = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        float area = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+
+        triNormal[t] = n;
+        triArea[t] = area;
+        triCenter[t] = { (p0.x + p1.x + p2.x) / 3.0f, (p0.y + p1.y + p2.y) / 3.0f, (p0.z + p1.z + p2.z) / 3.0f };
+        meshCenter[0] += triCenter[t].x * area;
+        meshCenter[1] += triCenter[t].y * area;
+        meshCenter[2] += triCenter[t].z * area;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+    {
+        for (float& c : meshCenter) { c /= meshArea; }
+    }
+
+    //まとまりごとに「メッシュの中心からどれだけ外を向いているか」を求める
+    struct Cluster
+    {
+        size_t begin;
+        size_t end;
+        float sortKey;
+    };
+    std::vector<Cluster> clusters;
+    clusters.reserve(clusterStarts.size());
+    for (size_t i = 0; i + 1 < clusterStarts.size(); ++i)
+    {
+        size_t begin = clusterStarts[i];
+        size_t end = clusterStarts[i + 1];
+
+        float center[3] = {};
+        float normal[3] = {};
+        float area = 0.0f;
+        for (size_t t = begin; t < end; ++t)
+        {
+            center[0] += triCenter[t].x * triArea[t];
+            center[1] += triCenter[t].y * triArea[t];
+            center[2] += triCenter[t].z * triArea[t];
+            normal[0] += triNormal[t].x;
+            normal[1] += triNormal[t].y;
+            normal[2] += triNormal[t].z;
+            area += triArea[t];
+        }
+
+        float key = 0.0f;
+        float len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (area > 0.0f && len > 0.0f)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                key += (center[k] / area - meshCenter[k]) * normal[k] / len;
+            }
+        }
+        clusters.push_back({ begin, end, key });
+    }
+
+    //外を向いているまとまりほど手前で遮る側になるので先に描く
+    std::stable_sort(clusters.begin(), clusters.end(),
+        [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const auto& c : clusters)
+    {
+        output.insert(output.end(), indices.begin() + c.begin * 3, indices.begin() + c.end * 3);
+    }
+
+    //並べ替えでキャッシュ効率が threshold 倍より悪くなったら元の順番のままにする
+    uint32_t outputMisses = 0;
+    SimulateFIFO(output, positions.size(), kMeshCacheSizeFIFO, nullptr, outputMisses);
+    if (static_cast<float>(outputMisses) <= static_cast<float>(totalMisses) * threshold)
+    {
+        indices.swap(output);
+    }
+}
+
+std::vector<uint32_t> BuildFetchRemap(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    const uint32_t kUnused = ~0u;
+    std::vector<uint32_t> remap(vertexCount, kUnused);
+
+    uint32_t next = 0;
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == kUnused) { remap[index] = next++; }
+        index = remap[index];
+    }
+
+    //どの三角形からも使われない頂点は末尾へ
+    for (uint32_t& r : remap)
+    {
+        if (r == kUnused) { r = next++; }
+    }
+    return remap;
+}
+
+float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize)
+{
+    size_t triCount = indices.size() / 3;
+    if (triCount == 0) { return 0.0f; }
+
+    uint32_t total = 0;
+    SimulateFIFO(indices, vertexCount, cacheSize, nullptr, total);
+    return static_cast<float>(total) / static_cast<float>(triCount);
+}
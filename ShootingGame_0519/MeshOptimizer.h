@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "MeshPosition.h"
+
+//------------------------------------------------------------
+// 読み込んだメッシュのインデックス / 頂点の並べ替え（CPU のみ）
+// ・OptimizeVertexCache : Forsyth 法で三角形を並べ替え、変換後頂点キャッシュのヒット率を上げる
+// ・OptimizeOverdraw    : キャッシュ効率をほぼ保ったまま、外向きのまとまりを先に描く順にする
+// ・BuildFetchRemap     : インデックスで最初に使われる順に頂点を並べ直す表（頂点フェッチの局所性）
+// ・ComputeACMR         : 三角形あたりのキャッシュミス数（FIFO キャッシュを模擬）
+// D3D には触らないので、Tools/MeshOptCheck で Linux でも同じ処理を確認できる
+//------------------------------------------------------------
+
+//並べ替えの結果（ログ・ツール表示用）
+struct MeshOptimizeStats
+{
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+    bool  index16 = false;      //16bit インデックスに収まったか
+};
+
+//ACMR の計測に使う FIFO キャッシュの大きさ（古い GPU の後処理キャッシュ相当）
+constexpr int kMeshCacheSizeFIFO = 16;
+
+//Forsyth 法で三角形の順番を並べ替える（indices は三角形リスト）
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+//キャッシュ最適化済みの三角形列をまとまり（クラスタ）に分け、外側を向くまとまりから描く順に並べ替える
+//threshold: クラスタの区切りを許す ACMR の悪化率（1.05 なら 5% まで）
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshPosition>& positions,
+    float threshold = 1.05f);
+
+//インデックスで最初に参照される順に頂点を並べ直す表を作る（remap[旧番号] = 新番号）
+//indices は新番号に書き換える。使われない頂点は末尾に回す
+std::vector<uint32_t> BuildFetchRemap(std::vector<uint32_t>& indices, size_t vertexCount);
+
+//remap に従って頂点配列を並べ直す
+template<typename T>
+void ApplyFetchRemap(std::vector<T>& vertices, const std::vector<uint32_t>& remap)
+{
+    std::vector<T> sorted(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        sorted[remap[i]] = vertices[i];
+    }
+    vertices.swap(sorted);
+}
+
+//三角形あたりのキャッシュミス数（1 頂点も共有しなければ 3.0、理想的な格子なら 0.5 付近）
+float ComputeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize = kMeshCacheSizeFIFO);
+
+//上の 3 つをまとめて行う（ModelComponent の読み込み時に使う流れ）
+//positions は並べ替え前の頂点の位置（vertices と同じ並び）
+template<typename T>
+MeshOptimizeStats OptimizeMesh(std::vector<uint32_t>& indices, std::vector<T>& vertices,
+    const std::vector<MeshPosition>& positions)
+{
+    MeshOptimizeStats stats;
+    stats.acmrBefore = ComputeACMR(indices, vertices.size());
+
+    std::vector<uint32_t> optimized = indices;
+    OptimizeVertexCache(optimized, vertices.size());
+    OptimizeOverdraw(optimized, positions);
+
+    //元の並びの方が良ければ（最適化済みで書き出されたモデルなど）三角形の順番はそのまま
+    if (ComputeACMR(optimized, vertices.size()) < stats.acmrBefore)
+    {
+        indices.swap(optimized);
+    }
+
+    std::vector<uint32_t> remap = BuildFetchRemap(indices, vertices.size());
+    ApplyFetchRemap(vertices, remap);
+
+    stats.acmrAfter = ComputeACMR(indices, vertices.size());
+    stats.index16 = vertices.size() <= 0xFFFF;
+    return stats;
+}
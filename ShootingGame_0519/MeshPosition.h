@@ -0,0 +1,11 @@
+﻿#pragma once
+
+//------------------------------------------------------------
+// メッシュ処理（MeshOptimizer / MeshSimplifier）に渡す頂点の位置
+// DirectXMath に依存させないための素の構造体（XMFLOAT3 と同じ並び）。
+// Tools のチェックツールを Linux の g++ でもそのままビルドできるようにする
+//------------------------------------------------------------
+struct MeshPosition
+{
+    float x, y, z;
+};
@@ -0,0 +1,490 @@
+﻿#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include <unordered_set>
+
+namespace
+{
+    constexpr uint32_t kNoEdge = 0xFFFFFFFFu;       //開いた辺がない
+    constexpr uint32_t kManyEdges = 0xFFFFFFFEu;    //開いた辺が 2 本以上ある（縁が 1 点で交わっている）
+
+    //縁の辺に足す平面の重み（面の誤差より強くして、穴の輪郭が崩れにくいようにする）
+    constexpr double kBorderWeight = 10.0;
+
+    //1 回の簡略化で繰り返す縮約パスの上限
+    constexpr int kMaxPasses = 64;
+
+    enum class VertexKind : uint8_t
+    {
+        Manifold,   //周りが三角形で閉じている（どの隣接頂点へも縮約できる）
+        Border,     //穴の縁（縁に沿ってだけ縮約できる）
+        Seam,       //同じ位置に頂点が 2 つある UV の継ぎ目（継ぎ目に沿って 2 つ一緒に縮約する）
+        Locked,     //動かさない
+    };
+
+    struct Vec3d
+    {
+        double x, y, z;
+    };
+
+    Vec3d Sub(const Vec3d& a, const Vec3d& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+    Vec3d Cross(const Vec3d& a, const Vec3d& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+    double Dot(const Vec3d& a, const Vec3d& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    double Length(const Vec3d& a) { return std::sqrt(Dot(a, a)); }
+
+    //平面までの距離の二乗を重み付きで足し合わせたもの（対称 4x4 行列を 10 要素で持つ）
+    struct Quadric
+    {
+        double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+        double c = 0.0;
+        double weight = 0.0;
+    };
+
+    //平面 dot(n, p) + d = 0（n は単位ベクトル）を重み w で足す
+    void AddPlane(Quadric& q, const Vec3d& n, double d, double w)
+    {
+        q.a00 += n.x * n.x * w; q.a11 += n.y * n.y * w; q.a22 += n.z * n.z * w;
+        q.a01 += n.x * n.y * w; q.a02 += n.x * n.z * w; q.a12 += n.y * n.z * w;
+        q.b0 += n.x * d * w; q.b1 += n.y * d * w; q.b2 += n.z * d * w;
+        q.c += d * d * w;
+        q.weight += w;
+    }
+
+    void AddQuadric(Quadric& dst, const Quadric& src)
+    {
+        dst.a00 += src.a00; dst.a11 += src.a11; dst.a22 += src.a22;
+        dst.a01 += src.a01; dst.a02 += src.a02; dst.a12 += src.a12;
+        dst.b0 += src.b0; dst.b1 += src.b1; dst.b2 += src.b2;
+        dst.c += src.c;
+        dst.weight += src.weight;
+    }
+
+    //p を置いたときの平面までの距離の二乗（重みで割って平均にする）
+    double QuadricError(const Quadric& q, const Vec3d& p)
+    {
+        double r = q.a00 * p.x * p.x + q.a11 * p.y * p.y + q.a22 * p.z * p.z
+            + 2.0 * (q.a01 * p.x * p.y + q.a02 * p.x * p.z + q.a12 * p.y * p.z)
+            + 2.0 * (q.b0 * p.x + q.b1 * p.y + q.b2 * p.z)
+            + q.c;
+        return std::fabs(r) / ((q.weight > 0.0) ? q.weight : 1.0);
+    }
+
+    uint64_t EdgeKey(uint32_t a, uint32_t b) { return (static_cast<uint64_t>(a) << 32) | b; }
+
+    void MarkOpen(uint32_t& slot, uint32_t v) { slot = (slot == kNoEdge) ? v : kManyEdges; }
+
+    //縮約後の番号で縁・継ぎ目のつながりを付け直す
+    void RemapEdgeLoop(std::vector<uint32_t>& loop, const std::vector<uint32_t>& remap)
+    {
+        for (size_t i = 0; i < loop.size(); ++i)
+        {
+            uint32_t next = loop[i];
+            if (next >= kManyEdges) { continue; }
+
+            //縁の辺を逆向き（次の頂点 → 自分）に縮約した場合は、つぶれた頂点の先へつなぎ直す
+            uint32_t r = remap[next];
+            loop[i] = (r == i) ? loop[next] : r;
+        }
+    }
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double error;
+    };
+}
+
+MeshSimplifyResult SimplifyMesh(const std::vector<uint32_t>& indices, const std::vector<MeshPosition>& positions,
+    size_t targetIndexCount, float targetError)
+{
+    MeshSimplifyResult result;
+    const size_t vertexCount = positions.size();
+
+    //範囲外・つぶれた三角形は最初に取り除いておく
+    result.indices.reserve(indices.size());
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        uint32_t a = indices[t], b = indices[t + 1], c = indices[t + 2];
+        if (a >= vertexCount || b >= vertexCount || c >= vertexCount) { continue; }
+        if (a == b || b == c || a == c) { continue; }
+        result.indices.push_back(a);
+        result.indices.push_back(b);
+        result.indices.push_back(c);
+    }
+    if (result.indices.size() <= targetIndexCount) { return result; }
+
+    //位置を最大辺 1 の大きさに正規化する（誤差をメッシュの大きさに対する比率で扱うため）
+    float minP[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maxP[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const MeshPosition& p : positions)
+    {
+        minP[0] = (std::min)(minP[0], p.x); maxP[0] = (std::max)(maxP[0], p.x);
+        minP[1] = (std::min)(minP[1], p.y); maxP[1] = (std::max)(maxP[1], p.y);
+        minP[2] = (std::min)(minP[2], p.z); maxP[2] = (std::max)(maxP[2], p.z);
+    }
+    float extent = (std::max)({ maxP[0] - minP[0], maxP[1] - minP[1], maxP[2] - minP[2] });
+    double scale = (extent > 0.0f) ? 1.0 / extent : 1.0;
+
+    std::vector<Vec3d> pos(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        pos[v] = { (positions[v].x - minP[0]) * scale, (positions[v].y - minP[1]) * scale, (positions[v].z - minP[2]) * scale };
+    }
+
+    //----------同じ位置の頂点をまとめる-------------
+    //group[v] = 同じ位置の代表頂点、wedge[v] = 同じ位置の次の頂点（輪になっている）
+    std::vector<uint8_t> used(vertexCount, 0);
+    for (uint32_t v : result.indices) { used[v] = 1; }
+
+    std::vector<uint32_t> order;
+    order.reserve(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        if (used[v]) { order.push_back(v); }
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            const MeshPosition& pa = positions[a];
+            const MeshPosition& pb = positions[b];
+            if (pa.x != pb.x) { return pa.x < pb.x; }
+            if (pa.y != pb.y) { return pa.y < pb.y; }
+            if (pa.z != pb.z) { return pa.z < pb.z; }
+            return a < b;
+        });
+
+    std::vector<uint32_t> group(vertexCount);
+    std::vector<uint32_t> wedge(vertexCount);
+    std::vector<uint32_t> groupSize(vertexCount, 0);
+    std::iota(group.begin(), group.end(), 0u);
+    std::iota(wedge.begin(), wedge.end(), 0u);
+    for (size_t s = 0; s < order.size();)
+    {
+        const MeshPosition& p = positions[order[s]];
+        size_t e = s + 1;
+        while (e < order.size() && positions[order[e]].x == p.x &&
+            positions[order[e]].y == p.y && positions[order[e]].z == p.z)
+        {
+            ++e;
+        }
+
+        for (size_t k = s; k < e; ++k)
+        {
+            group[order[k]] = order[s];
+            wedge[order[k]] = order[(k + 1 < e) ? k + 1 : s];
+        }
+        groupSize[order[s]] = static_cast<uint32_t>(e - s);
+        s = e;
+    }
+
+    //----------縁・継ぎ目の辺を調べる-------------
+    //openOut[v] / openInc[v] = v から出る / v に入る「逆向きの辺がない辺」の相手
+    std::unordered_set<uint64_t> edges;
+    std::unordered_set<uint64_t> groupEdges;
+    edges.reserve(result.indices.size() * 2);
+    groupEdges.reserve(result.indices.size() * 2);
+    for (size_t t = 0; t < result.indices.size(); t += 3)
+    {
+        for (int e = 0; e < 3; ++e)
+        {
+            uint32_t a = result.indices[t + e];
+            uint32_t b = result.indices[t + (e + 1) % 3];
+            edges.insert(EdgeKey(a, b));
+            groupEdges.insert(EdgeKey(group[a], group[b]));
+        }
+    }
+
+    std::vector<uint32_t> openOut(vertexCount, kNoEdge);
+    std::vector<uint32_t> openInc(vertexCount, kNoEdge);
+    for (size_t t = 0; t < result.indices.size(); t += 3)
+    {
+        for (int e = 0; e < 3; ++e)
+        {
+            uint32_t a = result.indices[t + e];
+            uint32_t b = result.indices[t + (e + 1) % 3];
+            if (edges.count(EdgeKey(b, a)) == 0)
+            {
+                MarkOpen(openOut[a], b);
+                MarkOpen(openInc[b], a);
+            }
+        }
+    }
+
+    //----------頂点の種類を決める-------------
+    std::vector<VertexKind> kind(vertexCount, VertexKind::Locked);
+    auto singleLoop = [&](uint32_t v) { return openOut[v] < kManyEdges && openInc[v] < kManyEdges; };
+    for (uint32_t v : order)
+    {
+        uint32_t size = groupSize[group[v]];
+        if (size == 1)
+        {
+            if (openOut[v] == kNoEdge && openInc[v] == kNoEdge) { kind[v] = VertexKind::Manifold; }
+            else if (singleLoop(v)) { kind[v] = VertexKind::Border; }
+        }
+        else if (size == 2)
+        {
+            //継ぎ目の両側で、開いた辺が同じ位置の辺を逆向きに通っていれば継ぎ目
+            uint32_t w = wedge[v];
+            if (singleLoop(v) && singleLoop(w) &&
+                group[openOut[v]] == group[openInc[w]] && group[openInc[v]] == group[openOut[w]])
+            {
+                kind[v] = VertexKind::Seam;
+            }
+        }
+    }
+
+    //----------二次誤差を位置ごとに集める-------------
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t < result.indices.size(); t += 3)
+    {
+        uint32_t tri[3] = { result.indices[t], result.indices[t + 1], result.indices[t + 2] };
+        const Vec3d& p0 = pos[tri[0]];
+        Vec3d n = Cross(Sub(pos[tri[1]], p0), Sub(pos[tri[2]], p0));
+        double len = Length(n);
+        if (len <= 0.0) { continue; }
+        n = { n.x / len, n.y / len, n.z / len };
+
+        //面の平面は面積で重み付けする
+        double d = -Dot(n, p0);
+        for (uint32_t v : tri) { AddPlane(quadrics[group[v]], n, d, len * 0.5); }
+
+        //穴の縁では、辺を含んで面に垂直な平面も足す（縁が内側に縮まないように）
+        for (int e = 0; e < 3; ++e)
+        {
+            uint32_t a = tri[e];
+            uint32_t b = tri[(e + 1) % 3];
+            if (groupEdges.count(EdgeKey(group[b], group[a])) != 0) { continue; }
+
+            Vec3d edge = Sub(pos[b], pos[a]);
+            Vec3d bn = Cross(edge, n);
+            double bnLen = Length(bn);
+            if (bnLen <= 0.0) { continue; }
+            bn = { bn.x / bnLen, bn.y / bnLen, bn.z / bnLen };
+
+            double bd = -Dot(bn, pos[a]);
+            double w = Dot(edge, edge) * kBorderWeight;
+            AddPlane(quadrics[group[a]], bn, bd, w);
+            AddPlane(quadrics[group[b]], bn, bd, w);
+        }
+    }
+
+    //----------縮約できるかの判定-------------
+    //継ぎ目の頂点 from を to へ寄せるとき、反対側の頂点が寄る先
+    auto seamTarget = [&](uint32_t from, uint32_t to)
+        {
+            uint32_t w = wedge[from];
+            return (to == openOut[from]) ? openInc[w] : openOut[w];
+        };
+
+    auto canCollapse = [&](uint32_t from, uint32_t to)
+        {
+            switch (kind[from])
+            {
+            case VertexKind::Manifold:
+                return true;
+            case VertexKind::Border:
+                return to == openOut[from] || to == openInc[from];
+            case VertexKind::Seam:
+            {
+                if (to != openOut[from] && to != openInc[from]) { return false; }
+                uint32_t w = seamTarget(from, to);
+                return w < kManyEdges && group[w] == group[to];
+            }
+            default:
+                return false;
+            }
+        };
+
+    //頂点 → 三角形の隣接リスト（パスごとに作り直す）
+    std::vector<uint32_t> adjOffset(vertexCount + 1);
+    std::vector<uint32_t> adjTris;
+
+    //from を to の位置に動かしたとき、周りの三角形が裏返らないか
+    auto hasFlips = [&](uint32_t from, uint32_t to)
+        {
+            const Vec3d& target = pos[to];
+            for (uint32_t k = adjOffset[from]; k < adjOffset[from + 1]; ++k)
+            {
+                const uint32_t* tri = &result.indices[adjTris[k] * 3];
+                if (group[tri[0]] == group[to] || group[tri[1]] == group[to] || group[tri[2]] == group[to])
+                {
+                    continue;   //縮約でつぶれる三角形
+                }
+
+                Vec3d p[3] = { pos[tri[0]], pos[tri[1]], pos[tri[2]] };
+                Vec3d before = Cross(Sub(p[1], p[0]), Sub(p[2], p[0]));
+                for (int c = 0; c < 3; ++c)
+                {
+                    if (tri[c] == from) { p[c] = target; }
+                }
+                Vec3d after = Cross(Sub(p[1], p[0]), Sub(p[2], p[0]));
+                if (Dot(before, after) <= 0.0) { return true; }
+            }
+            return false;
+        };
+
+    const double errorLimit = static_cast<double>(targetError) * targetError;
+    double maxErrorSq = 0.0;
+
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<uint8_t> locked(vertexCount);
+    std::vector<Collapse> candidates;
+
+    for (int pass = 0; pass < kMaxPasses && result.indices.size() > targetIndexCount; ++pass)
+    {
+        std::vector<uint32_t>& idx = result.indices;
+        const size_t triCount = idx.size() / 3;
+
+        std::fill(adjOffset.begin(), adjOffset.end(), 0u);
+        for (uint32_t v : idx) { ++adjOffset[v + 1]; }
+        for (size_t v = 0; v < vertexCount; ++v) { adjOffset[v + 1] += adjOffset[v]; }
+        adjTris.resize(idx.size());
+        {
+            std::vector<uint32_t> cursor(adjOffset.begin(), adjOffset.end() - 1);
+            for (size_t t = 0; t < triCount; ++t)
+            {
+                for (int c = 0; c < 3; ++c) { adjTris[cursor[idx[t * 3 + c]]++] = static_cast<uint32_t>(t); }
+            }
+        }
+
+        //辺ごとに、誤差の小さい向きの縮約を候補にする
+        candidates.clear();
+        for (size_t t = 0; t < triCount; ++t)
+        {
+            for (int e = 0; e < 3; ++e)
+            {
+                uint32_t a = idx[t * 3 + e];
+                uint32_t b = idx[t * 3 + (e + 1) % 3];
+
+                double errAB = canCollapse(a, b) ? QuadricError(quadrics[group[a]], pos[b]) : DBL_MAX;
+                double errBA = canCollapse(b, a) ? QuadricError(quadrics[group[b]], pos[a]) : DBL_MAX;
+                if (errAB == DBL_MAX && errBA == DBL_MAX) { continue; }
+
+                candidates.push_back((errAB <= errBA) ? Collapse{ a, b, errAB } : Collapse{ b, a, errBA });
+            }
+        }
+        if (candidates.empty()) { break; }
+
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Collapse& l, const Collapse& r) { return l.error < r.error; });
+
+        //1 回の縮約で三角形はおよそ 2 つ減る。目標数の半分あたりの誤差を目安に、それより大きい縮約は次のパスに回す
+        //（周りの頂点を動かさない制約で目安以下の縮約がほとんどできないときは、目安を超えても続ける）
+        size_t triangleGoal = (idx.size() - targetIndexCount + 2) / 3;
+        size_t edgeGoal = (std::max)(triangleGoal / 2, size_t(1));
+        double passLimit = candidates[(std::min)(edgeGoal, candidates.size() - 1)].error * 1.5;
+
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(locked.begin(), locked.end(), 0);
+
+        size_t removed = 0;
+        size_t collapsed = 0;
+        for (const Collapse& c : candidates)
+        {
+            if (c.error > errorLimit || removed >= triangleGoal) { break; }
+            if (c.error > passLimit && collapsed * 4 >= edgeGoal) { break; }
+
+            if (locked[group[c.from]] || locked[group[c.to]]) { continue; }
+
+            bool seam = (kind[c.from] == VertexKind::Seam);
+            uint32_t wedgeFrom = seam ? wedge[c.from] : c.from;
+            uint32_t wedgeTo = seam ? seamTarget(c.from, c.to) : c.to;
+            if (hasFlips(c.from, c.to) || (seam && hasFlips(wedgeFrom, wedgeTo))) { continue; }
+
+            //周りの頂点もこのパスでは動かさない（裏返り判定に使った位置がずれないように）
+            for (uint32_t v : { c.from, wedgeFrom })
+            {
+                for (uint32_t k = adjOffset[v]; k < adjOffset[v + 1]; ++k)
+                {
+                    const uint32_t* tri = &idx[adjTris[k] * 3];
+                    locked[group[tri[0]]] = locked[group[tri[1]]] = locked[group[tri[2]]] = 1;
+                }
+            }
+            locked[group[c.to]] = 1;
+
+            remap[c.from] = c.to;
+            if (seam) { remap[wedgeFrom] = wedgeTo; }
+            AddQuadric(quadrics[group[c.to]], quadrics[group[c.from]]);
+
+            maxErrorSq = (std::max)(maxErrorSq, c.error);
+            removed += (kind[c.from] == VertexKind::Border) ? 1 : 2;
+            ++collapsed;
+        }
+        if (collapsed == 0) { break; }
+
+        //付け替えて、つぶれた三角形を捨てる
+        size_t write = 0;
+        for (size_t t = 0; t < triCount; ++t)
+        {
+            uint32_t a = remap[idx[t * 3]], b = remap[idx[t * 3 + 1]], c = remap[idx[t * 3 + 2]];
+            if (group[a] == group[b] || group[b] == group[c] || group[a] == group[c]) { continue; }
+            idx[write++] = a;
+            idx[write++] = b;
+            idx[write++] = c;
+        }
+        idx.resize(write);
+
+        RemapEdgeLoop(openOut, remap);
+        RemapEdgeLoop(openInc, remap);
+    }
+
+    result.error = static_cast<float>(std::sqrt(maxErrorSq));
+    return result;
+}
+
+std::vector<MeshSimplifyResult> BuildMeshLods(const std::vector<uint32_t>& indices, const std::vector<MeshPosition>& positions)
+{
+    std::vector<MeshSimplifyResult> lods(1);
+    lods[0].indices = indices;
+
+    const size_t baseTriangles = indices.size() / 3;
+    for (int lod = 1; lod < kMaxMeshLods; ++lod)
+    {
+        const MeshSimplifyResult& prev = lods.back();
+
+        //前の LOD からの誤差は、元からの上限の残りまでに抑える
+        size_t target = static_cast<size_t>(baseTriangles * kLodTriangleRatio[lod]) * 3;
+        float budget = kLodMaxError[lod] - prev.error;
+        if (budget <= 0.0f) { break; }
+
+        MeshSimplifyResult next = SimplifyMesh(prev.indices, positions, target, budget);
+        if (next.indices.empty() || next.indices.size() * 5 > prev.indices.size() * 4) { break; }
+
+        next.error += prev.error;
+        lods.push_back(std::move(next));
+    }
+    return lods;
+}
+
+float ComputeScreenSize(float radius, float distance, float projScaleY)
+{
+    //カメラが境界球の中にいるときは最も細かい LOD になるよう十分大きな値を返す
+    if (distance <= radius) { return FLT_MAX; }
+
+    //NDC の高さは 2、境界球の直径は NDC で 2 * radius * projScaleY / distance
+    return radius * projScaleY / distance;
+}
+
+int SelectLod(float screenSize, int currentLod, int lodCount, const LodSelectSettings& settings)
+{
+    lodCount = (std::min)(lodCount, kMaxMeshLods);
+    if (lodCount <= 1) { return 0; }
+
+    int lod = (std::max)(0, (std::min)(currentLod, lodCount - 1));
+
+    //小さくなったとき：境目を hysteresis 分下回るまでは粗くしない
+    while (lod < lodCount - 1 && screenSize < settings.screenSize[lod] * (1.0f - settings.hysteresis))
+    {
+        ++lod;
+    }
+
+    //大きくなったとき：境目を hysteresis 分上回るまでは細かくしない
+    while (lod > 0 && screenSize > settings.screenSize[lod - 1] * (1.0f + settings.hysteresis))
+    {
+        --lod;
+    }
+    return lod;
+}
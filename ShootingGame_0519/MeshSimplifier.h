@@ -0,0 +1,52 @@
+﻿#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "MeshPosition.h"
+
+//------------------------------------------------------------
+// メッシュの簡略化（LOD 生成）と、画面上の大きさによる LOD の選択
+// ・SimplifyMesh : Quadric Error Metrics で辺を縮約する。頂点は既存の頂点に寄せるだけで新しく作らないので、
+//                  全 LOD が同じ頂点バッファを共有し、LOD ごとに変わるのはインデックスだけになる
+// ・SelectLod    : 境界球の画面上の大きさから LOD を選ぶ（境目でちらつかないようヒステリシスを持たせる）
+// D3D には触らないので、Tools/MeshSimplifyCheck で誤差を Linux でも確認できる
+//------------------------------------------------------------
+
+//1 メッシュあたりの LOD の最大数（LOD0 = 元のメッシュを含む）
+constexpr int kMaxMeshLods = 4;
+
+//簡略化の結果
+struct MeshSimplifyResult
+{
+    std::vector<uint32_t> indices;
+    float error = 0.0f;     //縮約で生じた誤差の見積もり（メッシュの最大辺の長さに対する比率）
+};
+
+//indices（三角形リスト）を targetIndexCount 以下まで減らす。誤差が targetError を超える縮約はしない
+//・メッシュの穴の縁は縁に沿ってだけ縮約する
+//・同じ位置に頂点が 2 つある UV の継ぎ目は、継ぎ目に沿って両側を一緒に縮約する（3 つ以上重なる頂点は動かさない）
+MeshSimplifyResult SimplifyMesh(const std::vector<uint32_t>& indices, const std::vector<MeshPosition>& positions,
+    size_t targetIndexCount, float targetError);
+
+//LOD ごとの目標（元に対する三角形の割合と、元からの誤差の上限）
+constexpr float kLodTriangleRatio[kMaxMeshLods] = { 1.0f, 0.5f, 0.2f, 0.06f };
+constexpr float kLodMaxError[kMaxMeshLods] = { 0.0f, 0.01f, 0.03f, 0.08f };
+
+//LOD0（元の indices）から順に LOD を作る。前の LOD を縮約して次の LOD にし、
+//三角形が 2 割以上減らなくなったらそこで打ち切る（戻り値の要素数 = 使える LOD の数）
+std::vector<MeshSimplifyResult> BuildMeshLods(const std::vector<uint32_t>& indices, const std::vector<MeshPosition>& positions);
+
+//LOD を切り替える画面上の大きさ
+struct LodSelectSettings
+{
+    //LOD i から i+1 に切り替える大きさ（境界球の直径が画面の高さに占める割合。降順）
+    float screenSize[kMaxMeshLods - 1] = { 0.30f, 0.12f, 0.05f };
+    //境目の前後に持たせる幅（0.15 なら ±15%）
+    float hysteresis = 0.15f;
+};
+
+//境界球の直径が画面の高さに占める割合（projScaleY は透視投影行列の _22）
+float ComputeScreenSize(float radius, float distance, float projScaleY);
+
+//現在の LOD から、screenSize に合う LOD を選ぶ（lodCount は使える LOD の数）
+int SelectLod(float screenSize, int currentLod, int lodCount, const LodSelectSettings& settings = LodSelectSettings());
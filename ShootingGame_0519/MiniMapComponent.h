@@ -1,5 +1,6 @@
 #pragma once
 #include "Component.h"
+#include "FrameArena.h"
 #include <string>
 #include <SimpleMath.h>
 #include <wrl/client.h>
@@ -36,8 +37,9 @@ public:
 	void SetEnemyIconSRV(ID3D11ShaderResourceView* srv) { m_enemyIconSRV = srv; }
 	void SetBuildingIconSRV(ID3D11ShaderResourceView* srv) { m_buildingIconSRV = srv; }
 
-	void SetEnemies(const std::vector<GameObject*>& enemies) { m_enemies = enemies; }
-	void SetBuildings(const std::vector<GameObject*>& buildings) { m_buildings = buildings; }
+	//t[A[ĩXg󂯎Ãobt@փRs[ieʂ͎g񂷁j
+	void SetEnemies(const FrameVector<GameObject*>& enemies) { m_enemies.assign(enemies.begin(), enemies.end()); }
+	void SetBuildings(const FrameVector<GameObject*>& buildings) { m_buildings.assign(buildings.begin(), buildings.end()); }
 
 	//-----------Get֐-------------
 	DirectX::SimpleMath::Vector2 GetScreenPosition() const { return m_screenPos      ; }
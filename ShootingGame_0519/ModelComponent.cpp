@@ -3,6 +3,14 @@
 #include "GameObject.h"
 #include "Application.h"
 #include "TextureManager.h" //  TextureManager gp
+#include "InstancedModelRenderer.h"
+#include "VertexPacking.h"
+#include "MeshOptimizer.h"
+#include "Logger.h"
+#include "MemoryTracker.h"
+#include "AssetIOSystem.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
 #include <WICTextureLoader.h>
 #include <iostream>
 
@@ -13,6 +21,12 @@
 
 using Microsoft::WRL::ComPtr;
 
+// ̂Ăf VB/IB  MemoryTracker  GPU gpʂiCPU  delete ŎIɈj
+ResidencyCache<ModelComponent::ModelData> ModelComponent::s_modelCache([](const std::string&, const ModelData& model, size_t)
+    {
+        MemoryTracker::AddGpuBytes(MemoryCategory::Model, -static_cast<int64_t>(model.vertexBytes + model.indexBytes));
+    });
+
 // RXgN^ (t@CpXw)
 ModelComponent::ModelComponent(const std::string& filepath)
     : m_filepath(filepath)
@@ -28,6 +42,17 @@ void ModelComponent::Initialize()
     }
 }
 
+std::shared_ptr<Component> ModelComponent::Clone() const
+{
+    // ǂݍݍς݂̋Lf[^piAssimp ̃V[͓ǂݍݎɉς݁j
+    auto clone = std::make_shared<ModelComponent>();
+    clone->m_model = m_model;
+    clone->m_color = m_color;
+    clone->m_useColor = m_useColor;
+    clone->m_instanced = m_instanced;
+    return clone;
+}
+
 // Update ͌ŃAj[VōXVz
 void ModelComponent::Update(float dt)
 {
@@ -38,50 +63,115 @@ void ModelComponent::Update(float dt)
 // ` (Ȉ)
 void ModelComponent::Draw(float alpha)
 {
+    if (!m_model) { return; }
+
     // [hsݒ
-    Matrix4x4 worldMatrix = GetOwner()->GetTransform().GetMatrix();
+    Matrix4x4 worldMatrix = GetOwner()->GetLocalMatrix();
+
+    m_lod = SelectLod(worldMatrix);
+
+    // CX^VOΏۂȂ炱ł͕`A܂Ƃ߂ĕ`悵Ă炤
+    if (m_instanced)
+    {
+        InstancedModelRenderer::Submit(m_model.get(), m_lod, worldMatrix, m_useColor ? m_color : Color(1, 1, 1, 1));
+        return;
+    }
+
     Renderer::SetWorldMatrix(&worldMatrix);
 
+    // k_p̃VF[_[^CAEgɐ؂ւ
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+    ctx->IASetInputLayout(Renderer::m_packedInputLayout.Get());
+    ctx->VSSetShader(Renderer::m_packedVertexShader.Get(), nullptr, 0);
+
     // bVƂɕ`
-    for (auto& mesh : m_meshes)
+    for (auto& mesh : m_model->meshes)
     {
         // ܂FZbg ( Diffuse FsNZVF[_ɓn)
-        ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
         // cbMaterial ̍\̂ Renderer ɂz
+        const Color& diffuse = m_useColor ? m_color : mesh.material.Diffuse;
         MATERIAL cb;
         cb.Diffuse = DirectX::XMFLOAT4(
-            mesh.material.Diffuse.x,
-            mesh.material.Diffuse.y,
-            mesh.material.Diffuse.z,
-            mesh.material.Diffuse.w
+            diffuse.x,
+            diffuse.y,
+            diffuse.z,
+            diffuse.w
         );
-        ctx->UpdateSubresource(Renderer::GetMaterialCB(), 0, nullptr, &cb, 0, 0);
-        ctx->PSSetConstantBuffers(0, 1, Renderer::GetMaterialCBAddress());
+        Renderer::SetMaterial(cb);
 
         // ȉA̒_/CfbNX/eNX`ݒ
-        UINT stride = sizeof(VERTEX_3D);
-        UINT offset = 0;
-        ctx->IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &stride, &offset);
-        ctx->IASetIndexBuffer(mesh.indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+        mesh.BindVertexStreams(ctx);
+        ctx->IASetIndexBuffer(mesh.indexBuffer.Get(), mesh.indexFormat, 0);
         ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
         if (mesh.srvDiffuse)
         {
-            ctx->PSSetShaderResources(0, 1, mesh.srvDiffuse.GetAddressOf());
+            ID3D11ShaderResourceView* srv = mesh.srvDiffuse.get();
+            ctx->PSSetShaderResources(0, 1, &srv);
         }
 
-        ctx->DrawIndexed(mesh.indexCount, 0, 0);
+        const MeshData::LodRange& range = mesh.GetLod(m_lod);
+        ctx->DrawIndexed(range.indexCount, range.indexStart, 0);
     }
+
+    // 㑱 Primitive `̂߂Ɍ̃VF[_[^CAEg֖߂
+    ID3D11Buffer* nullBuffer = nullptr;
+    UINT zero = 0;
+    ctx->IASetVertexBuffers(2, 1, &nullBuffer, &zero, &zero);
+    ctx->IASetInputLayout(Renderer::m_inputLayout.Get());
+    ctx->VSSetShader(Renderer::m_vertexShader.Get(), nullptr, 0);
 }
 
+int ModelComponent::SelectLod(const Matrix4x4& world) const
+{
+    if (m_model->lodCount <= 1 || m_model->boundingRadius <= 0.0f) { return 0; }
+
+    // sei2D `Ȃǁjł͑傫ŕςȂ̂ LOD gȂ
+    const Matrix4x4& proj = Renderer::m_cachedProjection;
+    if (proj._34 == 0.0f) { return 0; }
 
-void ModelComponent::SetColor(const Color& color)
+    // E[hցBa͊g嗦̍ł傫ɍ킹
+    Vector3 center = Vector3::Transform(Vector3(m_model->boundingCenter), world);
+    float scale = (std::max)({ world.Right().Length(), world.Up().Length(), world.Backward().Length() });
+
+    Vector3 cameraPos = Renderer::m_cachedView.Invert().Translation();
+    float screenSize = ComputeScreenSize(m_model->boundingRadius * scale, Vector3::Distance(center, cameraPos), proj._22);
+    return ::SelectLod(screenSize, m_lod, m_model->lodCount);
+}
+
+void ModelComponent::MeshData::BindVertexStreams(ID3D11DeviceContext* ctx) const
+{
+    UINT stride = sizeof(PackedVertex);
+    UINT offset = 0;
+    ctx->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
+    ctx->IASetVertexBuffers(2, 1, colorBuffer.GetAddressOf(), &colorStride, &offset);
+}
+
+size_t ModelComponent::ModelData::GetCpuBytes() const
 {
-    // VvɑSbṼ}eA Diffuse ㏑
-    for (auto& mesh : m_meshes)
+    // ƃnbV}bṽm[h͊mۃTCY̖ڈŐiGPU obt@͊܂܂Ȃj
+    size_t bytes = sizeof(ModelData) + meshes.capacity() * sizeof(MeshData) + materials.capacity() * sizeof(MATERIAL);
+    for (const auto& mesh : meshes)
     {
-        mesh.material.Diffuse = color;
+        bytes += mesh.lods.capacity() * sizeof(MeshData::LodRange) + mesh.boneIndices.capacity() * sizeof(uint16_t);
     }
+    bytes += boneInfos.capacity() * sizeof(BoneInfo);
+    for (const auto& bone : boneInfos)
+    {
+        bytes += bone.name.capacity();
+    }
+    bytes += boneNameToIndex.bucket_count() * sizeof(void*)
+        + boneNameToIndex.size() * (sizeof(std::pair<const std::string, int>) + sizeof(void*));
+    return bytes;
+}
+
+
+void ModelComponent::SetColor(const Color& color)
+{
+    // bVf[^͑̃CX^XƋLĂ̂ŁA
+    // }eA͏ɂ̃CX^X̐FƂĎ
+    m_color = color;
+    m_useColor = true;
 }
 
 // t@C݃`FbN
@@ -110,8 +200,9 @@ bool ModelComponent::FileExists(const std::string& path)
 // }eAƃeNX`̓ǂݍ
 void ModelComponent::LoadMaterials(const aiScene* scene)
 {
-    m_materials.clear();
-    m_materials.resize(scene->mNumMaterials);
+    std::vector<MATERIAL>& materials = m_model->materials;
+    materials.clear();
+    materials.resize(scene->mNumMaterials);
 
     for (UINT i = 0; i < scene->mNumMaterials; ++i)
     {
@@ -144,12 +235,12 @@ void ModelComponent::LoadMaterials(const aiScene* scene)
         // eNX` MeshData ŌʂɎ擾邪A
         // ŃpX肽ꍇ͎擾ĂƂ\B
 
-        m_materials[i] = mat;
+        materials[i] = mat;
     }
 }
 
 // aiMaterial ̃eNX`^Cvǂݍ SRV Ԃ (݂Ȃꍇ nullptr)
-Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ModelComponent::LoadTextureFromMaterial(aiMaterial* mat, aiTextureType t)
+TextureHandle ModelComponent::LoadTextureFromMaterial(aiMaterial* mat, aiTextureType t)
 {
     aiString texPath;
     if (mat->GetTextureCount(t) > 0 && mat->GetTexture(t, 0, &texPath) == AI_SUCCESS)
@@ -172,10 +263,7 @@ Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ModelComponent::LoadTextureFrom
         std::string fullPath = p.string();
 
         //  TextureManager gă[h (UTF8 -> ϊ͓łĂz)
-        ID3D11ShaderResourceView* srv = TextureManager::Load(fullPath);
-
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> comsrv = srv;
-        return comsrv;
+        return TextureManager::Load(fullPath);
     }
     return nullptr;
 }
@@ -183,57 +271,118 @@ Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ModelComponent::LoadTextureFrom
 // ۂ̃fǂݍݏ
 void ModelComponent::LoadModel(const std::string& path)
 {
+    // t@Cǂݍݍς݂Ȃ炻̃f[^L (Assimp ̓ǂݍ݂ VB/IB Ȃ)
+    // ÕV[ŎgIfA\Z𒴂Ď̂Ă܂ł͂Ō
+    if (std::shared_ptr<ModelData> cached = s_modelCache.Find(path))
+    {
+        m_model = cached;
+        return;
+    }
+
+    // Lff[^EAssimp ̈ꎞf[^Ƃ Model ƂĐieNX` TextureManager  Texture ɂȂj
+    MemoryScope memoryScope(MemoryCategory::Model);
+
+    auto model = std::make_shared<ModelData>();
+    m_model = model;
+
     // fBNg擾ĕێ (eNX`ǂݍ݂Ɏgp)
     {
         std::filesystem::path p(path);
         m_directory = p.parent_path().string(); // std::string ɈSɓ
     }
 
-    // Assimp œǂݍ (ׂ̈ɕKvȃtOǉ)
+    // Assimp œǂݍ
     // aiProcess_GenSmoothNormals: @ΐ
-    // aiProcess_CalcTangentSpace: ^WFgԂvZ (m[}}bvpɕKv)
+    // ^WFg PackedVertex ɓĂȂ̂ aiProcess_CalcTangentSpace ͕tȂim[}}bvΉɖ߂j
     unsigned int flags =
         aiProcess_Triangulate |
         aiProcess_GenSmoothNormals |
-        aiProcess_CalcTangentSpace |
         aiProcess_JoinIdenticalVertices |
         aiProcess_SortByPType;
 
-    // m_importer ̓oȂ̂łœǂݍ m_scene ɕێ
-    m_scene = m_importer.ReadFile(path, flags);
+    // C|[^͂̊֐̃[JBVB/IB ƃe[uIAV[Ɗ֐̏Iŉ
+    // t@C AssetArchive oRŊJiA[JCu΃}bvォA΍܂Œʂt@Cj
+    Assimp::Importer importer;
+    importer.SetIOHandler(new AssetIOSystem);
+    const aiScene* scene = importer.ReadFile(path, flags);
 
-    if (!m_scene || (m_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !m_scene->mRootNode)
+    if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode)
     {
-        const char* err = m_importer.GetErrorString();
-        std::string s = "Assimp ReadFile failed: ";
-        s += err ? err : "(null)";
-        s += "\n";
-        OutputDebugStringA(s.c_str());
+        const char* err = importer.GetErrorString();
+        LOG_ERROR("Assimp ReadFile failed: %s: %s", path.c_str(), err ? err : "(null)");
+        m_model.reset();
         return;
     }
 
     // }eA̓ǂݍ (V[S)
-    LoadMaterials(m_scene);
+    LoadMaterials(scene);
 
     // {[W̏ (ł̓bVɒǉĂ)
-    m_boneInfos.clear();
-    m_boneNameToIndex.clear();
+    model->boneInfos.clear();
+    model->boneNameToIndex.clear();
 
     // m[hċAŃbV𐶐
-    ProcessNode(m_scene->mRootNode, m_scene);
+    ProcessNode(scene->mRootNode, scene);
+
+    // LOD Ip̋EiSbV AABB ͂ދj
+    if (model->boundsMin.x <= model->boundsMax.x)
+    {
+        Vector3 mn(model->boundsMin), mx(model->boundsMax);
+        model->boundingCenter = (mn + mx) * 0.5f;
+        model->boundingRadius = Vector3::Distance(mn, mx) * 0.5f;
+    }
 
     // ǂݍ݌̃O
+    LOG_INFO("Model loaded: meshes=%zu bones=%zu materials=%zu vertexBytes=%zu (VERTEX_3D: %zu) indexBytes=%zu",
+        model->meshes.size(), model->boneInfos.size(), model->materials.size(),
+        model->vertexBytes, model->vertexCount * sizeof(VERTEX_3D), model->indexBytes);
+
+    if (model->boneInfos.size() > 256)
     {
-        char buf[256];
-        sprintf_s(buf, "Model loaded: meshes=%zu bones=%zu materials=%zu\n",
-            m_meshes.size(), m_boneInfos.size(), m_materials.size());
-        OutputDebugStringA(buf);
+        LOG_WARN("Model %s: bones=%zu ̓{[CfbNX 8bit Ɏ܂܂", path.c_str(), model->boneInfos.size());
     }
 
+    // V[̑傫ƁAɎc CPU ̃e[ȗ傫
+    aiMemoryInfo memory;
+    importer.GetMemoryRequirements(memory);
+    model->importBytes = memory.total;
+    MemoryTracker::AddGpuBytes(MemoryCategory::Model, static_cast<int64_t>(model->vertexBytes + model->indexBytes));
+    LOG_INFO("Model %s: Assimp scene %zu KB released after upload (resident tables %zu bytes)",
+        path.c_str(), model->importBytes / 1024, model->GetCpuBytes());
+
+    // 瓯pX̓LbVg
+    s_modelCache.Insert(path, model, model->vertexBytes + model->indexBytes + model->GetCpuBytes());
+
     // () Ń{[p̒萔obt@쐬邱Ƃ𐄏
     // : m_cbBones = CreateConstantBuffer(sizeof(XMMATRIX) * MAX_BONES);
 }
 
+void ModelComponent::SetModelCacheBudget(size_t bytes)
+{
+    s_modelCache.SetBudget(bytes);
+}
+
+void ModelComponent::TrimModelCache()
+{
+    const uint64_t evictions = s_modelCache.GetEvictions();
+    const size_t evicted = s_modelCache.Trim();
+    if (evicted > 0)
+    {
+        LOG_INFO("Model cache: evicted %llu models (%zu KB), resident %zu KB / budget %zu KB",
+            static_cast<unsigned long long>(s_modelCache.GetEvictions() - evictions), evicted / 1024,
+            s_modelCache.GetResidentBytes() / 1024, s_modelCache.GetBudget() / 1024);
+    }
+}
+
+void ModelComponent::UninitModelCache()
+{
+    LOG_INFO("Model cache: %zu models resident (%zu KB), hits=%llu misses=%llu evictions=%llu",
+        s_modelCache.GetCount(), s_modelCache.GetResidentBytes() / 1024,
+        static_cast<unsigned long long>(s_modelCache.GetHits()), static_cast<unsigned long long>(s_modelCache.GetMisses()),
+        static_cast<unsigned long long>(s_modelCache.GetEvictions()));
+    s_modelCache.Clear();
+}
+
 // m[hċA
 void ModelComponent::ProcessNode(aiNode* node, const aiScene* scene)
 {
@@ -254,8 +403,8 @@ void ModelComponent::ProcessNode(aiNode* node, const aiScene* scene)
 // bV
 void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
 {
-    // [Jɒ_ECfbNX
-    std::vector<VERTEX_3D> vertices;
+    // [Jɒ_ECfbNXikO̒lBGPU ɑO PackVertices ŋl߂j
+    std::vector<SourceVertex> vertices;
     vertices.resize(mesh->mNumVertices);
 
     // CfbNXz (faces ͎Op`ĂO)
@@ -265,49 +414,37 @@ void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
     // ܂A_𖄂߂
     for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
     {
-        VERTEX_3D v{};
+        SourceVertex v{};
         // ʒu
-        v.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+        v.position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
 
         // @ (ς݂̂͂)
         if (mesh->HasNormals())
         {
-            v.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+            v.normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
         }
         else
         {
-            v.Normal = { 0.f, 1.f, 0.f }; // tH[obN
+            v.normal = { 0.f, 1.f, 0.f }; // tH[obN
         }
 
         // UV
         if (mesh->HasTextureCoords(0))
         {
-            v.TexCoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
+            v.texcoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
         }
         else
         {
-            v.TexCoord = { 0.f, 0.f };
+            v.texcoord = { 0.f, 0.f };
         }
 
-        // _F ()
+        // _F (΁BΔ̂܂)
         if (mesh->HasVertexColors(0))
         {
             aiColor4D c = mesh->mColors[0][i];
-            v.Diffuse = Color(c.r, c.g, c.b, c.a);
-        }
-        else
-        {
-            v.Diffuse = Color(1, 1, 1, 1);
+            v.color = { c.r, c.g, c.b, c.a };
         }
 
-        // {[֘A (ő4EFCgz)
-        for (int bi = 0; bi < 4; ++bi)
-        {
-            v.BoneIndex[bi] = 0;
-            v.BoneWeight[bi] = 0.0f;
-        }
-        v.bonecnt = 0;
-
         vertices[i] = v;
     }
 
@@ -331,17 +468,21 @@ void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
             std::string boneName = aibone->mName.C_Str();
 
             int boneIndex = -1;
-            auto it = m_boneNameToIndex.find(boneName);
-            if (it == m_boneNameToIndex.end())
+            auto it = m_model->boneNameToIndex.find(boneName);
+            if (it == m_model->boneNameToIndex.end())
             {
                 // V{[ȂǉăCfbNXU
+                const aiMatrix4x4& m = aibone->mOffsetMatrix;
                 BoneInfo bi;
                 bi.name = boneName;
-                bi.offsetMatrix = aibone->mOffsetMatrix;
-                bi.finalTransform = aiMatrix4x4(); // 
-                boneIndex = static_cast<int>(m_boneInfos.size());
-                m_boneInfos.push_back(bi);
-                m_boneNameToIndex[boneName] = boneIndex;
+                bi.offsetMatrix = Matrix4x4(
+                    m.a1, m.b1, m.c1, m.d1,
+                    m.a2, m.b2, m.c2, m.d2,
+                    m.a3, m.b3, m.c3, m.d3,
+                    m.a4, m.b4, m.c4, m.d4);
+                boneIndex = static_cast<int>(m_model->boneInfos.size());
+                m_model->boneInfos.push_back(bi);
+                m_model->boneNameToIndex[boneName] = boneIndex;
             }
             else
             {
@@ -354,15 +495,14 @@ void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
                 unsigned int vertexId = aibone->mWeights[w].mVertexId;
                 float weight = aibone->mWeights[w].mWeight;
 
-                // _ BoneWeight zɑ} (󂫃XbgT)
+                // _ boneWeight zɑ} (󂫃XbgT)
                 bool placed = false;
                 for (int slot = 0; slot < 4; ++slot)
                 {
-                    if (vertices[vertexId].BoneWeight[slot] == 0.0f)
+                    if (vertices[vertexId].boneWeight[slot] == 0.0f)
                     {
-                        vertices[vertexId].BoneIndex[slot] = boneIndex;
-                        vertices[vertexId].BoneWeight[slot] = weight;
-                        vertices[vertexId].bonecnt = std::max<int>(vertices[vertexId].bonecnt, slot + 1);
+                        vertices[vertexId].boneIndex[slot] = boneIndex;
+                        vertices[vertexId].boneWeight[slot] = weight;
                         placed = true;
                         break;
                     }
@@ -371,17 +511,17 @@ void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
                 {
                     // 4܂ĂłEFCguȈՐ헪
                     int minIdx = 0;
-                    float minW = vertices[vertexId].BoneWeight[0];
+                    float minW = vertices[vertexId].boneWeight[0];
                     for (int s = 1; s < 4; ++s)
                     {
-                        if (vertices[vertexId].BoneWeight[s] < minW)
+                        if (vertices[vertexId].boneWeight[s] < minW)
                         {
-                            minW = vertices[vertexId].BoneWeight[s];
+                            minW = vertices[vertexId].boneWeight[s];
                             minIdx = s;
                         }
                     }
-                    vertices[vertexId].BoneIndex[minIdx] = boneIndex;
-                    vertices[vertexId].BoneWeight[minIdx] = weight;
+                    vertices[vertexId].boneIndex[minIdx] = boneIndex;
+                    vertices[vertexId].boneWeight[minIdx] = weight;
                 }
             }
         }
@@ -389,28 +529,61 @@ void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
         // (IvV) e_̃EFCgv 1.0 ɂȂ悤K
         for (auto& v : vertices)
         {
-            float sum = v.BoneWeight[0] + v.BoneWeight[1] + v.BoneWeight[2] + v.BoneWeight[3];
+            float sum = v.boneWeight[0] + v.boneWeight[1] + v.boneWeight[2] + v.boneWeight[3];
             if (sum > 0.0f && sum != 1.0f)
             {
-                v.BoneWeight[0] /= sum;
-                v.BoneWeight[1] /= sum;
-                v.BoneWeight[2] /= sum;
-                v.BoneWeight[3] /= sum;
+                v.boneWeight[0] /= sum;
+                v.boneWeight[1] /= sum;
+                v.boneWeight[2] /= sum;
+                v.boneWeight[3] /= sum;
             }
         }
     }
 
-    // }eA擾 (mesh->mMaterialIndex LȂ m_materials Q)
+    // _LbVEI[o[h[E_tFb`̏ɕבւi{[̔fōsƁj
+    std::vector<MeshPosition> positions(vertices.size());
+    auto gatherPositions = [&]()
+    {
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            positions[i] = { vertices[i].position.x, vertices[i].position.y, vertices[i].position.z };
+        }
+    };
+    gatherPositions();
+    MeshOptimizeStats optStats = OptimizeMesh(indices, vertices, positions);
+
+    // LODF_͋L܂܁Aבւ̒_ŊȗCfbNX LOD Ƃɍ
+    gatherPositions();
+    std::vector<MeshSimplifyResult> lods = BuildMeshLods(indices, positions);
+
+    std::string lodLog;
+    for (size_t lod = 0; lod < lods.size(); ++lod)
+    {
+        if (lod > 0) { OptimizeVertexCache(lods[lod].indices, vertices.size()); }
+        lodLog += (lod > 0 ? "/" : "") + std::to_string(lods[lod].indices.size() / 3);
+    }
+    m_model->lodCount = (std::max)(m_model->lodCount, static_cast<int>(lods.size()));
+
+    for (const MeshPosition& p : positions)
+    {
+        m_model->boundsMin = { (std::min)(m_model->boundsMin.x, p.x), (std::min)(m_model->boundsMin.y, p.y), (std::min)(m_model->boundsMin.z, p.z) };
+        m_model->boundsMax = { (std::max)(m_model->boundsMax.x, p.x), (std::max)(m_model->boundsMax.y, p.y), (std::max)(m_model->boundsMax.z, p.z) };
+    }
+
+    LOG_INFO("Mesh %s: tris=%s ACMR %.3f -> %.3f index=%dbit lodError=%.4f",
+        mesh->mName.C_Str(), lodLog.c_str(), optStats.acmrBefore, optStats.acmrAfter, optStats.index16 ? 16 : 32,
+        lods.back().error);
+
+    // }eA擾 (mesh->mMaterialIndex LȂ materials Q)
     MATERIAL mat{};
-    if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)m_materials.size())
+    if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)m_model->materials.size())
     {
-        mat = m_materials[mesh->mMaterialIndex];
+        mat = m_model->materials[mesh->mMaterialIndex];
     }
 
     // MeshData 
     MeshData meshData;
     meshData.material = mat;
-    meshData.indexCount = static_cast<UINT>(indices.size());
 
     // }eAeNX` (Diffuse/Normal/Specular) [h (݂)
     if (mesh->mMaterialIndex >= 0)
@@ -421,49 +594,102 @@ void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
         meshData.srvSpecular = LoadTextureFromMaterial(aimat, aiTextureType_SPECULAR);
     }
 
-    // _obt@쐬
-    D3D11_BUFFER_DESC vbDesc{};
-    vbDesc.Usage = D3D11_USAGE_DEFAULT;
-    vbDesc.ByteWidth = static_cast<UINT>(sizeof(VERTEX_3D) * vertices.size());
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vbDesc.CPUAccessFlags = 0;
+    // _kăXg[Ƃ̃obt@
+    PackedMesh packed = PackVertices(vertices, mesh->HasBones());
+
+    auto createVertexBuffer = [](const void* data, size_t bytes, ComPtr<ID3D11Buffer>& out)
+        {
+            D3D11_BUFFER_DESC desc{};
+            desc.Usage = D3D11_USAGE_IMMUTABLE;
+            desc.ByteWidth = static_cast<UINT>(bytes);
+            desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+            D3D11_SUBRESOURCE_DATA init{};
+            init.pSysMem = data;
+
+            HRESULT hr = Renderer::GetDevice()->CreateBuffer(&desc, &init, out.GetAddressOf());
+            return SUCCEEDED(hr) && out;
+        };
+
+    if (!createVertexBuffer(packed.vertices.data(), sizeof(PackedVertex) * packed.vertices.size(), meshData.vertexBuffer))
+    {
+        LOG_ERROR("Failed to create vertex buffer for mesh");
+        return;
+    }
 
-    D3D11_SUBRESOURCE_DATA vbData{};
-    vbData.pSysMem = vertices.data();
+    // _FbVŜœȂ 1 F̃obt@ stride 0 őS_Ɏg
+    PackedColor uniformColor = PackColor(packed.uniformColor);
+    bool colorOk = packed.colors.empty()
+        ? createVertexBuffer(&uniformColor, sizeof(PackedColor), meshData.colorBuffer)
+        : createVertexBuffer(packed.colors.data(), sizeof(PackedColor) * packed.colors.size(), meshData.colorBuffer);
+    meshData.colorStride = packed.colors.empty() ? 0 : sizeof(PackedColor);
+    if (!colorOk)
+    {
+        LOG_ERROR("Failed to create color buffer for mesh");
+        return;
+    }
 
-    HRESULT hr = Renderer::GetDevice()->CreateBuffer(&vbDesc, &vbData, meshData.vertexBuffer.GetAddressOf());
-    if (FAILED(hr) || !meshData.vertexBuffer)
+    if (!packed.skin.empty() &&
+        !createVertexBuffer(packed.skin.data(), sizeof(PackedSkin) * packed.skin.size(), meshData.skinBuffer))
     {
-        OutputDebugStringA("Failed to create vertex buffer for mesh\n");
+        LOG_ERROR("Failed to create skin buffer for mesh");
         return;
     }
 
-    // CfbNXobt@쐬
+    m_model->vertexCount += vertices.size();
+    m_model->vertexBytes += sizeof(PackedVertex) * packed.vertices.size()
+        + sizeof(PackedColor) * (std::max)(packed.colors.size(), size_t(1))
+        + sizeof(PackedSkin) * packed.skin.size();
+
+    // CfbNXobt@쐬iS LOD 𑱂ēB16bit Ɏ܂Ȃl߂j
+    std::vector<uint32_t> allIndices;
+    for (const MeshSimplifyResult& lod : lods)
+    {
+        MeshData::LodRange range;
+        range.indexStart = static_cast<UINT>(allIndices.size());
+        range.indexCount = static_cast<UINT>(lod.indices.size());
+        meshData.lods.push_back(range);
+        allIndices.insert(allIndices.end(), lod.indices.begin(), lod.indices.end());
+    }
+
+    std::vector<uint16_t> indices16;
+    const void* indexData = allIndices.data();
+    UINT indexBytes = static_cast<UINT>(sizeof(uint32_t) * allIndices.size());
+    if (optStats.index16)
+    {
+        indices16.reserve(allIndices.size());
+        for (uint32_t index : allIndices) { indices16.push_back(static_cast<uint16_t>(index)); }
+        indexData = indices16.data();
+        indexBytes = static_cast<UINT>(sizeof(uint16_t) * indices16.size());
+        meshData.indexFormat = DXGI_FORMAT_R16_UINT;
+    }
+    m_model->indexBytes += indexBytes;
+
     D3D11_BUFFER_DESC ibDesc{};
-    ibDesc.Usage = D3D11_USAGE_DEFAULT;
-    ibDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * indices.size());
+    ibDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    ibDesc.ByteWidth = indexBytes;
     ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
     ibDesc.CPUAccessFlags = 0;
 
     D3D11_SUBRESOURCE_DATA ibData{};
-    ibData.pSysMem = indices.data();
+    ibData.pSysMem = indexData;
 
-    hr = Renderer::GetDevice()->CreateBuffer(&ibDesc, &ibData, meshData.indexBuffer.GetAddressOf());
+    HRESULT hr = Renderer::GetDevice()->CreateBuffer(&ibDesc, &ibData, meshData.indexBuffer.GetAddressOf());
     if (FAILED(hr) || !meshData.indexBuffer)
     {
-        OutputDebugStringA("Failed to create index buffer for mesh\n");
+        LOG_ERROR("Failed to create index buffer for mesh");
         return;
     }
 
-    // ̃bVɊ܂܂{[Xg (KvȂg)
+    // ̃bVɊ܂܂{[iO boneInfos  1 Ał̓CfbNXj
     if (mesh->HasBones())
     {
-        meshData.boneNames.reserve(mesh->mNumBones);
+        meshData.boneIndices.reserve(mesh->mNumBones);
         for (UINT b = 0; b < mesh->mNumBones; ++b)
         {
-            meshData.boneNames.emplace_back(mesh->mBones[b]->mName.C_Str());
+            meshData.boneIndices.push_back(static_cast<uint16_t>(m_model->boneNameToIndex[mesh->mBones[b]->mName.C_Str()]));
         }
     }
     // Ō push_back
-    m_meshes.push_back(std::move(meshData));
+    m_model->meshes.push_back(std::move(meshData));
 }
@@ -1,9 +1,10 @@
 #pragma once
 #include "Component.h"
 #include "renderer.h"
+#include "MeshSimplifier.h"
+#include "TextureManager.h"
+#include "ResidencyCache.h"
 #include <assimp/scene.h>
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
 #include <string>
 #include <vector>
 #include <memory>
@@ -11,6 +12,8 @@
 #include <wrl/client.h>
 #include <unordered_map>
 #include <filesystem>
+#include <algorithm>
+#include <cfloat>
 
 class ModelComponent : public Component
 {
@@ -37,51 +40,126 @@ public:
     //
     void SetColor(const Color& color);
 
-private:
-    // 
-    void ProcessNode(aiNode* node, const aiScene* scene);
-    void ProcessMesh(aiMesh* mesh, const aiScene* scene);
-    void LoadMaterials(const aiScene* scene); // V[}eAꗗ
-    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> LoadTextureFromMaterial(aiMaterial* mat, aiTextureType t);
+    //CX^VO`ɉ񂷂ǂiG⌚ȂǓfʂɒǔj
+    //true ̏ꍇ Draw() ł͕`悹 InstancedModelRenderer ɕ`vς
+    void SetInstanced(bool instanced) { m_instanced = instanced; }
+    bool IsInstanced() const { return m_instanced; }
+
+    //O Draw() őI LODi0 łׂj
+    int GetCurrentLod() const { return m_lod; }
 
-    // XLjOî߂̃f[^j
+    //ivnupjBff[^͋LA`ݒ肾Rs[
+    std::shared_ptr<Component> Clone() const override;
+
+    // XLjOî߂̃f[^jBǂݍ݌Ɏĉ͖OƋtoChs񂾂
+    // iAj[V̍ŏIs̓CX^XƂɕς̂ŁALf[^ɂ͒uȂj
     struct BoneInfo
     {
         std::string name;                 // {[
-        aiMatrix4x4 offsetMatrix;         // inverse bind pose
-        // ŏIϊs (Aj[VvZɂɓ)
-        aiMatrix4x4 finalTransform;
+        Matrix4x4 offsetMatrix;           // inverse bind poseiaiBone::mOffsetMatrix ]učsxNg`ɂ́j
     };
 
     // 1bṼf[^
     struct MeshData
     {
-        Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+        // _ VertexPacking.h ̈k`ŃXg[ƂɕĎ
+        Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;  // PackedVertexiXbg0j
+        Microsoft::WRL::ComPtr<ID3D11Buffer> colorBuffer;   // _FiXbg2jBlȐFȂ 1 F stride 0 Ŏg
+        UINT colorStride = 0;
+        Microsoft::WRL::ComPtr<ID3D11Buffer> skinBuffer;    // PackedSkiniXLbVBXLjO`͖j
         Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
-        UINT indexCount = 0;
+        DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT;     // _ 65535 ȉȂ R16_UINT
+
+        // LOD Ƃ̃CfbNX͈̔́iS LOD  1 ̃CfbNXobt@ɑēB_͋Lj
+        struct LodRange
+        {
+            UINT indexStart = 0;
+            UINT indexCount = 0;
+        };
+        std::vector<LodRange> lods;     // lods[0] ̃bV
+
+        // ̃bVɖ LOD w肳ꂽłe LOD Ԃ
+        const LodRange& GetLod(int lod) const { return lods[(std::min)(lod, static_cast<int>(lods.size()) - 1)]; }
+
+        // _Xg[̓Xbgɐݒ肷iʏ`ECX^VO`ŋʁj
+        void BindVertexStreams(ID3D11DeviceContext* ctx) const;
 
         MATERIAL material; //  MATERIAL ^ɍ킹Ċi[
         // eNX`ΉiKvɉđ₷j
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvDiffuse;
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvNormal;
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvSpecular;
+        // inhĂԂ TextureManager ̂ĂȂj
+        TextureHandle srvDiffuse;
+        TextureHandle srvNormal;
+        TextureHandle srvSpecular;
 
-        // XLjOpF̃bVɊ܂܂{[̖OXg / CfbNX globalBoneMap Q
-        std::vector<std::string> boneNames;
+        // XLjOpF̃bVɊ܂܂{[iModelData::boneInfos ̃CfbNXj
+        std::vector<uint16_t> boneIndices;
     };
 
-    std::vector<MeshData> m_meshes;
+    // t@Cǂݍ ModelComponent mŋL郂ff[^
+    // iVB/IBE}eAE{[j
+    struct ModelData
+    {
+        std::vector<MeshData> meshes;
+
+        // {[}bvi{[ -> O[oCfbNXj
+        std::vector<BoneInfo> boneInfos;
+        std::unordered_map<std::string, int> boneNameToIndex;
+
+        // }eAXgiV[Pʁj
+        std::vector<MATERIAL> materials;
+
+        // _f[^̓vik̃oCgƒ_j
+        size_t vertexBytes = 0;
+        size_t vertexCount = 0;
+        size_t indexBytes = 0;
+
+        // LOD ̐ibVƂ LOD ̍őjƁALOD IɎgEifԁj
+        int lodCount = 1;
+        DirectX::XMFLOAT3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+        DirectX::XMFLOAT3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        DirectX::XMFLOAT3 boundingCenter = { 0.0f, 0.0f, 0.0f };
+        float boundingRadius = 0.0f;
+
+        // ǂݍ݂Ɏg Assimp ̃V[̑傫iAbv[hɉ̂ŏ풓͂ȂBOpj
+        size_t importBytes = 0;
+
+        // CPU ɏ풓e[uibVE{[E}eAĵ悻̃oCg
+        size_t GetCpuBytes() const;
+    };
+
+    //Lff[^̎擾iCX^VÕO[ṽL[ɂgj
+    const ModelData* GetModelData() const { return m_model.get(); }
+
+    //------------------------------Lff[^̃LbV------------------------------
+    // gĂȂfcĂiVB/IB + CPU ̃e[uB0 ͏Ȃj
+    static void SetModelCacheBudget(size_t bytes);
+    // 𒴂ĂΎgĂȂfÂɎ̂ĂiV[ Init ̌ɌĂԁj
+    static void TrimModelCache();
+    // ׂĎiIj
+    static void UninitModelCache();
+
+private:
+    // 
+    void ProcessNode(aiNode* node, const aiScene* scene);
+    void ProcessMesh(aiMesh* mesh, const aiScene* scene);
+    void LoadMaterials(const aiScene* scene); // V[}eAꗗ
+    TextureHandle LoadTextureFromMaterial(aiMaterial* mat, aiTextureType t);
+
+    // Ẻʏ̑傫 LOD Iԁim_lod qXeVXtœj
+    int SelectLod(const Matrix4x4& world) const;
+
+    std::shared_ptr<ModelData> m_model;
+
+    // ǂݍݍς݃f̃LbVit@CpX -> Lff[^Bm_model  ModelComponent Ԃ͎̂ĂȂj
+    static ResidencyCache<ModelData> s_modelCache;
 
-    // Assimp ̃C|[^ƃV[oɎ lifetime ΂
-    Assimp::Importer m_importer;
-    const aiScene* m_scene = nullptr;
+    // CX^XƂ̐FiSetColor ŏ㏑ꂽꍇ̂ݎgj
+    Color m_color = Color(1, 1, 1, 1);
+    bool m_useColor = false;
 
-    // {[}bvi{[ -> O[oCfbNXj
-    std::vector<BoneInfo> m_boneInfos;
-    std::unordered_map<std::string, int> m_boneNameToIndex;
+    bool m_instanced = false;
 
-    // }eAXgiV[Pʁj
-    std::vector<MATERIAL> m_materials;
+    int m_lod = 0;
 
     // t@CpX֘A
     std::string m_filepath;
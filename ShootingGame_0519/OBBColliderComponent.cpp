@@ -24,8 +24,7 @@ Vector3 OBBColliderComponent::GetCenter() const
         m_LocalOffset.z * owner->GetScale().z);
 
     // ]iIuWFNǧjɂ胍[JItZbg[hɉ
-    Vector3 rot = owner->GetRotation();
-    Matrix rotMat = Matrix::CreateFromYawPitchRoll(rot.y, rot.x, rot.z);
+    const Matrix& rotMat = owner->GetRotationMatrix();
 
     Vector3 worldOffset = Vector3::Transform(scaledOffset, rotMat);
 
@@ -53,6 +52,5 @@ DirectX::SimpleMath::Matrix OBBColliderComponent::GetRotationMatrix() const
     {
         return DirectX::SimpleMath::Matrix::Identity;
     }
-    Vector3 rot = owner->GetRotation();
-    return DirectX::SimpleMath::Matrix::CreateFromYawPitchRoll(rot.y, rot.x, rot.z);
+    return owner->GetRotationMatrix();
 }
\ No newline at end of file
@@ -30,6 +30,9 @@ public:
     void SetLocalOffset(const Vector3& offset) { m_LocalOffset = offset; }
     const Vector3& GetLocalOffset() const { return m_LocalOffset; }
 
+    //ivnupj
+    std::shared_ptr<Component> Clone() const override { return std::make_shared<OBBColliderComponent>(*this); }
+
 private:
 
     //AAs̑傫ꂼݒłϐ
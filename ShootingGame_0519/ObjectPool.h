@@ -0,0 +1,96 @@
+﻿#pragma once
+#include <memory>
+#include <vector>
+#include "Handle.h"
+
+//------------------------------------------------------------
+// 型ごとのオブジェクトプール
+// ・Release() したオブジェクトは破棄せずに持っておき、次の Acquire() でそのまま使い回す
+// ・一度プールが温まれば Acquire / Release でヒープ確保は起きない
+// ・スロットは世代付きハンドルで管理するので、返却済みのハンドルは Get() で nullptr になる
+//
+// シーンは shared_ptr でオブジェクトを持つので、プール側も shared_ptr で保持している
+// （シーンから外れてもプールが持っているので破棄されない）
+//------------------------------------------------------------
+template<typename T>
+class ObjectPool
+{
+public:
+    //空きがあれば再利用、無ければ新しく作る
+    //outCreated : 新規作成なら true（呼び出し側で初回だけの初期化をするため）
+    std::shared_ptr<T> Acquire(Handle<T>& outHandle, bool& outCreated)
+    {
+        uint32_t index;
+        if (!m_free.empty())
+        {
+            index = m_free.back();
+            m_free.pop_back();
+            outCreated = false;
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back({});
+            m_slots[index].object = std::make_shared<T>();
+            outCreated = true;
+        }
+
+        Slot& slot = m_slots[index];
+        slot.active = true;
+
+        outHandle.index = index;
+        outHandle.generation = slot.generation;
+        return slot.object;
+    }
+
+    //プールに返す（オブジェクトは破棄しない）
+    void Release(Handle<T> h)
+    {
+        if (!IsValid(h)) { return; }
+
+        Slot& slot = m_slots[h.index];
+        slot.active = false;
+        ++slot.generation;
+        m_free.push_back(h.index);
+    }
+
+    bool IsValid(Handle<T> h) const
+    {
+        return h.index < m_slots.size()
+            && m_slots[h.index].active
+            && m_slots[h.index].generation == h.generation;
+    }
+
+    T* Get(Handle<T> h) const
+    {
+        return IsValid(h) ? m_slots[h.index].object.get() : nullptr;
+    }
+
+    //管理配列だけ先に確保しておく
+    void Reserve(size_t count)
+    {
+        m_slots.reserve(count);
+        m_free.reserve(count);
+    }
+
+    //全オブジェクトを破棄する（シーン終了時など、誰も使っていないときに呼ぶ）
+    void Clear()
+    {
+        m_slots.clear();
+        m_free.clear();
+    }
+
+    size_t GetActiveCount() const { return m_slots.size() - m_free.size(); }
+    size_t GetPooledCount() const { return m_slots.size(); }
+
+private:
+    struct Slot
+    {
+        std::shared_ptr<T> object;
+        uint32_t generation = 0;
+        bool active = false;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_free;
+};
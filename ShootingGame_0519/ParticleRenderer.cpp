@@ -0,0 +1,258 @@
+﻿#include "ParticleRenderer.h"
+#include "ParticleSystem.h"
+#include "renderer.h"
+#include "Logger.h"
+#include "MemoryTracker.h"
+
+Microsoft::WRL::ComPtr<ID3D11Buffer> ParticleRenderer::m_vertexBuffer;
+Microsoft::WRL::ComPtr<ID3D11Buffer> ParticleRenderer::m_indexBuffer;
+size_t ParticleRenderer::m_capacity = 0;
+
+std::vector<float> ParticleRenderer::m_frameUV;
+
+ParticleRenderer::SavedState ParticleRenderer::m_saved;
+bool ParticleRenderer::m_begun = false;
+
+int ParticleRenderer::m_drawCalls = 0;
+int ParticleRenderer::m_particles = 0;
+int ParticleRenderer::m_lastDrawCalls = 0;
+int ParticleRenderer::m_lastParticles = 0;
+
+namespace
+{
+    //ビルボード用シェーダーの入力レイアウトと同じ並び
+    struct ParticleVertex
+    {
+        DirectX::XMFLOAT3 pos;
+        DirectX::XMFLOAT2 uv;
+        DirectX::XMFLOAT4 color;
+    };
+
+    //capacity 粒分の頂点バッファ + インデックスバッファのバイト数（MemoryTracker への計上用）
+    int64_t GetBufferBytes(size_t capacity)
+    {
+        return static_cast<int64_t>((sizeof(ParticleVertex) * 4 + sizeof(uint32_t) * 6) * capacity);
+    }
+}
+
+bool ParticleRenderer::EnsureCapacity(size_t particleCount)
+{
+    if (m_vertexBuffer && particleCount <= m_capacity) { return true; }
+
+    // 足りない場合は倍々で確保し直す（毎フレームの作り直しを避ける）
+    size_t newCapacity = (m_capacity > 0) ? m_capacity : 1024;
+    while (newCapacity < particleCount) { newCapacity *= 2; }
+
+    ID3D11Device* device = Renderer::GetDevice();
+
+    //--------------頂点バッファ（1 粒 4 頂点・毎フレーム書き換え）------------------
+    D3D11_BUFFER_DESC vbDesc{};
+    vbDesc.ByteWidth = static_cast<UINT>(sizeof(ParticleVertex) * 4 * newCapacity);
+    vbDesc.Usage = D3D11_USAGE_DYNAMIC;
+    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    vbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> vb;
+    if (FAILED(device->CreateBuffer(&vbDesc, nullptr, vb.GetAddressOf())))
+    {
+        LOG_ERROR("[ParticleRenderer] Failed to create vertex buffer");
+        return false;
+    }
+
+    //--------------インデックスバッファ（四角形の並びは固定なので作るときに 1 回だけ書く）------------------
+    std::vector<uint32_t> indices(newCapacity * 6);
+    for (size_t i = 0; i < newCapacity; ++i)
+    {
+        uint32_t v = static_cast<uint32_t>(i * 4);
+        uint32_t* dst = &indices[i * 6];
+        dst[0] = v + 0; dst[1] = v + 1; dst[2] = v + 2;
+        dst[3] = v + 1; dst[4] = v + 3; dst[5] = v + 2;
+    }
+
+    D3D11_BUFFER_DESC ibDesc{};
+    ibDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * indices.size());
+    ibDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+    D3D11_SUBRESOURCE_DATA init{};
+    init.pSysMem = indices.data();
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> ib;
+    if (FAILED(device->CreateBuffer(&ibDesc, &init, ib.GetAddressOf())))
+    {
+        LOG_ERROR("[ParticleRenderer] Failed to create index buffer");
+        return false;
+    }
+
+    //作り直した分だけ GPU の使用量を差し替える
+    MemoryTracker::AddGpuBytes(MemoryCategory::Effect,
+        static_cast<int64_t>(vbDesc.ByteWidth + ibDesc.ByteWidth) - GetBufferBytes(m_capacity));
+
+    m_vertexBuffer = vb;
+    m_indexBuffer = ib;
+    m_capacity = newCapacity;
+    return true;
+}
+
+void ParticleRenderer::Begin()
+{
+    if (m_begun) { return; }
+    m_begun = true;
+
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+
+    //--------------GPUステート保存------------------
+    ctx->VSGetShader(&m_saved.vs, nullptr, nullptr);
+    ctx->PSGetShader(&m_saved.ps, nullptr, nullptr);
+    ctx->IAGetInputLayout(&m_saved.il);
+    ctx->OMGetBlendState(&m_saved.blend, m_saved.blendFactor, &m_saved.sampleMask);
+    ctx->OMGetDepthStencilState(&m_saved.dss, &m_saved.stencilRef);
+    ctx->IAGetPrimitiveTopology(&m_saved.topology);
+    ctx->IAGetVertexBuffers(0, 1, &m_saved.vb, &m_saved.stride, &m_saved.offset);
+    ctx->IAGetIndexBuffer(&m_saved.ib, &m_saved.ibFormat, &m_saved.ibOffset);
+
+    //--------------パーティクル共通のステート------------------
+    // 深度：テストのみ（壁の裏に出ない）
+    Renderer::SetDepthEnable(true);
+
+    // 頂点が既にワールド座標なのでワールド行列は Identity
+    DirectX::SimpleMath::Matrix world = DirectX::SimpleMath::Matrix::Identity;
+    Renderer::SetWorldMatrix(reinterpret_cast<Matrix4x4*>(&world));
+
+    ctx->IASetInputLayout(Renderer::m_billboardInputLayout.Get());
+    ctx->VSSetShader(Renderer::m_billboardVertexShader.Get(), nullptr, 0);
+    ctx->PSSetShader(Renderer::m_billboardPixelShader.Get(), nullptr, 0);
+    ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void ParticleRenderer::Draw(const ParticleBuffer& buffer, ID3D11ShaderResourceView* texture,
+                            int cols, int rows, bool isAdditive)
+{
+    size_t count = buffer.GetCount();
+    if (!m_begun || !texture || count == 0) { return; }
+
+    if (!EnsureCapacity(count)) { return; }
+
+    if (cols <= 0) { cols = 1; }
+    if (rows <= 0) { rows = 1; }
+
+    //--------------コマ番号 -> UV の表------------------
+    int frameCount = cols * rows;
+    float du = 1.0f / static_cast<float>(cols);
+    float dv = 1.0f / static_cast<float>(rows);
+
+    m_frameUV.resize(static_cast<size_t>(frameCount) * 2);
+    for (int f = 0; f < frameCount; ++f)
+    {
+        m_frameUV[f * 2 + 0] = static_cast<float>(f % cols) * du;
+        m_frameUV[f * 2 + 1] = static_cast<float>(f / cols) * dv;
+    }
+
+    //--------------ビルボードの向き（カメラのRight/Up）------------------
+    DirectX::SimpleMath::Matrix invView = Renderer::m_cachedView.Invert();
+    DirectX::SimpleMath::Vector3 camRight = invView.Right();
+    DirectX::SimpleMath::Vector3 camUp = invView.Up();
+
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+
+    //--------------動的バッファへ直接展開------------------
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    if (FAILED(ctx->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) { return; }
+
+    auto* v = static_cast<ParticleVertex*>(mapped.pData);
+
+    const float* px = buffer.GetPositionX();
+    const float* py = buffer.GetPositionY();
+    const float* pz = buffer.GetPositionZ();
+    const float* size = buffer.GetSize();
+    const float* frame = buffer.GetFrame();
+    const float* cr = buffer.GetColorR();
+    const float* cg = buffer.GetColorG();
+    const float* cb = buffer.GetColorB();
+    const float* ca = buffer.GetColorA();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        float half = size[i] * 0.5f;
+        float rx = camRight.x * half, ry = camRight.y * half, rz = camRight.z * half;
+        float ux = camUp.x * half, uy = camUp.y * half, uz = camUp.z * half;
+
+        int f = static_cast<int>(frame[i]);
+        if (f < 0 || f >= frameCount) { f = frameCount - 1; }
+        float u0 = m_frameUV[f * 2 + 0];
+        float v0 = m_frameUV[f * 2 + 1];
+        float u1 = u0 + du;
+        float v1 = v0 + dv;
+
+        DirectX::XMFLOAT4 color(cr[i], cg[i], cb[i], ca[i]);
+
+        // 左上・右上・左下・右下
+        v[0] = { { px[i] - rx + ux, py[i] - ry + uy, pz[i] - rz + uz }, { u0, v0 }, color };
+        v[1] = { { px[i] + rx + ux, py[i] + ry + uy, pz[i] + rz + uz }, { u1, v0 }, color };
+        v[2] = { { px[i] - rx - ux, py[i] - ry - uy, pz[i] - rz - uz }, { u0, v1 }, color };
+        v[3] = { { px[i] + rx - ux, py[i] + ry - uy, pz[i] + rz - uz }, { u1, v1 }, color };
+        v += 4;
+    }
+
+    ctx->Unmap(m_vertexBuffer.Get(), 0);
+
+    //--------------描画------------------
+    // ブレンド：爆発=加算、煙=アルファ、など
+    Renderer::SetBlendState(isAdditive ? BS_ADDITIVE : BS_ALPHABLEND);
+
+    UINT stride = sizeof(ParticleVertex);
+    UINT offset = 0;
+    ctx->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
+    ctx->IASetIndexBuffer(m_indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    ctx->PSSetShaderResources(0, 1, &texture);
+
+    ctx->DrawIndexed(static_cast<UINT>(count * 6), 0, 0);
+
+    m_drawCalls++;
+    m_particles += static_cast<int>(count);
+}
+
+void ParticleRenderer::End()
+{
+    if (!m_begun) { return; }
+    m_begun = false;
+
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+
+    // SRV解除（次の描画で事故りにくくする）
+    ID3D11ShaderResourceView* nullSRV = nullptr;
+    ctx->PSSetShaderResources(0, 1, &nullSRV);
+
+    //--------------復元------------------
+    ctx->VSSetShader(m_saved.vs, nullptr, 0);
+    ctx->PSSetShader(m_saved.ps, nullptr, 0);
+    ctx->IASetInputLayout(m_saved.il);
+    ctx->OMSetBlendState(m_saved.blend, m_saved.blendFactor, m_saved.sampleMask);
+    ctx->OMSetDepthStencilState(m_saved.dss, m_saved.stencilRef);
+    ctx->IASetPrimitiveTopology(m_saved.topology);
+    ctx->IASetVertexBuffers(0, 1, &m_saved.vb, &m_saved.stride, &m_saved.offset);
+    ctx->IASetIndexBuffer(m_saved.ib, m_saved.ibFormat, m_saved.ibOffset);
+
+    if (m_saved.vs) m_saved.vs->Release();
+    if (m_saved.ps) m_saved.ps->Release();
+    if (m_saved.il) m_saved.il->Release();
+    if (m_saved.blend) m_saved.blend->Release();
+    if (m_saved.dss) m_saved.dss->Release();
+    if (m_saved.vb) m_saved.vb->Release();
+    if (m_saved.ib) m_saved.ib->Release();
+    m_saved = SavedState{};
+
+    m_lastDrawCalls = m_drawCalls;
+    m_lastParticles = m_particles;
+    m_drawCalls = 0;
+    m_particles = 0;
+}
+
+void ParticleRenderer::Uninit()
+{
+    MemoryTracker::AddGpuBytes(MemoryCategory::Effect, -GetBufferBytes(m_capacity));
+    m_vertexBuffer.Reset();
+    m_indexBuffer.Reset();
+    m_capacity = 0;
+    m_frameUV.clear();
+}
@@ -0,0 +1,66 @@
+﻿#pragma once
+#include <vector>
+#include <d3d11.h>
+#include <wrl/client.h>
+
+class ParticleBuffer;
+
+//------------------------------------------------------------
+// ParticleBuffer の中身をビルボードに展開して描画するクラス
+// ・1 つのバッファ（= 1 枚のアトラス）を 1 回の DrawIndexed でまとめて描く
+// ・頂点は動的バッファに直接書き込み、インデックスは四角形の並びを使い回す
+// ・Begin() 〜 End() の間で Draw() を呼ぶ（GPU ステートの保存・復元は Begin / End でまとめて行う）
+//------------------------------------------------------------
+class ParticleRenderer
+{
+public:
+    static void Begin();
+    static void Draw(const ParticleBuffer& buffer, ID3D11ShaderResourceView* texture,
+                     int cols, int rows, bool isAdditive);
+    static void End();
+
+    //頂点・インデックスバッファの解放
+    static void Uninit();
+
+    //直前のフレームで発行したドローコール数 / 描画した粒数（デバッグ表示用）
+    static int GetLastDrawCallCount() { return m_lastDrawCalls; }
+    static int GetLastParticleCount() { return m_lastParticles; }
+
+private:
+    //バッファの容量が足りなければ作り直す
+    static bool EnsureCapacity(size_t particleCount);
+
+    static Microsoft::WRL::ComPtr<ID3D11Buffer> m_vertexBuffer;
+    static Microsoft::WRL::ComPtr<ID3D11Buffer> m_indexBuffer;
+    static size_t m_capacity;
+
+    //コマ番号 -> UV 左上（アトラスごとに作り直す）
+    static std::vector<float> m_frameUV;
+
+    //Begin() 時点のステート
+    struct SavedState
+    {
+        ID3D11VertexShader* vs = nullptr;
+        ID3D11PixelShader* ps = nullptr;
+        ID3D11InputLayout* il = nullptr;
+        ID3D11BlendState* blend = nullptr;
+        FLOAT blendFactor[4] = { 0, 0, 0, 0 };
+        UINT sampleMask = 0xFFFFFFFF;
+        ID3D11DepthStencilState* dss = nullptr;
+        UINT stencilRef = 0;
+        D3D11_PRIMITIVE_TOPOLOGY topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+        ID3D11Buffer* vb = nullptr;
+        UINT stride = 0;
+        UINT offset = 0;
+        ID3D11Buffer* ib = nullptr;
+        DXGI_FORMAT ibFormat = DXGI_FORMAT_UNKNOWN;
+        UINT ibOffset = 0;
+    };
+    static SavedState m_saved;
+    static bool m_begun;
+
+    static int m_drawCalls;
+    static int m_particles;
+    static int m_lastDrawCalls;
+    static int m_lastParticles;
+};
@@ -0,0 +1,186 @@
+﻿#include "ParticleSystem.h"
+#include <cmath>
+#include <cstring>
+#include <new>
+
+using namespace DirectX;
+
+namespace
+{
+    //SoA 配列の本数
+    constexpr size_t kStreamCount = 17;
+    constexpr size_t kAlignment = 16;
+}
+
+ParticleBuffer::ParticleBuffer(size_t capacity, int frameCount)
+{
+    //4 粒単位で回すので 4 の倍数に切り上げる
+    m_capacity = (capacity + 3) & ~static_cast<size_t>(3);
+    m_frameCount = (frameCount > 0) ? frameCount : 1;
+
+    //全配列を 1 回の確保でまとめて取る
+    size_t bytes = sizeof(float) * m_capacity * kStreamCount;
+    m_storage = static_cast<float*>(::operator new(bytes, std::align_val_t(kAlignment)));
+    std::memset(m_storage, 0, bytes);
+
+    float* p = m_storage;
+    float** streams[kStreamCount] =
+    {
+        &m_posX, &m_posY, &m_posZ,
+        &m_velX, &m_velY, &m_velZ,
+        &m_age, &m_invLife,
+        &m_sizeStart, &m_sizeDelta, &m_size, &m_frame,
+        &m_colorR, &m_colorG, &m_colorB, &m_colorA, &m_baseAlpha,
+    };
+    for (float** stream : streams)
+    {
+        *stream = p;
+        p += m_capacity;
+    }
+}
+
+ParticleBuffer::~ParticleBuffer()
+{
+    ::operator delete(m_storage, std::align_val_t(kAlignment));
+}
+
+float ParticleBuffer::RandomRange(float minValue, float maxValue)
+{
+    //xorshift32（描画用の見た目のばらつきだけなので質は問わない）
+    m_rngState ^= m_rngState << 13;
+    m_rngState ^= m_rngState >> 17;
+    m_rngState ^= m_rngState << 5;
+
+    float t = static_cast<float>(m_rngState >> 8) * (1.0f / 16777216.0f);
+    return minValue + (maxValue - minValue) * t;
+}
+
+size_t ParticleBuffer::Emit(const ParticleEmitParams& params)
+{
+    size_t emitted = 0;
+
+    for (int n = 0; n < params.count && m_count < m_capacity; ++n)
+    {
+        size_t i = m_count++;
+
+        //球面上の一様な方向
+        float z = RandomRange(-1.0f, 1.0f);
+        float phi = RandomRange(0.0f, XM_2PI);
+        float r = std::sqrt(1.0f - z * z);
+        float speed = RandomRange(params.speedMin, params.speedMax);
+
+        m_posX[i] = params.position.x;
+        m_posY[i] = params.position.y;
+        m_posZ[i] = params.position.z;
+        m_velX[i] = r * std::cos(phi) * speed;
+        m_velY[i] = r * std::sin(phi) * speed;
+        m_velZ[i] = z * speed;
+
+        float life = RandomRange(params.lifeMin, params.lifeMax);
+        m_age[i] = 0.0f;
+        m_invLife[i] = (life > 0.0f) ? 1.0f / life : 1.0e30f;
+
+        m_sizeStart[i] = params.sizeStart;
+        m_sizeDelta[i] = params.sizeEnd - params.sizeStart;
+        m_size[i] = params.sizeStart;
+        m_frame[i] = 0.0f;
+
+        m_colorR[i] = params.color.x;
+        m_colorG[i] = params.color.y;
+        m_colorB[i] = params.color.z;
+        m_colorA[i] = params.color.w;
+        m_baseAlpha[i] = params.color.w;
+
+        ++emitted;
+    }
+
+    return emitted;
+}
+
+void ParticleBuffer::Kill(size_t index)
+{
+    size_t last = --m_count;
+    if (index == last) { return; }
+
+    float* streams[] =
+    {
+        m_posX, m_posY, m_posZ, m_velX, m_velY, m_velZ,
+        m_age, m_invLife, m_sizeStart, m_sizeDelta, m_size, m_frame,
+        m_colorR, m_colorG, m_colorB, m_colorA, m_baseAlpha,
+    };
+    for (float* s : streams)
+    {
+        s[index] = s[last];
+    }
+}
+
+void ParticleBuffer::Update(float dt)
+{
+    if (m_count == 0 || dt <= 0.0f) { return; }
+
+    //定数はループの外で 4 レーンに広げておく
+    const XMVECTOR vDt = XMVectorReplicate(dt);
+    const XMVECTOR vOne = XMVectorReplicate(1.0f);
+    const XMVECTOR vZero = XMVectorZero();
+    const XMVECTOR vGravityDt = XMVectorReplicate(m_gravity * dt);
+    const XMVECTOR vDragFactor = XMVectorReplicate((m_drag * dt < 1.0f) ? 1.0f - m_drag * dt : 0.0f);
+    const XMVECTOR vFrames = XMVectorReplicate(static_cast<float>(m_frameCount));
+    const XMVECTOR vLastFrame = XMVectorReplicate(static_cast<float>(m_frameCount - 1));
+    const XMVECTOR vFadeScale = XMVectorReplicate(4.0f); //寿命の最後の 1/4 でフェードアウト
+
+    bool anyDead = false;
+
+    //末尾の端数も 4 粒単位で回す（配列は 4 の倍数長なので範囲外にはならない）
+    for (size_t i = 0; i < m_count; i += 4)
+    {
+        //--------------寿命------------------
+        XMVECTOR age = XMVectorAdd(XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_age + i)), vDt);
+        XMVECTOR t = XMVectorMultiply(age, XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_invLife + i)));
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_age + i), age);
+
+        anyDead |= XMComparisonAnyTrue(XMVector4GreaterOrEqualR(t, vOne));
+        t = XMVectorMin(t, vOne);
+
+        //--------------速度（空気抵抗と重力）------------------
+        XMVECTOR vx = XMVectorMultiply(XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_velX + i)), vDragFactor);
+        XMVECTOR vy = XMVectorMultiply(XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_velY + i)), vDragFactor);
+        XMVECTOR vz = XMVectorMultiply(XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_velZ + i)), vDragFactor);
+        vy = XMVectorSubtract(vy, vGravityDt);
+
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_velX + i), vx);
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_velY + i), vy);
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_velZ + i), vz);
+
+        //--------------位置------------------
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_posX + i),
+            XMVectorMultiplyAdd(vx, vDt, XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_posX + i))));
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_posY + i),
+            XMVectorMultiplyAdd(vy, vDt, XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_posY + i))));
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_posZ + i),
+            XMVectorMultiplyAdd(vz, vDt, XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_posZ + i))));
+
+        //--------------見た目（大きさ・コマ・アルファ）------------------
+        XMVECTOR size = XMVectorMultiplyAdd(
+            XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_sizeDelta + i)), t,
+            XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_sizeStart + i)));
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_size + i), size);
+
+        XMVECTOR frame = XMVectorMin(XMVectorFloor(XMVectorMultiply(t, vFrames)), vLastFrame);
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_frame + i), frame);
+
+        XMVECTOR fade = XMVectorClamp(XMVectorMultiply(XMVectorSubtract(vOne, t), vFadeScale), vZero, vOne);
+        XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(m_colorA + i),
+            XMVectorMultiply(XMLoadFloat4A(reinterpret_cast<const XMFLOAT4A*>(m_baseAlpha + i)), fade));
+    }
+
+    if (!anyDead) { return; }
+
+    //後ろから見ていけば、入れ替えで持ってきた粒は判定済みのものになる
+    for (size_t i = m_count; i-- > 0;)
+    {
+        if (m_age[i] * m_invLife[i] >= 1.0f)
+        {
+            Kill(i);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <DirectXMath.h>
+
+//------------------------------------------------------------
+// パーティクルのシミュレーション部分（描画・D3D には依存しない）
+// ・1 つの ParticleBuffer が 1 枚のスプライトシート（アトラス）に対応する
+// ・データは SoA（成分ごとの配列）で持ち、更新は 4 粒ずつ SIMD で進める
+// ・生きている粒は常に [0, GetCount()) に詰めておく（死んだ粒は末尾と入れ替える）
+// ・最大数は生成時に固定。満杯のときの Emit は古い粒を消さずに諦める
+//------------------------------------------------------------
+
+//1 回の放出パラメータ
+struct ParticleEmitParams
+{
+    DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+    int   count = 1;
+
+    //速度（ランダムな方向 × [speedMin, speedMax]）
+    float speedMin = 0.0f;
+    float speedMax = 0.0f;
+
+    //寿命（秒）
+    float lifeMin = 0.35f;
+    float lifeMax = 0.35f;
+
+    //大きさ（寿命に合わせて start -> end へ補間）
+    float sizeStart = 8.0f;
+    float sizeEnd = 8.0f;
+
+    DirectX::XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+class ParticleBuffer
+{
+public:
+    //capacity : 最大粒数 / frameCount : スプライトシートのコマ数（cols * rows）
+    ParticleBuffer(size_t capacity, int frameCount);
+    ~ParticleBuffer();
+
+    ParticleBuffer(const ParticleBuffer&) = delete;
+    ParticleBuffer& operator=(const ParticleBuffer&) = delete;
+
+    //粒を放出する。実際に出せた数を返す
+    size_t Emit(const ParticleEmitParams& params);
+
+    //全粒を dt 秒進め、寿命の尽きた粒を取り除く
+    void Update(float dt);
+
+    void Clear() { m_count = 0; }
+
+    //----------Set関数-------------
+    void SetGravity(float gravity) { m_gravity = gravity; }
+    void SetDrag(float drag) { m_drag = drag; }
+
+    //----------Get関数-------------
+    size_t GetCount() const { return m_count; }
+    size_t GetCapacity() const { return m_capacity; }
+    int GetFrameCount() const { return m_frameCount; }
+
+    //描画用（[0, GetCount()) が有効）
+    const float* GetPositionX() const { return m_posX; }
+    const float* GetPositionY() const { return m_posY; }
+    const float* GetPositionZ() const { return m_posZ; }
+    const float* GetSize() const { return m_size; }
+    const float* GetFrame() const { return m_frame; }
+    const float* GetColorR() const { return m_colorR; }
+    const float* GetColorG() const { return m_colorG; }
+    const float* GetColorB() const { return m_colorB; }
+    const float* GetColorA() const { return m_colorA; }
+
+private:
+    //死んだ粒 index を末尾の粒で埋める
+    void Kill(size_t index);
+
+    float RandomRange(float minValue, float maxValue);
+
+    size_t m_capacity = 0;
+    size_t m_count = 0;
+    int    m_frameCount = 1;
+
+    float m_gravity = 0.0f;
+    float m_drag = 0.0f;
+
+    uint32_t m_rngState = 0x12345678u;
+
+    //--------------SoA 配列（すべて 16 バイト境界・4 の倍数長）------------------
+    float* m_storage = nullptr;
+
+    float* m_posX = nullptr;
+    float* m_posY = nullptr;
+    float* m_posZ = nullptr;
+    float* m_velX = nullptr;
+    float* m_velY = nullptr;
+    float* m_velZ = nullptr;
+    float* m_age = nullptr;       //経過時間
+    float* m_invLife = nullptr;   //1 / 寿命
+    float* m_sizeStart = nullptr;
+    float* m_sizeDelta = nullptr; //sizeEnd - sizeStart
+    float* m_size = nullptr;      //現在の大きさ（Update で計算）
+    float* m_frame = nullptr;     //現在のコマ番号（Update で計算）
+    float* m_colorR = nullptr;
+    float* m_colorG = nullptr;
+    float* m_colorB = nullptr;
+    float* m_colorA = nullptr;    //寿命に合わせてフェードした後のアルファ
+    float* m_baseAlpha = nullptr;
+};
@@ -19,8 +19,8 @@ void PatrolComponent::Update(float dt)
 {
 	//eIuWFNgȂȂ
 	if (!GetOwner()){return;}
-	//n_Ȃꍇ
-	if (m_waypoints.size() < 2) { return; }
+	//n_ĽoHꍇ
+	if (!m_path && m_waypoints.size() < 2) { return; }
 	//f^^C0菬ꍇ
 	if (dt <= 0.0f) { return; }
 
@@ -28,201 +28,56 @@ void PatrolComponent::Update(float dt)
 
 	if (!m_useSpline){ return; }
 
-	auto calcPoints = [&](Vector3& outP0, Vector3& outP1, Vector3& outP2, Vector3& outP3)
+	//oH̕\E[vݒ肪ςȂ蒼iEFC|CgĂꍇj
+	if ((!m_path || m_path->IsLoop() != m_loop) && m_waypoints.size() >= 2)
 	{
-			int i1 = static_cast<int>(m_currentIndex);
-			int i2 = i1 + 1;
-			int i0 = i1 - 1;
-			int i3 = i2 + 1;
-
-			outP0 = GetPointClamped(i0);
-			outP1 = GetPointClamped(i1);
-			outP2 = GetPointClamped(i2);
-			outP3 = GetPointClamped(i3);
-	};
-
-	Vector3 p0, p1, p2, p3;
-	calcPoints(p0, p1, p2, p3);
-
-	Vector3 tangent = EvalCatmullRomTangentXZ(p0, p1, p2, p3, m_segmentT);
-	float tangentLen = tangent.Length();
-
-	if (tangentLen < 1e-6f)
-	{
-		AdvanceSegment();
-		return;
-	}
-
-	//Őiނ悤tvZ
-	float deltaT = (m_speed * dt) / tangentLen;
-	m_segmentT += deltaT;
-
-	int safety = 0;
-	int count = static_cast<int>(m_waypoints.size());
-
-	//Ԃ܂
-	while (m_segmentT >= 1.10f)
-	{
-		m_segmentT -= 1.0f;
-
-		size_t prevIndex = m_currentIndex;
-		AdvanceSegment();
-
-		if (!m_loop)
-		{
-			if(m_currentIndex == prevIndex)
-			{
-				m_segmentT = 1.0f;
-				break;
-			}
-		}
-
-		safety++;
-
-		if (safety > count + 2)
-		{
-			// [vh~
-			m_segmentT = 0.0f;
-			break;
-		}
+		BakePath();
 	}
 
-	calcPoints(p0, p1, p2, p3);
+	//̂i߂ĕ\ʒuƌix͏Ɉj
+	m_distance = m_path->Wrap(m_distance + m_speed * dt);
 
-	Vector3 newPos = EvalCatmullRomXZ(p0, p1, p2, p3, m_segmentT);
+	DirectX::XMFLOAT3 pathPos;
+	DirectX::XMFLOAT3 pathDir;
+	m_path->Evaluate(m_distance, pathPos, pathDir, m_currentIndex);
 
 	Vector3 pos = owner->GetPosition();
-	newPos.y = pos.y;
-
-	owner->SetPosition(newPos);
+	owner->SetPosition(Vector3(pathPos.x, pos.y, pathPos.z));
 
 	if (m_faceMovement)
 	{
-		Vector3 dir = EvalCatmullRomTangentXZ(p0, p1, p2, p3, m_segmentT);
-		dir.y = 0.0f;
-
-		if (dir.LengthSquared() > 1e-6f)
-		{
-			dir.Normalize();
-
-			float yaw = std::atan2(dir.x, dir.z);
-
-			Vector3 rot = owner->GetRotation();
-			rot.y = yaw;
-			owner->SetRotation(rot);
-		}
-	}
-}
-
-/// <summary>
-/// n_z񂩂o֐
-/// </summary>
-/// <param name="index"> ~n_̔zԍ </param>
-/// <returns>w肵zԍ̒n_W</returns>
-Vector3 PatrolComponent::GetPointClamped(int index) const
-{
-	//TCY擾
-	int count = static_cast<int>(m_waypoints.size());
-
-	//[vȂ
-	if (m_loop)
-	{
-		//
-		int wrapped = index % count;
-		if (wrapped < 0)
-		{
-			wrapped += count;
-		}
+		float yaw = std::atan2(pathDir.x, pathDir.z);
 
-		return m_waypoints[wrapped];
+		Vector3 rot = owner->GetRotation();
+		rot.y = yaw;
+		owner->SetRotation(rot);
 	}
-
-	//[vȂƂ
-	int clamped = std::clamp(index, 0, count - 1);
-	return m_waypoints[clamped];
-}
-
-/// <summary>
-/// 4̒n_ƂƂAȐ̈ʒuiWjvZ֐
-/// </summary>
-/// <param name="p0">p1 1O̒n_</param>
-/// <param name="p1">̋Ԃ̃X^[gn_</param>
-/// <param name="p2">̋Ԃ̃S[n_</param>
-/// <param name="p3">p2 1̒n_</param>
-/// <param name="t">ړ̐i݋</param>
-/// <returns>G̐iލW</returns>
-Vector3 PatrolComponent::EvalCatmullRomXZ(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) const
-{
-	float t2 = t * t;
-	float t3 = t2 * t;
-
-	Vector3 pos =
-		0.5f * (
-			(2.0f * p1) +
-			(-p0 + p2) * t +
-			(2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
-			(-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3
-			);
-
-	pos.y = 0.0f;
-	return pos;
-}
-
-Vector3 PatrolComponent::EvalCatmullRomTangentXZ(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) const
-{
-	float t2 = t * t;
-
-	Vector3 tan =0.5f * ((-p0 + p2) +
-					      2.0f * (2.0f * p0 -
-					       5.0f * p1 + 4.0f * p2 -
-						  p3) * t +3.0f * 
-						  (-p0 + 3.0f * p1 - 3.0f * 
-						   p2 + p3) * t2);
-
-	tan.y = 0.0f;
-	return tan;
 }
 
-void PatrolComponent::AdvanceSegment()
+void PatrolComponent::BakePath()
 {
-	int count = static_cast<int>(m_waypoints.size());
-	if (count < 2)
-	{
-		return;
-	}
-
-	if (m_loop)
-	{
-		m_currentIndex = (m_currentIndex + 1) % static_cast<size_t>(count);
-		return;
-	}
-
-	// 񃋁[vFŌ̋ԊJn count-2 ܂
-	if (m_currentIndex + 1 < static_cast<size_t>(count - 1))
-	{
-		m_currentIndex++;
-		return;
-	}
-
-	m_currentIndex = static_cast<size_t>(count - 2);
-	m_segmentT = 1.0f;
+	//Vector3 -> XMFLOAT3 ɋlߑւďĂiɈxj
+	std::vector<DirectX::XMFLOAT3> points(m_waypoints.begin(), m_waypoints.end());
+	m_path = SplinePath::Bake(points, m_loop);
 }
 
 void PatrolComponent::SetWaypoints(const std::vector<Vector3>& pts)
 {
 	m_waypoints = pts;
+	m_path.reset();
 	Reset();
 }
 
 void PatrolComponent::SetWaypoints(std::vector<Vector3>&& pts)
 {
 	m_waypoints = std::move(pts);
+	m_path.reset();
 	Reset();
 }
 
 void PatrolComponent::Reset()
 {
 	m_currentIndex = 0;
-	m_segmentT = 0.0f;
+	m_distance = 0.0f;
 	m_splineTension = 0.5f;
 }
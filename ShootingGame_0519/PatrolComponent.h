@@ -2,8 +2,10 @@
 #include "Component.h"
 #include "IMovable.h"
 #include <vector>
+#include <memory>
 #include <SimpleMath.h>
 #include <functional>
+#include "SplinePath.h"
 
 using namespace DirectX::SimpleMath;
 
@@ -30,6 +32,10 @@ public:
 	void SetUseSpline(bool useSpline) { m_useSpline = useSpline; }
 	void SetSplineTension(float tension) { m_splineTension = tension; }	//XvC̊炩
 	void SetLoop(bool loop) { m_loop = loop; }                    //[v邩ipingpongƂ̑gɒӁj
+
+	//Ăς݂̌oHgiEFC|CggGmŋLBSetWaypoints ̌ɌĂԁj
+	//oHnꍇ̓EFC|CgȂivnuG͂j
+	void SetPath(std::shared_ptr<const SplinePath> path) { m_path = std::move(path); }
 	void SetPingPong(bool p) { m_pingPong = p; }
 
 	void SetVelocity(const DirectX::SimpleMath::Vector3& velocity) override
@@ -54,6 +60,9 @@ public:
 	//Zbg
 	void Reset();
 
+	//ivnupj
+	std::shared_ptr<Component> Clone() const override { return std::make_shared<PatrolComponent>(*this); }
+
 private:
 	//-------------EFC|Cg֘A--------------
 	std::vector<Vector3> m_waypoints;			//n_(EFC|Cg)ۑxN^[̔z
@@ -69,7 +78,8 @@ private:
 	bool m_useSpline = false;					//XvC⊮gǂbool
 	float m_splineTension = 0.5f;				//XvC̊炩i0`1j
 
-	float m_segmentT = 0.0f;				    //݂̃ZOg̒
+	std::shared_ptr<const SplinePath> m_path;	//̂ňoH̕\i Update ōj
+	float m_distance = 0.0f;					//oH̐擪̓̂
 	float m_arrivalThreshold = 0.5f;
 
 	Vector3 m_currentDir = Vector3(0.0f,0.0f,1.0f);		//݂̈ړxNg
@@ -80,9 +90,6 @@ private:
 	std::function<void(size_t)> m_onReached;
 
 	//-------------֐--------------
-	Vector3 GetPointClamped(int index) const;
-	Vector3 EvalCatmullRomXZ(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) const;
-	Vector3 EvalCatmullRomTangentXZ(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) const;
-
-	void AdvanceSegment();
+	//̃EFC|Cgƃ[vݒŌoH̕\
+	void BakePath();
 };
@@ -39,6 +39,7 @@ void Player::Initialize()
     m_Collider -> SetSize({ 6.0f, 1.5f, 8.0f }); // fɍ킹Ē
     //m_Collider -> SetLocalOffset(Vector3(0.0f,0.0f ,15.0f));
     m_Collider ->isStatic = false;
+    m_Collider ->SetLayer(LAYER_PLAYER);
 
   //---------------GameObjectɒǉ---------------
     AddComponent(modelComp);
@@ -6,7 +6,7 @@
 class Player : public GameObject
 {
 public:
-    Player() = default;
+    Player() { SetTag(TAG_PLAYER); }
     ~Player() override = default;
 
     void Initialize() override;     //
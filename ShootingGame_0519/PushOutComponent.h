@@ -18,6 +18,9 @@ public:
 	void AddPush(const DirectX::SimpleMath::Vector3& push);
 	void ApplyPush();
 
+	//ivnupj
+	std::shared_ptr<Component> Clone() const override { return std::make_shared<PushOutComponent>(*this); }
+
 private:
 	DirectX::SimpleMath::Vector3 m_accumulatedPush = DirectX::SimpleMath::Vector3::Zero; //oxNg
 	float m_mass = 1.0f;   //ȍd
@@ -0,0 +1,164 @@
+﻿#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------
+// 読み込んだアセットの常駐管理（参照カウント付きハンドル + LRU）
+// ・ハンドルは std::shared_ptr。キャッシュ自身も 1 つ持つので、use_count が 1 なら誰も使っていない
+// ・使われなくなったアセットもすぐには捨てず、常駐バイト数が予算を超えたときだけ、最後に使われたのが古い順に捨てる
+// ・捨てるのは Trim を呼んだときだけ（SceneManager が次のシーンの Init の後に呼ぶ）。
+//   次のシーンが Init でハンドルを取り直してから捨てるので、前後のシーンで共通のアセットはキャッシュヒットになる
+// D3D に依存しないので Tools/ResidencyCacheCheck で確認できる
+//------------------------------------------------------------
+template <typename T>
+class ResidencyCache
+{
+public:
+    using Handle = std::shared_ptr<T>;
+
+    //捨てたときに呼ぶ（MemoryTracker からの差し引き用）
+    using EvictCallback = std::function<void(const std::string& key, const T& value, size_t bytes)>;
+
+    explicit ResidencyCache(EvictCallback onEvict = nullptr) : m_onEvict(std::move(onEvict)) {}
+
+    //常駐させておく上限（0 は上限なし = 何も捨てない）
+    void SetBudget(size_t bytes) { m_budget = bytes; }
+    size_t GetBudget() const { return m_budget; }
+
+    //読み込み済みならハンドルを返す（無ければ nullptr）
+    Handle Find(const std::string& key)
+    {
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            ++m_misses;
+            return nullptr;
+        }
+        ++m_hits;
+        it->second.lastUse = ++m_clock;
+        return it->second.value;
+    }
+
+    //読み込んだものを bytes の大きさで登録する（同じキーがあれば前のものは捨てたことにする）
+    void Insert(const std::string& key, Handle value, size_t bytes)
+    {
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            Evict(it);
+        }
+
+        Entry entry;
+        entry.value = std::move(value);
+        entry.bytes = bytes;
+        entry.lastUse = ++m_clock;
+        m_entries.emplace(key, std::move(entry));
+        m_residentBytes += bytes;
+    }
+
+    //予算を超えている間、使われていないものを古い順に捨てる。捨てたバイト数を返す
+    size_t Trim() { return EvictUnused(m_budget); }
+
+    //使われていないものを予算に関係なくすべて捨てる
+    size_t Purge() { return EvictUnused(0, true); }
+
+    //すべて捨てる（終了時用。外に出ているハンドルはそのまま使える）
+    void Clear()
+    {
+        while (!m_entries.empty())
+        {
+            Evict(m_entries.begin());
+        }
+    }
+
+    //------------------------------統計------------------------------
+    size_t GetCount() const { return m_entries.size(); }
+    size_t GetResidentBytes() const { return m_residentBytes; }
+
+    //誰も使っていない（LRU に並んでいる）分
+    size_t GetUnusedBytes() const
+    {
+        size_t bytes = 0;
+        for (const auto& kv : m_entries)
+        {
+            if (kv.second.value.use_count() <= 1) { bytes += kv.second.bytes; }
+        }
+        return bytes;
+    }
+
+    uint64_t GetHits() const { return m_hits; }
+    uint64_t GetMisses() const { return m_misses; }
+    uint64_t GetEvictions() const { return m_evictions; }
+    uint64_t GetEvictedBytes() const { return m_evictedBytes; }
+
+private:
+    struct Entry
+    {
+        Handle value;
+        size_t bytes = 0;
+        uint64_t lastUse = 0;   //Find / Insert / 使用中のまま Trim を迎えたときの m_clock
+    };
+    using Map = std::unordered_map<std::string, Entry>;
+
+    void Evict(typename Map::iterator it)
+    {
+        const size_t bytes = it->second.bytes;
+        if (m_onEvict && it->second.value) { m_onEvict(it->first, *it->second.value, bytes); }
+        m_residentBytes -= bytes;
+        ++m_evictions;
+        m_evictedBytes += bytes;
+        m_entries.erase(it);    //ここでキャッシュの参照が外れ、他に持ち主がいなければ解放される
+    }
+
+    //limit 以下になるまで（all なら全部）使われていないものを古い順に捨てる
+    size_t EvictUnused(size_t limit, bool all = false)
+    {
+        //使用中のものは「今使われた」ことにする。使われなくなった順がおおよそ LRU の順になる
+        const uint64_t now = ++m_clock;
+        std::vector<std::pair<uint64_t, typename Map::iterator>> unused;
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->second.value.use_count() > 1)
+            {
+                it->second.lastUse = now;
+            }
+            else
+            {
+                unused.emplace_back(it->second.lastUse, it);
+            }
+        }
+
+        if (!all && (limit == 0 || m_residentBytes <= limit)) { return 0; }
+
+        std::sort(unused.begin(), unused.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        size_t evicted = 0;
+        for (auto& item : unused)
+        {
+            if (!all && m_residentBytes <= limit) { break; }
+            evicted += item.second->second.bytes;
+            Evict(item.second);
+        }
+        return evicted;
+    }
+
+    Map m_entries;
+    size_t m_budget = 0;
+    size_t m_residentBytes = 0;
+    uint64_t m_clock = 0;
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_evictedBytes = 0;
+
+    EvictCallback m_onEvict;
+};
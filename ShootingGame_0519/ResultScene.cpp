@@ -49,7 +49,14 @@ void ResultScene::Draw(float deltatime)
 
 void ResultScene::Uninit()
 {
-
+    //wiȂǂ̃IuWFNgi Init ō蒼j
+    for (auto& obj : m_GameObjects)
+    {
+        if (obj) { obj->Uninit(); }
+    }
+    m_GameObjects.clear();
+    m_AddObjects.clear();
+    m_DeleteObjects.clear();
 }
 
 
@@ -2,6 +2,7 @@
 #include "Input.h"
 #include "Renderer.h"
 #include "Application.h"
+#include "Logger.h"
 #include <Windows.h>
 #include <iostream>
 
@@ -17,14 +18,14 @@ void Reticle::Initialize()
     m_texture = AddComponent<TextureComponent>();
     if (!m_texture)
     {
-        OutputDebugStringA("Reticle: TextureComponent 쐬s\n");
+        LOG_WARN("Reticle: TextureComponent 쐬s");
         return;
     }
 
     // eNX`ǂݍ݁i[LOfBNgɈˑj
     if (!m_texture->LoadTexture(m_texturePath))
     {
-        OutputDebugStringA("Reticle: eNX`ǂݍݎs\n");
+        LOG_WARN("Reticle: eNX`ǂݍݎs");
     }
     m_texture->SetSize(m_size, m_size);
 
@@ -9,6 +9,10 @@
 #include "CollisionManager.h"
 #include "Application.h" 
 #include "ResultLooseScene.h"
+#include "MemoryTracker.h"
+#include "ModelComponent.h"
+#include "TextureManager.h"
+#include "Logger.h"
        
 std::unordered_map<std::string, std::unique_ptr<IScene>> SceneManager::m_scenes;
 
@@ -34,8 +38,9 @@ void SceneManager::SetCurrentScene(const std::string& name)
     Input::Reset();
 
     // VV[ZbgInit
+    std::string previous = m_currentSceneName;
     m_currentSceneName = name;
-    m_scenes[m_currentSceneName]->Init();
+    InitCurrentScene(previous);
     Sound::StopBgm();
     Sound::StopAllSe();
 
@@ -69,11 +74,45 @@ void SceneManager::SetChangeScene(const std::string& name)
 
     Input::Reset();
 
+    std::string previous = m_currentSceneName;
     m_currentSceneName = name;
-    m_scenes[m_currentSceneName]->Init();
+    InitCurrentScene(previous);
 
 }
 
+void SceneManager::InitCurrentScene(const std::string& previous)
+{
+    //ÕV[ Uninit ŕԂȂƁAĖ߂ĂƂ̑
+    MemorySceneReport change = MemoryTracker::OnSceneChange(previous, m_currentSceneName);
+
+    {
+        MemoryScope memoryScope(MemoryCategory::Scene);
+        m_scenes[m_currentSceneName]->Init();
+    }
+
+    //VV[ĝ蒼ŁA\Z𒴂gĂȂ̂̂Ă
+    //ifeNX`̂Ă悤ɁAfj
+    ModelComponent::TrimModelCache();
+    TextureManager::Trim();
+
+    MemorySceneReport loaded = MemoryTracker::OnSceneLoaded(m_currentSceneName);
+    MemoryTracker::AppendReport(change.text + loaded.text);
+
+    if (change.hasResidual)
+    {
+        LOG_INFO("Memory: %s left CPU %+lld KB / GPU %+lld KB after Uninit", previous.c_str(),
+            static_cast<long long>(change.residual.TotalCpu() / 1024), static_cast<long long>(change.residual.TotalGpu() / 1024));
+    }
+    if (change.revisit && (change.loop.TotalCpu() > 0 || change.loop.TotalGpu() > 0))
+    {
+        LOG_WARN("Memory: CPU %+lld KB / GPU %+lld KB since the last visit to %s (see MemoryReport.txt)",
+            static_cast<long long>(change.loop.TotalCpu() / 1024), static_cast<long long>(change.loop.TotalGpu() / 1024),
+            m_currentSceneName.c_str());
+    }
+    LOG_INFO("Memory: %s Init CPU %+lld KB / GPU %+lld KB", m_currentSceneName.c_str(),
+        static_cast<long long>(loaded.loaded.TotalCpu() / 1024), static_cast<long long>(loaded.loaded.TotalGpu() / 1024));
+}
+
 void SceneManager::Init()
 {
     //-------------------------------------------------------------
@@ -94,7 +133,7 @@ void SceneManager::Init()
 
     //V[TitleSceneݒ
     m_currentSceneName = "TitleScene";
-    m_scenes[m_currentSceneName]->Init();
+    InitCurrentScene("");
 
 }
 
@@ -106,6 +145,7 @@ void SceneManager::Update(float deltatime)
     {
         if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
         {
+            MemoryScope memoryScope(MemoryCategory::Scene);
             m_scenes[m_currentSceneName]->Update(deltatime);
         }
         
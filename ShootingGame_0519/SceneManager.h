@@ -25,6 +25,9 @@ private:
 
 	static bool m_sceneChangedThisFrame;
 
+	//̃V[ Init AÕV[̃̑ MemoryReport.txt ɏ
+	static void InitCurrentScene(const std::string& previous);
+
 public:
 	//Q[̒ŎgV[o^֐
 	static void RegisterScene(const std::string& name, std::unique_ptr<IScene> scene);
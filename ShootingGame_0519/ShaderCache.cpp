@@ -0,0 +1,222 @@
+﻿#include "ShaderCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+fs::path ShaderCache::m_directory = "ShaderCache";
+std::unordered_map<std::string, std::string> ShaderCache::m_index;
+int ShaderCache::m_hits = 0;
+int ShaderCache::m_misses = 0;
+
+namespace
+{
+    constexpr const char* kIndexFileName = "index.txt";
+
+    bool ReadFileBytes(const fs::path& path, std::string& out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) { return false; }
+
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        out = ss.str();
+        return true;
+    }
+
+    //一時ファイルに書いてから名前を変える（書き込み途中で落ちても壊れたファイルを残さない）
+    bool WriteFileAtomic(const fs::path& path, const void* data, size_t size)
+    {
+        fs::path temp = path;
+        temp += ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file) { return false; }
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if (!file) { return false; }
+        }
+
+        std::error_code ec;
+        fs::rename(temp, path, ec);
+        if (ec)
+        {
+            fs::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    //ソースと、そこから #include されているファイルを順にハッシュへ足す
+    //（D3D_COMPILE_STANDARD_FILE_INCLUDE と同じく、取り込む側のファイルのディレクトリから探す）
+    bool HashSourceTree(const fs::path& path, uint64_t& hash, std::unordered_set<std::string>& visited)
+    {
+        std::string name = path.lexically_normal().generic_string();
+        if (!visited.insert(name).second) { return true; }
+
+        std::string source;
+        if (!ReadFileBytes(path, source)) { return false; }
+
+        //ファイル名も足す（同じ内容の別ファイルに差し替えた場合も区別する）
+        hash = HashShaderBytes(name.data(), name.size(), hash);
+        hash = HashShaderBytes(source.data(), source.size(), hash);
+
+        std::istringstream lines(source);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            size_t p = line.find_first_not_of(" \t");
+            if (p == std::string::npos || line.compare(p, 8, "#include") != 0) { continue; }
+
+            size_t open = line.find_first_of("\"<", p + 8);
+            if (open == std::string::npos) { continue; }
+            size_t close = line.find((line[open] == '"') ? '"' : '>', open + 1);
+            if (close == std::string::npos) { continue; }
+
+            if (!HashSourceTree(path.parent_path() / line.substr(open + 1, close - open - 1), hash, visited))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool IsDxbc(const std::vector<uint8_t>& bytes)
+    {
+        return bytes.size() >= 4 && bytes[0] == 'D' && bytes[1] == 'X' && bytes[2] == 'B' && bytes[3] == 'C';
+    }
+}
+
+uint64_t HashShaderBytes(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= p[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+void ShaderCache::Init(const fs::path& directory)
+{
+    m_directory = directory;
+    m_index.clear();
+    m_hits = 0;
+    m_misses = 0;
+
+    //1 行 1 シェーダー：「識別名<TAB>キー」
+    std::ifstream file(m_directory / kIndexFileName);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t tab = line.rfind('\t');
+        if (tab == std::string::npos) { continue; }
+        m_index[line.substr(0, tab)] = line.substr(tab + 1);
+    }
+}
+
+std::string ShaderCache::ComputeKey(const ShaderCacheKeyDesc& desc)
+{
+    uint64_t hash = HashShaderBytes(nullptr, 0);
+    std::unordered_set<std::string> visited;
+    if (!HashSourceTree(desc.sourcePath, hash, visited)) { return std::string(); }
+
+    //文字列は終端の 0 まで足して、"ab"+"c" と "a"+"bc" を区別する
+    auto addString = [&hash](const std::string& s) { hash = HashShaderBytes(s.c_str(), s.size() + 1, hash); };
+    addString(desc.entryPoint);
+    addString(desc.profile);
+    for (const auto& define : desc.defines)
+    {
+        addString(define.first);
+        addString(define.second);
+    }
+
+    uint32_t numbers[3] = { static_cast<uint32_t>(desc.defines.size()), desc.compileFlags, desc.compilerVersion };
+    hash = HashShaderBytes(numbers, sizeof(numbers), hash);
+
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+bool ShaderCache::Load(const std::string& key, std::vector<uint8_t>& outBytecode)
+{
+    std::string bytes;
+    if (key.empty() || !ReadFileBytes(m_directory / (key + ".cso"), bytes))
+    {
+        ++m_misses;
+        return false;
+    }
+
+    outBytecode.assign(bytes.begin(), bytes.end());
+    if (!IsDxbc(outBytecode))
+    {
+        outBytecode.clear();
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+    return true;
+}
+
+bool ShaderCache::Store(const ShaderCacheKeyDesc& desc, const std::string& key, const void* bytecode, size_t size)
+{
+    if (key.empty() || !bytecode || size == 0) { return false; }
+
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+    if (!WriteFileAtomic(m_directory / (key + ".cso"), bytecode, size)) { return false; }
+
+    //ソースが変わってキーが変わった場合は、前のキーの .cso を消す
+    std::string& current = m_index[IdentityOf(desc)];
+    if (!current.empty() && current != key)
+    {
+        fs::remove(m_directory / (current + ".cso"), ec);
+    }
+    current = key;
+
+    return SaveIndex();
+}
+
+std::string ShaderCache::IdentityOf(const ShaderCacheKeyDesc& desc)
+{
+    //Debug / Release でフラグが違うものは別のシェーダーとして両方残す
+    std::string identity = desc.sourcePath.lexically_normal().generic_string();
+    identity += '|';
+    identity += desc.entryPoint;
+    identity += '|';
+    identity += desc.profile;
+    for (const auto& define : desc.defines)
+    {
+        identity += '|';
+        identity += define.first;
+        identity += '=';
+        identity += define.second;
+    }
+    identity += '|';
+    identity += std::to_string(desc.compileFlags);
+    return identity;
+}
+
+bool ShaderCache::SaveIndex()
+{
+    //差分が見やすいよう識別名の順に書く
+    std::vector<std::pair<std::string, std::string>> entries(m_index.begin(), m_index.end());
+    std::sort(entries.begin(), entries.end());
+
+    std::string text;
+    for (const auto& entry : entries)
+    {
+        text += entry.first;
+        text += '\t';
+        text += entry.second;
+        text += '\n';
+    }
+    return WriteFileAtomic(m_directory / kIndexFileName, text.data(), text.size());
+}
@@ -0,0 +1,62 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <utility>
+#include <filesystem>
+#include <unordered_map>
+
+//------------------------------------------------------------
+// コンパイル済みシェーダー（バイトコード）のディスクキャッシュ
+// ・キーはソース本体 / #include したファイル / エントリポイント / プロファイル / マクロ / フラグの内容ハッシュ
+// ・キャッシュディレクトリに <キー>.cso として置き、index.txt に「どのシェーダーが今どのキーか」を記録する
+//   ソースを書き換えてキーが変わったら、同じシェーダーの古い .cso は消す
+// D3D には触らない（コンパイルは Renderer::CompileShader の担当）ので、Tools/ShaderCacheCheck で単体確認できる
+//------------------------------------------------------------
+
+//キーの計算に使う情報
+struct ShaderCacheKeyDesc
+{
+    std::filesystem::path sourcePath;
+    std::string entryPoint;
+    std::string profile;                                        //vs_5_0 など
+    std::vector<std::pair<std::string, std::string>> defines;   //名前と値（並び順もキーに含む）
+    uint32_t compileFlags = 0;
+    uint32_t compilerVersion = 0;                               //D3D_COMPILER_VERSION（コンパイラ更新で作り直す）
+};
+
+//64bit FNV-1a（seed に前回の値を渡せば続けて計算できる）
+uint64_t HashShaderBytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
+
+class ShaderCache
+{
+public:
+    //キャッシュの置き場所を決めて index.txt を読み込む（Renderer::Init の最初に呼ぶ）
+    static void Init(const std::filesystem::path& directory = "ShaderCache");
+
+    //ソースと #include 先を読んでキーを計算する。ソースか #include 先が読めなければ空文字
+    static std::string ComputeKey(const ShaderCacheKeyDesc& desc);
+
+    //キャッシュにあればバイトコードを返す（DXBC でないファイルは壊れているとみなして使わない）
+    static bool Load(const std::string& key, std::vector<uint8_t>& outBytecode);
+
+    //コンパイル結果を保存し、同じシェーダーの古いキャッシュを消す。書き込めなければ false
+    static bool Store(const ShaderCacheKeyDesc& desc, const std::string& key, const void* bytecode, size_t size);
+
+    //Init 以降のヒット / ミス数（起動ログ用）
+    static int GetHitCount() { return m_hits; }
+    static int GetMissCount() { return m_misses; }
+
+    static const std::filesystem::path& GetDirectory() { return m_directory; }
+
+private:
+    //index.txt で使うシェーダーの識別名（ソース・エントリポイント・プロファイル・マクロ・コンパイルフラグ）
+    //フラグを含めるので、Debug / Release の両方のバイトコードがそれぞれ残る。コンパイラのバージョンは含めない（更新したら置き換える）
+    static std::string IdentityOf(const ShaderCacheKeyDesc& desc);
+    static bool SaveIndex();
+
+    static std::filesystem::path m_directory;
+    static std::unordered_map<std::string, std::string> m_index;   //識別名 -> 現在のキー
+    static int m_hits;
+    static int m_misses;
+};
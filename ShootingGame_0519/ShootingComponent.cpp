@@ -6,8 +6,12 @@
 #include "IScene.h"
 #include "Application.h"
 #include "HomingComponent.h"
+#include "SpatialIndex.h"
+#include "FrameArena.h"
 #include <iostream>
 #include <random>
+#include <algorithm>
+#include <cmath>
 #include <DirectXMath.h>
 
 using namespace DirectX;
@@ -35,8 +39,7 @@ void ShootingComponent::FireHomingBullet(GameObject* owner, const std::shared_pt
 
     //発射位置計算
     Vector3 muzzleLocal(0.0f, 0.0f, m_spawnOffset);
-    Vector3 rot = owner->GetRotation();
-    Matrix rotM = Matrix::CreateFromYawPitchRoll(rot.y, rot.x, rot.z);
+    const Matrix& rotM = owner->GetRotationMatrix();
     Vector3 spawnPos = owner->GetPosition() + Vector3::Transform(muzzleLocal, rotM);
 
     Vector3 toTarget = targetSp->GetPosition() - spawnPos;
@@ -63,10 +66,10 @@ void ShootingComponent::FireHomingBullet(GameObject* owner, const std::shared_pt
         }
     }
 
-     auto homing = bullet->AddComponent<HomingComponent>();
+     auto homing = bullet->GetOrAddHoming();
      if (homing)
      {
-         homing->SetTarget(targetSp);
+         homing->SetTarget(targetSp.get());
          homing->SetTimeToIntercept(1.0f);    
          homing->SetMaxAcceleration(2000.0f); 
          homing->SetLifeTime(5.0f);
@@ -110,6 +113,9 @@ std::shared_ptr<GameObject> ShootingComponent::FindBestHomingTarget()
 {
     if (!m_scene || !m_camera) { return nullptr; }
 
+    const SpatialIndex* index = m_scene->GetSpatialIndex();
+    if (!index) { return nullptr; }
+
     const auto& objects = m_scene->GetObjects();
 
     float screenW = static_cast<float>(Application::GetWidth());
@@ -126,15 +132,39 @@ std::shared_ptr<GameObject> ShootingComponent::FindBestHomingTarget()
     XMMATRIX projXM = XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(&proj));
     XMMATRIX worldXM = XMMatrixIdentity();
 
+    //--------------画面中央の円を含む円錐で候補を絞る------------------
+    //カメラ位置と、画面中央を通る視線（手前・奥のクリップ面上の点から求める）
+    Vector3 apex = view.Invert().Translation();
+    XMVECTOR nearPt = XMVector3Unproject(XMVectorSet(cx, cy, 0.0f, 0.0f),
+        0.0f, 0.0f, screenW, screenH, 0.0f, 1.0f, projXM, viewXM, worldXM);
+    XMVECTOR farPt = XMVector3Unproject(XMVectorSet(cx, cy, 1.0f, 0.0f),
+        0.0f, 0.0f, screenW, screenH, 0.0f, 1.0f, projXM, viewXM, worldXM);
+
+    Vector3 axis;
+    XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(&axis), XMVectorSubtract(farPt, nearPt));
+    if (axis.LengthSquared() < 1e-6f) { return nullptr; }
+    axis.Normalize();
+
+    //画面上の半径 maxScreenRadius に相当する視線からの角度（縦横で大きい方）
+    float tanX = (maxScreenRadius / cx) / std::fabs(proj._11);
+    float tanY = (maxScreenRadius / cy) / std::fabs(proj._22);
+    float tanHalf = (tanX > tanY) ? tanX : tanY;
+    float cosHalf = 1.0f / std::sqrt(1.0f + tanHalf * tanHalf);
+
+    //奥のクリップ面より先は sz > 1 で弾かれるので、そこまでで打ち切る
+    Vector3 farPos;
+    XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(&farPos), farPt);
+    float maxDistance = (farPos - apex).Length() / cosHalf;
+
+    FrameVector<GameObject*> candidates;
+    index->QueryCone(apex, axis, cosHalf, maxDistance, TAG_ENEMY, candidates);
+
+    //--------------候補だけ正確にスクリーン座標で判定する------------------
     std::shared_ptr<GameObject> bestTarget;
     float bestScore = FLT_MAX;
 
-    for (auto& obj : objects)
+    for (GameObject* obj : candidates)
     {
-        if (!obj) { continue; }
-
-        if (!std::dynamic_pointer_cast<Enemy>(obj)) { continue; }
-
         Vector3 worldPos = obj->GetPosition();
 
         //ワールド座標をスクリーン座標に変換する
@@ -159,8 +189,12 @@ std::shared_ptr<GameObject> ShootingComponent::FindBestHomingTarget()
 
         if (dist2 < bestScore)
         {
+            //シーン配列の位置から shared_ptr を引く
+            int slot = obj->GetSceneSlot().index;
+            if (slot < 0 || slot >= static_cast<int>(objects.size()) || objects[slot].get() != obj) { continue; }
+
             bestScore = dist2;
-            bestTarget = obj;
+            bestTarget = objects[slot];
         }
     }
 
@@ -285,8 +319,7 @@ void ShootingComponent::Update(float dt)
         }
 
         Vector3 muzzleLocal(0.0f, 0.0f, m_spawnOffset);
-        Vector3 rot = owner->GetRotation();
-        Matrix rotM = Matrix::CreateFromYawPitchRoll(rot.y, rot.x, rot.z);
+        const Matrix& rotM = owner->GetRotationMatrix();
         Vector3 spawnPos = owner->GetPosition() + Vector3::Transform(muzzleLocal, rotM);
 
         auto bullet = CreateBullet(spawnPos, forward, colorSpace);
@@ -355,12 +388,12 @@ void ShootingComponent::Update(float dt)
 /// <param name="dir">弾の方向ベクトル</param>
 /// <param name="color">弾の色</param>
 /// <returns>生成した弾ベクトル</returns>
-std::shared_ptr<GameObject> ShootingComponent::CreateBullet(const Vector3& pos, const Vector3& dir,
+std::shared_ptr<Bullet> ShootingComponent::CreateBullet(const Vector3& pos, const Vector3& dir,
                                                             const Vector4& color)
 {
-    auto bullet = std::make_shared<Bullet>();
+    //プールから取り出す（Initialize 済み）
+    auto bullet = Bullet::Spawn();
     bullet->SetPosition(pos);
-    bullet->Initialize();
 
     auto bc = bullet->GetComponent<BulletComponent>();
     if (bc)
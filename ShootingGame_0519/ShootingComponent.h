@@ -38,7 +38,7 @@ public:
 
 protected:
 
-    std::shared_ptr<GameObject> CreateBullet(const Vector3& pos, const Vector3& dir,
+    std::shared_ptr<Bullet> CreateBullet(const Vector3& pos, const Vector3& dir,
                                              const Vector4& color = Vector4(1,1,1,1));
 
     void AddBulletToScene(const std::shared_ptr<GameObject>& bullet);
@@ -9,7 +9,7 @@ SkyDome::SkyDome(const std::string& texPath)
 	if (!texPath.empty())
 	{
 		//texPathłȂ΁A[h
-		m_texture.Attach(TextureManager::Load(texPath));
+		m_texture = TextureManager::Load(texPath);
 	}
 }
 
@@ -43,12 +43,13 @@ void SkyDome::Draw(float alpha)
 	Renderer::DisableCulling(false);  //ʂ̏OiJOj𖳌
 
 	//JɒǏ]
-	Matrix4x4 world = GetTransform().GetMatrix();
+	Matrix4x4 world = GetLocalMatrix();
 	Renderer::SetWorldMatrix(&world);
 
 	if (m_texture)
 	{
-		Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, m_texture.GetAddressOf());
+		ID3D11ShaderResourceView* srv = m_texture.get();
+		Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, &srv);
 	}
 
 	//`֐
@@ -5,6 +5,7 @@
 #include "GameObject.h"
 #include "Primitive.h"
 #include "ICameraViewProvider.h"
+#include "TextureManager.h"
 
 class SkyDome : public GameObject
 {
@@ -23,7 +24,7 @@ public:
 
 private:
     Primitive m_primitive;      //XJCh[p̋̕`
-    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_texture;  //
+    TextureHandle m_texture;                                     //
     float m_radius = 100.0f;                                     // JWn̒Pʂɍ킹
     ICameraViewProvider* m_cameraProvider = nullptr;             //ʒu킹邽߂̃J擾
 };
@@ -1,6 +1,9 @@
 #include "Sound.h"
-#include <fstream>
+#include "MemoryTracker.h"
+#include "AssetArchive.h"
+#include "AsyncFileSystem.h"
 #include <algorithm>
+#include <cstring>
 
 Microsoft::WRL::ComPtr<IXAudio2> Sound::m_XAudio2;
 IXAudio2MasteringVoice* Sound::m_MasterVoice = nullptr;
@@ -19,18 +22,46 @@ float Sound::m_SeVolume = 1.0f;
 std::unordered_map<std::wstring, Sound::WavData> Sound::m_SeCache;
 std::vector<Sound::SeVoiceEntry> Sound::m_SeVoices;
 
-static uint32_t ReadU32(std::ifstream& ifs)
+namespace
 {
-    uint32_t v = 0;
-    ifs.read(reinterpret_cast<char*>(&v), sizeof(v));
-    return v;
-}
+    // ǂݍ WAV ̒g𓪂ǂށiI𒴂ǂݍ݂͎sɂj
+    struct WavReader
+    {
+        const uint8_t* data;
+        size_t size;
+        size_t position = 0;
 
-static uint16_t ReadU16(std::ifstream& ifs)
-{
-    uint16_t v = 0;
-    ifs.read(reinterpret_cast<char*>(&v), sizeof(v));
-    return v;
+        bool Read(void* dst, size_t bytes)
+        {
+            if (bytes > size - position)
+            {
+                position = size;
+                return false;
+            }
+            std::memcpy(dst, data + position, bytes);
+            position += bytes;
+            return true;
+        }
+
+        void Skip(size_t bytes)
+        {
+            position += (std::min)(bytes, size - position);
+        }
+
+        uint32_t ReadU32()
+        {
+            uint32_t v = 0;
+            Read(&v, sizeof(v));
+            return v;
+        }
+
+        uint16_t ReadU16()
+        {
+            uint16_t v = 0;
+            Read(&v, sizeof(v));
+            return v;
+        }
+    };
 }
 
 bool Sound::Init()
@@ -171,6 +202,7 @@ const Sound::WavData* Sound::GetOrLoadSeWav(const std::wstring& filepath)
         return &it->second;
     }
 
+    MemoryScope memoryScope(MemoryCategory::Sound);
     WavData wav{};
     if (!LoadWavPcm(filepath, wav))
     {
@@ -181,27 +213,65 @@ const Sound::WavData* Sound::GetOrLoadSeWav(const std::wstring& filepath)
     return &res.first->second;
 }
 
+void Sound::PreloadSeAsync(const std::vector<std::wstring>& filepaths)
+{
+    std::vector<FileReadRequest> requests;
+    for (const std::wstring& filepath : filepaths)
+    {
+        if (m_SeCache.find(filepath) != m_SeCache.end())
+        {
+            continue;
+        }
+
+        FileReadRequest request;
+        request.path = AssetPathToUtf8(filepath);
+        request.priority = FileReadPriority::Low;
+        request.onComplete = [filepath](FileReadResult& result)
+            {
+                // ǂłԂ PlaySeWav ̏œǂł΁Ac
+                if (!result.ok || m_SeCache.find(filepath) != m_SeCache.end())
+                {
+                    return;
+                }
+
+                MemoryScope memoryScope(MemoryCategory::Sound);
+                WavData wav{};
+                if (ParseWavPcm(result.view.data, result.view.size, wav))
+                {
+                    m_SeCache.emplace(filepath, std::move(wav));
+                }
+            };
+        requests.push_back(std::move(request));
+    }
+    AsyncFileSystem::ReadBatch(std::move(requests));
+}
+
 
 bool Sound::LoadWavPcm(const std::wstring& filepath, WavData& outData)
 {
-    std::ifstream ifs(filepath, std::ios::binary);
-    if (!ifs.is_open())
+    // A[JCuɂ΃}bvォA΃t@Cǂ
+    AssetView view;
+    if (!AssetArchive::Load(filepath, view))
     {
         return false;
     }
+    return ParseWavPcm(view.data, view.size, outData);
+}
+
+bool Sound::ParseWavPcm(const uint8_t* bytes, size_t size, WavData& outData)
+{
+    WavReader reader{ bytes, size };
 
     char riff[4]{};
-    ifs.read(riff, 4);
-    if (std::memcmp(riff, "RIFF", 4) != 0)
+    if (!reader.Read(riff, 4) || std::memcmp(riff, "RIFF", 4) != 0)
     {
         return false;
     }
 
-    (void)ReadU32(ifs); // file size
+    (void)reader.ReadU32(); // file size
 
     char wave[4]{};
-    ifs.read(wave, 4);
-    if (std::memcmp(wave, "WAVE", 4) != 0)
+    if (!reader.Read(wave, 4) || std::memcmp(wave, "WAVE", 4) != 0)
     {
         return false;
     }
@@ -212,29 +282,28 @@ bool Sound::LoadWavPcm(const std::wstring& filepath, WavData& outData)
     WAVEFORMATEX fmt{};
     std::vector<uint8_t> data;
 
-    while (ifs && (!foundFmt || !foundData))
+    while (!foundFmt || !foundData)
     {
         char chunkId[4]{};
-        ifs.read(chunkId, 4);
-        if (!ifs)
+        if (!reader.Read(chunkId, 4))
         {
             break;
         }
 
-        uint32_t chunkSize = ReadU32(ifs);
+        uint32_t chunkSize = reader.ReadU32();
 
         if (std::memcmp(chunkId, "fmt ", 4) == 0)
         {
-            uint16_t audioFormat = ReadU16(ifs);
-            uint16_t numChannels = ReadU16(ifs);
-            uint32_t sampleRate = ReadU32(ifs);
-            uint32_t byteRate = ReadU32(ifs);
-            uint16_t blockAlign = ReadU16(ifs);
-            uint16_t bitsPerSample = ReadU16(ifs);
+            uint16_t audioFormat = reader.ReadU16();
+            uint16_t numChannels = reader.ReadU16();
+            uint32_t sampleRate = reader.ReadU32();
+            uint32_t byteRate = reader.ReadU32();
+            uint16_t blockAlign = reader.ReadU16();
+            uint16_t bitsPerSample = reader.ReadU16();
 
             if (chunkSize > 16)
             {
-                ifs.seekg(chunkSize - 16, std::ios::cur);
+                reader.Skip(chunkSize - 16);
             }
 
             if (audioFormat != 1)
@@ -255,13 +324,17 @@ bool Sound::LoadWavPcm(const std::wstring& filepath, WavData& outData)
         }
         else if (std::memcmp(chunkId, "data", 4) == 0)
         {
+            // Đobt@v̂ŁAPCM ̓LbV֎ʂ
             data.resize(chunkSize);
-            ifs.read(reinterpret_cast<char*>(data.data()), chunkSize);
+            if (!reader.Read(data.data(), chunkSize))
+            {
+                return false;
+            }
             foundData = true;
         }
         else
         {
-            ifs.seekg(chunkSize, std::ios::cur);
+            reader.Skip(chunkSize);
         }
     }
 
@@ -284,6 +357,7 @@ bool Sound::PlayBgmWav(const std::wstring& filepath, float volume)
 
     StopBgm();
 
+    MemoryScope memoryScope(MemoryCategory::Sound);
     WavData wav{};
     if (!LoadWavPcm(filepath, wav))
     {
@@ -23,6 +23,9 @@ public:
     static bool PlaySeWav(const std::wstring& filepath, float volume = 1.0f);
     static void StopAllSe();
     static void ClearSeCache();
+    //܂LbVɖ SE ̓ǂݍ݂ AsyncFileSystem ŗɉ񂷁i͂ƃLbVւ̓o^ Poll ̒j
+    //ǂݏIO PlaySeWav Ă΂ꂽA܂Œʂ肻̏œǂ
+    static void PreloadSeAsync(const std::vector<std::wstring>& filepaths);
 
     //--------Set֐-------
     static void SetBgmVolume(float volume);
@@ -46,6 +49,7 @@ private:
     };
 
     static bool LoadWavPcm(const std::wstring& filepath, WavData& outData);
+    static bool ParseWavPcm(const uint8_t* bytes, size_t size, WavData& outData);
     static const WavData* GetOrLoadSeWav(const std::wstring& filepath);
 
     static Microsoft::WRL::ComPtr<IXAudio2> m_XAudio2;
@@ -0,0 +1,354 @@
+﻿#include "SpatialIndex.h"
+#include "GameObject.h"
+#include "Enemy.h"
+#include "OBBColliderComponent.h"
+#include "AABBColliderComponent.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX::SimpleMath;
+
+void SpatialIndex::SetBounds(const Vector3& min, const Vector3& max, float cellSize)
+{
+    m_min = min;
+    m_max = max;
+    m_cellSize = (cellSize > 1e-3f) ? cellSize : 1.0f;
+
+    m_cellsX = (std::max)(1, static_cast<int>(std::ceil((max.x - min.x) / m_cellSize)));
+    m_cellsZ = (std::max)(1, static_cast<int>(std::ceil((max.z - min.z) / m_cellSize)));
+
+    Clear();
+}
+
+void SpatialIndex::Clear()
+{
+    m_entries.clear();
+    m_cellStart.assign(static_cast<size_t>(m_cellsX) * m_cellsZ + 1, 0);
+    m_maxRadius = 0.0f;
+    m_objects = nullptr;
+}
+
+int SpatialIndex::CellX(float x) const
+{
+    //範囲外（無限大を含む）は端のセルに丸める
+    float f = (x - m_min.x) / m_cellSize;
+    if (!(f > 0.0f)) { return 0; }
+    if (f >= static_cast<float>(m_cellsX - 1)) { return m_cellsX - 1; }
+    return static_cast<int>(f);
+}
+
+int SpatialIndex::CellZ(float z) const
+{
+    float f = (z - m_min.z) / m_cellSize;
+    if (!(f > 0.0f)) { return 0; }
+    if (f >= static_cast<float>(m_cellsZ - 1)) { return m_cellsZ - 1; }
+    return static_cast<int>(f);
+}
+
+float SpatialIndex::ComputeRadius(GameObject* obj)
+{
+    //敵は設定された簡易半径をそのまま使う（途中で変わることがあるので毎回読む）
+    if (obj->GetTag() & TAG_ENEMY)
+    {
+        return static_cast<Enemy*>(obj)->GetBoundingRadius();
+    }
+
+    //それ以外はコライダーの対角長の半分（オブジェクトごとに 1 回だけ計算する）
+    GameObjectHandle h = obj->GetHandle();
+    if (h.IsNull()) { return 0.0f; }
+
+    if (h.index >= m_radiusCache.size())
+    {
+        m_radiusCache.resize(h.index + 1);
+    }
+
+    RadiusCache& cache = m_radiusCache[h.index];
+    if (cache.valid && cache.generation == h.generation)
+    {
+        return cache.radius;
+    }
+
+    float radius = 0.0f;
+    if (auto obb = obj->GetComponent<OBBColliderComponent>())
+    {
+        radius = (obb->GetSize() * 0.5f).Length();
+    }
+    else if (auto aabb = obj->GetComponent<AABBColliderComponent>())
+    {
+        radius = (aabb->GetSize() * 0.5f).Length();
+    }
+
+    cache.generation = h.generation;
+    cache.valid = true;
+    cache.radius = radius;
+    return radius;
+}
+
+void SpatialIndex::Rebuild(const std::vector<std::shared_ptr<GameObject>>& objects)
+{
+    m_objects = &objects;
+    m_maxRadius = 0.0f;
+
+    size_t cellCount = static_cast<size_t>(m_cellsX) * m_cellsZ;
+    m_cellStart.assign(cellCount + 1, 0);
+
+    //--------------エントリを作ってセルごとの数を数える------------------
+    m_scratch.clear();
+    m_scratchCell.clear();
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        GameObject* obj = objects[i].get();
+        if (!obj) { continue; }
+
+        Entry e;
+        e.object = obj;
+        e.objectIndex = static_cast<uint32_t>(i);
+        e.position = obj->GetPosition();
+        e.radius = ComputeRadius(obj);
+        e.tag = obj->GetTag();
+
+        PushScratch(e);
+    }
+
+    SortScratchIntoCells();
+}
+
+void SpatialIndex::RebuildSpheres(const Vector3* centers, const float* radii, size_t count)
+{
+    m_objects = nullptr;
+    m_maxRadius = 0.0f;
+
+    size_t cellCount = static_cast<size_t>(m_cellsX) * m_cellsZ;
+    m_cellStart.assign(cellCount + 1, 0);
+
+    m_scratch.clear();
+    m_scratchCell.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        Entry e;
+        e.objectIndex = static_cast<uint32_t>(i);
+        e.position = centers[i];
+        e.radius = radii[i];
+        e.tag = ~0u;
+        PushScratch(e);
+    }
+
+    SortScratchIntoCells();
+}
+
+void SpatialIndex::PushScratch(const Entry& e)
+{
+    if (e.radius > m_maxRadius) { m_maxRadius = e.radius; }
+
+    uint32_t cell = static_cast<uint32_t>(CellZ(e.position.z) * m_cellsX + CellX(e.position.x));
+    m_scratch.push_back(e);
+    m_scratchCell.push_back(cell);
+    ++m_cellStart[cell + 1];
+}
+
+void SpatialIndex::SortScratchIntoCells()
+{
+    size_t cellCount = static_cast<size_t>(m_cellsX) * m_cellsZ;
+
+    //--------------セル順に並べ替え（計数ソート）------------------
+    for (size_t c = 0; c < cellCount; ++c)
+    {
+        m_cellStart[c + 1] += m_cellStart[c];
+    }
+
+    m_entries.resize(m_scratch.size());
+    std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (size_t i = 0; i < m_scratch.size(); ++i)
+    {
+        m_entries[cursor[m_scratchCell[i]]++] = m_scratch[i];
+    }
+}
+
+template<typename Fn>
+void SpatialIndex::ForEachInBox(float minX, float minZ, float maxX, float maxZ, uint32_t tagMask, Fn&& fn) const
+{
+    if (m_entries.empty()) { return; }
+
+    //中心のセルにしか入れていないので、最大半径ぶん広げて探す
+    int x0 = CellX(minX - m_maxRadius);
+    int x1 = CellX(maxX + m_maxRadius);
+    int z0 = CellZ(minZ - m_maxRadius);
+    int z1 = CellZ(maxZ + m_maxRadius);
+
+    for (int z = z0; z <= z1; ++z)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            size_t cell = static_cast<size_t>(z) * m_cellsX + x;
+            for (uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i)
+            {
+                const Entry& e = m_entries[i];
+                if (e.tag & tagMask)
+                {
+                    fn(e);
+                }
+            }
+        }
+    }
+}
+
+void SpatialIndex::Collect(uint32_t tagMask, FrameVector<GameObject*>& out) const
+{
+    for (const Entry& e : m_entries)
+    {
+        if (e.tag & tagMask)
+        {
+            out.push_back(e.object);
+        }
+    }
+}
+
+void SpatialIndex::QuerySphere(const Vector3& center, float radius, uint32_t tagMask,
+                               FrameVector<GameObject*>& out) const
+{
+    ForEachInBox(center.x - radius, center.z - radius, center.x + radius, center.z + radius, tagMask,
+        [&](const Entry& e)
+        {
+            float r = radius + e.radius;
+            if ((e.position - center).LengthSquared() <= r * r)
+            {
+                out.push_back(e.object);
+            }
+        });
+}
+
+void SpatialIndex::QueryBoxIndices(const Vector3& min, const Vector3& max, FrameVector<uint32_t>& out) const
+{
+    ForEachInBox(min.x, min.z, max.x, max.z, ~0u,
+        [&](const Entry& e)
+        {
+            //箱と球（箱までの距離 <= 半径）
+            float d2 = 0.0f;
+            const float p[3] = { e.position.x, e.position.y, e.position.z };
+            const float lo[3] = { min.x, min.y, min.z };
+            const float hi[3] = { max.x, max.y, max.z };
+            for (int k = 0; k < 3; ++k)
+            {
+                if (p[k] < lo[k]) { d2 += (lo[k] - p[k]) * (lo[k] - p[k]); }
+                else if (p[k] > hi[k]) { d2 += (p[k] - hi[k]) * (p[k] - hi[k]); }
+            }
+            if (d2 <= e.radius * e.radius)
+            {
+                out.push_back(e.objectIndex);
+            }
+        });
+}
+
+void SpatialIndex::QueryCone(const Vector3& apex, const Vector3& dir, float cosHalfAngle, float maxDistance,
+                             uint32_t tagMask, FrameVector<GameObject*>& out) const
+{
+    float cos2 = cosHalfAngle * cosHalfAngle;
+    float maxDist2 = (maxDistance < FLT_MAX) ? maxDistance * maxDistance : FLT_MAX;
+
+    ForEachInBox(apex.x - maxDistance, apex.z - maxDistance, apex.x + maxDistance, apex.z + maxDistance, tagMask,
+        [&](const Entry& e)
+        {
+            Vector3 to = e.position - apex;
+            float d = to.Dot(dir);
+            if (d <= 0.0f) { return; }
+
+            //cos(角度) >= cosHalfAngle を平方根なしで判定
+            float len2 = to.LengthSquared();
+            if (len2 > maxDist2) { return; }
+            if (d * d < cos2 * len2) { return; }
+
+            out.push_back(e.object);
+        });
+}
+
+void SpatialIndex::QueryNearest(const Vector3& point, size_t k, float maxDistance, uint32_t tagMask,
+                                FrameVector<GameObject*>& out) const
+{
+    if (k == 0 || m_entries.empty()) { return; }
+
+    //探索半径を倍々に広げ、k 件以上見つかった時点でその中から近い順に取る
+    //（半径 r の中で k 件あれば、それより外に近いものは無い）
+    FrameVector<std::pair<float, GameObject*>> found;
+    float extent = (std::max)(m_max.x - m_min.x, m_max.z - m_min.z) + m_maxRadius;
+    float r = m_cellSize;
+
+    for (;;)
+    {
+        if (r > maxDistance) { r = maxDistance; }
+
+        found.clear();
+        float r2 = r * r;
+        ForEachInBox(point.x - r, point.z - r, point.x + r, point.z + r, tagMask,
+            [&](const Entry& e)
+            {
+                float d2 = (e.position - point).LengthSquared();
+                if (d2 <= r2)
+                {
+                    found.push_back({ d2, e.object });
+                }
+            });
+
+        if (found.size() >= k || r >= maxDistance || r >= extent) { break; }
+        r *= 2.0f;
+    }
+
+    size_t n = (std::min)(k, found.size());
+    std::partial_sort(found.begin(), found.begin() + n, found.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        out.push_back(found[i].second);
+    }
+}
+
+bool SpatialIndex::Raycast(const Vector3& origin, const Vector3& dir, float maxDistance, uint32_t tagMask,
+                           GameObject* ignore, const std::function<bool(GameObject*)>& predicate,
+                           RaycastHit& outHit) const
+{
+    Vector3 end = origin + dir * maxDistance;
+
+    float bestT = FLT_MAX;
+    const Entry* best = nullptr;
+
+    ForEachInBox((std::min)(origin.x, end.x), (std::min)(origin.z, end.z),
+                 (std::max)(origin.x, end.x), (std::max)(origin.z, end.z), tagMask,
+        [&](const Entry& e)
+        {
+            if (e.object == ignore || e.radius <= 0.0f) { return; }
+
+            //レイ vs 球
+            Vector3 m = origin - e.position;
+            float b = m.Dot(dir);
+            float c = m.Dot(m) - e.radius * e.radius;
+            if (c > 0.0f && b > 0.0f) { return; }
+
+            float discr = b * b - c;
+            if (discr < 0.0f) { return; }
+
+            float t = -b - std::sqrt(discr);
+            if (t < 0.0f)
+            {
+                t = -b + std::sqrt(discr);
+            }
+            if (t < 0.0f || t > maxDistance || t >= bestT) { return; }
+
+            if (predicate && !predicate(e.object)) { return; }
+
+            bestT = t;
+            best = &e;
+        });
+
+    if (!best || !m_objects) { return false; }
+
+    outHit.hitObject = (*m_objects)[best->objectIndex];
+    outHit.distance = bestT;
+    outHit.position = origin + dir * bestT;
+    outHit.normal = outHit.position - best->position;
+    if (outHit.normal.LengthSquared() > 1e-6f)
+    {
+        outHit.normal.Normalize();
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+﻿#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <SimpleMath.h>
+#include "FrameArena.h"
+#include "RaycastHit.h"
+
+class GameObject;
+
+//------------------------------------------------------------
+// シーン内オブジェクトの空間インデックス（XZ 平面のルーズな一様グリッド）
+// ・1 フレーム 1 回 Rebuild() で作り直し、AI・ターゲット選択・ミニマップなどで共有する
+// ・オブジェクトは中心のセルにだけ入れ、検索範囲を最大半径ぶん広げて取りこぼしを防ぐ
+// ・ObjectTag のビットマスクで種類を絞り込める（RTTI を使わない）
+// ・検索結果は FrameVector に追加するので、フレームをまたいで持たないこと
+//------------------------------------------------------------
+class SpatialIndex
+{
+public:
+    //1 件分のデータ
+    struct Entry
+    {
+        GameObject* object = nullptr;
+        uint32_t objectIndex = 0;               //Rebuild に渡した配列内の位置
+        DirectX::SimpleMath::Vector3 position;
+        float radius = 0.0f;                    //レイ判定用の半径（0 = 形が無い）
+        uint32_t tag = 0;
+    };
+
+    //グリッドの範囲とセルの大きさ（範囲外のオブジェクトは端のセルに入る）
+    void SetBounds(const DirectX::SimpleMath::Vector3& min, const DirectX::SimpleMath::Vector3& max, float cellSize = 32.0f);
+
+    //全オブジェクトを入れ直す
+    void Rebuild(const std::vector<std::shared_ptr<GameObject>>& objects);
+
+    //GameObject を介さずに球（中心・半径）を入れ直す（当たり判定の広域判定用）
+    //Entry::object は nullptr、objectIndex は渡した配列内の位置になる。Raycast などの GameObject を返す検索には使わない
+    void RebuildSpheres(const DirectX::SimpleMath::Vector3* centers, const float* radii, size_t count);
+
+    //中身を空にする（Rebuild に渡した配列が変わるときに呼ぶ）
+    void Clear();
+
+    //----------検索関数（見つかったものを out の末尾に追加する）-------------
+    //タグが一致するものをすべて
+    void Collect(uint32_t tagMask, FrameVector<GameObject*>& out) const;
+
+    //球と重なるもの（相手の半径も含めて判定）
+    void QuerySphere(const DirectX::SimpleMath::Vector3& center, float radius, uint32_t tagMask,
+                     FrameVector<GameObject*>& out) const;
+
+    //箱 [min, max] と重なる球の objectIndex（RebuildSpheres で入れたもの向け。タグは見ない）
+    void QueryBoxIndices(const DirectX::SimpleMath::Vector3& min, const DirectX::SimpleMath::Vector3& max,
+                         FrameVector<uint32_t>& out) const;
+
+    //円錐の中にあるもの（dir は正規化済み、cosHalfAngle は半頂角の cos）
+    void QueryCone(const DirectX::SimpleMath::Vector3& apex, const DirectX::SimpleMath::Vector3& dir,
+                   float cosHalfAngle, float maxDistance, uint32_t tagMask,
+                   FrameVector<GameObject*>& out) const;
+
+    //近い順に最大 k 件（中心同士の距離で比較）
+    void QueryNearest(const DirectX::SimpleMath::Vector3& point, size_t k, float maxDistance, uint32_t tagMask,
+                      FrameVector<GameObject*>& out) const;
+
+    //レイと各オブジェクトの球との交差のうち一番手前のもの（dir は正規化済み）
+    bool Raycast(const DirectX::SimpleMath::Vector3& origin, const DirectX::SimpleMath::Vector3& dir,
+                 float maxDistance, uint32_t tagMask, GameObject* ignore,
+                 const std::function<bool(GameObject*)>& predicate, RaycastHit& outHit) const;
+
+    size_t GetCount() const { return m_entries.size(); }
+
+private:
+    //XZ の範囲 [min, max] に掛かるセルのエントリを順に渡す
+    template<typename Fn>
+    void ForEachInBox(float minX, float minZ, float maxX, float maxZ, uint32_t tagMask, Fn&& fn) const;
+
+    //m_scratch に 1 件積み、セルごとの数を数える / 積んだものをセル順に並べて m_entries にする
+    void PushScratch(const Entry& e);
+    void SortScratchIntoCells();
+
+    int CellX(float x) const;
+    int CellZ(float z) const;
+
+    //タグ・コライダーからレイ判定用の半径を決める
+    float ComputeRadius(GameObject* obj);
+
+    DirectX::SimpleMath::Vector3 m_min = DirectX::SimpleMath::Vector3(-1000, -1000, -1000);
+    DirectX::SimpleMath::Vector3 m_max = DirectX::SimpleMath::Vector3(1000, 1000, 1000);
+    float m_cellSize = 32.0f;
+    int m_cellsX = 1;
+    int m_cellsZ = 1;
+
+    std::vector<uint32_t> m_cellStart;   //セル i のエントリは [m_cellStart[i], m_cellStart[i + 1])
+    std::vector<Entry>    m_entries;     //セル順に並べたエントリ
+    std::vector<Entry>    m_scratch;     //並べ替え用
+    std::vector<uint32_t> m_scratchCell;
+    float m_maxRadius = 0.0f;
+
+    //コライダーから求めた半径のキャッシュ（handle.index で引き、generation が変われば作り直す）
+    struct RadiusCache
+    {
+        uint32_t generation = 0;
+        bool valid = false;
+        float radius = 0.0f;
+    };
+    std::vector<RadiusCache> m_radiusCache;
+
+    const std::vector<std::shared_ptr<GameObject>>* m_objects = nullptr;
+};
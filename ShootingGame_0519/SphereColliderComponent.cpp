@@ -17,8 +17,7 @@ Vector3 SphereColliderComponent::GetCenter() const
 								   m_localOffset.y * owner->GetScale().y,
 								   m_localOffset.z * owner->GetScale().z);
 
-	Vector3 rot = owner->GetRotation();
-	Matrix rotMat = Matrix::CreateFromYawPitchRoll(rot.y, rot.x, rot.z);
+	const Matrix& rotMat = owner->GetRotationMatrix();
 	Vector3 worldOffset = Vector3::Transform(scaledOffset, rotMat);
 
 	return owner->GetPosition() + worldOffset;
@@ -20,6 +20,9 @@ public:
 	Vector3 GetSize() const override { return DirectX::SimpleMath::Vector3::Zero; };
 	DirectX::SimpleMath::Matrix GetRotationMatrix() const override;
 
+	//ivnupj
+	std::shared_ptr<Component> Clone() const override { return std::make_shared<SphereColliderComponent>(*this); }
+
 private:
 	//--------------Sphere֘A------------------
 	float m_radius = 1.0f;
@@ -30,7 +30,7 @@ void SphereComponent::Draw(float /*alpha*/)
 
     Renderer::SetDepthEnable(false);
 
-    Matrix4x4 world = GetOwner()->GetTransform().GetMatrix();
+    Matrix4x4 world = GetOwner()->GetLocalMatrix();
     Renderer::SetWorldMatrix(&world);
 
     ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
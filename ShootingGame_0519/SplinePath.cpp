@@ -0,0 +1,265 @@
+﻿#include "SplinePath.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace
+{
+    //ループなら巻き戻し、そうでなければ端に丸めて点を取り出す（PatrolComponent の従来の取り方と同じ）
+    XMVECTOR GetPoint(const std::vector<XMFLOAT3>& points, int index, bool loop)
+    {
+        int count = static_cast<int>(points.size());
+        if (loop)
+        {
+            index %= count;
+            if (index < 0) { index += count; }
+        }
+        else
+        {
+            index = std::clamp(index, 0, count - 1);
+        }
+
+        //XZ 平面だけで扱う
+        const XMFLOAT3& p = points[index];
+        return XMVectorSet(p.x, 0.0f, p.z, 0.0f);
+    }
+
+    //1 区間分の 4 点
+    struct Segment
+    {
+        XMVECTOR p0, p1, p2, p3;
+    };
+
+    XMVECTOR EvalPosition(const Segment& s, float t)
+    {
+        //XMVectorCatmullRom は 0.5 * (...) の標準形
+        return XMVectorCatmullRom(s.p0, s.p1, s.p2, s.p3, t);
+    }
+
+    XMVECTOR EvalTangent(const Segment& s, float t)
+    {
+        float t2 = t * t;
+
+        //d/dt of 0.5 * (2p1 + (-p0+p2)t + (2p0-5p1+4p2-p3)t^2 + (-p0+3p1-3p2+p3)t^3)
+        XMVECTOR a = XMVectorSubtract(s.p2, s.p0);
+        XMVECTOR b = XMVectorAdd(XMVectorSubtract(XMVectorScale(s.p0, 2.0f), XMVectorScale(s.p1, 5.0f)),
+                                 XMVectorSubtract(XMVectorScale(s.p2, 4.0f), s.p3));
+        XMVECTOR c = XMVectorAdd(XMVectorSubtract(XMVectorScale(s.p1, 3.0f), s.p0),
+                                 XMVectorSubtract(s.p3, XMVectorScale(s.p2, 3.0f)));
+
+        XMVECTOR tan = XMVectorAdd(a, XMVectorAdd(XMVectorScale(b, 2.0f * t), XMVectorScale(c, 3.0f * t2)));
+        return XMVectorScale(tan, 0.5f);
+    }
+
+    //t での速さ |dP/dt|
+    float EvalSpeed(const Segment& s, float t)
+    {
+        return XMVectorGetX(XMVector3Length(EvalTangent(s, t)));
+    }
+
+    //区間内 [ta, tb] の道のり（5 点 Gauss-Legendre で |dP/dt| を積分）
+    float ArcLength(const Segment& s, float ta, float tb)
+    {
+        static constexpr float kNodes[5] = { 0.0f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f };
+        static constexpr float kWeights[5] = { 0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f, 0.2369268851f };
+
+        float half = 0.5f * (tb - ta);
+        float mid = 0.5f * (ta + tb);
+        float sum = 0.0f;
+        for (int i = 0; i < 5; ++i)
+        {
+            sum += kWeights[i] * EvalSpeed(s, mid + half * kNodes[i]);
+        }
+        return sum * half;
+    }
+
+    //[t0, t1] の中で、t0 からの道のりが target になる t を求める（ニュートン法。はみ出したら二分法に切り替える）
+    float SolveArcLength(const Segment& s, float t0, float t1, float target, float guess)
+    {
+        float lo = t0;
+        float hi = t1;
+        float t = std::clamp(guess, t0, t1);
+
+        for (int iter = 0; iter < 8; ++iter)
+        {
+            float g = ArcLength(s, t0, t) - target;
+            if (std::fabs(g) < 1e-5f) { break; }
+
+            if (g > 0.0f) { hi = t; }
+            else          { lo = t; }
+
+            float speed = EvalSpeed(s, t);
+            float next = (speed > 1e-6f) ? t - g / speed : lo;
+            if (!(next > lo && next < hi))
+            {
+                next = 0.5f * (lo + hi);
+            }
+            t = next;
+        }
+        return t;
+    }
+}
+
+std::shared_ptr<const SplinePath> SplinePath::Bake(const std::vector<XMFLOAT3>& points, bool loop, float spacing)
+{
+    auto path = std::make_shared<SplinePath>();
+    path->m_loop = loop;
+
+    if (points.empty()) { return path; }
+
+    int count = static_cast<int>(points.size());
+    int segmentCount = (count < 2) ? 0 : (loop ? count : count - 1);
+
+    //--------------区間ごとの 4 点------------------
+    std::vector<Segment> segments(segmentCount);
+    for (int i = 0; i < segmentCount; ++i)
+    {
+        segments[i].p0 = GetPoint(points, i - 1, loop);
+        segments[i].p1 = GetPoint(points, i, loop);
+        segments[i].p2 = GetPoint(points, i + 1, loop);
+        segments[i].p3 = GetPoint(points, i + 2, loop);
+    }
+
+    //--------------細かく刻んで累積の道のりを測る------------------
+    //dense[k] は区間 k / kSamplesPerSegment、t = (k % kSamplesPerSegment) / kSamplesPerSegment の点
+    //（弦の長さの和ではなく、刻みごとに |dP/dt| を積分した道のり）
+    size_t denseCount = static_cast<size_t>(segmentCount) * kSamplesPerSegment + 1;
+    std::vector<float> denseLength(denseCount, 0.0f);
+
+    const float dt = 1.0f / kSamplesPerSegment;
+    for (size_t k = 1; k < denseCount; ++k)
+    {
+        size_t seg = (k - 1) / kSamplesPerSegment;
+        float t0 = static_cast<float>(k - 1 - seg * kSamplesPerSegment) * dt;
+
+        denseLength[k] = denseLength[k - 1] + ArcLength(segments[seg], t0, t0 + dt);
+    }
+
+    float total = denseLength.back();
+    const XMFLOAT3& first = points.front();
+
+    //長さが無い（点が 1 つ・全部同じ位置）なら先頭の点だけ
+    if (segmentCount == 0 || total <= 1e-5f)
+    {
+        path->m_samples.push_back({ first.x, first.z, 0.0f, 1.0f, 0 });
+        return path;
+    }
+
+    //--------------道のり一定間隔で取り直す------------------
+    if (spacing <= 1e-3f) { spacing = 1e-3f; }
+    size_t stepCount = static_cast<size_t>(std::ceil(total / spacing));
+    if (stepCount < 1) { stepCount = 1; }
+
+    path->m_length = total;
+    path->m_step = total / static_cast<float>(stepCount);
+    path->m_invStep = 1.0f / path->m_step;
+    path->m_samples.resize(stepCount + 1);
+
+    size_t k = 1;
+    for (size_t n = 0; n <= stepCount; ++n)
+    {
+        float s = (n == stepCount) ? total : path->m_step * static_cast<float>(n);
+
+        //s を含む細かい刻み [k-1, k] を探す（s は単調増加なので前から進めるだけ）
+        while (k < denseCount - 1 && denseLength[k] < s) { ++k; }
+
+        float l0 = denseLength[k - 1];
+        float l1 = denseLength[k];
+        float f = (l1 > l0) ? (s - l0) / (l1 - l0) : 0.0f;
+        f = std::clamp(f, 0.0f, 1.0f);
+
+        //刻み内の t は、線形に割った値から道のりの積分を逆に解いて合わせる
+        size_t seg = (k - 1) / kSamplesPerSegment;
+        float t0 = static_cast<float>(k - 1 - seg * kSamplesPerSegment) * dt;
+        float t = SolveArcLength(segments[seg], t0, t0 + dt, s - l0, t0 + f * dt);
+
+        XMVECTOR pos = EvalPosition(segments[seg], t);
+        XMVECTOR tan = EvalTangent(segments[seg], t);
+        if (XMVectorGetX(XMVector3LengthSq(tan)) > 1e-12f)
+        {
+            tan = XMVector3Normalize(tan);
+        }
+        else
+        {
+            tan = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+        }
+
+        Sample& out = path->m_samples[n];
+        out.x = XMVectorGetX(pos);
+        out.z = XMVectorGetZ(pos);
+        out.dirX = XMVectorGetX(tan);
+        out.dirZ = XMVectorGetZ(tan);
+        out.segment = static_cast<uint32_t>(seg);
+    }
+
+    return path;
+}
+
+float SplinePath::Wrap(float distance) const
+{
+    if (m_length <= 0.0f) { return 0.0f; }
+
+    if (m_loop)
+    {
+        distance = std::fmod(distance, m_length);
+        if (distance < 0.0f) { distance += m_length; }
+        return distance;
+    }
+
+    return std::clamp(distance, 0.0f, m_length);
+}
+
+void SplinePath::Evaluate(float distance, XMFLOAT3& outPos, XMFLOAT3& outDir, size_t& outSegment) const
+{
+    if (m_samples.size() < 2)
+    {
+        const Sample& s = m_samples.empty() ? Sample{ 0.0f, 0.0f, 0.0f, 1.0f, 0 } : m_samples.front();
+        outPos = XMFLOAT3(s.x, 0.0f, s.z);
+        outDir = XMFLOAT3(s.dirX, 0.0f, s.dirZ);
+        outSegment = s.segment;
+        return;
+    }
+
+    //表の位置 = 道のり / 間隔（範囲外は端に丸める）
+    float u = distance * m_invStep;
+    size_t last = m_samples.size() - 1;
+
+    size_t i;
+    float f;
+    if (!(u > 0.0f))
+    {
+        i = 0;
+        f = 0.0f;
+    }
+    else if (u >= static_cast<float>(last))
+    {
+        i = last - 1;
+        f = 1.0f;
+    }
+    else
+    {
+        i = static_cast<size_t>(u);
+        f = u - static_cast<float>(i);
+    }
+
+    const Sample& a = m_samples[i];
+    const Sample& b = m_samples[i + 1];
+
+    outPos = XMFLOAT3(a.x + (b.x - a.x) * f, 0.0f, a.z + (b.z - a.z) * f);
+
+    float dx = a.dirX + (b.dirX - a.dirX) * f;
+    float dz = a.dirZ + (b.dirZ - a.dirZ) * f;
+    float len2 = dx * dx + dz * dz;
+    if (len2 > 1e-12f)
+    {
+        float inv = 1.0f / std::sqrt(len2);
+        outDir = XMFLOAT3(dx * inv, 0.0f, dz * inv);
+    }
+    else
+    {
+        outDir = XMFLOAT3(a.dirX, 0.0f, a.dirZ);
+    }
+
+    outSegment = (f < 1.0f) ? a.segment : b.segment;
+}
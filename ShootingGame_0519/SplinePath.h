@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <DirectXMath.h>
+
+//------------------------------------------------------------
+// ウェイポイントを通る Catmull-Rom 曲線（XZ 平面）を、道のりで引ける表にしたもの
+// ・Bake() で一度だけ作り、同じウェイポイントを使う敵同士で共有する
+// ・表は道のり spacing ごとの点なので、位置の取り出しは O(1) で速度も一定になる
+// ・描画・D3D には依存しない（DirectXMath だけで単体テストできる）
+//------------------------------------------------------------
+class SplinePath
+{
+public:
+    //1 区間あたりの長さ計測用の分割数（刻みごとに積分し、刻み内の t はニュートン法で求める）
+    static constexpr int kSamplesPerSegment = 32;
+
+    //表を作る。loop = true なら最後の点から最初の点へ戻る区間も含める
+    //spacing : 表の点の間隔（道のり）
+    static std::shared_ptr<const SplinePath> Bake(const std::vector<DirectX::XMFLOAT3>& points,
+                                                  bool loop, float spacing = 0.5f);
+
+    //道のり distance の位置・進行方向（正規化済み）・区間番号を返す（y は常に 0）
+    //distance は Wrap() 済みの値を渡すこと
+    void Evaluate(float distance, DirectX::XMFLOAT3& outPos, DirectX::XMFLOAT3& outDir,
+                  size_t& outSegment) const;
+
+    //道のりを有効範囲に収める（ループなら一周で巻き戻し、そうでなければ端で止める）
+    float Wrap(float distance) const;
+
+    float GetLength() const { return m_length; }
+    bool IsLoop() const { return m_loop; }
+    size_t GetSampleCount() const { return m_samples.size(); }
+
+private:
+    struct Sample
+    {
+        float x, z;          //位置
+        float dirX, dirZ;    //進行方向（正規化済み）
+        uint32_t segment;    //元のウェイポイントの区間番号
+    };
+
+    std::vector<Sample> m_samples;  //道のり k * m_step の点（先頭と末尾を含む）
+    float m_length = 0.0f;
+    float m_step = 0.0f;
+    float m_invStep = 0.0f;
+    bool m_loop = false;
+};
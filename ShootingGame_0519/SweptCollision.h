@@ -0,0 +1,188 @@
+﻿#pragma once
+#include <cmath>
+#include <SimpleMath.h>
+
+//----------------------------------------------------------------
+// 連続衝突判定（CCD）用の関数をまとめたヘッダーファイル
+// 半径 r の球が 1 フレームで p0 -> p1 へ動いたとき、相手に最初に触れる時刻 t (0..1) を求める
+// ・t = 0 は移動開始時点で既に重なっている
+// ・相手は静止しているものとして扱う（動いている同士は相対移動にして呼ぶ）
+// ・コンポーネントに依存しないので単体でテストできる（Tools/SweptCollisionCheck）
+//----------------------------------------------------------------
+namespace Collision
+{
+    using DirectX::SimpleMath::Vector3;
+
+    // ---------------------------------------
+    // 移動する球 vs 静止した球（解析解）
+    // ---------------------------------------
+    inline bool SweepSphereVsSphere(
+        const Vector3& p0, const Vector3& p1, float r,
+        const Vector3& center, float radius,
+        float& outT)
+    {
+        Vector3 d = p1 - p0;
+        Vector3 m = p0 - center;
+        float rr = r + radius;
+
+        float c = m.Dot(m) - rr * rr;
+        if (c <= 0.0f)
+        {
+            //最初から重なっている
+            outT = 0.0f;
+            return true;
+        }
+
+        float a = d.Dot(d);
+        float b = m.Dot(d);
+        if (a < 1e-12f || b >= 0.0f)
+        {
+            //動いていない or 離れていく
+            return false;
+        }
+
+        float disc = b * b - a * c;
+        if (disc < 0.0f)
+        {
+            return false;
+        }
+
+        float t = (-b - std::sqrt(disc)) / a;
+        if (t > 1.0f)
+        {
+            return false;
+        }
+
+        outT = (t < 0.0f) ? 0.0f : t;
+        return true;
+    }
+
+    //点と AABB の距離の二乗
+    inline float DistanceSqPointAABB(const Vector3& p, const Vector3& mn, const Vector3& mx)
+    {
+        float sq = 0.0f;
+        const float v[3] = { p.x, p.y, p.z };
+        const float lo[3] = { mn.x, mn.y, mn.z };
+        const float hi[3] = { mx.x, mx.y, mx.z };
+        for (int i = 0; i < 3; ++i)
+        {
+            if (v[i] < lo[i]) { sq += (lo[i] - v[i]) * (lo[i] - v[i]); }
+            if (v[i] > hi[i]) { sq += (v[i] - hi[i]) * (v[i] - hi[i]); }
+        }
+        return sq;
+    }
+
+    //線分 p0 + d*t (t=0..1) と AABB のスラブ判定。入る時刻と出る時刻を返す
+    inline bool SegmentVsAABBSlab(
+        const Vector3& p0, const Vector3& d,
+        const Vector3& mn, const Vector3& mx,
+        float& outEnter, float& outExit)
+    {
+        float tEnter = 0.0f;
+        float tExit = 1.0f;
+
+        const float p[3] = { p0.x, p0.y, p0.z };
+        const float v[3] = { d.x, d.y, d.z };
+        const float lo[3] = { mn.x, mn.y, mn.z };
+        const float hi[3] = { mx.x, mx.y, mx.z };
+
+        for (int i = 0; i < 3; ++i)
+        {
+            if (std::fabs(v[i]) < 1e-12f)
+            {
+                //この軸には動かない：範囲外なら当たらない
+                if (p[i] < lo[i] || p[i] > hi[i]) { return false; }
+                continue;
+            }
+
+            float inv = 1.0f / v[i];
+            float t1 = (lo[i] - p[i]) * inv;
+            float t2 = (hi[i] - p[i]) * inv;
+            if (t1 > t2) { float tmp = t1; t1 = t2; t2 = tmp; }
+
+            if (t1 > tEnter) { tEnter = t1; }
+            if (t2 < tExit) { tExit = t2; }
+            if (tEnter > tExit) { return false; }
+        }
+
+        outEnter = tEnter;
+        outExit = tExit;
+        return true;
+    }
+
+    // ---------------------------------------
+    // 移動する球 vs AABB
+    // 半径分ふくらませた箱で範囲を絞り、面の上なら入った時刻がそのまま答え
+    // 角・辺の近くは「箱までの距離」が t に対して凸なので、最小点を探してから根を二分探索する
+    // ---------------------------------------
+    inline bool SweepSphereVsAABB(
+        const Vector3& p0, const Vector3& p1, float r,
+        const Vector3& mn, const Vector3& mx,
+        float& outT)
+    {
+        Vector3 d = p1 - p0;
+        Vector3 e(r, r, r);
+
+        float tEnter, tExit;
+        if (!SegmentVsAABBSlab(p0, d, mn - e, mx + e, tEnter, tExit))
+        {
+            return false;
+        }
+
+        const float r2 = r * r;
+        auto distSq = [&](float t) { return DistanceSqPointAABB(p0 + d * t, mn, mx); };
+
+        //面に当たっている（または最初から重なっている）
+        if (distSq(tEnter) <= r2 * (1.0f + 1e-4f) + 1e-8f)
+        {
+            outT = tEnter;
+            return true;
+        }
+
+        //角・辺の丸まった部分：[tEnter, tExit] で一番近づく時刻を三分探索
+        float lo = tEnter;
+        float hi = tExit;
+        for (int i = 0; i < 40; ++i)
+        {
+            float m1 = lo + (hi - lo) / 3.0f;
+            float m2 = hi - (hi - lo) / 3.0f;
+            if (distSq(m1) <= distSq(m2)) { hi = m2; }
+            else { lo = m1; }
+        }
+        float tClosest = (lo + hi) * 0.5f;
+        if (distSq(tClosest) > r2)
+        {
+            return false;
+        }
+
+        //初めて距離が r になる時刻を二分探索
+        lo = tEnter;
+        hi = tClosest;
+        for (int i = 0; i < 32; ++i)
+        {
+            float mid = (lo + hi) * 0.5f;
+            if (distSq(mid) <= r2) { hi = mid; }
+            else { lo = mid; }
+        }
+
+        outT = hi;
+        return true;
+    }
+
+    // ---------------------------------------
+    // 移動する球 vs OBB（OBB のローカル空間に移して AABB として判定）
+    // axes : 正規化済みの Right, Up, Forward
+    // ---------------------------------------
+    inline bool SweepSphereVsOBB(
+        const Vector3& p0, const Vector3& p1, float r,
+        const Vector3& center, const Vector3 axes[3], const Vector3& halfSize,
+        float& outT)
+    {
+        Vector3 a = p0 - center;
+        Vector3 b = p1 - center;
+        Vector3 localP0(a.Dot(axes[0]), a.Dot(axes[1]), a.Dot(axes[2]));
+        Vector3 localP1(b.Dot(axes[0]), b.Dot(axes[1]), b.Dot(axes[2]));
+
+        return SweepSphereVsAABB(localP0, localP1, r, -halfSize, halfSize, outT);
+    }
+}
@@ -1,6 +1,6 @@
 #include "TextureComponent.h"
 #include "Renderer.h"
-#include <WICTextureLoader.h>
+#include "TextureManager.h"
 #include "Application.h"
 #include <iostream>
 
@@ -15,11 +15,11 @@ TextureComponent::TextureComponent()
 
 bool TextureComponent::LoadTexture(const std::wstring& filepath)
 {
-    ID3D11Device* device = Renderer::GetDevice();
-    if (!device) { return false; }
+    if (!Renderer::GetDevice()) { return false; }
 
-    HRESULT hr = CreateWICTextureFromFile(device, filepath.c_str(), nullptr, m_TextureSRV.GetAddressOf());
-    return SUCCEEDED(hr);
+    //TextureManager oRɂāA摜̋LƏĂς DDS ̗D
+    m_TextureSRV = TextureManager::Load(std::string(filepath.begin(), filepath.end()));
+    return m_TextureSRV != nullptr;
 }
 
 void TextureComponent::Initialize() 
@@ -40,7 +40,7 @@ void TextureComponent::Draw(float deltaTime)
     Renderer::SetTextureAlpha(m_Alpha);
 
     // ̃eNX``iDrawTexture  SRV gj
-    Renderer::DrawTexture(m_TextureSRV.Get(), m_Position, m_Size);
+    Renderer::DrawTexture(m_TextureSRV.get(), m_Position, m_Size);
 
     // iDrawTexture  SRV ̃AoChVF[_AsĂȂsvj
 }
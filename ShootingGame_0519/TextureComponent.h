@@ -4,6 +4,7 @@
 #include <SimpleMath.h>
 #include <wrl/client.h>
 #include <d3d11.h>
+#include "TextureManager.h"
 
 class TextureComponent : public Component
 {
@@ -21,6 +22,9 @@ public:
     //eNX`ǂݍ
     bool LoadTexture(const std::wstring& filepath);
 
+    //ǂݍݍς݂̃eNX`giTextureManager::LoadAsync ̎󂯎pB͂܂ł͉`Ȃj
+    void SetTexture(TextureHandle texture) { m_TextureSRV = std::move(texture); }
+
     //(UnityCanvas݂)̍W̃Zbg֐()
     void SetScreenPosition(float x, float y) { m_Position = { x,y };}
 
@@ -33,11 +37,11 @@ public:
 
     //--------Get֐-------
     bool GetVisible() const { return m_IsVisible; }
-    ID3D11ShaderResourceView* GetSRV() const { return m_TextureSRV.Get(); }
+    ID3D11ShaderResourceView* GetSRV() const { return m_TextureSRV.get(); }
 
 private:
     //Textureۑϐ
-    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_TextureSRV;
+    TextureHandle m_TextureSRV;
 
     //ʏ̍W̕ϐ
     DirectX::SimpleMath::Vector2 m_Position;
@@ -3,29 +3,240 @@
 #include <windows.h>
 #endif
 #include "TextureManager.h"
+#include <filesystem>
+#include <DDSTextureLoader.h>
 #include <WICTextureLoader.h>
 #include "Renderer.h"
+#include "Logger.h"
+#include "MemoryTracker.h"
+#include "AssetArchive.h"
 
-std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> TextureManager::m_textures;
+// 捨てたテクスチャの分は MemoryTracker の GPU 使用量から引く
+ResidencyCache<ID3D11ShaderResourceView> TextureManager::m_textures([](const std::string&, const ID3D11ShaderResourceView&, size_t bytes)
+    {
+        MemoryTracker::AddGpuBytes(MemoryCategory::Texture, -static_cast<int64_t>(bytes));
+    });
+
+std::unordered_map<std::string, std::vector<std::function<void(TextureHandle)>>> TextureManager::m_loading;
+
+namespace
+{
+    //Tools/TextureBaker が焼いた同名の .dds を探す
+    //元画像より古い .dds は焼き直し忘れとみなして使わない（元画像が無ければ .dds だけで良い）
+    bool FindBakedTexture(const std::string& filepath, std::wstring& outPath)
+    {
+        std::filesystem::path source(filepath);
+        std::filesystem::path baked = source;
+        baked.replace_extension(".dds");
+
+        std::error_code ec;
+        if (!std::filesystem::exists(baked, ec)) { return false; }
+
+        if (std::filesystem::exists(source, ec) &&
+            std::filesystem::last_write_time(baked, ec) < std::filesystem::last_write_time(source, ec))
+        {
+            LOG_WARN("TextureManager: %s が元画像より古いので使いません", baked.string().c_str());
+            return false;
+        }
+
+        outPath = baked.wstring();
+        return true;
+    }
+
+    //アーカイブから読む。焼き済みの .dds があればそちらを、無ければ元画像をメモリからデコードする
+    //アーカイブは Tools/AssetPacker が焼き済みのものと一緒に作るので、ここでは新旧を比べない
+    HRESULT LoadFromArchive(const std::string& filepath, ID3D11ShaderResourceView** texture)
+    {
+        std::string baked = std::filesystem::path(filepath).replace_extension(".dds").string();
+
+        AssetView view;
+        if (AssetArchive::Contains(baked) && AssetArchive::Load(baked, view))
+        {
+            HRESULT hr = DirectX::CreateDDSTextureFromMemory(
+                Renderer::GetDevice(), view.data, view.size, nullptr, texture);
+            if (SUCCEEDED(hr)) { return hr; }
+            LOG_WARN("TextureManager: DDS の読み込みに失敗しました (%s, hr=0x%08X)", filepath.c_str(), static_cast<unsigned>(hr));
+        }
+
+        if (AssetArchive::Contains(filepath) && AssetArchive::Load(filepath, view))
+        {
+            return DirectX::CreateWICTextureFromMemory(
+                Renderer::GetDevice(), view.data, view.size, nullptr, texture);
+        }
+        return E_FAIL;
+    }
+
+    //読み込んだテクスチャが GPU で使うバイト数（MemoryTracker への計上用。よく使う形式だけ見分ける）
+    int64_t EstimateTextureBytes(ID3D11ShaderResourceView* srv)
+    {
+        Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+        srv->GetResource(resource.GetAddressOf());
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+        if (!resource || FAILED(resource.As(&texture))) { return 0; }
+
+        D3D11_TEXTURE2D_DESC desc{};
+        texture->GetDesc(&desc);
 
-ID3D11ShaderResourceView* TextureManager::Load(const std::string& filepath)
+        uint32_t bitsPerPixel = 32;
+        bool blockCompressed = false;
+        switch (desc.Format)
+        {
+        case DXGI_FORMAT_BC1_UNORM: case DXGI_FORMAT_BC1_UNORM_SRGB:
+        case DXGI_FORMAT_BC4_UNORM: case DXGI_FORMAT_BC4_SNORM:
+            bitsPerPixel = 4; blockCompressed = true; break;
+        case DXGI_FORMAT_BC2_UNORM: case DXGI_FORMAT_BC2_UNORM_SRGB:
+        case DXGI_FORMAT_BC3_UNORM: case DXGI_FORMAT_BC3_UNORM_SRGB:
+        case DXGI_FORMAT_BC5_UNORM: case DXGI_FORMAT_BC5_SNORM:
+        case DXGI_FORMAT_BC6H_UF16: case DXGI_FORMAT_BC6H_SF16:
+        case DXGI_FORMAT_BC7_UNORM: case DXGI_FORMAT_BC7_UNORM_SRGB:
+            bitsPerPixel = 8; blockCompressed = true; break;
+        case DXGI_FORMAT_R8_UNORM: case DXGI_FORMAT_A8_UNORM:
+            bitsPerPixel = 8; break;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT: case DXGI_FORMAT_R16G16B16A16_UNORM:
+            bitsPerPixel = 64; break;
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            bitsPerPixel = 128; break;
+        default:
+            break;
+        }
+        return MemoryTracker::EstimateTextureBytes(desc.Width, desc.Height, desc.MipLevels, desc.ArraySize,
+                                                   bitsPerPixel, blockCompressed);
+    }
+}
+
+TextureHandle TextureManager::Load(const std::string& filepath)
 {
-    auto it = m_textures.find(filepath);
-    if (it != m_textures.end())
+    if (TextureHandle cached = m_textures.Find(filepath))
     {
-        return it->second.Get();
+        return cached;
     }
 
+    MemoryScope memoryScope(MemoryCategory::Texture);
+
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture;
-    HRESULT hr = DirectX::CreateWICTextureFromFile(
-        Renderer::GetDevice(), std::wstring(filepath.begin(), filepath.end()).c_str(),
-        nullptr, texture.GetAddressOf());
+    HRESULT hr = E_FAIL;
+
+    if (AssetArchive::IsMounted())
+    {
+        hr = LoadFromArchive(filepath, texture.GetAddressOf());
+    }
+
+    //焼き済みの DDS（ミップマップ付き・BC 圧縮）があればデコード無しでそのまま使う
+    std::wstring ddsPath;
+    if (FAILED(hr) && FindBakedTexture(filepath, ddsPath))
+    {
+        hr = DirectX::CreateDDSTextureFromFile(
+            Renderer::GetDevice(), ddsPath.c_str(), nullptr, texture.GetAddressOf());
+        if (FAILED(hr))
+        {
+            LOG_WARN("TextureManager: DDS の読み込みに失敗しました (%s, hr=0x%08X)", filepath.c_str(), static_cast<unsigned>(hr));
+        }
+    }
+
+    if (FAILED(hr))
+    {
+        hr = DirectX::CreateWICTextureFromFile(
+            Renderer::GetDevice(), std::wstring(filepath.begin(), filepath.end()).c_str(),
+            nullptr, texture.GetAddressOf());
+    }
 
     if (SUCCEEDED(hr))
     {
-        m_textures[filepath] = texture;
-        return texture.Get();
+        return Register(filepath, texture);
     }
 
     return nullptr;
+}
+
+TextureHandle TextureManager::Register(const std::string& filepath, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& texture)
+{
+    const int64_t bytes = EstimateTextureBytes(texture.Get());
+    MemoryTracker::AddGpuBytes(MemoryCategory::Texture, bytes);
+
+    // 最後の参照が外れたら COM の参照も返す
+    TextureHandle handle(texture.Detach(), [](ID3D11ShaderResourceView* srv) { srv->Release(); });
+    m_textures.Insert(filepath, handle, static_cast<size_t>(bytes));
+    return handle;
+}
+
+void TextureManager::LoadAsync(const std::string& filepath, std::function<void(TextureHandle)> onLoaded, FileReadPriority priority)
+{
+    if (TextureHandle cached = m_textures.Find(filepath))
+    {
+        if (onLoaded) { onLoaded(cached); }
+        return;
+    }
+
+    std::vector<std::function<void(TextureHandle)>>& waiting = m_loading[filepath];
+    waiting.push_back(std::move(onLoaded));
+    if (waiting.size() > 1) { return; }
+
+    // Load と同じ優先順で読むファイルを決める（アーカイブの .dds -> アーカイブの元画像 -> 焼き済みの .dds -> 元画像）
+    std::string source = filepath;
+    std::wstring ddsPath;
+    const std::string baked = std::filesystem::path(filepath).replace_extension(".dds").string();
+    if (AssetArchive::IsMounted() && AssetArchive::Contains(baked))
+    {
+        source = baked;
+    }
+    else if (!(AssetArchive::IsMounted() && AssetArchive::Contains(filepath)) && FindBakedTexture(filepath, ddsPath))
+    {
+        source = baked;
+    }
+    const bool isDds = source != filepath;
+
+    FileReadRequest request;
+    request.path = source;
+    request.priority = priority;
+    request.onComplete = [filepath, isDds](FileReadResult& result)
+        {
+            // 読み込み中に Load で同じものが作られていればそちらを使う
+            TextureHandle handle = m_textures.Find(filepath);
+            if (!handle && result.ok)
+            {
+                MemoryScope memoryScope(MemoryCategory::Texture);
+                Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture;
+                HRESULT hr = isDds
+                    ? DirectX::CreateDDSTextureFromMemory(Renderer::GetDevice(), result.view.data, result.view.size, nullptr, texture.GetAddressOf())
+                    : DirectX::CreateWICTextureFromMemory(Renderer::GetDevice(), result.view.data, result.view.size, nullptr, texture.GetAddressOf());
+                if (SUCCEEDED(hr)) { handle = Register(filepath, texture); }
+            }
+            if (!handle) { handle = Load(filepath); }
+
+            // 渡した先でまた LoadAsync を呼んでも良いように、先に取り出しておく
+            std::vector<std::function<void(TextureHandle)>> callbacks = std::move(m_loading[filepath]);
+            m_loading.erase(filepath);
+            for (auto& callback : callbacks)
+            {
+                if (callback) { callback(handle); }
+            }
+        };
+    AsyncFileSystem::Read(std::move(request));
+}
+
+void TextureManager::SetBudget(size_t bytes)
+{
+    m_textures.SetBudget(bytes);
+}
+
+void TextureManager::Trim()
+{
+    const uint64_t evictions = m_textures.GetEvictions();
+    const size_t evicted = m_textures.Trim();
+    if (evicted > 0)
+    {
+        LOG_INFO("TextureManager: evicted %llu textures (%zu KB), resident %zu KB / budget %zu KB",
+            static_cast<unsigned long long>(m_textures.GetEvictions() - evictions), evicted / 1024,
+            m_textures.GetResidentBytes() / 1024, m_textures.GetBudget() / 1024);
+    }
+}
+
+void TextureManager::Uninit()
+{
+    LOG_INFO("TextureManager: %zu textures resident (%zu KB), hits=%llu misses=%llu evictions=%llu",
+        m_textures.GetCount(), m_textures.GetResidentBytes() / 1024,
+        static_cast<unsigned long long>(m_textures.GetHits()), static_cast<unsigned long long>(m_textures.GetMisses()),
+        static_cast<unsigned long long>(m_textures.GetEvictions()));
+    m_loading.clear();
+    m_textures.Clear();
 }
\ No newline at end of file
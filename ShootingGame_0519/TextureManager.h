@@ -1,15 +1,44 @@
 // TextureManager.h
 #pragma once
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <wrl/client.h>
 #include <d3d11.h>
+#include "ResidencyCache.h"
+#include "AsyncFileSystem.h"
+
+// 読み込んだテクスチャへの参照。持っている間はキャッシュから捨てられない
+using TextureHandle = std::shared_ptr<ID3D11ShaderResourceView>;
 
 class TextureManager
 {
 public:
-    static ID3D11ShaderResourceView* Load(const std::string& filepath);
+    static TextureHandle Load(const std::string& filepath);
+
+    // ファイルの読み込みだけ AsyncFileSystem で裏に回し、テクスチャは AsyncFileSystem::Poll の中（メインスレッド）で作って onLoaded に渡す
+    // キャッシュにあればその場で渡す。同じパスを読み込み中なら読み込みは 1 回で、全員に同じハンドルを渡す
+    // 失敗したときは Load と同じ経路で読み直し、それでも駄目なら nullptr を渡す
+    static void LoadAsync(const std::string& filepath, std::function<void(TextureHandle)> onLoaded,
+                          FileReadPriority priority = FileReadPriority::Normal);
+
+    // 使われていないテクスチャを残しておく上限（GPU のバイト数の見積もり。0 は上限なし）
+    static void SetBudget(size_t bytes);
+
+    // 上限を超えていれば使われていないものを古い順に捨てる（シーンの Init の後に呼ぶ）
+    static void Trim();
+
+    // すべて手放す（終了時）
+    static void Uninit();
 
 private:
-    static std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_textures;
+    // 作ったテクスチャをキャッシュに入れ、GPU の使用量に数える
+    static TextureHandle Register(const std::string& filepath, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& texture);
+
+    static ResidencyCache<ID3D11ShaderResourceView> m_textures;
+
+    // LoadAsync で読み込み中のパスと、終わったら渡す先
+    static std::unordered_map<std::string, std::vector<std::function<void(TextureHandle)>>> m_loading;
 };
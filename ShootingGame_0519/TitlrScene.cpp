@@ -9,6 +9,7 @@
 #include "FreeCameraComponent.h"
 #include "ModelComponent.h"
 #include "TextureComponent.h"
+#include "TextureManager.h"
 #include "Sound.h"
 #include "EffectManager.h"
 
@@ -27,15 +28,24 @@ void TitleScene::Init()
     m_Player->AddComponent(model);
 
     m_TitleLogo = std::make_shared<GameObject>();
+    //Sƕ͋@̂ʂ߂ĂôŁAǂݍ݂͗Ői߂Ă
     auto LogoTexter = std::make_shared<TextureComponent>();
-    LogoTexter->LoadTexture(L"Asset/UI/TitleLogo01.png");
+    std::weak_ptr<TextureComponent> logo = LogoTexter;
+    TextureManager::LoadAsync("Asset/UI/TitleLogo01.png", [logo](TextureHandle texture)
+        {
+            if (auto component = logo.lock()) { component->SetTexture(std::move(texture)); }
+        });
     LogoTexter->SetSize(614.4f, 520.8f);
     LogoTexter->SetScreenPosition(340, -30);
     m_TitleLogo->AddComponent(LogoTexter);
 
     m_TitleText = std::make_shared<GameObject>();
     auto TextTexter = std::make_shared<TextureComponent>();
-    TextTexter->LoadTexture(L"Asset/UI/TitleText02.png");
+    std::weak_ptr<TextureComponent> text = TextTexter;
+    TextureManager::LoadAsync("Asset/UI/TitleText02.png", [text](TextureHandle texture)
+        {
+            if (auto component = text.lock()) { component->SetTexture(std::move(texture)); }
+        });
     TextTexter->SetSize(780, 260);
     TextTexter->SetScreenPosition(250, 370);
     m_TitleText->AddComponent(TextTexter);
@@ -73,6 +83,9 @@ void TitleScene::Init()
     }
     
     Sound::PlaySeWav(L"Asset/Sound/SE/TitlePlayerPassing.wav", 0.5f);
+
+    //艹͓͂󂯕tĂ炷̂ŁAǂ݂Ă
+    Sound::PreloadSeAsync({ L"Asset/Sound/SE/TitleSelect01.wav" });
 }
 
 void TitleScene::Update(float deltatime)
@@ -203,7 +216,31 @@ void TitleScene::DrawUI(float deltatime)
 
 void TitleScene::Uninit()
 {
-    
+    //IuWFNgāA Init ō蒼i܂܂ƃfeNX`LbV̂ĂȂj
+    for (auto& obj : m_GameObjects)
+    {
+        if (obj) { obj->Uninit(); }
+    }
+    for (auto& obj : m_TextureObjects)
+    {
+        if (obj) { obj->Uninit(); }
+    }
+    m_GameObjects.clear();
+    m_TextureObjects.clear();
+    m_AddObjects.clear();
+    m_DeleteObjects.clear();
+
+    m_SkyDome.reset();
+    m_Player.reset();
+    m_camera.reset();
+    m_TitleLogo.reset();
+    m_TitleText.reset();
+    m_TitleMotion.reset();
+
+    m_IsLogoShown = false;
+    m_BlinkTimer = 0.0f;
+    m_BlinkVisible = true;
+    m_CurrentPathIndex = 0;
 }
     
 
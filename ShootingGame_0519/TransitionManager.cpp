@@ -7,7 +7,7 @@
 #include <iostream>
 #include <algorithm>
 
-ID3D11ShaderResourceView* TransitionManager::m_TextureSRV;
+TextureHandle TransitionManager::m_TextureSRV;
 bool  TransitionManager::m_isTransitioning;
 float TransitionManager::m_fadeSpeed;
 TransitionType TransitionManager::m_type = TransitionType::FADE;
@@ -130,7 +130,7 @@ void TransitionManager::Draw(float deltaTime)
     Renderer::SetTextureAlpha(m_alpha);
 
     //摜`
-    Renderer::DrawTexture(m_TextureSRV, topLeft, size);
+    Renderer::DrawTexture(m_TextureSRV.get(), topLeft, size);
 }
 
 //--------------------------------------------------------
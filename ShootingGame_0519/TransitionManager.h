@@ -2,6 +2,7 @@
 #include <string>
 #include <functional>
 #include <d3d11.h>
+#include "TextureManager.h"
 
 /// <summary>
 /// ʑJډõ^Cv񋓌^
@@ -31,7 +32,7 @@ public:
 private:
     ///static void FinishTransitionPhase();
 
-    static ID3D11ShaderResourceView* m_TextureSRV;
+    static TextureHandle m_TextureSRV;
     static bool m_isTransitioning; 
     static float m_duration; 
     static float m_elapsed;
@@ -1,5 +1,6 @@
 #include "TransitionRenderer.h"
 #include "renderer.h" // Renderer::GetDevice()/GetDeviceContext()
+#include "Logger.h"
 #include <d3dcompiler.h>
 #include <wrl/client.h>
 #include <cassert>
@@ -93,7 +94,8 @@ bool TransitionRenderer::Init()
     ComPtr<ID3DBlob> vsBlob;
     if (!CompileShader(g_vs_src, "VSMain", "vs_5_0", vsBlob, err))
     {
-        OutputDebugStringA(("Transition VS compile error: " + err + "\n").c_str());
+        LOG_ERROR("Transition VS compile error");
+        LOG_ERROR_LINES(err.c_str(), err.size());
         return false;
     }
     dev->CreateVertexShader(vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), nullptr, s_vsFull.GetAddressOf());
@@ -101,7 +103,8 @@ bool TransitionRenderer::Init()
     ComPtr<ID3DBlob> psBlob;
     if (!CompileShader(g_ps_fade, "PSMain", "ps_5_0", psBlob, err))
     {
-        OutputDebugStringA(("Transition PS(fade) compile error: " + err + "\n").c_str());
+        LOG_ERROR("Transition PS(fade) compile error");
+        LOG_ERROR_LINES(err.c_str(), err.size());
         return false;
     }
     dev->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, s_psFade.GetAddressOf());
@@ -109,7 +112,8 @@ bool TransitionRenderer::Init()
     // PS iris
     if (!CompileShader(g_ps_iris, "PSMain", "ps_5_0", psBlob, err))
     {
-        OutputDebugStringA(("Transition PS(iris) compile error: " + err + "\n").c_str());
+        LOG_ERROR("Transition PS(iris) compile error");
+        LOG_ERROR_LINES(err.c_str(), err.size());
         return false;
     }
     dev->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, s_psIris.GetAddressOf());
@@ -0,0 +1,292 @@
+﻿#include "VertexPacking.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+    float SignNotZero(float v) { return (v >= 0.0f) ? 1.0f : -1.0f; }
+
+    int16_t ToSnorm16(float v)
+    {
+        v = (std::max)(-1.0f, (std::min)(1.0f, v));
+        return static_cast<int16_t>(std::lround(v * 32767.0f));
+    }
+
+    float FromSnorm16(int16_t v)
+    {
+        //-32768 と -32767 はどちらも -1（D3D の SNORM と同じ）
+        return (std::max)(static_cast<float>(v) / 32767.0f, -1.0f);
+    }
+}
+
+void EncodeOctahedralNormal(const XMFLOAT3& n, int16_t out[2])
+{
+    float len = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+    if (len < 1.0e-12f)
+    {
+        //長さ 0 の法線は +Z 扱い
+        out[0] = out[1] = 0;
+        return;
+    }
+
+    float x = n.x / len;
+    float y = n.y / len;
+    if (n.z < 0.0f)
+    {
+        //下半球は四隅に折り返す
+        float fx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        float fy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = fx;
+        y = fy;
+    }
+
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+XMFLOAT3 DecodeOctahedralNormal(const int16_t in[2])
+{
+    //シェーダー側の DecodeOctahedral と同じ計算
+    float x = FromSnorm16(in[0]);
+    float y = FromSnorm16(in[1]);
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    float t = (std::max)(-z, 0.0f);
+    x += (x >= 0.0f) ? -t : t;
+    y += (y >= 0.0f) ? -t : t;
+
+    float len = std::sqrt(x * x + y * y + z * z);
+    return XMFLOAT3(x / len, y / len, z / len);
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t absBits = bits & 0x7FFFFFFF;
+
+    //NaN / 無限大
+    if (absBits >= 0x7F800000)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00 | ((absBits > 0x7F800000) ? 0x200 : 0));
+    }
+
+    int exponent = static_cast<int>(absBits >> 23) - 127 + 15;
+    uint32_t mantissa = absBits & 0x7FFFFF;
+
+    if (exponent >= 31)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+
+    if (exponent <= 0)
+    {
+        //half の非正規化数（小さすぎれば 0）
+        if (exponent < -10) { return sign; }
+        mantissa |= 0x800000;
+        int shift = 14 - exponent;
+        uint32_t half = (mantissa + (1u << (shift - 1))) >> shift;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    //仮数の切り捨て分を四捨五入する（繰り上がりで指数が増えても正しい値になる）
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000) { ++half; }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float HalfToFloat(uint16_t half)
+{
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            //非正規化数を正規化し直す
+            int e = -1;
+            do { ++e; mantissa <<= 1; } while ((mantissa & 0x400) == 0);
+            bits = sign | (static_cast<uint32_t>(127 - 15 - e) << 23) | ((mantissa & 0x3FF) << 13);
+        }
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+PackedColor PackColor(const XMFLOAT4& color)
+{
+    auto unorm8 = [](float v)
+        {
+            v = (std::max)(0.0f, (std::min)(1.0f, v));
+            return static_cast<uint32_t>(std::lround(v * 255.0f));
+        };
+    return unorm8(color.x) | (unorm8(color.y) << 8) | (unorm8(color.z) << 16) | (unorm8(color.w) << 24);
+}
+
+XMFLOAT4 UnpackColor(PackedColor color)
+{
+    return XMFLOAT4(
+        static_cast<float>(color & 0xFF) / 255.0f,
+        static_cast<float>((color >> 8) & 0xFF) / 255.0f,
+        static_cast<float>((color >> 16) & 0xFF) / 255.0f,
+        static_cast<float>((color >> 24) & 0xFF) / 255.0f);
+}
+
+PackedSkin PackSkin(const int boneIndex[4], const float boneWeight[4])
+{
+    PackedSkin skin{};
+
+    float sum = 0.0f;
+    for (int i = 0; i < 4; ++i) { sum += (std::max)(boneWeight[i], 0.0f); }
+    if (sum <= 0.0f) { return skin; }
+
+    //切り捨てた後、端数の大きい順に 1 ずつ足して合計を 255 に揃える
+    int quantized[4];
+    float remainder[4];
+    int total = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        float scaled = (std::max)(boneWeight[i], 0.0f) / sum * 255.0f;
+        quantized[i] = static_cast<int>(scaled);
+        remainder[i] = scaled - static_cast<float>(quantized[i]);
+        total += quantized[i];
+    }
+    while (total < 255)
+    {
+        int best = 0;
+        for (int i = 1; i < 4; ++i)
+        {
+            if (remainder[i] > remainder[best]) { best = i; }
+        }
+        ++quantized[best];
+        remainder[best] = -1.0f;
+        ++total;
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        skin.boneIndex[i] = static_cast<uint8_t>((std::max)(0, (std::min)(255, boneIndex[i])));
+        skin.boneWeight[i] = static_cast<uint8_t>(quantized[i]);
+    }
+    return skin;
+}
+
+PackedMesh PackVertices(const std::vector<SourceVertex>& source, bool skinned)
+{
+    PackedMesh packed;
+    packed.vertices.resize(source.size());
+
+    bool uniform = true;
+    PackedColor firstColor = source.empty() ? PackColor(packed.uniformColor) : PackColor(source[0].color);
+
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        const SourceVertex& s = source[i];
+        PackedVertex& v = packed.vertices[i];
+        v.position = s.position;
+        EncodeOctahedralNormal(s.normal, v.normal);
+        v.texcoord[0] = FloatToHalf(s.texcoord.x);
+        v.texcoord[1] = FloatToHalf(s.texcoord.y);
+
+        if (PackColor(s.color) != firstColor) { uniform = false; }
+    }
+
+    //頂点色は 8bit に丸めた後で全頂点同じなら 1 色にまとめる
+    if (uniform)
+    {
+        packed.uniformColor = UnpackColor(firstColor);
+    }
+    else
+    {
+        packed.colors.resize(source.size());
+        for (size_t i = 0; i < source.size(); ++i) { packed.colors[i] = PackColor(source[i].color); }
+    }
+
+    if (skinned)
+    {
+        packed.skin.resize(source.size());
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            packed.skin[i] = PackSkin(source[i].boneIndex, source[i].boneWeight);
+        }
+    }
+
+    return packed;
+}
+
+VertexPackError MeasurePackError(const std::vector<SourceVertex>& source, const PackedMesh& packed)
+{
+    VertexPackError err;
+
+    for (size_t i = 0; i < source.size() && i < packed.vertices.size(); ++i)
+    {
+        const SourceVertex& s = source[i];
+        const PackedVertex& v = packed.vertices[i];
+
+        float dx = s.position.x - v.position.x;
+        float dy = s.position.y - v.position.y;
+        float dz = s.position.z - v.position.z;
+        err.position = (std::max)(err.position, std::sqrt(dx * dx + dy * dy + dz * dz));
+
+        //長さ 0 の元法線は比較しない
+        float len = std::sqrt(s.normal.x * s.normal.x + s.normal.y * s.normal.y + s.normal.z * s.normal.z);
+        if (len > 1.0e-6f)
+        {
+            //小さい角は acos だと float の精度が足りないので、外積の長さと内積から求める
+            XMFLOAT3 n = DecodeOctahedralNormal(v.normal);
+            float cx = s.normal.y * n.z - s.normal.z * n.y;
+            float cy = s.normal.z * n.x - s.normal.x * n.z;
+            float cz = s.normal.x * n.y - s.normal.y * n.x;
+            float dot = s.normal.x * n.x + s.normal.y * n.y + s.normal.z * n.z;
+            float angle = std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot);
+            err.normalDegrees = (std::max)(err.normalDegrees, XMConvertToDegrees(angle));
+        }
+
+        float du = s.texcoord.x - HalfToFloat(v.texcoord[0]);
+        float dv = s.texcoord.y - HalfToFloat(v.texcoord[1]);
+        err.texcoord = (std::max)(err.texcoord, std::sqrt(du * du + dv * dv));
+
+        XMFLOAT4 c = packed.colors.empty() ? packed.uniformColor : UnpackColor(packed.colors[i]);
+        err.color = (std::max)({ err.color,
+            std::fabs(s.color.x - c.x), std::fabs(s.color.y - c.y),
+            std::fabs(s.color.z - c.z), std::fabs(s.color.w - c.w) });
+
+        if (!packed.skin.empty())
+        {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) { sum += (std::max)(s.boneWeight[k], 0.0f); }
+            if (sum > 0.0f)
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    float w = (std::max)(s.boneWeight[k], 0.0f) / sum;
+                    err.boneWeight = (std::max)(err.boneWeight,
+                        std::fabs(w - packed.skin[i].boneWeight[k] / 255.0f));
+                }
+            }
+        }
+    }
+
+    return err;
+}
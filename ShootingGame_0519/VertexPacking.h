@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+#include <DirectXMath.h>
+
+//------------------------------------------------------------
+// モデル頂点の圧縮（読み込み時に CPU で 1 回だけ行う）
+// ・位置は float3 のまま、法線は八面体写像の snorm16x2、UV は half2 にする
+// ・頂点色はメッシュ内で全頂点が同じなら頂点から外し、1 色として持つ
+// ・ボーンのインデックス / ウェイトはスキンメッシュだけ別ストリームに分ける
+// D3D には触らないので、往復誤差を単体で確認できる（Tools/VertexPackCheck）
+//------------------------------------------------------------
+
+//ストリーム 0：全メッシュ共通（20 byte）
+//BasicVertexShader.hlsl の VSMainPacked / InstancedVertexShader.hlsl と並びを合わせること
+struct PackedVertex
+{
+    DirectX::XMFLOAT3 position;     //R32G32B32_FLOAT
+    int16_t  normal[2];             //R16G16_SNORM（八面体写像）
+    uint16_t texcoord[2];           //R16G16_FLOAT
+};
+
+//ストリーム 2：頂点色（一様でないメッシュだけ。4 byte）
+using PackedColor = uint32_t;       //R8G8B8A8_UNORM
+
+//ストリーム 3：スキンメッシュだけ（8 byte）
+struct PackedSkin
+{
+    uint8_t boneIndex[4];           //R8G8B8A8_UINT（256 本まで）
+    uint8_t boneWeight[4];          //R8G8B8A8_UNORM（合計がちょうど 255 になるよう丸める）
+};
+
+//圧縮前の頂点（Assimp から読んだままの値）
+struct SourceVertex
+{
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT3 normal;
+    DirectX::XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    DirectX::XMFLOAT2 texcoord;
+    int   boneIndex[4] = {};
+    float boneWeight[4] = {};
+};
+
+//圧縮後の 1 メッシュ分
+struct PackedMesh
+{
+    std::vector<PackedVertex> vertices;
+    std::vector<PackedColor>  colors;   //空なら全頂点 uniformColor
+    std::vector<PackedSkin>   skin;     //空なら静的メッシュ
+    DirectX::XMFLOAT4 uniformColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+};
+
+//往復（圧縮 → 展開）で出た誤差の最大値
+struct VertexPackError
+{
+    float position = 0.0f;
+    float normalDegrees = 0.0f;     //元の法線とのなす角
+    float texcoord = 0.0f;          //UV 空間での距離
+    float color = 0.0f;             //成分ごとの差（0～1）
+    float boneWeight = 0.0f;
+};
+
+//----------個別の変換-------------
+void EncodeOctahedralNormal(const DirectX::XMFLOAT3& n, int16_t out[2]);
+DirectX::XMFLOAT3 DecodeOctahedralNormal(const int16_t in[2]);
+
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+PackedColor PackColor(const DirectX::XMFLOAT4& color);
+DirectX::XMFLOAT4 UnpackColor(PackedColor color);
+
+PackedSkin PackSkin(const int boneIndex[4], const float boneWeight[4]);
+
+//----------メッシュ単位-------------
+//skinned = false ならボーン情報は捨てる
+PackedMesh PackVertices(const std::vector<SourceVertex>& source, bool skinned);
+
+//圧縮結果を展開し、元の頂点との誤差を測る
+VertexPackError MeasurePackError(const std::vector<SourceVertex>& source, const PackedMesh& packed);
@@ -0,0 +1,226 @@
+﻿#include "WaveScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include "Logger.h"
+#include "AssetArchive.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    float ElapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+}
+
+WaveScheduler::WaveScheduler(EnemySpawner* spawner) : m_spawner(spawner)
+{
+}
+
+bool WaveScheduler::Load(const std::string& path)
+{
+    AssetView view;
+    if (!AssetArchive::Load(path, view))
+    {
+        LOG_WARN("WaveScheduler: %s を開けません", path.c_str());
+        return false;
+    }
+    std::istringstream file(std::string(reinterpret_cast<const char*>(view.data), view.size));
+
+    std::vector<WaveEntry> entries;
+    std::string line;
+    int lineNo = 0;
+
+    while (std::getline(file, line))
+    {
+        ++lineNo;
+
+        //コメントを落とす
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+
+        //空行
+        if (line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+
+        std::istringstream ss(line);
+        std::string name;
+        WaveEntry entry;
+
+        if (!(ss >> entry.time))
+        {
+            LOG_WARN("WaveScheduler: %s(%d) 時刻が読めません", path.c_str(), lineNo);
+            continue;
+        }
+
+        if (!(ss >> name >> entry.count >> entry.pathId))
+        {
+            LOG_WARN("WaveScheduler: %s(%d) 項目が足りません（時刻 種類 数 経路番号 [間隔]）", path.c_str(), lineNo);
+            continue;
+        }
+
+        if (!EnemySpawner::ParseArchetype(name, entry.type))
+        {
+            LOG_WARN("WaveScheduler: %s(%d) 不明な種類 '%s'", path.c_str(), lineNo, name.c_str());
+            continue;
+        }
+
+        //間隔は省略可
+        if (!(ss >> entry.interval))
+        {
+            entry.interval = 0.0f;
+        }
+
+        if (entry.count <= 0 || entry.time < 0.0f || entry.interval < 0.0f)
+        {
+            LOG_WARN("WaveScheduler: %s(%d) 数・時刻・間隔が不正です", path.c_str(), lineNo);
+            continue;
+        }
+
+        entries.push_back(entry);
+    }
+
+    if (entries.empty())
+    {
+        LOG_WARN("WaveScheduler: %s に有効なエントリがありません", path.c_str());
+        return false;
+    }
+
+    Expand(entries);
+    return true;
+}
+
+void WaveScheduler::SetEntries(const std::vector<WaveEntry>& entries)
+{
+    Expand(entries);
+}
+
+void WaveScheduler::Expand(const std::vector<WaveEntry>& entries)
+{
+    m_events.clear();
+    m_nextSpawn = 0;
+    m_nextBuild = 0;
+    m_time = 0.0f;
+
+    size_t total = 0;
+    for (const auto& e : entries)
+    {
+        total += static_cast<size_t>((std::max)(e.count, 0));
+    }
+    m_events.reserve(total);
+
+    for (const auto& e : entries)
+    {
+        for (int i = 0; i < e.count; ++i)
+        {
+            SpawnEvent ev;
+            ev.time = e.time + e.interval * static_cast<float>(i);
+            ev.type = e.type;
+            ev.pathId = e.pathId;
+            m_events.push_back(ev);
+        }
+    }
+
+    //同時刻ならファイルに書いた順
+    std::stable_sort(m_events.begin(), m_events.end(),
+        [](const SpawnEvent& a, const SpawnEvent& b) { return a.time < b.time; });
+}
+
+void WaveScheduler::Prepare()
+{
+    if (!m_spawner) { return; }
+
+    //プレハブが無い種類は組み立てられないので予定から外す
+    //（残すと出現しないまま総数に数えられ、全滅判定が終わらなくなる）
+    int skipped[static_cast<int>(EnemyArchetype::Count)] = {};
+    auto removed = std::remove_if(m_events.begin(), m_events.end(),
+        [&](const SpawnEvent& ev)
+        {
+            if (m_spawner->GetPrefab(ev.type)) { return false; }
+            ++skipped[static_cast<int>(ev.type)];
+            return true;
+        });
+    m_events.erase(removed, m_events.end());
+
+    for (int i = 0; i < static_cast<int>(EnemyArchetype::Count); ++i)
+    {
+        if (skipped[i] > 0)
+        {
+            LOG_WARN("WaveScheduler: プレハブ '%s' が無いので %d 体を飛ばします",
+                EnemySpawner::GetArchetypeName(static_cast<EnemyArchetype>(i)), skipped[i]);
+        }
+    }
+
+    //種類と経路の組ごとに 1 回だけ温める
+    std::vector<std::pair<EnemyArchetype, int>> warmed;
+    for (const auto& ev : m_events)
+    {
+        auto key = std::make_pair(ev.type, ev.pathId);
+        if (std::find(warmed.begin(), warmed.end(), key) != warmed.end()) { continue; }
+
+        m_spawner->WarmUp(ev.type, ev.pathId);
+        warmed.push_back(key);
+    }
+
+    //開始直後に出る敵はロード中に組み立てておく（最初のフレームで詰まらないように）
+    while (m_nextBuild < m_events.size() && m_events[m_nextBuild].time <= 0.0f)
+    {
+        m_events[m_nextBuild].instance = m_spawner->Build(m_events[m_nextBuild].type, m_events[m_nextBuild].pathId);
+        ++m_nextBuild;
+    }
+}
+
+void WaveScheduler::Update(float dt)
+{
+    if (!m_spawner || IsFinished()) { return; }
+
+    m_time += dt;
+
+    Clock::time_point start = Clock::now();
+    int spawned = 0;
+
+    //出現時刻を過ぎた敵を出す
+    //予算を超えたら次のフレームへ（進まなくならないよう 1 体は必ず出す）
+    while (m_nextSpawn < m_events.size() && m_events[m_nextSpawn].time <= m_time)
+    {
+        if (spawned > 0 && ElapsedMs(start) >= m_frameBudgetMs)
+        {
+            ++m_deferredFrames;
+            break;
+        }
+
+        SpawnEvent& ev = m_events[m_nextSpawn];
+        if (!ev.instance)
+        {
+            ev.instance = m_spawner->Build(ev.type, ev.pathId);
+            ++m_lateBuilds;
+        }
+
+        m_spawner->Activate(ev.type, ev.instance);
+        ev.instance.reset();
+
+        ++m_nextSpawn;
+        ++spawned;
+    }
+
+    //残りの予算で、少し先に出る敵を組み立てておく
+    if (m_nextBuild < m_nextSpawn)
+    {
+        m_nextBuild = m_nextSpawn;
+    }
+
+    while (m_nextBuild < m_events.size()
+        && m_events[m_nextBuild].time <= m_time + m_lookahead
+        && ElapsedMs(start) < m_frameBudgetMs)
+    {
+        SpawnEvent& ev = m_events[m_nextBuild];
+        ev.instance = m_spawner->Build(ev.type, ev.pathId);
+        ++m_nextBuild;
+    }
+
+    m_lastFrameMs = ElapsedMs(start);
+}
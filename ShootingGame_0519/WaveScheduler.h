@@ -0,0 +1,87 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "EnemySpawner.h"
+
+//------------------------------------------------------------
+// ウェーブファイルに従って敵を出すスケジューラ
+// ・ファイルは 1 行 1 エントリ「開始時刻 種類 数 経路番号 [間隔]」（# 以降はコメント）
+// ・読み込み時に種類ごとの共有データ（モデル・経路）を温め、開始時刻 0 の敵は組み立てまで済ませておく
+// ・以降は出現の少し前から 1 体ずつ組み立てておき、出現時はシーンに登録するだけにする
+// ・組み立てと登録は 1 フレームの予算（ミリ秒）内で行い、あふれた分は次のフレームに回す
+//------------------------------------------------------------
+
+//ウェーブファイルの 1 行
+struct WaveEntry
+{
+	float time = 0.0f;			//最初の 1 体が出る時刻（シーン開始からの秒数）
+	EnemyArchetype type = EnemyArchetype::Patrol;
+	int count = 1;				//出す数
+	int pathId = 0;				//経路・位置セットの番号（EnemySpawner::Build に渡す）
+	float interval = 0.0f;		//2 体目以降の出現間隔（秒）
+};
+
+class WaveScheduler
+{
+public:
+	explicit WaveScheduler(EnemySpawner* spawner);
+
+	//ファイルから読み込む（読めなかった行は警告して飛ばす）。1 件も読めなければ false
+	bool Load(const std::string& path);
+
+	//直接エントリを渡す（ファイルが無いときの既定ウェーブ用）
+	void SetEntries(const std::vector<WaveEntry>& entries);
+
+	//共有データを温め、開始直後に出る敵を組み立てておく（シーンの Init で、プレハブを読んだ後に呼ぶ）
+	//プレハブの無い種類の予定は警告して外す（GetTotalCount にも数えない）
+	void Prepare();
+
+	//時間を進めて、出現時刻になった敵を出す
+	void Update(float dt);
+
+	//----------Set関数-------------
+	void SetFrameBudgetMs(float ms) { m_frameBudgetMs = ms; }
+	void SetLookahead(float seconds) { m_lookahead = seconds; }
+
+	//----------Get関数-------------
+	//このスケジュールで出る敵の総数（全滅判定に使う）
+	int GetTotalCount() const { return static_cast<int>(m_events.size()); }
+	int GetSpawnedCount() const { return static_cast<int>(m_nextSpawn); }
+	int GetReadyCount() const { return static_cast<int>(m_nextBuild - m_nextSpawn); }
+	bool IsFinished() const { return m_nextSpawn >= m_events.size(); }
+	float GetTime() const { return m_time; }
+
+	float GetLastFrameMs() const { return m_lastFrameMs; }
+	uint32_t GetDeferredFrames() const { return m_deferredFrames; }
+	uint32_t GetLateBuilds() const { return m_lateBuilds; }
+
+private:
+	//1 体分の出現予定
+	struct SpawnEvent
+	{
+		float time = 0.0f;
+		EnemyArchetype type = EnemyArchetype::Patrol;
+		int pathId = 0;
+		std::shared_ptr<GameObject> instance;	//組み立て済みならここに入る
+	};
+
+	//エントリを 1 体ずつの予定に展開して時刻順に並べる
+	void Expand(const std::vector<WaveEntry>& entries);
+
+	EnemySpawner* m_spawner = nullptr;
+
+	std::vector<SpawnEvent> m_events;
+	size_t m_nextSpawn = 0;		//次に出す予定
+	size_t m_nextBuild = 0;		//次に組み立てる予定（m_nextSpawn 以上）
+
+	float m_time = 0.0f;
+	float m_frameBudgetMs = 1.0f;	//1 フレームで組み立て・登録に使ってよい時間
+	float m_lookahead = 3.0f;		//何秒先の敵まで組み立てておくか
+
+	//統計（デバッグ表示用）
+	float m_lastFrameMs = 0.0f;
+	uint32_t m_deferredFrames = 0;	//予算切れで出現を次フレームに回した回数
+	uint32_t m_lateBuilds = 0;		//組み立てが間に合わず出現時に組み立てた数
+};
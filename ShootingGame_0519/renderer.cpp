@@ -13,6 +13,10 @@
 #include "renderer.h"
 #include "Application.h"
 #include "TransitionManager.h"
+#include "VertexPacking.h"
+#include "ShaderCache.h"
+#include "MemoryTracker.h"
+#include "Logger.h"
 
 
 //------------------------------------------------------------------------------
@@ -33,6 +37,23 @@ ComPtr<ID3D11Buffer> Renderer::m_projectionBuffer;
 ComPtr<ID3D11Buffer> Renderer::m_materialBuffer;
 ComPtr<ID3D11Buffer> Renderer::m_lightBuffer;
 
+ComPtr<ID3D11DeviceContext1> Renderer::m_deviceContext1;
+ComPtr<ID3D11Buffer>         Renderer::m_constantRingBuffer;
+ConstantBufferRing           Renderer::m_constantRing;
+bool                         Renderer::m_constantRingEnabled = false;
+
+namespace
+{
+    //O̗eʁi256 oCg ~ 4096 񕪁BȂ΃t[̓r DISCARD Đ擪ɖ߂j
+    constexpr UINT kConstantRingBytes = 1024 * 1024;
+
+    //Xbg b0`b5 ɍŌɏ萔iJ⃉Cĝ悤ɖt[͐ݒ肳ȂlADISCARD ̌ɏj
+    ConstantSlotShadows s_constantShadow;
+
+    //Init  MemoryTracker Ɍvサ GPU ̃oCgiUninit œj
+    int64_t s_trackedGpuBytes = 0;
+}
+
 ComPtr<ID3D11DepthStencilState> Renderer::m_depthStateEnable;
 ComPtr<ID3D11DepthStencilState> Renderer::m_depthStateDisable;
 
@@ -58,6 +79,13 @@ ComPtr<ID3D11VertexShader> Renderer::m_billboardVertexShader;
 ComPtr<ID3D11PixelShader>  Renderer::m_billboardPixelShader;
 ComPtr<ID3D11InputLayout>  Renderer::m_billboardInputLayout;
 
+//----------------------CX^VO--------------------
+ComPtr<ID3D11VertexShader> Renderer::m_packedVertexShader;
+ComPtr<ID3D11InputLayout>  Renderer::m_packedInputLayout;
+
+ComPtr<ID3D11VertexShader> Renderer::m_instancedVertexShader;
+ComPtr<ID3D11InputLayout>  Renderer::m_instancedInputLayout;
+
 DirectX::SimpleMath::Matrix Renderer::m_cachedView = DirectX::SimpleMath::Matrix::Identity;
 DirectX::SimpleMath::Matrix Renderer::m_cachedProjection = DirectX::SimpleMath::Matrix::Identity;
 //-------------------------------------------------------
@@ -92,7 +120,8 @@ struct MotionBlurParams
 Microsoft::WRL::ComPtr<ID3DBlob> Renderer::CompileShader(
     const wchar_t* filePath,
     const char* entryPoint,
-    const char* target)
+    const char* target,
+    const D3D_SHADER_MACRO* defines)
 {
     Microsoft::WRL::ComPtr<ID3DBlob> shaderBlob;
     Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
@@ -102,9 +131,30 @@ Microsoft::WRL::ComPtr<ID3DBlob> Renderer::CompileShader(
     compileFlags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
+    // \[XE#include EGg|CgEvt@CE}NEtOȂAÕoCgR[hg
+    ShaderCacheKeyDesc keyDesc;
+    keyDesc.sourcePath = filePath;
+    keyDesc.entryPoint = entryPoint;
+    keyDesc.profile = target;
+    for (const D3D_SHADER_MACRO* m = defines; m && m->Name; ++m)
+    {
+        keyDesc.defines.emplace_back(m->Name, m->Definition ? m->Definition : "");
+    }
+    keyDesc.compileFlags = compileFlags;
+    keyDesc.compilerVersion = D3D_COMPILER_VERSION;
+
+    std::string key = ShaderCache::ComputeKey(keyDesc);
+    std::vector<uint8_t> cached;
+    if (ShaderCache::Load(key, cached) &&
+        SUCCEEDED(D3DCreateBlob(cached.size(), shaderBlob.GetAddressOf())))
+    {
+        memcpy(shaderBlob->GetBufferPointer(), cached.data(), cached.size());
+        return shaderBlob;
+    }
+
     HRESULT hr = D3DCompileFromFile(
         filePath,
-        nullptr,
+        defines,
         D3D_COMPILE_STANDARD_FILE_INCLUDE,
         entryPoint,
         target,
@@ -115,16 +165,23 @@ Microsoft::WRL::ComPtr<ID3DBlob> Renderer::CompileShader(
 
     if (FAILED(hr))
     {
+        LOG_ERROR("Shader compile failed: %s (%s)", entryPoint, target);
         if (errorBlob)
         {
-            // G[bZ[WóifobOpj
-            OutputDebugStringA(static_cast<const char*>(errorBlob->GetBufferPointer()));
+            // RpC̃bZ[W͕sȂ̂1so
+            LOG_ERROR_LINES(errorBlob->GetBufferPointer(), errorBlob->GetBufferSize());
         }
 
         // s͗O𓊂iĂяoŃLb`/nhzj
         throw std::runtime_error("Shader compile failed");
     }
 
+    if (!key.empty() &&
+        !ShaderCache::Store(keyDesc, key, shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize()))
+    {
+        LOG_WARN("ShaderCache: failed to store %s (%s)", key.c_str(), entryPoint);
+    }
+
     return shaderBlob;
 }
 
@@ -133,6 +190,12 @@ void Renderer::Init()
 
     HRESULT hr = S_OK;
 
+    //Init ̒ newiVF[_[̃oCgR[hȂǁj Renderer ɕt
+    MemoryScope memoryScope(MemoryCategory::Renderer);
+
+    // RpCς݃VF[_[̃LbVisfBNg ShaderCache/j
+    ShaderCache::Init();
+
     //Xbv`FC쐬
     DXGI_SWAP_CHAIN_DESC swapChainDesc{};
 
@@ -239,6 +302,11 @@ void Renderer::Init()
     hr = m_device->CreateShaderResourceView(m_prevSceneColorTex.Get(), nullptr, m_prevSceneColorSRV.GetAddressOf());
     if (FAILED(hr)) { throw std::runtime_error("Failed to create prev scene SRV"); }
 
+    //[xi16bitjƃV[F 2 iRGBA8jBXbv`FC̃obt@͐Ȃ
+    s_trackedGpuBytes =
+        MemoryTracker::EstimateTextureBytes(textureDesc.Width, textureDesc.Height, 1, textureDesc.SampleDesc.Count, 16, false) +
+        MemoryTracker::EstimateTextureBytes(sceneDesc.Width, sceneDesc.Height, 1, sceneDesc.SampleDesc.Count, 32, false) * 2;
+
     // =========================
     //  |XgvZXp萔obt@
     // =========================
@@ -371,6 +439,37 @@ void Renderer::Init()
     m_deviceContext->VSSetConstantBuffers(4, 1, m_lightBuffer.GetAddressOf());
     m_deviceContext->PSSetConstantBuffers(4, 1, m_lightBuffer.GetAddressOf());
 
+    //-----------------------萔obt@̃O-----------------------
+    //ItZbgtoChƁA萔obt@ւ NO_OVERWRITE  Map ̗gƂLɂ
+    //igȂΏ̌ʂ̃obt@ UpdateSubresource ōXV]̌oĤ܂܁j
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+    if (SUCCEEDED(m_deviceContext.As(&m_deviceContext1)) &&
+        SUCCEEDED(m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+        options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer)
+    {
+        D3D11_BUFFER_DESC ringDesc{};
+        ringDesc.ByteWidth = kConstantRingBytes;
+        ringDesc.Usage = D3D11_USAGE_DYNAMIC;
+        ringDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        ringDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        if (SUCCEEDED(m_device->CreateBuffer(&ringDesc, nullptr, m_constantRingBuffer.GetAddressOf())))
+        {
+            m_constantRing.Reset(kConstantRingBytes);
+            m_constantRingEnabled = true;
+            s_trackedGpuBytes += kConstantRingBytes;
+        }
+    }
+    if (m_constantRingEnabled)
+    {
+        LOG_INFO("Constant buffer ring: %u KB", kConstantRingBytes / 1024);
+    }
+    else
+    {
+        m_deviceContext1.Reset();
+        LOG_WARN("Constant buffer offsetting is not supported. Using UpdateSubresource per draw.");
+    }
+    MemoryTracker::AddGpuBytes(MemoryCategory::Renderer, s_trackedGpuBytes);
+
     D3D11_BUFFER_DESC alphaDesc{};
     alphaDesc.ByteWidth = sizeof(CBTextureAlpha); // 16oCgEɍ킹TCY
     alphaDesc.Usage = D3D11_USAGE_DEFAULT;
@@ -570,7 +669,79 @@ void Renderer::Init()
         throw std::runtime_error("Failed to create Billboard input layout");
     }
 
+    //-----------------------k_ifjpVF[_[̃RpC-----------------------
+    // sNZVF[_[ BasicPixelShader ̂܂܎g
+    auto packedVsBlob = CompileShader(L"BasicVertexShader.hlsl", "VSMainPacked", "vs_5_0");
+    hr = m_device->CreateVertexShader(
+        packedVsBlob->GetBufferPointer(),
+        packedVsBlob->GetBufferSize(),
+        nullptr,
+        m_packedVertexShader.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Packed vertex shader");
+    }
+
+    // Xbg0FPackedVertex / Xbg2F_FiXbg1̓CX^VOpɋ󂯂Ăj
+    D3D11_INPUT_ELEMENT_DESC packedLayout[] =
+    {
+        { "POSITION",  0, DXGI_FORMAT_R32G32B32_FLOAT,      0, offsetof(PackedVertex, position), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "NORMAL",    0, DXGI_FORMAT_R16G16_SNORM,         0, offsetof(PackedVertex, normal),   D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD",  0, DXGI_FORMAT_R16G16_FLOAT,         0, offsetof(PackedVertex, texcoord), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "COLOR",     0, DXGI_FORMAT_R8G8B8A8_UNORM,       2, 0,                                D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    };
+
+    hr = m_device->CreateInputLayout(
+        packedLayout,
+        _countof(packedLayout),
+        packedVsBlob->GetBufferPointer(),
+        packedVsBlob->GetBufferSize(),
+        m_packedInputLayout.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Packed input layout");
+    }
 
+    //-----------------------CX^VOpVF[_[̃RpC-----------------------
+    // sNZVF[_[ BasicPixelShader ̂܂܎g
+    auto instVsBlob = CompileShader(L"InstancedVertexShader.hlsl", "VSMain", "vs_5_0");
+    hr = m_device->CreateVertexShader(
+        instVsBlob->GetBufferPointer(),
+        instVsBlob->GetBufferSize(),
+        nullptr,
+        m_instancedVertexShader.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Instanced vertex shader");
+    }
+
+    // Xbg0FPackedVertexi_Ɓj / Xbg1FInstanceDataiCX^XƁj / Xbg2F_F
+    D3D11_INPUT_ELEMENT_DESC instLayout[] =
+    {
+        { "POSITION",  0, DXGI_FORMAT_R32G32B32_FLOAT,      0, offsetof(PackedVertex, position), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "NORMAL",    0, DXGI_FORMAT_R16G16_SNORM,         0, offsetof(PackedVertex, normal),   D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD",  0, DXGI_FORMAT_R16G16_FLOAT,         0, offsetof(PackedVertex, texcoord), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "COLOR",     0, DXGI_FORMAT_R8G8B8A8_UNORM,       2, 0,                                D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "INSTWORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT,   1, 0,  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "INSTWORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT,   1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "INSTWORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT,   1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "INSTWORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT,   1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "INSTCOLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT,   1, 64, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    };
+
+    hr = m_device->CreateInputLayout(
+        instLayout,
+        _countof(instLayout),
+        instVsBlob->GetBufferPointer(),
+        instVsBlob->GetBufferSize(),
+        m_instancedInputLayout.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Instanced input layout");
+    }
+
+    LOG_INFO("ShaderCache: hits=%d compiled=%d (%s)",
+        ShaderCache::GetHitCount(), ShaderCache::GetMissCount(), ShaderCache::GetDirectory().string().c_str());
 }
 
 
@@ -590,6 +761,17 @@ void Renderer::Uninit()
     m_projectionBuffer.Reset();
     m_lightBuffer.Reset();
     m_materialBuffer.Reset();
+    if (m_constantRingEnabled)
+    {
+        LOG_INFO("Constant buffer ring: peak %u / %u bytes per frame",
+            m_constantRing.GetPeakFrameBytes(), m_constantRing.GetCapacity());
+    }
+    m_constantRingBuffer.Reset();
+    m_constantRingEnabled = false;
+    MemoryTracker::AddGpuBytes(MemoryCategory::Renderer, -s_trackedGpuBytes);
+    s_trackedGpuBytes = 0;
+    s_constantShadow.Clear();
+    m_deviceContext1.Reset();
     m_renderTargetView.Reset();
     m_swapChain.Reset();
     m_deviceContext.Reset();
@@ -610,6 +792,14 @@ void Renderer::Begin()
     ID3D11RenderTargetView* rtv = m_sceneColorRTV.Get();
     m_deviceContext->OMSetRenderTargets(1, &rtv, m_depthStencilView.Get());
 
+    //Õt[̒萔 DISCARD ŎāAO擪g
+    //ioCh܂܂̃Xbg͒ĝŁAŌɐݒ肳ꂽlĂj
+    if (m_constantRingEnabled)
+    {
+        m_constantRing.BeginFrame();
+        RewriteConstantSlots(ConstantSlotShadows::kNoSlot);
+    }
+
     float clearColor[4] = { 0.1f, 0.2f, 0.8f, 1.0f };
     m_deviceContext->ClearRenderTargetView(m_sceneColorRTV.Get(), clearColor);
     m_deviceContext->ClearDepthStencilView(m_depthStencilView.Get(),
@@ -659,10 +849,10 @@ void Renderer::SetATCEnable(bool Enable)
 void Renderer::SetWorldViewProjection2D()
 {
     Matrix4x4 world = Matrix4x4::Identity.Transpose();
-    m_deviceContext->UpdateSubresource(m_worldBuffer.Get(), 0, nullptr, &world, 0, 0);
+    UploadConstants(m_worldBuffer.Get(), &world, sizeof(world), 0, true, false);
 
     Matrix4x4 view = Matrix4x4::Identity.Transpose();
-    m_deviceContext->UpdateSubresource(m_viewBuffer.Get(), 0, nullptr, &view, 0, 0);
+    UploadConstants(m_viewBuffer.Get(), &view, sizeof(view), 1, true, false);
 
     Matrix4x4 projection = DirectX::XMMatrixOrthographicOffCenterLH(
         0.0f,
@@ -672,19 +862,15 @@ void Renderer::SetWorldViewProjection2D()
         0.0f,
         1.0f);
     projection = projection.Transpose();
-    m_deviceContext->UpdateSubresource(m_projectionBuffer.Get(), 0, nullptr, &projection, 0, 0);
+    UploadConstants(m_projectionBuffer.Get(), &projection, sizeof(projection), 2, true, false);
 }
 
 void Renderer::SetTextureAlpha(float alpha)
 {
     CBTextureAlpha cb{};
     cb.Alpha = alpha;
-    // UpdateSubresource  CB XV
-    m_deviceContext->UpdateSubresource(m_textureAlphaBuffer.Get(), 0, nullptr, &cb, 0, 0);
-
-    // PixelShader Xbg b5 ɃoChiŃoCĥSj
-    ID3D11Buffer* cbPtr = m_textureAlphaBuffer.Get();
-    m_deviceContext->PSSetConstantBuffers(5, 1, &cbPtr);
+    // PixelShader Xbg b5 ɏŃoChiŃoCĥSj
+    UploadConstants(m_textureAlphaBuffer.Get(), &cb, sizeof(cb), 5, false, true);
 }
 
 /**
@@ -694,7 +880,7 @@ void Renderer::SetTextureAlpha(float alpha)
 void Renderer::SetWorldMatrix(Matrix4x4* WorldMatrix)
 {
     Matrix4x4 mat = WorldMatrix->Transpose();
-    m_deviceContext->UpdateSubresource(m_worldBuffer.Get(), 0, nullptr, &mat, 0, 0);
+    UploadConstants(m_worldBuffer.Get(), &mat, sizeof(mat), 0, true, false);
 }
 
 /**
@@ -706,7 +892,7 @@ void Renderer::SetViewMatrix(SimpleMath::Matrix ViewMatrix)
     m_cachedView = ViewMatrix;
 
     SimpleMath::Matrix mat = ViewMatrix.Transpose();
-    m_deviceContext->UpdateSubresource(m_viewBuffer.Get(), 0, nullptr, &mat, 0, 0);
+    UploadConstants(m_viewBuffer.Get(), &mat, sizeof(mat), 1, true, false);
 }
 
 /**
@@ -718,7 +904,7 @@ void Renderer::SetProjectionMatrix(SimpleMath::Matrix ProjectionMatrix)
     m_cachedProjection = ProjectionMatrix;
 
     SimpleMath::Matrix mat = ProjectionMatrix.Transpose();
-    m_deviceContext->UpdateSubresource(m_projectionBuffer.Get(), 0, nullptr, &mat, 0, 0);
+    UploadConstants(m_projectionBuffer.Get(), &mat, sizeof(mat), 2, true, false);
 }
 
 /**
@@ -727,7 +913,7 @@ void Renderer::SetProjectionMatrix(SimpleMath::Matrix ProjectionMatrix)
  */
 void Renderer::SetMaterial(MATERIAL Material)
 {
-    m_deviceContext->UpdateSubresource(m_materialBuffer.Get(), 0, nullptr, &Material, 0, 0);
+    UploadConstants(m_materialBuffer.Get(), &Material, sizeof(Material), 3, true, true);
 }
 
 /**
@@ -736,7 +922,158 @@ void Renderer::SetMaterial(MATERIAL Material)
  */
 void Renderer::SetLight(LIGHT Light)
 {
-    m_deviceContext->UpdateSubresource(m_lightBuffer.Get(), 0, nullptr, &Light, 0, 0);
+    UploadConstants(m_lightBuffer.Get(), &Light, sizeof(Light), 4, true, true);
+}
+
+/**
+ * @brief 萔ŁAw肵XbgɃoCh܂B
+ *
+ * @details
+ * OgƂ̓Ő󂫈ʒu WRITE_NO_OVERWRITEit[ŏƐ擪ɖ߂Ƃ WRITE_DISCARDjŏA
+ * *SetConstantBuffers1 ł̈ʒuoCh܂BgȂƂ fallbackBuffer  UpdateSubresource ōXVăoCh܂B
+ */
+void Renderer::UploadConstants(ID3D11Buffer* fallbackBuffer, const void* data, UINT size, UINT slot, bool vs, bool ps)
+{
+    s_constantShadow.Remember(slot, fallbackBuffer, data, size, vs, ps);
+    WriteConstants(fallbackBuffer, data, size, slot, vs, ps);
+}
+
+void Renderer::WriteConstants(ID3D11Buffer* fallbackBuffer, const void* data, UINT size, UINT slot, bool vs, bool ps)
+{
+    ConstantBufferAllocation alloc;
+    if (m_constantRingEnabled && m_constantRing.Allocate(size, alloc))
+    {
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        D3D11_MAP mapType = alloc.discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+        if (SUCCEEDED(m_deviceContext->Map(m_constantRingBuffer.Get(), 0, mapType, 0, &mapped)))
+        {
+            memcpy(static_cast<uint8_t*>(mapped.pData) + alloc.offset, data, size);
+            m_deviceContext->Unmap(m_constantRingBuffer.Get(), 0);
+
+            ID3D11Buffer* ring = m_constantRingBuffer.Get();
+            if (vs) m_deviceContext1->VSSetConstantBuffers1(slot, 1, &ring, &alloc.firstConstant, &alloc.numConstants);
+            if (ps) m_deviceContext1->PSSetConstantBuffers1(slot, 1, &ring, &alloc.firstConstant, &alloc.numConstants);
+
+            //t[̓rŐ擪ɖ߂iDISCARD jƂ́ÃXbgwĂꏊĂ̂ŏ
+            if (alloc.discard)
+            {
+                RewriteConstantSlots(slot);
+            }
+            return;
+        }
+        m_constantRing.RequestDiscard();
+    }
+
+    //XbgɃOcĂꍇ̂ŁAʂ̃obt@𖈉oCh
+    m_deviceContext->UpdateSubresource(fallbackBuffer, 0, nullptr, data, 0, 0);
+    if (vs) m_deviceContext->VSSetConstantBuffers(slot, 1, &fallbackBuffer);
+    if (ps) m_deviceContext->PSSetConstantBuffers(slot, 1, &fallbackBuffer);
+}
+
+/**
+ * @brief oĂXbgiskipSlot ȊOj̒萔OɏăoCh܂B
+ *
+ * @details
+ * Begin ƁAt[̓rŃO擪ɖ߂ƂɌĂт܂B̓rłɐ擪ɖ߂Ăqɂ͂܂B
+ */
+void Renderer::RewriteConstantSlots(UINT skipSlot)
+{
+    s_constantShadow.RewriteAll(skipSlot, [](uint32_t slot, const ConstantSlotShadow& shadow)
+    {
+        WriteConstants(static_cast<ID3D11Buffer*>(shadow.fallbackBuffer), shadow.data, shadow.size, slot, shadow.vs, shadow.ps);
+    });
+}
+
+/**
+ * @brief 萔obt@̃oCh擾܂iOgp̓ItZbgƒ萔̐AXbg̒lT܂jB
+ */
+void Renderer::GetConstantBuffers(bool pixelShader, UINT startSlot, UINT count, SavedConstantBuffers& saved)
+{
+    count = (std::min)(count, SavedConstantBuffers::kMaxSlots);
+    saved.pixelShader = pixelShader;
+    saved.startSlot = startSlot;
+    saved.count = count;
+    saved.ringGeneration = m_constantRing.GetGeneration();
+    for (UINT i = 0; i < count; ++i)
+    {
+        if (startSlot + i < ConstantSlotShadows::kSlotCount)
+        {
+            saved.shadows[i] = s_constantShadow.Get(startSlot + i);
+        }
+    }
+
+    if (m_deviceContext1)
+    {
+        if (pixelShader) m_deviceContext1->PSGetConstantBuffers1(startSlot, count, saved.buffers, saved.firstConstant, saved.numConstants);
+        else             m_deviceContext1->VSGetConstantBuffers1(startSlot, count, saved.buffers, saved.firstConstant, saved.numConstants);
+        return;
+    }
+
+    if (pixelShader) m_deviceContext->PSGetConstantBuffers(startSlot, count, saved.buffers);
+    else             m_deviceContext->VSGetConstantBuffers(startSlot, count, saved.buffers);
+    for (UINT i = 0; i < count; ++i)
+    {
+        saved.firstConstant[i] = 0;
+        saved.numConstants[i] = 0;
+    }
+}
+
+/**
+ * @brief GetConstantBuffers Ŏ擾oChɖ߂܂B
+ *
+ * @details
+ * ÖʒuwĂXbǵÅԂ DISCARDit[̓rŐ擪ɖ߂jĂȂΓʒuoChA
+ * DISCARD ĂΒgĂ̂ŁATĂlOɏăoCh܂B
+ */
+void Renderer::SetConstantBuffers(const SavedConstantBuffers& saved)
+{
+    const bool pixelShader = saved.pixelShader;
+    for (UINT i = 0; i < saved.count; ++i)
+    {
+        const UINT slot = saved.startSlot + i;
+        ID3D11Buffer* const* buffer = &saved.buffers[i];
+
+        //萔̐ 0 ̂̂̓ItZbgŃoChĂ
+        if (m_deviceContext1 && saved.numConstants[i] != 0)
+        {
+            //Xbg̒lޔƂɖ߂i DISCARD Ƃ̏Ɏgj
+            const bool fromRing = (saved.buffers[i] == m_constantRingBuffer.Get()) && saved.shadows[i].size != 0;
+            if (fromRing)
+            {
+                s_constantShadow.Set(slot, saved.shadows[i]);
+            }
+
+            if (fromRing && saved.ringGeneration != m_constantRing.GetGeneration())
+            {
+                const ConstantSlotShadow& shadow = saved.shadows[i];
+                WriteConstants(static_cast<ID3D11Buffer*>(shadow.fallbackBuffer), shadow.data, shadow.size, slot, !pixelShader, pixelShader);
+                continue;
+            }
+
+            if (pixelShader) m_deviceContext1->PSSetConstantBuffers1(slot, 1, buffer, &saved.firstConstant[i], &saved.numConstants[i]);
+            else             m_deviceContext1->VSSetConstantBuffers1(slot, 1, buffer, &saved.firstConstant[i], &saved.numConstants[i]);
+        }
+        else
+        {
+            if (pixelShader) m_deviceContext->PSSetConstantBuffers(slot, 1, buffer);
+            else             m_deviceContext->VSSetConstantBuffers(slot, 1, buffer);
+        }
+    }
+}
+
+/**
+ * @brief GetConstantBuffers Ŏ󂯎obt@̎QƂ܂B
+ */
+void SavedConstantBuffers::Release()
+{
+    for (UINT i = 0; i < count; ++i)
+    {
+        if (buffers[i])
+        {
+            buffers[i]->Release();
+            buffers[i] = nullptr;
+        }
+    }
 }
 
 /**
@@ -845,8 +1182,8 @@ void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& pos
     ID3D11VertexShader* prevVS = nullptr;
     ID3D11PixelShader* prevPS = nullptr;
     ID3D11InputLayout* prevIL = nullptr;
-    ID3D11Buffer* prevVSCB[1] = { nullptr };
-    ID3D11Buffer* prevPSCB[1] = { nullptr };
+    SavedConstantBuffers prevVSCB;
+    SavedConstantBuffers prevPSCB;
     ID3D11BlendState* prevBlend = nullptr;
     FLOAT prevBlendFactor[4] = { 0,0,0,0 };
     UINT prevSampleMask = 0xFFFFFFFF;
@@ -863,8 +1200,8 @@ void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& pos
     m_deviceContext->VSGetShader(&prevVS, nullptr, nullptr);
     m_deviceContext->PSGetShader(&prevPS, nullptr, nullptr);
     m_deviceContext->IAGetInputLayout(&prevIL);
-    m_deviceContext->VSGetConstantBuffers(0, 1, prevVSCB);
-    m_deviceContext->PSGetConstantBuffers(0, 1, prevPSCB);
+    GetConstantBuffers(false, 0, 1, prevVSCB);
+    GetConstantBuffers(true, 0, 1, prevPSCB);
     m_deviceContext->OMGetBlendState(&prevBlend, prevBlendFactor, &prevSampleMask);
     m_deviceContext->OMGetDepthStencilState(&prevDSS, &prevStencilRef);
     m_deviceContext->RSGetState(&prevRS);
@@ -906,8 +1243,8 @@ void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& pos
         if (prevVS) prevVS->Release();
         if (prevPS) prevPS->Release();
         if (prevIL) prevIL->Release();
-        if (prevVSCB[0]) prevVSCB[0]->Release();
-        if (prevPSCB[0]) prevPSCB[0]->Release();
+        prevVSCB.Release();
+        prevPSCB.Release();
         if (prevBlend) prevBlend->Release();
         if (prevDSS) prevDSS->Release();
         if (prevRS) prevRS->Release();
@@ -963,8 +1300,8 @@ void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& pos
     m_deviceContext->OMSetBlendState(prevBlend, prevBlendFactor, prevSampleMask);
 
     // restore constant buffers
-    m_deviceContext->VSSetConstantBuffers(0, 1, prevVSCB);
-    m_deviceContext->PSSetConstantBuffers(0, 1, prevPSCB);
+    SetConstantBuffers(prevVSCB);
+    SetConstantBuffers(prevPSCB);
 
     // restore shaders & input layout
     m_deviceContext->VSSetShader(prevVS, nullptr, 0);
@@ -975,8 +1312,8 @@ void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& pos
     if (prevVS) prevVS->Release();
     if (prevPS) prevPS->Release();
     if (prevIL) prevIL->Release();
-    for (auto p : prevVSCB) if (p) p->Release();
-    for (auto p : prevPSCB) if (p) p->Release();
+    prevVSCB.Release();
+    prevPSCB.Release();
     if (prevBlend) prevBlend->Release();
     if (prevDSS) prevDSS->Release();
     if (prevRS) prevRS->Release();
@@ -1023,8 +1360,8 @@ void Renderer::ApplyMotionBlur()
     ID3D11VertexShader* prevVS = nullptr;
     ID3D11PixelShader* prevPS = nullptr;
     ID3D11InputLayout* prevIL = nullptr;
-    ID3D11Buffer* prevVSCB[1] = { nullptr };
-    ID3D11Buffer* prevPSCB[1] = { nullptr };
+    SavedConstantBuffers prevVSCB;
+    SavedConstantBuffers prevPSCB;
     ID3D11BlendState* prevBlend = nullptr;
     FLOAT               prevBlendFactor[4] = { 0,0,0,0 };
     UINT                prevSampleMask = 0xFFFFFFFF;
@@ -1041,8 +1378,8 @@ void Renderer::ApplyMotionBlur()
     m_deviceContext->VSGetShader(&prevVS, nullptr, nullptr);
     m_deviceContext->PSGetShader(&prevPS, nullptr, nullptr);
     m_deviceContext->IAGetInputLayout(&prevIL);
-    m_deviceContext->VSGetConstantBuffers(0, 1, prevVSCB);
-    m_deviceContext->PSGetConstantBuffers(0, 1, prevPSCB);
+    GetConstantBuffers(false, 0, 1, prevVSCB);
+    GetConstantBuffers(true, 0, 1, prevPSCB);
     m_deviceContext->OMGetBlendState(&prevBlend, prevBlendFactor, &prevSampleMask);
     m_deviceContext->OMGetDepthStencilState(&prevDSS, &prevStencilRef);
     m_deviceContext->RSGetState(&prevRS);
@@ -1148,8 +1485,8 @@ void Renderer::ApplyMotionBlur()
     m_deviceContext->RSSetState(prevRS);
     m_deviceContext->OMSetDepthStencilState(prevDSS, prevStencilRef);
     m_deviceContext->OMSetBlendState(prevBlend, prevBlendFactor, prevSampleMask);
-    m_deviceContext->VSSetConstantBuffers(0, 1, prevVSCB);
-    m_deviceContext->PSSetConstantBuffers(0, 1, prevPSCB);
+    SetConstantBuffers(prevVSCB);
+    SetConstantBuffers(prevPSCB);
     m_deviceContext->VSSetShader(prevVS, nullptr, 0);
     m_deviceContext->PSSetShader(prevPS, nullptr, 0);
     m_deviceContext->IASetInputLayout(prevIL);
@@ -1157,8 +1494,8 @@ void Renderer::ApplyMotionBlur()
     if (prevVS) prevVS->Release();
     if (prevPS) prevPS->Release();
     if (prevIL) prevIL->Release();
-    if (prevVSCB[0]) prevVSCB[0]->Release();
-    if (prevPSCB[0]) prevPSCB[0]->Release();
+    prevVSCB.Release();
+    prevPSCB.Release();
     if (prevBlend) prevBlend->Release();
     if (prevDSS) prevDSS->Release();
     if (prevRS) prevRS->Release();
@@ -1,5 +1,5 @@
 #pragma once
-#include <d3d11.h>
+#include <d3d11_1.h>
 #include <io.h>
 #include <string>
 #include <vector>
@@ -9,6 +9,7 @@
 #include "Transform.h"
 #include "VisualSettings.h"
 #include "Sound.h"
+#include "ConstantBufferRing.h"
 
 using namespace DirectX;
 
@@ -109,6 +110,25 @@ struct CBTextureAlpha
     float Padding[3];
 };
 
+//Renderer::GetConstantBuffers őޔ萔obt@̃oChi1 Xe[WAb0 ő 6 Xbgj
+//ÖʒuɉāÂƂXbgɓĂlTĂB
+//߂܂ł̊ԂɃO DISCARD ŏĂATlOɏăoCh
+struct SavedConstantBuffers
+{
+    static constexpr UINT kMaxSlots = ConstantSlotShadows::kSlotCount;
+
+    bool pixelShader = false;
+    UINT startSlot = 0;
+    UINT count = 0;
+    ID3D11Buffer* buffers[kMaxSlots] = {};     //Get ŎQƂ̂ŁASet ̌ Release() Ă
+    UINT firstConstant[kMaxSlots] = {};
+    UINT numConstants[kMaxSlots] = {};         //0 ȂItZbgŃoChĂ
+    uint32_t ringGeneration = 0;
+    ConstantSlotShadow shadows[kMaxSlots];
+
+    void Release();
+};
+
 // @brief DirectX_OǗ郌_NX
 //̃NX́ADirect3DfoCXAReLXgAXbv`F[Ȃǂ̊ǗƁA
 //_ȌAJnAIȂǂ̋@\񋟂܂B
@@ -130,6 +150,21 @@ private:
     static ComPtr<ID3D11Buffer> m_materialBuffer;
     static ComPtr<ID3D11Buffer> m_lightBuffer;
 
+    //---------------------------萔obt@̃O------------------------------
+    // sE}eAȂǕ`悲Ƃɕς萔 1 {̓Iobt@؂oāAItZbgtŃoCh
+    // ItZbgtoChgȂł m_constantRingEnabled = false ŁǍʃobt@XV
+    static ComPtr<ID3D11DeviceContext1> m_deviceContext1;
+    static ComPtr<ID3D11Buffer>         m_constantRingBuffer;
+    static ConstantBufferRing           m_constantRing;
+    static bool                         m_constantRingEnabled;
+
+    //萔 slot ɃoChivs / ps őΏۂ̃Xe[WIԁj
+    //DISCARD ł܂ł̒g͏̂ŁAXbgƂɍŌ̒loĂA
+    //Begin ƃt[rŐ擪ɖ߂ƂɁAoĂXbgׂď
+    static void UploadConstants(ID3D11Buffer* fallbackBuffer, const void* data, UINT size, UINT slot, bool vs, bool ps);
+    static void WriteConstants(ID3D11Buffer* fallbackBuffer, const void* data, UINT size, UINT slot, bool vs, bool ps);
+    static void RewriteConstantSlots(UINT skipSlot);
+
     static ComPtr<ID3D11DepthStencilState> m_depthStateEnable;
     static ComPtr<ID3D11DepthStencilState> m_depthStateDisable;
 
@@ -153,10 +188,11 @@ private:
 
     //-----------------------------------------------------------------------------
 
-    //VF[_RpC̋ʃwp
+    //VF[_RpC̋ʃwpiShaderCache ɂ΃RpCɓǂݍށj
     static Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath,
                                                           const char* entryPoint,
-                                                          const char* target);
+                                                          const char* target,
+                                                          const D3D_SHADER_MACRO* defines = nullptr);
 
 public:
     static Renderer& Get();
@@ -203,6 +239,12 @@ public:
 
     static void SetTextureAlpha(float alpha);
 
+    //萔obt@̃oCh̑ޔEiO犄蓖Ă̂̓ItZbg܂߂Ė߂j
+    //Get Ŏ󂯎 saved.buffers  Set ̌ saved.Release() Ŏ
+    static void GetConstantBuffers(bool pixelShader, UINT startSlot, UINT count, SavedConstantBuffers& saved);
+    static void SetConstantBuffers(const SavedConstantBuffers& saved);
+    static const ConstantBufferRing& GetConstantRing() { return m_constantRing; }
+
     //eBNp̊֐
     static void DrawReticle(ID3D11ShaderResourceView* texture, const POINT& center, const Vector2& size);
 
@@ -211,18 +253,6 @@ public:
                               float size,const DirectX::SimpleMath::Vector4& color,
                               int cols = 1,int rows = 1,int frameIndex = 0,bool isAdditive = true);
 
-    // }eAp萔obt@̃|C^擾
-    static ID3D11Buffer* GetMaterialCB()
-    {
-        return m_materialBuffer.Get();
-    }
-
-    // }eAp萔obt@̃AhXiID3D11Buffer**j擾
-    static ID3D11Buffer** GetMaterialCBAddress()
-    {
-        return m_materialBuffer.GetAddressOf();
-    }
-
     static void DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size);
 
     //------------------------------Billboard֘A------------------------------
@@ -230,6 +260,15 @@ public:
     static ComPtr<ID3D11PixelShader>  m_billboardPixelShader;
     static ComPtr<ID3D11InputLayout>  m_billboardInputLayout;
 
+    //------------------------------k_ifj֘A------------------------------
+    // PackedVertexiXbg0j+ _FiXbg2jBBasicVertexShader.hlsl  VSMainPacked p
+    static ComPtr<ID3D11VertexShader> m_packedVertexShader;
+    static ComPtr<ID3D11InputLayout>  m_packedInputLayout;
+
+    //------------------------------CX^VO֘A------------------------------
+    static ComPtr<ID3D11VertexShader> m_instancedVertexShader;
+    static ComPtr<ID3D11InputLayout>  m_instancedInputLayout;
+
     // uŌɃZbgꂽView/ProjvRendererŊoir{[ȟvZɕKvj
     static DirectX::SimpleMath::Matrix m_cachedView;
     static DirectX::SimpleMath::Matrix m_cachedProjection;
@@ -0,0 +1,304 @@
+﻿//------------------------------------------------------------
+// Asset/ 以下を 1 つのアーカイブ（Asset.pak）にまとめるツール
+// 実行時は Game::GameInit が作業フォルダの Asset.pak をマップし、AssetArchive から読む（無ければ今まで通りファイルから）
+// ・キーは作業フォルダ（ShootingGame_0519）からの相対パスを正規化したもの（例: asset/ui/title.png）
+// ・LZ4 で 10% 以上小さくなるものだけ圧縮する（PNG / JPEG / DDS の BC 圧縮はほぼ縮まないので無圧縮のまま、コピー無しで読める）
+// ・TextureBaker で焼いた .dds も同じフォルダにあれば一緒に入り、TextureManager が元画像より優先して使う
+// ・書き出した後にマウントし直して、全エントリが元ファイルと同じ中身で引けるかを確かめる（違えば 0 以外で終了する）
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 AssetPacker.cpp ../../ShootingGame_0519/AssetArchive.cpp ../../ShootingGame_0519/Lz4Block.cpp -o AssetPacker
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 AssetPacker.cpp ..\..\ShootingGame_0519\AssetArchive.cpp ..\..\ShootingGame_0519\Lz4Block.cpp
+// 実行例:
+//   ./AssetPacker ../../ShootingGame_0519 ../../ShootingGame_0519/Asset.pak
+//   ./AssetPacker --no-lz4 ../../ShootingGame_0519 /tmp/Asset.pak Asset/Texture Asset/Model
+//
+// オプション:
+//   --no-lz4    圧縮しない（全エントリをコピー無しで読めるようにする）
+//   -v          エントリごとのサイズを表示する
+//------------------------------------------------------------
+#include "AssetArchive.h"
+#include "Lz4Block.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct Options
+    {
+        bool lz4 = true;
+        bool verbose = false;
+    };
+
+    //書き出すエントリ
+    struct PackedFile
+    {
+        fs::path source;
+        std::string key;            //正規化したパス
+        uint64_t hash = 0;
+        uint64_t size = 0;
+        uint32_t flags = 0;
+        std::vector<uint8_t> stored;
+    };
+
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    bool ReadFile(const fs::path& path, std::vector<uint8_t>& out)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs) { return false; }
+        out.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    //u8string は C++17 では std::string、C++20 では std::u8string なので中身だけ写す
+    std::string ToKey(const fs::path& relative)
+    {
+        const auto u8 = relative.generic_u8string();
+        return NormalizeAssetPath(std::string(u8.begin(), u8.end()));
+    }
+
+    uint64_t AlignUp(uint64_t value)
+    {
+        return (value + kAssetArchiveAlignment - 1) / kAssetArchiveAlignment * kAssetArchiveAlignment;
+    }
+
+    bool Collect(const fs::path& root, const fs::path& dir, std::vector<PackedFile>& files)
+    {
+        std::error_code ec;
+        if (!fs::is_directory(root / dir, ec))
+        {
+            std::printf("%s がありません\n", (root / dir).string().c_str());
+            return false;
+        }
+
+        for (const auto& it : fs::recursive_directory_iterator(root / dir))
+        {
+            if (!it.is_regular_file()) { continue; }
+            PackedFile file;
+            file.source = it.path();
+            file.key = ToKey(fs::relative(it.path(), root));
+            file.hash = HashAssetPath(file.key);
+            files.push_back(std::move(file));
+        }
+        return true;
+    }
+
+    bool Pack(std::vector<PackedFile>& files, const Options& opt, const fs::path& outPath)
+    {
+        //索引は hash の昇順（同じ hash はパス順）に並べる
+        std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b)
+            {
+                return a.hash != b.hash ? a.hash < b.hash : a.key < b.key;
+            });
+        for (size_t i = 1; i < files.size(); ++i)
+        {
+            if (files[i].key == files[i - 1].key)
+            {
+                std::printf("同じキーが 2 回あります: %s\n", files[i].key.c_str());
+                return false;
+            }
+        }
+
+        uint64_t rawBytes = 0;
+        uint64_t storedBytes = 0;
+        size_t compressed = 0;
+        std::vector<uint8_t> packed;
+
+        for (PackedFile& file : files)
+        {
+            if (!ReadFile(file.source, file.stored))
+            {
+                std::printf("%s を読めません\n", file.source.string().c_str());
+                return false;
+            }
+            file.size = file.stored.size();
+
+            //10% 以上縮むときだけ圧縮したものを入れる
+            if (opt.lz4 && file.size > 0 &&
+                Lz4CompressBlock(file.stored.data(), file.stored.size(), packed) * 10 <= file.size * 9)
+            {
+                file.stored.swap(packed);
+                file.flags |= kAssetEntryLz4;
+                ++compressed;
+            }
+
+            rawBytes += file.size;
+            storedBytes += file.stored.size();
+            if (opt.verbose)
+            {
+                std::printf("  %-60s %10llu -> %10llu%s\n", file.key.c_str(), static_cast<unsigned long long>(file.size),
+                    static_cast<unsigned long long>(file.stored.size()), (file.flags & kAssetEntryLz4) ? " (lz4)" : "");
+            }
+        }
+
+        //ヘッダー | 索引 | パス文字列 | (4KB 境界) 中身 ...
+        std::string names;
+        std::vector<AssetArchiveEntry> entries(files.size());
+        AssetArchiveHeader header{};
+        std::memcpy(header.magic, kAssetArchiveMagic, sizeof(header.magic));
+        header.version = kAssetArchiveVersion;
+        header.entryCount = static_cast<uint32_t>(files.size());
+        header.indexOffset = sizeof(AssetArchiveHeader);
+        header.namesOffset = header.indexOffset + sizeof(AssetArchiveEntry) * files.size();
+
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            entries[i].hash = files[i].hash;
+            entries[i].nameOffset = static_cast<uint32_t>(names.size());
+            entries[i].nameLength = static_cast<uint32_t>(files[i].key.size());
+            entries[i].flags = files[i].flags;
+            entries[i].size = files[i].size;
+            entries[i].storedSize = files[i].stored.size();
+            names += files[i].key;
+        }
+        header.namesSize = names.size();
+
+        uint64_t offset = AlignUp(header.namesOffset + header.namesSize);
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            entries[i].offset = offset;
+            offset = AlignUp(offset + entries[i].storedSize);
+        }
+        header.fileSize = files.empty() ? header.namesOffset + header.namesSize
+                                        : entries.back().offset + entries.back().storedSize;
+
+        std::ofstream ofs(outPath, std::ios::binary | std::ios::trunc);
+        if (!ofs)
+        {
+            std::printf("%s に書けません\n", outPath.string().c_str());
+            return false;
+        }
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(sizeof(AssetArchiveEntry) * entries.size()));
+        ofs.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+        uint64_t written = header.namesOffset + header.namesSize;
+        const std::vector<char> padding(kAssetArchiveAlignment, 0);
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            ofs.write(padding.data(), static_cast<std::streamsize>(entries[i].offset - written));
+            ofs.write(reinterpret_cast<const char*>(files[i].stored.data()), static_cast<std::streamsize>(files[i].stored.size()));
+            written = entries[i].offset + entries[i].storedSize;
+            std::vector<uint8_t>().swap(files[i].stored);
+        }
+        if (!ofs.flush())
+        {
+            std::printf("%s の書き込みに失敗しました\n", outPath.string().c_str());
+            return false;
+        }
+
+        std::printf("%s: %zu entries, %llu KB -> %llu KB (lz4 %zu entries), archive %llu KB\n",
+            outPath.string().c_str(), files.size(),
+            static_cast<unsigned long long>(rawBytes / 1024), static_cast<unsigned long long>(storedBytes / 1024),
+            compressed, static_cast<unsigned long long>(header.fileSize / 1024));
+        return true;
+    }
+
+    //書き出したものをランタイムと同じ経路で読み、元ファイルと比べる
+    void Verify(const std::vector<PackedFile>& files, const fs::path& outPath)
+    {
+        std::printf("--- 検証\n");
+
+        Check(AssetArchive::Mount(outPath), "マウントできる");
+        Check(AssetArchive::GetEntryCount() == files.size(), "エントリ数が合う");
+
+        size_t mismatched = 0;
+        size_t misaligned = 0;
+        size_t notMapped = 0;
+        std::vector<uint8_t> original;
+        for (const PackedFile& file : files)
+        {
+            AssetView view;
+            ReadFile(file.source, original);
+            if (!AssetArchive::Contains(file.key) || !AssetArchive::Load(file.key, view) ||
+                view.size != original.size() || (view.size > 0 && std::memcmp(view.data, original.data(), view.size) != 0))
+            {
+                std::printf("      一致しない: %s\n", file.key.c_str());
+                ++mismatched;
+                continue;
+            }
+            if ((file.flags & kAssetEntryLz4) == 0)
+            {
+                if (!view.IsMapped()) { ++notMapped; }
+                //マップの先頭はページ境界なので、アドレスで 4KB 境界を確かめられる
+                if (reinterpret_cast<uintptr_t>(view.data) % kAssetArchiveAlignment != 0 && view.size > 0) { ++misaligned; }
+            }
+        }
+        Check(mismatched == 0, "全エントリが元ファイルと同じ中身");
+        Check(notMapped == 0, "無圧縮のエントリはコピー無しで返る");
+        Check(misaligned == 0, "エントリは 4KB 境界にある");
+
+        //ゲーム側はバックスラッシュや大文字混じりのパスで引く
+        if (!files.empty())
+        {
+            std::string windowsStyle = files.front().key;
+            std::replace(windowsStyle.begin(), windowsStyle.end(), '/', '\\');
+            std::transform(windowsStyle.begin(), windowsStyle.end(), windowsStyle.begin(),
+                [](char c) { return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c; });
+            Check(AssetArchive::Contains(windowsStyle), "区切りと大文字小文字が違っても引ける");
+        }
+        Check(!AssetArchive::Contains("asset/__missing__.png"), "無いパスは見つからない");
+
+        std::printf("      loads mapped=%llu decompressed=%llu loose=%llu\n",
+            static_cast<unsigned long long>(AssetArchive::GetMappedLoads()),
+            static_cast<unsigned long long>(AssetArchive::GetDecompressedLoads()),
+            static_cast<unsigned long long>(AssetArchive::GetLooseLoads()));
+        AssetArchive::Unmount();
+    }
+
+    void PrintUsage()
+    {
+        std::printf("usage: AssetPacker [--no-lz4] [-v] <root> <out.pak> [dir...]\n");
+        std::printf("  dir は root からの相対パス（既定は Asset）\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--no-lz4") { opt.lz4 = false; }
+        else if (arg == "-v") { opt.verbose = true; }
+        else if (!arg.empty() && arg[0] == '-') { PrintUsage(); return 1; }
+        else { args.push_back(arg); }
+    }
+    if (args.size() < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const fs::path root = args[0];
+    const fs::path outPath = args[1];
+    std::vector<std::string> dirs(args.begin() + 2, args.end());
+    if (dirs.empty()) { dirs.push_back("Asset"); }
+
+    std::vector<PackedFile> files;
+    for (const std::string& dir : dirs)
+    {
+        if (!Collect(root, dir, files)) { return 1; }
+    }
+    if (!Pack(files, opt, outPath)) { return 1; }
+
+    Verify(files, outPath);
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+﻿//------------------------------------------------------------
+// AsyncFileSystem のベンチマーク（ウィンドウ・GPU 不要）
+// 小さなファイルをたくさん読むときの速さを、今までの同期読み込み（1 ファイルずつ開いて全部読む）と比べる
+// ・blocking    : AssetArchive::Load を 1 ファイルずつ順に呼ぶ（Sound::LoadWavPcm などの今までの読み方）
+// ・thread pool : AsyncFileSystem（ワーカースレッド）にまとめて積む
+// ・io_uring    : AsyncFileSystem（io_uring。Linux のみ）にまとめて積む
+// それぞれページキャッシュから追い出した状態（cold。Linux のみ）と、載った状態（warm）で測る
+// 読んだ中身・範囲読み込み・優先度の順・まとめて積んだときのコールバックも確かめ、問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -pthread -I../../ShootingGame_0519 AsyncFileBench.cpp ../../ShootingGame_0519/AsyncFileSystem.cpp ../../ShootingGame_0519/AssetArchive.cpp ../../ShootingGame_0519/Lz4Block.cpp -o AsyncFileBench
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 AsyncFileBench.cpp ..\..\ShootingGame_0519\AsyncFileSystem.cpp ..\..\ShootingGame_0519\AssetArchive.cpp ..\..\ShootingGame_0519\Lz4Block.cpp
+// 実行例:
+//   ./AsyncFileBench [ファイル数=2000] [1 ファイルの KB=16] [作業フォルダ=AsyncFileBenchData]
+//------------------------------------------------------------
+#include "AsyncFileSystem.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    //ファイルごとに中身を変える（先頭 4 バイトに番号を入れ、残りは番号から作る）
+    uint8_t ExpectedByte(size_t file, size_t i)
+    {
+        return static_cast<uint8_t>((file * 131 + i * 7) ^ (i >> 8));
+    }
+
+    bool CheckContent(size_t file, const uint8_t* data, size_t size, size_t offset = 0)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (data[i] != ExpectedByte(file, offset + i)) { return false; }
+        }
+        return true;
+    }
+
+    std::vector<std::string> PrepareFiles(const fs::path& dir, size_t count, size_t bytes)
+    {
+        fs::create_directories(dir);
+        std::vector<std::string> paths;
+        std::vector<uint8_t> buffer(bytes);
+        for (size_t f = 0; f < count; ++f)
+        {
+            fs::path path = dir / ("file" + std::to_string(f) + ".bin");
+            paths.push_back(path.string());
+
+            std::error_code ec;
+            if (fs::exists(path, ec) && fs::file_size(path, ec) == bytes) { continue; }
+            for (size_t i = 0; i < bytes; ++i) { buffer[i] = ExpectedByte(f, i); }
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(bytes));
+        }
+        return paths;
+    }
+
+    //ページキャッシュから追い出す（Linux 以外では何もしないので cold は測らない）
+    bool DropCache(const std::vector<std::string>& paths)
+    {
+#ifdef __linux__
+        for (const std::string& path : paths)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) { return false; }
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+        return true;
+#else
+        (void)paths;
+        return false;
+#endif
+    }
+
+    struct RunResult
+    {
+        double ms = 0.0;
+        size_t ok = 0;
+        size_t correct = 0;
+        uint64_t submits = 0;
+    };
+
+    RunResult RunBlocking(const std::vector<std::string>& paths)
+    {
+        RunResult r;
+        auto start = Clock::now();
+        for (size_t f = 0; f < paths.size(); ++f)
+        {
+            AssetView view;
+            if (!AssetArchive::Load(paths[f], view)) { continue; }
+            ++r.ok;
+            if (CheckContent(f, view.data, view.size)) { ++r.correct; }
+        }
+        r.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        return r;
+    }
+
+    RunResult RunAsync(const std::vector<std::string>& paths)
+    {
+        RunResult r;
+        const uint64_t submitsBefore = AsyncFileSystem::GetSubmitCount();
+        auto start = Clock::now();
+
+        std::vector<FileReadRequest> requests(paths.size());
+        for (size_t f = 0; f < paths.size(); ++f)
+        {
+            requests[f].path = paths[f];
+            requests[f].onComplete = [&r, f](FileReadResult& result)
+                {
+                    if (!result.ok) { return; }
+                    ++r.ok;
+                    if (CheckContent(f, result.view.data, result.view.size)) { ++r.correct; }
+                };
+        }
+        AsyncFileSystem::ReadBatch(std::move(requests));
+        AsyncFileSystem::WaitAll();
+
+        r.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        r.submits = AsyncFileSystem::GetSubmitCount() - submitsBefore;
+        return r;
+    }
+
+    void Report(const char* name, const char* cache, const RunResult& r, size_t count, size_t bytes)
+    {
+        const double seconds = r.ms / 1000.0;
+        std::printf("  %-12s %-5s %9.2f ms %10.0f files/s %8.1f MB/s  submits=%llu\n", name, cache, r.ms,
+            count / seconds, count * static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds,
+            static_cast<unsigned long long>(r.submits));
+    }
+
+    //優先度の順・範囲読み込み・まとめたときのコールバック
+    void CheckBehavior(const std::vector<std::string>& paths, size_t bytes)
+    {
+        std::printf("--- 動作\n");
+
+        //ワーカー 1 本なら、まとめて積んだ中では優先度の高いものから、同じ優先度は積んだ順に読む
+        AsyncFileSystem::Init(1, false);
+        std::vector<int> order;
+        bool batchAfterAll = false;
+        const FileReadPriority priorities[] = { FileReadPriority::Low, FileReadPriority::Normal, FileReadPriority::High,
+                                                FileReadPriority::Normal, FileReadPriority::High };
+        std::vector<FileReadRequest> requests;
+        for (int i = 0; i < 5; ++i)
+        {
+            FileReadRequest request;
+            request.path = paths[i];
+            request.priority = priorities[i];
+            request.onComplete = [&order, i](FileReadResult&) { order.push_back(i); };
+            requests.push_back(std::move(request));
+        }
+        AsyncFileSystem::ReadBatch(std::move(requests), [&] { batchAfterAll = order.size() == 5; });
+        AsyncFileSystem::WaitAll();
+        Check(order == std::vector<int>({ 2, 4, 1, 3, 0 }), "優先度の高い順、同じ優先度は積んだ順");
+        Check(batchAfterAll, "まとめたときのコールバックは全部の後");
+
+        //範囲読み込みと、無いファイル
+        const bool ioUring = (AsyncFileSystem::Init(), AsyncFileSystem::GetBackend() == FileIoBackend::IoUring);
+        for (int pass = 0; pass < (ioUring ? 2 : 1); ++pass)
+        {
+            if (pass == 1) { AsyncFileSystem::Init(0, false); }
+            const std::string name = AsyncFileSystem::GetBackendName();
+
+            bool rangeOk = false;
+            bool tailOk = false;
+            bool missingFailed = false;
+            FileReadRequest range;
+            range.path = paths[7];
+            range.offset = 100;
+            range.size = 50;
+            range.onComplete = [&](FileReadResult& result) { rangeOk = result.ok && result.view.size == 50 && CheckContent(7, result.view.data, 50, 100); };
+            AsyncFileSystem::Read(std::move(range));
+
+            FileReadRequest tail;
+            tail.path = paths[8];
+            tail.offset = bytes - 10;
+            tail.size = 1000;
+            tail.onComplete = [&](FileReadResult& result) { tailOk = result.ok && result.view.size == 10 && CheckContent(8, result.view.data, 10, bytes - 10); };
+            AsyncFileSystem::Read(std::move(tail));
+
+            FileReadRequest missing;
+            missing.path = paths[0] + ".missing";
+            missing.onComplete = [&](FileReadResult& result) { missingFailed = !result.ok; };
+            AsyncFileSystem::Read(std::move(missing));
+
+            AsyncFileSystem::WaitAll();
+            Check(rangeOk, (name + ": offset / size の範囲だけ読む").c_str());
+            Check(tailOk, (name + ": ファイルの終わりで切り詰める").c_str());
+            Check(missingFailed, (name + ": 無いファイルは ok = false").c_str());
+        }
+        AsyncFileSystem::Uninit();
+
+        //Init 前は呼んだスレッドで読み、Poll でコールバックする
+        bool called = false;
+        FileReadRequest immediate;
+        immediate.path = paths[1];
+        immediate.onComplete = [&](FileReadResult& result) { called = result.ok; };
+        AsyncFileSystem::Read(std::move(immediate));
+        Check(!called && AsyncFileSystem::GetOutstandingCount() == 1, "Init 前でもコールバックは Poll まで待つ");
+        AsyncFileSystem::Poll();
+        Check(called && AsyncFileSystem::GetOutstandingCount() == 0, "Poll でコールバックされる");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const size_t bytes = ((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 16) * 1024;
+    const fs::path dir = (argc > 3) ? argv[3] : "AsyncFileBenchData";
+    if (count < 10 || bytes < 1024)
+    {
+        std::printf("ファイル数は 10 以上、サイズは 1 KB 以上にしてください\n");
+        return 1;
+    }
+
+    const std::vector<std::string> paths = PrepareFiles(dir, count, bytes);
+    std::printf("%zu files x %zu KB (%s)\n", count, bytes / 1024, dir.string().c_str());
+
+    CheckBehavior(paths, bytes);
+
+    std::printf("--- 計測\n");
+    const bool canDrop = DropCache(paths);
+    for (int warm = canDrop ? 0 : 1; warm < 2; ++warm)
+    {
+        const char* cache = warm ? "warm" : "cold";
+
+        if (!warm) { DropCache(paths); }
+        RunResult blocking = RunBlocking(paths);
+        Report("blocking", cache, blocking, count, bytes);
+        Check(blocking.ok == count && blocking.correct == count, "blocking: 全部正しく読める");
+
+        AsyncFileSystem::Init(0, false);
+        if (!warm) { DropCache(paths); }
+        RunResult pool = RunAsync(paths);
+        Report("thread pool", cache, pool, count, bytes);
+        Check(pool.ok == count && pool.correct == count, "thread pool: 全部正しく読める");
+
+        AsyncFileSystem::Init(0, true);
+        if (AsyncFileSystem::GetBackend() == FileIoBackend::IoUring)
+        {
+            if (!warm) { DropCache(paths); }
+            RunResult uring = RunAsync(paths);
+            Report("io_uring", cache, uring, count, bytes);
+            Check(uring.ok == count && uring.correct == count, "io_uring: 全部正しく読める");
+        }
+        AsyncFileSystem::Uninit();
+    }
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,321 @@
+﻿//------------------------------------------------------------
+// ConstantBufferRing の割り当てを確認するツール（D3D 不要）
+// ・オフセットとサイズが 256 バイト（16 定数）の倍数で、*SetConstantBuffers1 に渡す値と一致するか
+// ・フレームの最初と、先頭に戻ったときだけ DISCARD になるか
+// ・DISCARD から次の DISCARD までの割り当てが重ならないか（NO_OVERWRITE で GPU の読む場所を上書きしないか）
+// ・大きすぎる割り当ては失敗して、従来の経路に回せるか
+// ・フレームの途中で先頭に戻った（DISCARD した）とき、前にバインドしたスロット（ビュー・プロジェクション・ライトなど）が
+//   ConstantSlotShadows で書き直され、すべて今の中身を指しているか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 ConstantBufferRingCheck.cpp ../../ShootingGame_0519/ConstantBufferRing.cpp -o ConstantBufferRingCheck
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 ConstantBufferRingCheck.cpp ..\..\ShootingGame_0519\ConstantBufferRing.cpp
+//------------------------------------------------------------
+#include "ConstantBufferRing.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    void CheckAlign()
+    {
+        std::printf("--- AlignConstantBufferSize\n");
+
+        Check(AlignConstantBufferSize(0) == 0, "0 バイトは 0");
+        Check(AlignConstantBufferSize(1) == 256, "1 バイトは 256");
+        Check(AlignConstantBufferSize(64) == 256, "行列 1 つは 256");
+        Check(AlignConstantBufferSize(256) == 256, "256 はそのまま");
+        Check(AlignConstantBufferSize(257) == 512, "257 は 512");
+    }
+
+    void CheckBasic()
+    {
+        std::printf("--- Allocate\n");
+
+        ConstantBufferRing ring(4096);
+        ConstantBufferAllocation a, b, c;
+
+        Check(ring.Allocate(64, a) && a.offset == 0 && a.size == 256 && a.discard, "最初の割り当ては先頭から DISCARD");
+        Check(a.firstConstant == 0 && a.numConstants == 16, "定数単位の位置と数");
+
+        Check(ring.Allocate(80, b) && b.offset == 256 && !b.discard, "次は 256 バイト後ろから NO_OVERWRITE");
+        Check(b.firstConstant == 16 && b.numConstants == 16, "80 バイトも 16 定数");
+
+        Check(ring.Allocate(300, c) && c.offset == 512 && c.size == 512 && c.numConstants == 32, "256 を超えると 2 ブロック");
+        Check(ring.GetFrameAllocations() == 3 && ring.GetFrameBytes() == 1024, "フレームの統計");
+
+        ConstantBufferAllocation d;
+        Check(!ring.Allocate(0, d), "0 バイトは失敗");
+        Check(!ring.Allocate(4097, d), "容量を超えると失敗");
+        ConstantBufferRing big(1024 * 1024);
+        Check(!big.Allocate(kConstantBufferMaxBindBytes + 1, d), "1 回のバインドの上限を超えると失敗");
+        Check(big.Allocate(kConstantBufferMaxBindBytes, d) && d.numConstants == 4096, "上限ちょうどは割り当てられる");
+
+        ConstantBufferRing odd(1000);
+        Check(odd.GetCapacity() == 768, "容量は 256 の倍数に切り下げる");
+    }
+
+    void CheckWrapAndFrame()
+    {
+        std::printf("--- 先頭に戻る / BeginFrame\n");
+
+        ConstantBufferRing ring(1024);
+        ConstantBufferAllocation a;
+        for (int i = 0; i < 4; ++i) { ring.Allocate(64, a); }
+        Check(ring.GetHead() == 1024 && ring.GetFrameWraps() == 0, "容量ちょうどまで使える");
+
+        Check(ring.Allocate(64, a) && a.offset == 0 && a.discard && ring.GetFrameWraps() == 1, "入りきらなければ先頭に戻って DISCARD");
+        Check(ring.Allocate(64, a) && a.offset == 256 && !a.discard, "戻った後は NO_OVERWRITE");
+
+        ring.BeginFrame();
+        Check(ring.GetPeakFrameBytes() == 1536, "前のフレームの使用量がピークに残る");
+        Check(ring.GetFrameBytes() == 0 && ring.GetFrameWraps() == 0, "フレームの統計が戻る");
+        Check(ring.Allocate(64, a) && a.offset == 0 && a.discard, "フレームの最初は先頭から DISCARD");
+
+        ring.RequestDiscard();
+        Check(ring.Allocate(64, a) && a.offset == 256 && a.discard, "RequestDiscard の後は DISCARD");
+        Check(ring.Allocate(64, a) && !a.discard, "その次は NO_OVERWRITE");
+
+        ring.BeginFrame();
+        Check(ring.GetPeakFrameBytes() == 1536, "少ないフレームではピークは変わらない");
+    }
+
+    //いろいろな大きさで何フレームも割り当て、DISCARD の間で重ならないことを確かめる
+    void CheckRandom()
+    {
+        std::printf("--- 乱数で割り当て\n");
+
+        ConstantBufferRing ring(64 * 1024);
+        std::mt19937 rng(12345);
+        std::uniform_int_distribution<uint32_t> sizeDist(1, 1200);
+        std::uniform_int_distribution<int> countDist(50, 600);
+
+        bool aligned = true;
+        bool inside = true;
+        bool noOverlap = true;
+        bool discardAtStart = true;
+        int wraps = 0;
+
+        std::vector<std::pair<uint32_t, uint32_t>> live;   //最後の DISCARD 以降に書いた範囲
+        for (int frame = 0; frame < 200; ++frame)
+        {
+            ring.BeginFrame();
+            int count = countDist(rng);
+            for (int i = 0; i < count; ++i)
+            {
+                uint32_t size = sizeDist(rng);
+                ConstantBufferAllocation a;
+                if (!ring.Allocate(size, a)) { aligned = false; continue; }
+
+                if (i == 0 && !a.discard) { discardAtStart = false; }
+                if (a.discard) { live.clear(); }
+
+                aligned = aligned && (a.offset % 256 == 0) && (a.size % 256 == 0) && a.size >= size &&
+                    a.firstConstant * 16 == a.offset && a.numConstants * 16 == a.size && a.numConstants <= 4096;
+                inside = inside && a.offset + a.size <= ring.GetCapacity();
+
+                for (const auto& range : live)
+                {
+                    if (a.offset < range.second && range.first < a.offset + a.size) { noOverlap = false; }
+                }
+                live.emplace_back(a.offset, a.offset + a.size);
+            }
+            wraps += static_cast<int>(ring.GetFrameWraps());
+        }
+
+        Check(aligned, "すべて 256 バイト境界で、定数単位の値と一致する");
+        Check(inside, "バッファの外にはみ出さない");
+        Check(noOverlap, "DISCARD の間で割り当てが重ならない");
+        Check(discardAtStart, "各フレームの最初の割り当ては DISCARD");
+        Check(wraps > 0, "先頭に戻る場合も通った");
+        std::printf("      wraps=%d peak=%u bytes\n", wraps, ring.GetPeakFrameBytes());
+    }
+
+    //Renderer::UploadConstants / WriteConstants と同じ流れを、GPU のバッファの代わりにバイト列で行う
+    //DISCARD で Map したときは、前の中身が当てにならないことを 0xCD で埋めて表す
+    struct FakeConstantDevice
+    {
+        ConstantBufferRing ring;
+        ConstantSlotShadows shadows;
+        std::vector<uint8_t> memory;
+        uint32_t boundOffset[ConstantSlotShadows::kSlotCount] = {};
+        bool bound[ConstantSlotShadows::kSlotCount] = {};
+        bool rewrite = true;        //false にすると書き直さない（修正前の動き）
+
+        explicit FakeConstantDevice(uint32_t capacity) : ring(capacity), memory(ring.GetCapacity(), 0) {}
+
+        void BeginFrame()
+        {
+            ring.BeginFrame();
+            if (rewrite) { RewriteAll(ConstantSlotShadows::kNoSlot); }
+        }
+
+        void Upload(uint32_t slot, const void* data, uint32_t size)
+        {
+            shadows.Remember(slot, nullptr, data, size, true, false);
+            Write(slot, data, size);
+        }
+
+        void Write(uint32_t slot, const void* data, uint32_t size)
+        {
+            ConstantBufferAllocation a;
+            if (!ring.Allocate(size, a)) { return; }
+
+            if (a.discard) { std::memset(memory.data(), 0xCD, memory.size()); }
+            std::memcpy(memory.data() + a.offset, data, size);
+            boundOffset[slot] = a.offset;
+            bound[slot] = true;
+
+            if (a.discard && rewrite) { RewriteAll(slot); }
+        }
+
+        void RewriteAll(uint32_t skipSlot)
+        {
+            shadows.RewriteAll(skipSlot, [this](uint32_t slot, const ConstantSlotShadow& shadow)
+            {
+                Write(slot, shadow.data, shadow.size);
+            });
+        }
+
+        //覚えているスロットがすべて、最後に書いた値と同じ中身の場所を指しているか
+        bool AllSlotsValid() const
+        {
+            for (uint32_t slot = 0; slot < ConstantSlotShadows::kSlotCount; ++slot)
+            {
+                const ConstantSlotShadow& shadow = shadows.Get(slot);
+                if (shadow.size == 0) { continue; }
+                if (!bound[slot]) { return false; }
+                if (std::memcmp(memory.data() + boundOffset[slot], shadow.data, shadow.size) != 0) { return false; }
+            }
+            return true;
+        }
+    };
+
+    struct Matrix { float m[16]; };
+
+    Matrix MakeMatrix(float value)
+    {
+        Matrix matrix;
+        for (float& f : matrix.m) { f = value; }
+        return matrix;
+    }
+
+    void CheckRewriteOnWrap()
+    {
+        std::printf("--- 先頭に戻ったときのスロットの書き直し\n");
+
+        //ビュー・プロジェクション・ライトを最初に 1 回だけ書き、あとはワールド行列を描画ごとに書く
+        //（4 回分の容量なので、ワールド行列の 2 回目で先頭に戻る）
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            FakeConstantDevice device(1024);
+            device.rewrite = (pass == 0);
+
+            device.BeginFrame();
+            Matrix view = MakeMatrix(1.0f), projection = MakeMatrix(2.0f);
+            float light[8] = { 3, 3, 3, 3, 3, 3, 3, 3 };
+            device.Upload(1, &view, sizeof(view));
+            device.Upload(2, &projection, sizeof(projection));
+            device.Upload(4, light, sizeof(light));
+
+            bool validBeforeWrap = true;
+            uint32_t generation = device.ring.GetGeneration();
+            for (int draw = 0; draw < 2; ++draw)
+            {
+                Matrix world = MakeMatrix(10.0f + draw);
+                device.Upload(0, &world, sizeof(world));
+                if (device.ring.GetFrameWraps() == 0) { validBeforeWrap = validBeforeWrap && device.AllSlotsValid(); }
+            }
+
+            if (pass == 0)
+            {
+                Check(validBeforeWrap, "先頭に戻るまではすべてのスロットが正しい");
+                Check(device.ring.GetFrameWraps() == 1, "ワールド行列の途中で先頭に戻った");
+                Check(device.ring.GetGeneration() != generation, "先頭に戻ると世代が変わる（退避したバインドは古くなる）");
+                Check(device.AllSlotsValid(), "先頭に戻った後も b0/b1/b2/b4 が今の中身を指す");
+                Check(device.boundOffset[1] < device.ring.GetHead() && device.boundOffset[2] < device.ring.GetHead() &&
+                    device.boundOffset[4] < device.ring.GetHead(), "b1/b2/b4 は先頭に戻った後の位置にバインドし直されている");
+
+                device.BeginFrame();
+                Check(device.AllSlotsValid(), "次のフレームの最初も書き直される");
+            }
+            else
+            {
+                Check(!device.AllSlotsValid(), "（書き直さなければ、先頭に戻った後に古い場所を指す）");
+            }
+        }
+
+        //書き直しの途中で DISCARD になっても入れ子にしない
+        ConstantSlotShadows shadows;
+        float value[4] = {};
+        shadows.Remember(0, nullptr, value, sizeof(value), true, false);
+        shadows.Remember(3, nullptr, value, sizeof(value), true, true);
+        uint32_t nested = ~0u;
+        uint32_t outer = shadows.RewriteAll(0, [&](uint32_t, const ConstantSlotShadow&)
+        {
+            nested = shadows.RewriteAll(ConstantSlotShadows::kNoSlot, [](uint32_t, const ConstantSlotShadow&) {});
+        });
+        Check(outer == 1 && nested == 0, "skipSlot を除いて書き直し、入れ子の書き直しはしない");
+        Check(!shadows.Remember(6, nullptr, value, sizeof(value), true, false), "b6 以降は覚えない");
+        Check(!shadows.Remember(1, nullptr, value, kConstantBufferAlignment + 16, true, false), "256 バイトを超える値は覚えない");
+    }
+
+    //いろいろなスロットへ何フレームも書き、毎回すべてのスロットが正しい中身を指すことを確かめる
+    void CheckRewriteRandom()
+    {
+        std::printf("--- 乱数でスロットに書き込み\n");
+
+        FakeConstantDevice device(16 * 1024);
+        std::mt19937 rng(777);
+        std::uniform_int_distribution<uint32_t> slotDist(0, ConstantSlotShadows::kSlotCount - 1);
+        std::uniform_int_distribution<uint32_t> sizeDist(16, kConstantBufferAlignment);
+        std::uniform_int_distribution<int> countDist(10, 200);
+
+        bool valid = true;
+        int wraps = 0;
+        uint8_t data[kConstantBufferAlignment];
+        for (int frame = 0; frame < 300; ++frame)
+        {
+            device.BeginFrame();
+            valid = valid && device.AllSlotsValid();
+            int count = countDist(rng);
+            for (int i = 0; i < count; ++i)
+            {
+                uint32_t size = sizeDist(rng) & ~15u;
+                for (uint32_t b = 0; b < size; ++b) { data[b] = static_cast<uint8_t>(rng()); }
+                device.Upload(slotDist(rng), data, size);
+                valid = valid && device.AllSlotsValid();
+            }
+            wraps += static_cast<int>(device.ring.GetFrameWraps());
+        }
+
+        Check(valid, "毎回すべてのスロットが最後に書いた値を指す");
+        Check(wraps > 0, "フレームの途中で先頭に戻る場合も通った");
+        std::printf("      wraps=%d\n", wraps);
+    }
+}
+
+int main()
+{
+    CheckAlign();
+    CheckBasic();
+    CheckWrapAndFrame();
+    CheckRandom();
+    CheckRewriteOnWrap();
+    CheckRewriteRandom();
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
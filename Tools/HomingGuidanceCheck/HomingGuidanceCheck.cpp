@@ -0,0 +1,271 @@
+﻿//------------------------------------------------------------
+// HomingGuidance の一括計算（SolveBatch）を従来の 1 発ずつの計算（SolveScalar）と突き合わせるツール（ウィンドウ・GPU 不要）
+// ・手で答えが分かるケース：止まっている敵へまっすぐ / 旋回制限で曲がり切れない / 横切る敵の迎撃点 / 弾と同じ速さの敵
+// ・4 発に満たない端数（1 〜 7 発）でも、まとめて解いたときと同じ結果になるか
+// ・乱数で作った 100k 発：向きの差が HOMING_VALIDATE と同じ 1e-3 以内か、速度が一致するか、向きが単位ベクトルか
+//   （向き 0・速度 0・敵と同じ速さ・真後ろ・重なっている・旋回制限 0 や π 超えなども混ぜる）
+// 問題があれば 0 以外で終了する
+//
+// ビルド例（開発者コマンドプロンプト）:
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 /I..\..\ShootingGame_0519\DirectXTK\Inc HomingGuidanceCheck.cpp ..\..\ShootingGame_0519\HomingGuidanceSolve.cpp
+//------------------------------------------------------------
+#include "HomingGuidance.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    int g_failures = 0;
+
+    //Solve() の HOMING_VALIDATE と同じ許容誤差
+    constexpr float kTolerance = 1e-3f;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    void Check(bool ok, const char* what, float value)
+    {
+        std::printf("[%s] %s (%g)\n", ok ? " OK " : "FAIL", what, value);
+        if (!ok) { ++g_failures; }
+    }
+
+    HomingOutput SolveOne(const HomingInput& in)
+    {
+        HomingOutput out;
+        HomingGuidance::SolveBatch(&in, &out, 1);
+        return out;
+    }
+
+    float Angle(const Vector3& a, const Vector3& b)
+    {
+        float d = a.Dot(b) / (a.Length() * b.Length());
+        return std::acos(d > 1.0f ? 1.0f : (d < -1.0f ? -1.0f : d));
+    }
+
+    //--------------答えが分かるケース------------------
+    void CheckKnownCases()
+    {
+        std::printf("--- 答えが分かるケース\n");
+
+        //止まっている敵が正面にいる：そのまま向く
+        HomingInput in;
+        in.position = Vector3(0, 0, 0);
+        in.direction = Vector3(0, 0, 1);
+        in.speed = 20.0f;
+        in.targetPosition = Vector3(0, 0, 50);
+        in.maxTurn = 0.1f;
+        HomingOutput out = SolveOne(in);
+        Check((out.direction - Vector3(0, 0, 1)).Length() < 1e-5f, "stationary target ahead");
+        Check(out.speed == 20.0f, "speed is kept");
+
+        //真横の敵へは 1 フレームで maxTurn だけ曲がる（x-z 平面の中で）
+        in.targetPosition = Vector3(50, 0, 0);
+        out = SolveOne(in);
+        Check(std::fabs(Angle(out.direction, in.direction) - 0.1f) < 1e-4f, "turn is limited to maxTurn",
+              Angle(out.direction, in.direction));
+        Check(out.direction.x > 0.0f && std::fabs(out.direction.y) < 1e-5f, "turns toward the target side");
+
+        //旋回制限より小さい角度なら曲がり切る
+        in.targetPosition = Vector3(5, 0, 100);
+        out = SolveOne(in);
+        Vector3 toTarget = in.targetPosition;
+        toTarget.Normalize();
+        Check((out.direction - toTarget).Length() < 1e-5f, "small turn reaches the target direction");
+
+        //x = 30 から -x 方向に速さ 10 で横切る敵、弾は原点から速さ 20。z = 40 の線上
+        //|(30 - 10t, 0, 40)| = 20t -> 300t^2 + 600t - 2500 = 0 -> t = -1 + sqrt(1 + 25/3)
+        in.targetPosition = Vector3(30, 0, 40);
+        in.targetVelocity = Vector3(-10, 0, 0);
+        in.maxTurn = 3.0f;
+        out = SolveOne(in);
+        float t = -1.0f + std::sqrt(1.0f + 25.0f / 3.0f);
+        Vector3 intercept = in.targetPosition + in.targetVelocity * t;
+        intercept.Normalize();
+        Check((out.direction - intercept).Length() < 1e-4f, "leads a crossing target to the intercept point");
+
+        //敵が弾と同じ速さ 20 で近づいてくる：a が丸め誤差だけになるので一次方程式 t = -c / b で解く
+        //正面 z = 40 から (1, 1, -1) 方向に来る -> b = 2 * 40 * (-20 / sqrt(3)), c = 1600
+        in.targetPosition = Vector3(0, 0, 40);
+        in.targetVelocity = Vector3(1, 1, -1) * (20.0f / std::sqrt(3.0f));
+        in.maxTurn = 3.0f;
+        t = 1600.0f / (80.0f * 20.0f / std::sqrt(3.0f));
+        intercept = in.targetPosition + in.targetVelocity * t;
+        intercept.Normalize();
+        out = SolveOne(in);
+        HomingOutput ref;
+        HomingGuidance::SolveScalar(in, ref);
+        Check((out.direction - intercept).Length() < 1e-4f && (ref.direction - intercept).Length() < 1e-4f,
+              "same speed as the target uses the linear intercept");
+
+        //敵の方が速くて追いつけない（判別式 < 0）ときは fallbackTime 後の位置を狙う
+        in.targetPosition = Vector3(0, 0, 40);
+        in.targetVelocity = Vector3(30, 0, 30);
+        in.fallbackTime = 0.5f;
+        out = SolveOne(in);
+        Vector3 fallback = in.targetPosition + in.targetVelocity * 0.5f;
+        fallback.Normalize();
+        Check((out.direction - fallback).Length() < 1e-4f, "unreachable target uses fallbackTime");
+    }
+
+    //--------------乱数で 1 発分を作る------------------
+    HomingInput RandomInput(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+        auto vec = [&](float s) { return Vector3(u(rng) * s, u(rng) * s, u(rng) * s); };
+
+        HomingInput in;
+        in.position = vec(200.0f);
+        in.direction = vec(1.0f);
+        in.speed = u01(rng) * 120.0f;
+        in.targetPosition = vec(200.0f);
+        in.targetVelocity = u01(rng) < 0.7f ? vec(80.0f) : Vector3::Zero;
+        in.aimBias = u01(rng) < 0.5f ? vec(0.5f) : Vector3::Zero;
+        in.maxTurn = u01(rng) * 0.2f;
+        in.fallbackTime = u01(rng) * 2.0f;
+
+        //境界になりやすい入力を混ぜる
+        float kind = u01(rng);
+        if (kind < 0.02f)
+        {
+            in.direction = Vector3::Zero;                                   //向きが無い
+        }
+        else if (kind < 0.04f)
+        {
+            in.speed = 0.0f;                                                //止まっている
+        }
+        else if (kind < 0.06f)
+        {
+            Vector3 v = vec(1.0f);                                          //敵と同じ速さ（一次方程式になる）
+            v.Normalize();
+            in.targetVelocity = v * in.speed;
+        }
+        else if (kind < 0.08f)
+        {
+            Vector3 d = in.direction;                                       //真後ろの止まっている敵
+            d.Normalize();
+            in.targetPosition = in.position - d * 50.0f;
+            in.targetVelocity = Vector3::Zero;
+            in.aimBias = Vector3::Zero;
+        }
+        else if (kind < 0.10f)
+        {
+            in.targetPosition = in.position;                                //敵と重なっている
+        }
+        else if (kind < 0.12f)
+        {
+            in.maxTurn = 0.0f;                                              //曲がれない
+        }
+        else if (kind < 0.14f)
+        {
+            in.maxTurn = 4.0f;                                              //π を超える旋回制限
+        }
+        else if (kind < 0.16f)
+        {
+            in.fallbackTime = 0.0f;                                         //0.001 に切り上げる側
+        }
+        return in;
+    }
+
+    //--------------端数------------------
+    void CheckTail()
+    {
+        std::printf("--- 4 発に満たない端数\n");
+        std::mt19937 rng(7);
+        std::vector<HomingInput> inputs(8);
+        for (HomingInput& in : inputs) { in = RandomInput(rng); }
+
+        std::vector<HomingOutput> all(inputs.size());
+        HomingGuidance::SolveBatch(inputs.data(), all.data(), inputs.size());
+
+        //レーンは互いに独立なので、数を減らしても同じ値になる
+        bool same = true;
+        for (size_t count = 1; count < inputs.size(); ++count)
+        {
+            std::vector<HomingOutput> part(count);
+            HomingGuidance::SolveBatch(inputs.data(), part.data(), count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (part[i].direction.x != all[i].direction.x || part[i].direction.y != all[i].direction.y ||
+                    part[i].direction.z != all[i].direction.z || part[i].speed != all[i].speed)
+                {
+                    same = false;
+                }
+            }
+        }
+        Check(same, "counts 1..7 match the full batch");
+    }
+
+    //--------------乱数 100k 発------------------
+    void CheckRandom()
+    {
+        std::printf("--- 乱数 100k 発を従来の計算と比べる\n");
+        const size_t count = 100003;    //4 で割り切れない数にして端数のレーンも通す
+        std::mt19937 rng(12345);
+        std::vector<HomingInput> inputs(count);
+        for (HomingInput& in : inputs) { in = RandomInput(rng); }
+
+        std::vector<HomingOutput> batch(count);
+        std::vector<HomingOutput> scalar(count);
+
+        auto t0 = std::chrono::steady_clock::now();
+        HomingGuidance::SolveBatch(inputs.data(), batch.data(), count);
+        auto t1 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            HomingGuidance::SolveScalar(inputs[i], scalar[i]);
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        float maxError = 0.0f;
+        size_t worst = 0;
+        size_t overTolerance = 0;
+        size_t speedMismatch = 0;
+        float maxLengthError = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            float err = (batch[i].direction - scalar[i].direction).Length();
+            if (err > maxError) { maxError = err; worst = i; }
+            if (!(err <= kTolerance)) { ++overTolerance; }
+            if (batch[i].speed != scalar[i].speed) { ++speedMismatch; }
+
+            float lengthError = std::fabs(batch[i].direction.Length() - 1.0f);
+            if (!(lengthError <= maxLengthError)) { maxLengthError = lengthError; }
+        }
+
+        Check(overTolerance == 0, "direction within 1e-3 of SolveScalar (max error)", maxError);
+        Check(speedMismatch == 0, "speed matches SolveScalar", static_cast<float>(speedMismatch));
+        Check(maxLengthError < 1e-3f, "direction is unit length (max error)", maxLengthError);
+
+        if (overTolerance > 0)
+        {
+            const HomingInput& w = inputs[worst];
+            std::printf("       worst #%zu: dir (%f %f %f) speed %f target (%f %f %f) vel (%f %f %f) maxTurn %f\n",
+                worst, w.direction.x, w.direction.y, w.direction.z, w.speed,
+                w.targetPosition.x - w.position.x, w.targetPosition.y - w.position.y, w.targetPosition.z - w.position.z,
+                w.targetVelocity.x, w.targetVelocity.y, w.targetVelocity.z, w.maxTurn);
+        }
+
+        std::printf("       SolveBatch %.3f ms / SolveScalar %.3f ms\n",
+            std::chrono::duration<double, std::milli>(t1 - t0).count(),
+            std::chrono::duration<double, std::milli>(t2 - t1).count());
+    }
+}
+
+int main()
+{
+    CheckKnownCases();
+    CheckTail();
+    CheckRandom();
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
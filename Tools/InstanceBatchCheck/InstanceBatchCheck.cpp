@@ -0,0 +1,200 @@
+﻿//------------------------------------------------------------
+// InstanceBatch のグループ分けとインスタンスバッファへの詰め込みを確認するツール（ウィンドウ・GPU 不要）
+// ・モデルと LOD の組ごとに 1 バッチになり、バッチは各組が最初に出てきた順に並ぶか
+// ・バッチ内のインスタンスが Submit された順のまま、連続した位置に詰められるか
+// ・firstInstance / instanceCount がインスタンス配列を隙間なく重なりなく分けているか
+// ・InstanceData の並び（INSTWORLD0～3 が 0/16/32/48、INSTCOLOR が 64 バイト目）が入力レイアウトと合うか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 InstanceBatchCheck.cpp ../../ShootingGame_0519/InstanceBatch.cpp -o InstanceBatchCheck
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 InstanceBatchCheck.cpp ..\..\ShootingGame_0519\InstanceBatch.cpp
+//------------------------------------------------------------
+#include "InstanceBatch.h"
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    //モデルの識別子の代わり（アドレスだけを使う）
+    int g_models[64];
+
+    //何番目の Submit かを行列とカラーに埋め込んだ描画要求
+    InstanceSubmission MakeSubmission(int model, uint32_t lod, int serial)
+    {
+        InstanceSubmission s;
+        s.key = &g_models[model];
+        s.lod = lod;
+        for (int i = 0; i < 16; ++i) { s.data.world[i] = static_cast<float>(serial * 100 + i); }
+        s.data.color[0] = static_cast<float>(serial);
+        s.data.color[1] = static_cast<float>(model);
+        s.data.color[2] = static_cast<float>(lod);
+        s.data.color[3] = 1.0f;
+        return s;
+    }
+
+    //バッチがインスタンス配列を先頭から隙間なく分けているか
+    bool Contiguous(const std::vector<InstanceBatch>& batches, size_t instanceCount)
+    {
+        uint32_t expected = 0;
+        for (const auto& batch : batches)
+        {
+            if (batch.firstInstance != expected || batch.instanceCount == 0) { return false; }
+            expected += batch.instanceCount;
+        }
+        return expected == instanceCount;
+    }
+
+    void CheckLayout()
+    {
+        std::printf("--- InstanceData の並び\n");
+
+        Check(sizeof(InstanceData) == 80, "1 インスタンス 80 バイト（入力レイアウトのストライド）");
+        Check(offsetof(InstanceData, world) == 0, "INSTWORLD0 は 0 バイト目");
+        Check(offsetof(InstanceData, color) == 64, "INSTCOLOR は 64 バイト目");
+
+        //行列は行ごとに 16 バイト（INSTWORLD1～3 は 16/32/48）
+        InstanceData data{};
+        for (int i = 0; i < 16; ++i) { data.world[i] = static_cast<float>(i); }
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&data);
+        bool rows = true;
+        for (int row = 0; row < 4; ++row)
+        {
+            float first = 0.0f;
+            std::memcpy(&first, bytes + row * 16, sizeof(float));
+            rows = rows && first == static_cast<float>(row * 4);
+        }
+        Check(rows, "world の各行が 16 バイトおき（INSTWORLD1～3 は 16/32/48 バイト目）");
+    }
+
+    void CheckGrouping()
+    {
+        std::printf("--- モデルと LOD ごとのまとめ\n");
+
+        std::vector<InstanceBatch> batches;
+        std::vector<InstanceData> instances;
+
+        //前の結果が残っていても、空の入力なら空になる
+        batches.resize(3);
+        instances.resize(5);
+        BuildInstanceBatches({}, batches, instances);
+        Check(batches.empty() && instances.empty(), "描画要求が無ければバッチもインスタンスも空");
+
+        //A0 B0 A0 C0 A1 B0 A0（A/B/C はモデル、数字は LOD）
+        std::vector<InstanceSubmission> submissions =
+        {
+            MakeSubmission(0, 0, 0), MakeSubmission(1, 0, 1), MakeSubmission(0, 0, 2), MakeSubmission(2, 0, 3),
+            MakeSubmission(0, 1, 4), MakeSubmission(1, 0, 5), MakeSubmission(0, 0, 6),
+        };
+        BuildInstanceBatches(submissions, batches, instances);
+
+        Check(batches.size() == 4, "A0 / B0 / C0 / A1 の 4 バッチ");
+        Check(batches.size() == 4 &&
+            batches[0].key == &g_models[0] && batches[0].lod == 0 &&
+            batches[1].key == &g_models[1] && batches[1].lod == 0 &&
+            batches[2].key == &g_models[2] && batches[2].lod == 0 &&
+            batches[3].key == &g_models[0] && batches[3].lod == 1, "バッチは最初に出てきた順（同じモデルでも LOD が違えば別）");
+        Check(batches.size() == 4 &&
+            batches[0].instanceCount == 3 && batches[1].instanceCount == 2 &&
+            batches[2].instanceCount == 1 && batches[3].instanceCount == 1, "バッチごとのインスタンス数");
+        Check(Contiguous(batches, submissions.size()) && instances.size() == submissions.size(), "インスタンス配列を隙間なく分ける");
+
+        //詰めた順：A0(0,2,6) B0(1,5) C0(3) A1(4)
+        const int expectedOrder[] = { 0, 2, 6, 1, 5, 3, 4 };
+        bool order = instances.size() == submissions.size();
+        for (size_t i = 0; order && i < instances.size(); ++i)
+        {
+            order = std::memcmp(&instances[i], &submissions[expectedOrder[i]].data, sizeof(InstanceData)) == 0;
+        }
+        Check(order, "バッチ内は Submit の順で、データはそのままコピーされる");
+
+        //1 種類だけなら 1 バッチ
+        std::vector<InstanceSubmission> single(10);
+        for (int i = 0; i < 10; ++i) { single[i] = MakeSubmission(5, 2, i); }
+        BuildInstanceBatches(single, batches, instances);
+        Check(batches.size() == 1 && batches[0].firstInstance == 0 && batches[0].instanceCount == 10 && batches[0].lod == 2,
+            "同じモデル・LOD だけなら 1 バッチ");
+    }
+
+    //多数の描画要求を、素直な方法で組ごとに分けた結果と比べる
+    void CheckRandom()
+    {
+        std::printf("--- 乱数で描画要求\n");
+
+        std::mt19937 rng(2024);
+        std::uniform_int_distribution<int> modelDist(0, 49);
+        std::uniform_int_distribution<uint32_t> lodDist(0, 3);
+
+        bool contiguous = true;
+        bool firstSeenOrder = true;
+        bool sameInstances = true;
+        bool uniqueKeys = true;
+
+        std::vector<InstanceBatch> batches;
+        std::vector<InstanceData> instances;
+        for (int round = 0; round < 20; ++round)
+        {
+            std::vector<InstanceSubmission> submissions;
+            int count = 1 + static_cast<int>(rng() % 5000);
+            for (int i = 0; i < count; ++i) { submissions.push_back(MakeSubmission(modelDist(rng), lodDist(rng), i)); }
+
+            BuildInstanceBatches(submissions, batches, instances);
+
+            //組 -> Submit の番号（順番どおり）と、組が最初に出てきた順
+            std::map<std::pair<const void*, uint32_t>, std::vector<int>> groups;
+            std::vector<std::pair<const void*, uint32_t>> firstSeen;
+            for (int i = 0; i < count; ++i)
+            {
+                auto key = std::make_pair(submissions[i].key, submissions[i].lod);
+                auto& list = groups[key];
+                if (list.empty()) { firstSeen.push_back(key); }
+                list.push_back(i);
+            }
+
+            contiguous = contiguous && Contiguous(batches, submissions.size()) && instances.size() == submissions.size();
+            uniqueKeys = uniqueKeys && batches.size() == groups.size();
+            for (size_t b = 0; b < batches.size() && b < firstSeen.size(); ++b)
+            {
+                const InstanceBatch& batch = batches[b];
+                firstSeenOrder = firstSeenOrder && batch.key == firstSeen[b].first && batch.lod == firstSeen[b].second;
+
+                const std::vector<int>& list = groups[std::make_pair(batch.key, batch.lod)];
+                if (list.size() != batch.instanceCount) { sameInstances = false; continue; }
+                for (size_t k = 0; k < list.size(); ++k)
+                {
+                    if (std::memcmp(&instances[batch.firstInstance + k], &submissions[list[k]].data, sizeof(InstanceData)) != 0)
+                    {
+                        sameInstances = false;
+                    }
+                }
+            }
+        }
+
+        Check(contiguous, "すべての回でインスタンス配列を隙間なく分ける");
+        Check(uniqueKeys, "モデルと LOD の組ごとにちょうど 1 バッチ");
+        Check(firstSeenOrder, "バッチは組が最初に出てきた順");
+        Check(sameInstances, "各バッチのインスタンスは Submit の順でデータも一致する");
+    }
+}
+
+int main()
+{
+    CheckLayout();
+    CheckGrouping();
+    CheckRandom();
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
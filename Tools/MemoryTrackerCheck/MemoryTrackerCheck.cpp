@@ -0,0 +1,234 @@
+﻿//------------------------------------------------------------
+// MemoryTracker の計測と報告を確認するツール（D3D 不要）
+// ・MemoryScope の中の new がそのカテゴリに数えられ、どこで delete しても元のカテゴリから引かれるか
+// ・new[] / nothrow / 別スレッド（スコープはスレッドごと）の扱い
+// ・テクスチャのバイト数の見積もり（ミップマップ・ブロック圧縮）
+// ・予算を超えたときに 1 回だけ知らせ、下回ったらまた知らせるか
+// ・Title -> Game -> Result -> Title と回したとき、解放漏れが「Uninit 後の残り」と「前回からの増加」に出るか
+// MEMORY_TRACKING=1 でビルドする。問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -DMEMORY_TRACKING=1 -I../../ShootingGame_0519 MemoryTrackerCheck.cpp ../../ShootingGame_0519/MemoryTracker.cpp -o MemoryTrackerCheck -pthread
+//   cl /O2 /EHsc /std:c++20 /DMEMORY_TRACKING=1 /I..\..\ShootingGame_0519 MemoryTrackerCheck.cpp ..\..\ShootingGame_0519\MemoryTracker.cpp
+//------------------------------------------------------------
+#include "MemoryTracker.h"
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    //確保した物をどこからも使わないと、最適化で new / delete ごと消されることがある
+    void* volatile g_sink = nullptr;
+
+    int64_t Cpu(MemoryCategory category) { return MemoryTracker::GetCpuBytes(category); }
+
+    void CheckScopes()
+    {
+        std::printf("--- MemoryScope\n");
+
+        const int64_t before = Cpu(MemoryCategory::Texture);
+        const int64_t blocksBefore = MemoryTracker::GetCpuAllocations(MemoryCategory::Texture);
+
+        char* block = nullptr;
+        {
+            MemoryScope scope(MemoryCategory::Texture);
+            Check(MemoryTracker::GetCurrentCategory() == MemoryCategory::Texture, "スコープの中はそのカテゴリ");
+            block = new char[1000];
+            g_sink = block;
+        }
+        Check(MemoryTracker::GetCurrentCategory() == MemoryCategory::Other, "抜けると元に戻る");
+        Check(Cpu(MemoryCategory::Texture) - before == 1000, "new[] の大きさが数えられる");
+        Check(MemoryTracker::GetCpuAllocations(MemoryCategory::Texture) - blocksBefore == 1, "ブロック数も数えられる");
+
+        //別のカテゴリのスコープで delete しても、確保したカテゴリから引かれる
+        {
+            MemoryScope scope(MemoryCategory::Sound);
+            const int64_t sound = Cpu(MemoryCategory::Sound);
+            delete[] block;
+            Check(Cpu(MemoryCategory::Sound) == sound, "delete したスコープのカテゴリは変わらない");
+        }
+        Check(Cpu(MemoryCategory::Texture) == before, "確保したカテゴリから引かれる");
+
+        //入れ子のスコープ
+        {
+            MemoryScope outer(MemoryCategory::Scene);
+            {
+                MemoryScope inner(MemoryCategory::Model);
+                Check(MemoryTracker::GetCurrentCategory() == MemoryCategory::Model, "内側のスコープが優先");
+            }
+            Check(MemoryTracker::GetCurrentCategory() == MemoryCategory::Scene, "内側を抜けると外側に戻る");
+        }
+
+        //nothrow と、コンテナ経由の確保
+        {
+            const int64_t model = Cpu(MemoryCategory::Model);
+            MemoryScope scope(MemoryCategory::Model);
+            int* p = new (std::nothrow) int[16];
+            std::vector<double> values(128);
+            g_sink = p;
+            g_sink = values.data();
+            Check(Cpu(MemoryCategory::Model) - model == 16 * sizeof(int) + 128 * sizeof(double), "nothrow と vector も数えられる");
+            delete[] p;
+        }
+
+        //スコープはスレッドごと（他のスレッドの確保は Other のまま）
+        {
+            const int64_t effect = Cpu(MemoryCategory::Effect);
+            MemoryScope scope(MemoryCategory::Effect);
+            std::unique_ptr<char[]> fromThread;
+            std::thread worker([&fromThread]() { fromThread.reset(new char[4096]); });
+            worker.join();
+            Check(Cpu(MemoryCategory::Effect) == effect, "別スレッドの new は付かない");
+        }
+    }
+
+    void CheckGpu()
+    {
+        std::printf("--- GPU\n");
+
+        MemoryTracker::AddGpuBytes(MemoryCategory::Texture, 4096);
+        MemoryTracker::AddGpuBytes(MemoryCategory::Texture, -1024);
+        Check(MemoryTracker::GetGpuBytes(MemoryCategory::Texture) == 3072, "GPU は計上した分だけ");
+        MemoryTracker::AddGpuBytes(MemoryCategory::Texture, -3072);
+
+        //256x256 RGBA8 のミップマップ付き = 4 * (65536 + 16384 + ... + 1)
+        Check(MemoryTracker::EstimateTextureBytes(256, 256, 9, 1, 32, false) == 349524, "RGBA8 のミップマップ");
+        Check(MemoryTracker::EstimateTextureBytes(256, 256, 0, 1, 32, false) == 349524, "MipLevels = 0 は 1x1 まで");
+        //BC1（4bpp）はブロック 8 バイト。2x2 と 1x1 も 1 ブロックになる
+        Check(MemoryTracker::EstimateTextureBytes(256, 256, 9, 1, 4, true) == 5463 * 8, "BC1 のミップマップ");
+        Check(MemoryTracker::EstimateTextureBytes(64, 32, 1, 6, 32, false) == 64 * 32 * 4 * 6, "配列の枚数分");
+    }
+
+    void CheckBudgets()
+    {
+        std::printf("--- 予算\n");
+
+        MemoryTracker::Reset();
+        MemoryBudgetAlert alerts[kMemoryCategoryCount * 2];
+
+        const int64_t base = Cpu(MemoryCategory::Scene);
+        MemoryTracker::SetBudget(MemoryCategory::Scene, base + 10000, 0);
+        MemoryTracker::SetBudget(MemoryCategory::Texture, 0, 8192);
+        Check(MemoryTracker::CheckBudgets(alerts) == 0, "予算内なら何もしない");
+
+        std::unique_ptr<char[]> big;
+        {
+            MemoryScope scope(MemoryCategory::Scene);
+            big.reset(new char[20000]);
+        }
+        int n = MemoryTracker::CheckBudgets(alerts);
+        Check(n == 1 && alerts[0].category == MemoryCategory::Scene && !alerts[0].gpu &&
+              alerts[0].bytes == base + 20000 && alerts[0].budget == base + 10000, "超えたら知らせる");
+        Check(MemoryTracker::CheckBudgets(alerts) == 0, "超えている間は繰り返さない");
+
+        big.reset();
+        Check(MemoryTracker::CheckBudgets(alerts) == 0, "下回っても知らせない");
+        {
+            MemoryScope scope(MemoryCategory::Scene);
+            big.reset(new char[20000]);
+        }
+        Check(MemoryTracker::CheckBudgets(alerts) == 1, "一度下回った後にまた超えたら知らせる");
+        big.reset();
+
+        MemoryTracker::AddGpuBytes(MemoryCategory::Texture, 10000);
+        n = MemoryTracker::CheckBudgets(alerts);
+        Check(n == 1 && alerts[0].category == MemoryCategory::Texture && alerts[0].gpu, "GPU の予算");
+        MemoryTracker::AddGpuBytes(MemoryCategory::Texture, -10000);
+        MemoryTracker::Reset();
+    }
+
+    void CheckSceneLoop(const std::filesystem::path& reportPath)
+    {
+        std::printf("--- シーンの一周\n");
+
+        MemoryTracker::Reset();
+        //コンテナ自体の確保はシーンの外で済ませておく
+        std::vector<std::unique_ptr<char[]>> sceneObjects;
+        std::vector<std::unique_ptr<char[]>> leaked;
+        sceneObjects.reserve(8);
+        leaked.reserve(8);
+        std::string report;
+
+        //シーンの Init で確保し、Uninit で解放する（Game は 5000 バイトを解放し忘れる）
+        auto runScene = [&](const std::string& from, const std::string& to, bool leak)
+            {
+                MemorySceneReport change = MemoryTracker::OnSceneChange(from, to);
+                report += change.text;
+                {
+                    MemoryScope scope(MemoryCategory::Scene);
+                    sceneObjects.emplace_back(new char[30000]);
+                    if (leak) { leaked.emplace_back(new char[5000]); }
+                }
+                MemorySceneReport loaded = MemoryTracker::OnSceneLoaded(to);
+                report += loaded.text;
+                sceneObjects.clear();   //次の切り替えの前に Uninit
+                return std::make_pair(change, loaded);
+            };
+
+        auto title = runScene("", "Title", false);
+        Check(!title.first.hasResidual && !title.first.revisit, "最初のシーンは比較するものが無い");
+        Check(title.second.hasLoaded && title.second.loaded.cpuBytes[static_cast<size_t>(MemoryCategory::Scene)] == 30000,
+              "Init で増えた分");
+
+        auto game = runScene("Title", "Game", true);
+        Check(game.first.hasResidual && game.first.residual.cpuBytes[static_cast<size_t>(MemoryCategory::Scene)] == 0,
+              "Title は全部解放している");
+
+        auto result = runScene("Game", "Result", false);
+        Check(result.first.residual.cpuBytes[static_cast<size_t>(MemoryCategory::Scene)] == 5000,
+              "Game の解放漏れが Uninit 後の残りに出る");
+
+        auto title2 = runScene("Result", "Title", false);
+        Check(title2.first.revisit && title2.first.loop.cpuBytes[static_cast<size_t>(MemoryCategory::Scene)] == 5000,
+              "Title に戻ると前回からの増加に出る");
+        Check(title2.first.text.find("since previous visit") != std::string::npos &&
+              title2.first.text.find("Scene") != std::string::npos, "報告にカテゴリが出る");
+
+        auto game2 = runScene("Title", "Game", true);
+        Check(game2.first.revisit && game2.first.loop.cpuBytes[static_cast<size_t>(MemoryCategory::Scene)] == 5000,
+              "2 周目の Game も 1 周分だけ増えている");
+
+        Check(MemoryTracker::AppendReport(report, reportPath), "報告をファイルに書ける");
+        std::error_code ec;
+        Check(std::filesystem::file_size(reportPath, ec) > 0, "ファイルに内容がある");
+        std::printf("%s", title2.first.text.c_str());
+
+        MemoryTracker::Reset();
+    }
+}
+
+int main()
+{
+    if (!MemoryTracker::kHookEnabled)
+    {
+        std::printf("MEMORY_TRACKING=1 でビルドしてください\n");
+        return 1;
+    }
+
+    std::error_code ec;
+    const std::filesystem::path reportPath = std::filesystem::temp_directory_path(ec) / "MemoryTrackerCheck.txt";
+    std::filesystem::remove(reportPath, ec);
+
+    CheckScopes();
+    CheckGpu();
+    CheckBudgets();
+    CheckSceneLoop(reportPath);
+
+    std::filesystem::remove(reportPath, ec);
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
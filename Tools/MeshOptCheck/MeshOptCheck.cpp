@@ -0,0 +1,211 @@
+﻿//------------------------------------------------------------
+// MeshOptimizer の並べ替え結果を確認するツール（ウィンドウ・GPU・Assimp 不要）
+// ・三角形の集合（向きを含む）が並べ替えの前後で変わらないか
+// ・ACMR が並べ替えで下がるか（格子・球・引数で渡した OBJ）
+// ・頂点が最初に使われる順に並び、16bit インデックスに収まるか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 MeshOptCheck.cpp ../../ShootingGame_0519/MeshOptimizer.cpp -o MeshOptCheck
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 MeshOptCheck.cpp ..\..\ShootingGame_0519\MeshOptimizer.cpp
+// 実行例:
+//   ./MeshOptCheck [model.obj ...]     （OBJ は v / f 行だけを読む。多角形は扇形に三角形化）
+//------------------------------------------------------------
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what, float value)
+    {
+        std::printf("[%s] %s (%g)\n", ok ? " OK " : "FAIL", what, value);
+        if (!ok) { ++g_failures; }
+    }
+
+    struct Mesh
+    {
+        std::vector<MeshPosition> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    //n x n マスの格子（三角形の順番はばらばらにする）
+    Mesh MakeGrid(int n, std::mt19937& rng)
+    {
+        Mesh m;
+        for (int y = 0; y <= n; ++y)
+        {
+            for (int x = 0; x <= n; ++x) { m.positions.push_back({ float(x), 0.0f, float(y) }); }
+        }
+        for (int y = 0; y < n; ++y)
+        {
+            for (int x = 0; x < n; ++x)
+            {
+                uint32_t i0 = y * (n + 1) + x;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + (n + 1);
+                uint32_t i3 = i2 + 1;
+                m.indices.insert(m.indices.end(), { i0, i2, i1, i1, i2, i3 });
+            }
+        }
+
+        std::vector<std::array<uint32_t, 3>> tris(m.indices.size() / 3);
+        for (size_t t = 0; t < tris.size(); ++t) { tris[t] = { m.indices[t * 3], m.indices[t * 3 + 1], m.indices[t * 3 + 2] }; }
+        std::shuffle(tris.begin(), tris.end(), rng);
+        m.indices.clear();
+        for (const auto& t : tris) { m.indices.insert(m.indices.end(), t.begin(), t.end()); }
+        return m;
+    }
+
+    //緯度経度の球（ファイル順に近い、帯ごとの並び）
+    Mesh MakeSphere(int rings, int segments)
+    {
+        Mesh m;
+        for (int r = 0; r <= rings; ++r)
+        {
+            float phi = 3.14159265f * r / rings;
+            for (int s = 0; s <= segments; ++s)
+            {
+                float theta = 6.2831853f * s / segments;
+                m.positions.push_back({ std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) });
+            }
+        }
+        for (int r = 0; r < rings; ++r)
+        {
+            for (int s = 0; s < segments; ++s)
+            {
+                uint32_t i0 = r * (segments + 1) + s;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + (segments + 1);
+                uint32_t i3 = i2 + 1;
+                m.indices.insert(m.indices.end(), { i0, i2, i1, i1, i2, i3 });
+            }
+        }
+        return m;
+    }
+
+    bool LoadObj(const char* path, Mesh& m)
+    {
+        std::ifstream file(path);
+        if (!file) { return false; }
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream ss(line);
+            std::string key;
+            ss >> key;
+            if (key == "v")
+            {
+                MeshPosition p;
+                ss >> p.x >> p.y >> p.z;
+                m.positions.push_back(p);
+            }
+            else if (key == "f")
+            {
+                //"1/2/3" の先頭だけを使う（負の番号は末尾から）
+                std::vector<uint32_t> face;
+                std::string token;
+                while (ss >> token)
+                {
+                    long i = std::stol(token.substr(0, token.find('/')));
+                    face.push_back(static_cast<uint32_t>(i < 0 ? long(m.positions.size()) + i : i - 1));
+                }
+                for (size_t k = 1; k + 1 < face.size(); ++k)
+                {
+                    m.indices.insert(m.indices.end(), { face[0], face[k], face[k + 1] });
+                }
+            }
+        }
+        return !m.indices.empty();
+    }
+
+    //位置で表した三角形の集合（頂点の並べ替えに影響されない比較用）。回転して最小の頂点を先頭にする
+    std::vector<std::array<float, 9>> TriangleSet(const Mesh& m)
+    {
+        std::vector<std::array<float, 9>> set;
+        for (size_t t = 0; t + 2 < m.indices.size(); t += 3)
+        {
+            std::array<MeshPosition, 3> p = { m.positions[m.indices[t]], m.positions[m.indices[t + 1]], m.positions[m.indices[t + 2]] };
+            auto less = [](const MeshPosition& a, const MeshPosition& b)
+                {
+                    if (a.x != b.x) { return a.x < b.x; }
+                    if (a.y != b.y) { return a.y < b.y; }
+                    return a.z < b.z;
+                };
+            int first = 0;
+            for (int k = 1; k < 3; ++k) { if (less(p[k], p[first])) { first = k; } }
+
+            std::array<float, 9> key;
+            for (int k = 0; k < 3; ++k)
+            {
+                const MeshPosition& q = p[(first + k) % 3];
+                key[k * 3] = q.x;
+                key[k * 3 + 1] = q.y;
+                key[k * 3 + 2] = q.z;
+            }
+            set.push_back(key);
+        }
+        std::sort(set.begin(), set.end());
+        return set;
+    }
+
+    void Run(const char* name, Mesh mesh, float expectAcmr)
+    {
+        std::printf("--- %s: %zu 頂点 / %zu 三角形\n", name, mesh.positions.size(), mesh.indices.size() / 3);
+
+        auto before = TriangleSet(mesh);
+        std::vector<MeshPosition> vertices = mesh.positions;
+        MeshOptimizeStats stats = OptimizeMesh(mesh.indices, vertices, mesh.positions);
+        mesh.positions = vertices;
+
+        std::printf("    ACMR(FIFO %d) %.3f -> %.3f\n", kMeshCacheSizeFIFO, stats.acmrBefore, stats.acmrAfter);
+        Check(TriangleSet(mesh) == before, "三角形の集合が変わらない", 0.0f);
+        Check(stats.acmrAfter <= stats.acmrBefore, "ACMR が悪化しない", stats.acmrAfter);
+        if (expectAcmr > 0.0f) { Check(stats.acmrAfter <= expectAcmr, "ACMR が目安以下", stats.acmrAfter); }
+
+        //頂点は最初に使われる順に並んでいるはず
+        uint32_t next = 0;
+        bool ordered = true;
+        for (uint32_t i : mesh.indices)
+        {
+            if (i > next) { ordered = false; break; }
+            if (i == next) { ++next; }
+        }
+        Check(ordered, "頂点が最初に使われる順に並ぶ", float(next));
+        Check(stats.index16 == (mesh.positions.size() <= 0xFFFF), "16bit インデックスの判定", float(stats.index16));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::mt19937 rng(42);
+
+    //ばらばらの格子は最適化後 0.7 前後になるはず
+    Run("grid 128x128 (shuffled)", MakeGrid(128, rng), 0.8f);
+    Run("sphere 64x128", MakeSphere(64, 128), 0.8f);
+
+    for (int i = 1; i < argc; ++i)
+    {
+        Mesh mesh;
+        if (!LoadObj(argv[i], mesh))
+        {
+            std::printf("読み込めません: %s\n", argv[i]);
+            ++g_failures;
+            continue;
+        }
+        Run(argv[i], mesh, 0.0f);
+    }
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
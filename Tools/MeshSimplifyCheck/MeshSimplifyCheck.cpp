@@ -0,0 +1,344 @@
+﻿//------------------------------------------------------------
+// MeshSimplifier の LOD 生成と LOD 選択を確認するツール（ウィンドウ・GPU・Assimp 不要）
+// ・各 LOD の三角形数が目標まで減るか、縮約の誤差見積もりが上限内か
+// ・元の頂点から簡略化後の面までの距離（実測の誤差）が上限内か
+// ・閉じたメッシュ（UV の継ぎ目あり）に穴が開かないか、縁のあるメッシュの縁が保たれるか
+// ・画面上の大きさによる LOD 選択が距離に対して単調で、境目の揺れで切り替わり続けないか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 MeshSimplifyCheck.cpp ../../ShootingGame_0519/MeshSimplifier.cpp -o MeshSimplifyCheck
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 MeshSimplifyCheck.cpp ..\..\ShootingGame_0519\MeshSimplifier.cpp
+// 実行例:
+//   ./MeshSimplifyCheck [model.obj ...]     （OBJ は v / f 行だけを読む。多角形は扇形に三角形化）
+//------------------------------------------------------------
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what, float value)
+    {
+        std::printf("[%s] %s (%g)\n", ok ? " OK " : "FAIL", what, value);
+        if (!ok) { ++g_failures; }
+    }
+
+    struct Mesh
+    {
+        std::vector<MeshPosition> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    //緯度経度の球。経度 0 の位置に UV の継ぎ目として頂点が 2 つずつ重なる
+    Mesh MakeSphere(int rings, int segments)
+    {
+        Mesh m;
+        for (int r = 0; r <= rings; ++r)
+        {
+            //極は全頂点がちょうど同じ位置になるようにする
+            float phi = 3.14159265f * r / rings;
+            float sinPhi = (r == 0 || r == rings) ? 0.0f : std::sin(phi);
+            float cosPhi = (r == 0) ? 1.0f : (r == rings) ? -1.0f : std::cos(phi);
+            for (int s = 0; s <= segments; ++s)
+            {
+                float theta = 6.2831853f * (s % segments) / segments;
+                m.positions.push_back({ sinPhi * std::cos(theta), cosPhi, sinPhi * std::sin(theta) });
+            }
+        }
+        for (int r = 0; r < rings; ++r)
+        {
+            for (int s = 0; s < segments; ++s)
+            {
+                uint32_t i0 = r * (segments + 1) + s;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + (segments + 1);
+                uint32_t i3 = i2 + 1;
+                //極の三角形はつぶれるので片方だけ
+                if (r != 0) { m.indices.insert(m.indices.end(), { i0, i1, i2 }); }
+                if (r != rings - 1) { m.indices.insert(m.indices.end(), { i1, i3, i2 }); }
+            }
+        }
+        return m;
+    }
+
+    //なだらかな起伏のある n x n の地形（外周が縁になる）
+    Mesh MakeTerrain(int n)
+    {
+        Mesh m;
+        for (int y = 0; y <= n; ++y)
+        {
+            for (int x = 0; x <= n; ++x)
+            {
+                float fx = float(x) / n, fy = float(y) / n;
+                float h = 0.08f * std::sin(fx * 6.0f) * std::cos(fy * 5.0f);
+                m.positions.push_back({ fx, h, fy });
+            }
+        }
+        for (int y = 0; y < n; ++y)
+        {
+            for (int x = 0; x < n; ++x)
+            {
+                uint32_t i0 = y * (n + 1) + x;
+                uint32_t i1 = i0 + 1;
+                uint32_t i2 = i0 + (n + 1);
+                uint32_t i3 = i2 + 1;
+                m.indices.insert(m.indices.end(), { i0, i2, i1, i1, i2, i3 });
+            }
+        }
+        return m;
+    }
+
+    bool LoadObj(const char* path, Mesh& m)
+    {
+        std::ifstream file(path);
+        if (!file) { return false; }
+
+        std::string line;
+        while (std::getline(file, line))
+        {
+            std::istringstream ss(line);
+            std::string key;
+            ss >> key;
+            if (key == "v")
+            {
+                MeshPosition p;
+                ss >> p.x >> p.y >> p.z;
+                m.positions.push_back(p);
+            }
+            else if (key == "f")
+            {
+                //"1/2/3" の先頭だけを使う（負の番号は末尾から）
+                std::vector<uint32_t> face;
+                std::string token;
+                while (ss >> token)
+                {
+                    long i = std::stol(token.substr(0, token.find('/')));
+                    face.push_back(static_cast<uint32_t>(i < 0 ? long(m.positions.size()) + i : i - 1));
+                }
+                for (size_t k = 1; k + 1 < face.size(); ++k)
+                {
+                    m.indices.insert(m.indices.end(), { face[0], face[k], face[k + 1] });
+                }
+            }
+        }
+        return !m.indices.empty();
+    }
+
+    float Extent(const std::vector<MeshPosition>& p)
+    {
+        MeshPosition mn = p[0], mx = p[0];
+        for (const MeshPosition& q : p)
+        {
+            mn.x = (std::min)(mn.x, q.x); mx.x = (std::max)(mx.x, q.x);
+            mn.y = (std::min)(mn.y, q.y); mx.y = (std::max)(mx.y, q.y);
+            mn.z = (std::min)(mn.z, q.z); mx.z = (std::max)(mx.z, q.z);
+        }
+        return (std::max)({ mx.x - mn.x, mx.y - mn.y, mx.z - mn.z });
+    }
+
+    struct V3
+    {
+        float x, y, z;
+        V3(const MeshPosition& p) : x(p.x), y(p.y), z(p.z) {}
+        V3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+        V3 operator-(const V3& o) const { return V3(x - o.x, y - o.y, z - o.z); }
+        V3 operator+(const V3& o) const { return V3(x + o.x, y + o.y, z + o.z); }
+        V3 operator*(float s) const { return V3(x * s, y * s, z * s); }
+    };
+    float Dot(const V3& a, const V3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    float Length(const V3& a) { return std::sqrt(Dot(a, a)); }
+
+    //点と三角形の距離（Ericson, Real-Time Collision Detection 5.1.5）
+    float PointTriangleDistance(const V3& p, const V3& a, const V3& b, const V3& c)
+    {
+        V3 ab = b - a, ac = c - a, ap = p - a;
+        float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) { return Length(p - a); }
+
+        V3 bp = p - b;
+        float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) { return Length(p - b); }
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) { return Length(p - (a + ab * (d1 / (d1 - d3)))); }
+
+        V3 cp = p - c;
+        float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) { return Length(p - c); }
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) { return Length(p - (a + ac * (d2 / (d2 - d6)))); }
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        {
+            float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            return Length(p - (b + (c - b) * w));
+        }
+
+        float denom = 1.0f / (va + vb + vc);
+        return Length(p - (a + ab * (vb * denom) + ac * (vc * denom)));
+    }
+
+    //元の頂点から簡略化後の面までの最大距離（総当たり）
+    float MeasureDeviation(const Mesh& mesh, const std::vector<uint32_t>& simplified)
+    {
+        std::vector<uint8_t> used(mesh.positions.size(), 0);
+        for (uint32_t i : mesh.indices) { used[i] = 1; }
+
+        float worst = 0.0f;
+        for (size_t v = 0; v < mesh.positions.size(); ++v)
+        {
+            if (!used[v]) { continue; }
+            V3 p(mesh.positions[v]);
+            float best = FLT_MAX;
+            for (size_t t = 0; t + 2 < simplified.size() && best > 0.0f; t += 3)
+            {
+                best = (std::min)(best, PointTriangleDistance(p,
+                    mesh.positions[simplified[t]], mesh.positions[simplified[t + 1]], mesh.positions[simplified[t + 2]]));
+            }
+            worst = (std::max)(worst, best);
+        }
+        return worst;
+    }
+
+    //位置で見た「逆向きの辺がない辺」の数（閉じたメッシュなら 0、縁のあるメッシュなら縁の辺の数）
+    size_t CountOpenEdges(const Mesh& mesh, const std::vector<uint32_t>& indices)
+    {
+        auto key = [&](uint32_t v)
+            {
+                const MeshPosition& p = mesh.positions[v];
+                return std::make_pair(std::make_pair(p.x, p.y), p.z);
+            };
+        std::multiset<std::pair<decltype(key(0)), decltype(key(0))>> edges;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3)
+        {
+            for (int e = 0; e < 3; ++e) { edges.insert({ key(indices[t + e]), key(indices[t + (e + 1) % 3]) }); }
+        }
+
+        size_t open = 0;
+        for (const auto& e : edges)
+        {
+            if (edges.find({ e.second, e.first }) == edges.end()) { ++open; }
+        }
+        return open;
+    }
+
+    void Run(const char* name, const Mesh& mesh, bool expectTarget)
+    {
+        std::printf("--- %s: %zu 頂点 / %zu 三角形\n", name, mesh.positions.size(), mesh.indices.size() / 3);
+
+        const float extent = Extent(mesh.positions);
+        const size_t openBefore = CountOpenEdges(mesh, mesh.indices);
+
+        //ModelComponent の読み込みと同じ流れで LOD を作る
+        std::vector<MeshSimplifyResult> lods = BuildMeshLods(mesh.indices, mesh.positions);
+        for (size_t lod = 1; lod < lods.size(); ++lod)
+        {
+            const MeshSimplifyResult& r = lods[lod];
+            size_t target = static_cast<size_t>(mesh.indices.size() / 3 * kLodTriangleRatio[lod]) * 3;
+
+            float deviation = MeasureDeviation(mesh, r.indices) / extent;
+            std::printf("    LOD%zu: %zu 三角形 (目標 %zu) 見積もり誤差 %.4f 実測 %.4f\n",
+                lod, r.indices.size() / 3, target / 3, r.error, deviation);
+
+            bool valid = true;
+            for (uint32_t i : r.indices) { if (i >= mesh.positions.size()) { valid = false; } }
+            Check(valid && r.indices.size() % 3 == 0, "インデックスが範囲内", float(r.indices.size()));
+            Check(r.error <= kLodMaxError[lod], "見積もり誤差が上限以下", r.error);
+
+            //見積もりは平面までの距離の平均なので、実測の最大値は上限の 2 倍まで許す
+            Check(deviation <= kLodMaxError[lod] * 2.0f, "実測の誤差が上限の 2 倍以下", deviation);
+            Check(CountOpenEdges(mesh, r.indices) <= openBefore, "穴が開かない", float(CountOpenEdges(mesh, r.indices)));
+            if (expectTarget)
+            {
+                Check(r.indices.size() <= target, "三角形数が目標まで減る", float(r.indices.size() / 3));
+            }
+        }
+        if (expectTarget)
+        {
+            Check(lods.size() == kMaxMeshLods, "LOD をすべて作る", float(lods.size()));
+        }
+    }
+
+    void CheckSelection()
+    {
+        std::printf("--- LOD 選択\n");
+
+        const float radius = 10.0f;
+        const float projScaleY = 1.0f / std::tan(3.14159265f / 6.0f);   //縦の画角 60 度
+
+        //遠ざかるときは LOD が単調に粗くなり、近づくときは単調に細かくなる
+        int lod = 0;
+        bool monotonic = true;
+        int reached = 0;
+        for (float d = 5.0f; d <= 1000.0f; d += 1.0f)
+        {
+            int next = SelectLod(ComputeScreenSize(radius, d, projScaleY), lod, kMaxMeshLods);
+            if (next < lod) { monotonic = false; }
+            lod = next;
+            reached = (std::max)(reached, lod);
+        }
+        Check(monotonic, "遠ざかると LOD が粗くなる一方", float(lod));
+        Check(reached == kMaxMeshLods - 1, "最も遠い LOD まで使う", float(reached));
+
+        for (float d = 1000.0f; d >= 5.0f; d -= 1.0f)
+        {
+            int next = SelectLod(ComputeScreenSize(radius, d, projScaleY), lod, kMaxMeshLods);
+            if (next > lod) { monotonic = false; }
+            lod = next;
+        }
+        Check(monotonic && lod == 0, "近づくと LOD0 まで戻る", float(lod));
+
+        //境目の上下 ±5% で揺れても切り替わらない
+        LodSelectSettings settings;
+        int switches = 0;
+        lod = SelectLod(settings.screenSize[0] * 1.05f, 0, kMaxMeshLods);
+        for (int i = 0; i < 100; ++i)
+        {
+            float size = settings.screenSize[0] * ((i & 1) ? 0.95f : 1.05f);
+            int next = SelectLod(size, lod, kMaxMeshLods);
+            if (next != lod) { ++switches; }
+            lod = next;
+        }
+        Check(switches == 0, "境目付近の揺れで切り替わらない", float(switches));
+
+        //使える LOD が少ないメッシュでは範囲内に収める
+        Check(SelectLod(0.0001f, 0, 2) == 1, "LOD 数で上限を抑える", float(SelectLod(0.0001f, 0, 2)));
+        Check(SelectLod(0.0001f, 3, 1) == 0, "LOD が 1 つなら常に 0", float(SelectLod(0.0001f, 3, 1)));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Run("sphere 32x64 (UV seam)", MakeSphere(32, 64), true);
+    Run("terrain 48x48 (border)", MakeTerrain(48), true);
+
+    for (int i = 1; i < argc; ++i)
+    {
+        Mesh mesh;
+        if (!LoadObj(argv[i], mesh))
+        {
+            std::printf("読み込めません: %s\n", argv[i]);
+            ++g_failures;
+            continue;
+        }
+        Run(argv[i], mesh, false);
+    }
+
+    CheckSelection();
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
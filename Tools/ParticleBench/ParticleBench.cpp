@@ -0,0 +1,59 @@
+﻿//------------------------------------------------------------
+// パーティクルのシミュレーションだけを計測するベンチマーク（ウィンドウ・GPU 不要）
+//
+// ビルド例（開発者コマンドプロンプト）:
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 ParticleBench.cpp ..\..\ShootingGame_0519\ParticleSystem.cpp
+// 実行例:
+//   ParticleBench.exe [粒数=50000] [フレーム数=600]
+//------------------------------------------------------------
+#include "ParticleSystem.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv)
+{
+    size_t particleCount = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 50000;
+    int frames = (argc > 2) ? std::atoi(argv[2]) : 600;
+    const float dt = 1.0f / 60.0f;
+
+    ParticleBuffer buffer(particleCount, 9);
+    buffer.SetDrag(3.0f);
+
+    //爆発 1 回分（中心 + 火花）を、粒数が一定に保たれるように毎フレーム補充する
+    ParticleEmitParams params;
+    params.speedMin = 15.0f;
+    params.speedMax = 35.0f;
+    params.lifeMin = 0.25f;
+    params.lifeMax = 0.45f;
+    params.sizeStart = 8.0f;
+    params.sizeEnd = 2.0f;
+
+    using Clock = std::chrono::steady_clock;
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    size_t totalParticles = 0;
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        params.count = static_cast<int>(particleCount - buffer.GetCount());
+        buffer.Emit(params);
+        totalParticles += buffer.GetCount();
+
+        auto begin = Clock::now();
+        buffer.Update(dt);
+        auto end = Clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(end - begin).count();
+        totalMs += ms;
+        if (ms > worstMs) { worstMs = ms; }
+    }
+
+    double avgMs = totalMs / frames;
+    double avgParticles = static_cast<double>(totalParticles) / frames;
+    std::printf("particles(avg) : %.0f\n", avgParticles);
+    std::printf("update avg     : %.4f ms\n", avgMs);
+    std::printf("update worst   : %.4f ms\n", worstMs);
+    std::printf("ns / particle  : %.2f\n", avgMs * 1.0e6 / avgParticles);
+    return 0;
+}
@@ -0,0 +1,188 @@
+﻿//------------------------------------------------------------
+// ResidencyCache（TextureManager / ModelComponent のキャッシュ）を確認するツール（D3D 不要）
+// ・ハンドルを持っている間は、予算を超えても捨てられないか
+// ・予算内なら使われていないものも残り、次のシーンで取り直すとキャッシュヒットになるか
+// ・予算を超えたら、使われなくなったのが古い順に、予算に収まるまでだけ捨てるか
+// ・捨てたときのコールバック（MemoryTracker からの差し引き）と統計
+// ・Title -> Game -> Result -> Title と回しても、常駐量が予算と使用中の分を超えて増えないか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 ResidencyCacheCheck.cpp -o ResidencyCacheCheck
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 ResidencyCacheCheck.cpp
+//------------------------------------------------------------
+#include "ResidencyCache.h"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    //読み込んだアセットの代わり
+    struct Asset
+    {
+        std::string name;
+    };
+
+    using Cache = ResidencyCache<Asset>;
+
+    //キャッシュに無ければ「読み込む」（TextureManager::Load と同じ流れ）
+    Cache::Handle Load(Cache& cache, const std::string& name, size_t bytes, int* loads = nullptr)
+    {
+        if (Cache::Handle cached = cache.Find(name)) { return cached; }
+        if (loads) { ++*loads; }
+        Cache::Handle handle = std::make_shared<Asset>(Asset{ name });
+        cache.Insert(name, handle, bytes);
+        return handle;
+    }
+
+    void CheckBasic()
+    {
+        std::printf("--- Find / Insert\n");
+
+        Cache cache;
+        Check(!cache.Find("a") && cache.GetMisses() == 1, "無いものは nullptr");
+
+        Cache::Handle a = Load(cache, "a", 100);
+        Cache::Handle again = cache.Find("a");
+        Check(again == a && cache.GetHits() == 1, "読み込み済みは同じハンドル");
+        Check(cache.GetCount() == 1 && cache.GetResidentBytes() == 100, "常駐バイト数");
+        Check(cache.GetUnusedBytes() == 0, "ハンドルがあれば使用中");
+
+        a.reset();
+        again.reset();
+        Check(cache.GetUnusedBytes() == 100, "ハンドルを全部手放すと未使用");
+
+        cache.SetBudget(0);
+        Check(cache.Trim() == 0 && cache.GetCount() == 1, "予算なしなら捨てない");
+    }
+
+    void CheckBudget()
+    {
+        std::printf("--- 予算と LRU\n");
+
+        std::vector<std::string> evicted;
+        size_t evictedBytes = 0;
+        Cache cache([&](const std::string& key, const Asset& asset, size_t bytes)
+            {
+                evicted.push_back(key);
+                evictedBytes += bytes;
+                (void)asset;
+            });
+        cache.SetBudget(250);
+
+        Cache::Handle a = Load(cache, "a", 100);
+        Cache::Handle b = Load(cache, "b", 100);
+        Cache::Handle c = Load(cache, "c", 100);
+        Check(cache.Trim() == 0 && evicted.empty(), "使用中なら予算を超えても捨てない");
+
+        //b だけ手放す（a と c は使用中）
+        b.reset();
+        cache.Trim();
+        Check(evicted.size() == 1 && evicted[0] == "b", "超えた分だけ、使われていないものを捨てる");
+        Check(cache.GetResidentBytes() == 200 && evictedBytes == 100, "捨てた分が常駐から引かれる");
+
+        Cache::Handle d = Load(cache, "d", 100);
+        a.reset();
+        d.reset();
+        evicted.clear();
+        cache.Trim();
+        Check(evicted.size() == 1 && evicted[0] == "a", "古い方（a）から捨て、予算に収まったら止める");
+        Check(cache.GetResidentBytes() == 200 && cache.Find("d"), "新しい方（d）は残る");
+
+        //Trim の時点で使用中だったものは、その時点で使われたことにする
+        Cache lru;
+        lru.SetBudget(250);
+        Cache::Handle x = Load(lru, "x", 100);
+        Cache::Handle y = Load(lru, "y", 100);
+        y.reset();
+        lru.Trim();             //予算内なので捨てない（x は使用中なので y より新しくなる）
+        x.reset();
+        Cache::Handle z = Load(lru, "z", 100);
+        lru.Trim();             //x は y より先に読み込んだが、y より後まで使われていた
+        Check(!lru.Find("y") && lru.Find("x"), "使われなくなった時刻に近い順で捨てる");
+
+        Cache purge;
+        purge.SetBudget(1000);
+        Cache::Handle keep = Load(purge, "keep", 10);
+        Load(purge, "drop1", 10);
+        Load(purge, "drop2", 10);
+        Check(purge.Purge() == 20 && purge.GetCount() == 1, "Purge は使われていないものを全部捨てる");
+
+        purge.Clear();
+        Check(purge.GetCount() == 0 && keep && keep->name == "keep", "Clear の後も持っているハンドルは使える");
+    }
+
+    //シーンごとに使うアセット（名前 -> バイト数）
+    using SceneAssets = std::map<std::string, size_t>;
+
+    void CheckSceneLoop()
+    {
+        std::printf("--- シーンの一周\n");
+
+        Cache cache;
+        const size_t budget = 6000;
+        cache.SetBudget(budget);
+
+        //プレイヤーの機体は Title と Game の両方で使う
+        const std::map<std::string, SceneAssets> scenes =
+        {
+            { "Title",  { { "Fighterjet", 2000 }, { "SkyDome_03", 3000 }, { "TitleLogo", 500 } } },
+            { "Game",   { { "Fighterjet", 2000 }, { "SkyDome_01", 3000 }, { "Enemy", 1500 }, { "minimap", 200 } } },
+            { "Result", { { "ResultBackGround", 4000 } } },
+        };
+        const char* loop[] = { "Title", "Game", "Result", "Title", "Game", "Result", "Title", "Game" };
+
+        std::vector<Cache::Handle> held;    //今のシーンが持っているハンドル
+        int loads = 0;
+        int jetLoads = 0;
+        size_t maxResident = 0;
+        bool withinBound = true;
+
+        for (const char* name : loop)
+        {
+            //SceneManager と同じ順: 前のシーンの Uninit -> 次のシーンの Init -> Trim
+            held.clear();
+            size_t inUse = 0;
+            for (const auto& asset : scenes.at(name))
+            {
+                int before = loads;
+                held.push_back(Load(cache, asset.first, asset.second, &loads));
+                if (asset.first == "Fighterjet" && loads != before) { ++jetLoads; }
+                inUse += asset.second;
+            }
+            cache.Trim();
+
+            maxResident = (std::max)(maxResident, cache.GetResidentBytes());
+            //使っている分が予算より大きいシーンでも、使われていない分は残さない
+            withinBound = withinBound && cache.GetResidentBytes() <= (std::max)(budget, inUse);
+        }
+
+        Check(jetLoads == 1, "Title と Game で共通の機体は最初の 1 回だけ読み込む");
+        Check(withinBound, "常駐は予算（使用中が予算より多ければ使用中の分）まで");
+        Check(cache.GetEvictions() > 0, "予算を超えた分は捨てられている");
+        Check(loads < 8 * 3, "一周目の後もキャッシュヒットがある");
+        std::printf("      loads=%d hits=%llu evictions=%llu maxResident=%zu\n", loads,
+            static_cast<unsigned long long>(cache.GetHits()), static_cast<unsigned long long>(cache.GetEvictions()), maxResident);
+    }
+}
+
+int main()
+{
+    CheckBasic();
+    CheckBudget();
+    CheckSceneLoop();
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
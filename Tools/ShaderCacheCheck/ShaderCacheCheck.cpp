@@ -0,0 +1,210 @@
+﻿//------------------------------------------------------------
+// ShaderCache のキー計算とキャッシュの読み書きを確認するツール（D3D 不要）
+// ・同じ入力なら同じキー、ソース / #include 先 / エントリポイント / プロファイル / マクロ / フラグ /
+//   コンパイラのどれかが変われば別のキーになるか
+// ・#include 先が読めないときは空のキー（キャッシュを使わずにコンパイルする）になるか
+// ・保存したバイトコードが読み戻せ、壊れたファイルはミス扱いになるか
+// ・ソースを書き換えて保存し直すと古い .cso が消え、index.txt が読み直しても残るか
+// 一時ディレクトリの下に作業用のファイルを作り、最後に消す。問題があれば 0 以外で終了する
+//
+// ビルド例:
+//   g++ -O2 -std=c++17 -I../../ShootingGame_0519 ShaderCacheCheck.cpp ../../ShootingGame_0519/ShaderCache.cpp -o ShaderCacheCheck
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 ShaderCacheCheck.cpp ..\..\ShootingGame_0519\ShaderCache.cpp
+//------------------------------------------------------------
+#include "ShaderCache.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    void WriteText(const fs::path& path, const std::string& text)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    //DXBC で始まるだけの偽のバイトコード
+    std::vector<uint8_t> FakeBytecode(uint8_t fill, size_t size)
+    {
+        std::vector<uint8_t> bytes(size, fill);
+        bytes[0] = 'D'; bytes[1] = 'X'; bytes[2] = 'B'; bytes[3] = 'C';
+        return bytes;
+    }
+
+    void CheckHash()
+    {
+        std::printf("--- HashShaderBytes\n");
+
+        //FNV-1a 64bit の既知の値
+        Check(HashShaderBytes("", 0) == 0xcbf29ce484222325ull, "空文字列のハッシュ");
+        Check(HashShaderBytes("a", 1) == 0xaf63dc4c8601ec8cull, "\"a\" のハッシュ");
+        Check(HashShaderBytes("foobar", 6) == 0x85944171f73967e8ull, "\"foobar\" のハッシュ");
+
+        //続けて計算しても一度に計算しても同じ
+        uint64_t split = HashShaderBytes("bar", 3, HashShaderBytes("foo", 3));
+        Check(split == HashShaderBytes("foobar", 6), "分けて計算しても同じ値");
+    }
+
+    void CheckKeys(const fs::path& dir)
+    {
+        std::printf("--- ComputeKey\n");
+
+        WriteText(dir / "Common.hlsli", "float4 Tint;\n");
+        WriteText(dir / "Shader.hlsl", "#include \"Common.hlsli\"\nfloat4 VSMain() : SV_POSITION { return Tint; }\n");
+
+        ShaderCacheKeyDesc base;
+        base.sourcePath = dir / "Shader.hlsl";
+        base.entryPoint = "VSMain";
+        base.profile = "vs_5_0";
+        base.defines = { { "USE_FOG", "1" } };
+        base.compileFlags = 0x800;
+        base.compilerVersion = 47;
+
+        const std::string key = ShaderCache::ComputeKey(base);
+        Check(key.size() == 16, "キーは 16 桁の 16 進数");
+        Check(ShaderCache::ComputeKey(base) == key, "同じ入力なら同じキー");
+
+        auto differs = [&](ShaderCacheKeyDesc desc, const char* what)
+            {
+                Check(ShaderCache::ComputeKey(desc) != key, what);
+            };
+
+        ShaderCacheKeyDesc d = base;
+        d.entryPoint = "PSMain";
+        differs(d, "エントリポイントが違えば別のキー");
+
+        d = base;
+        d.profile = "vs_4_0";
+        differs(d, "プロファイルが違えば別のキー");
+
+        d = base;
+        d.defines[0].second = "0";
+        differs(d, "マクロの値が違えば別のキー");
+
+        d = base;
+        d.defines.clear();
+        differs(d, "マクロが無ければ別のキー");
+
+        d = base;
+        d.defines = { { "USE_FO", "G1" } };
+        differs(d, "マクロの名前と値の区切りを区別する");
+
+        d = base;
+        d.compileFlags = 0x801;
+        differs(d, "フラグが違えば別のキー");
+
+        d = base;
+        d.compilerVersion = 48;
+        differs(d, "コンパイラが違えば別のキー");
+
+        //#include 先だけを書き換えてもキーが変わる
+        WriteText(dir / "Common.hlsli", "float4 Tint;\nfloat4 Fog;\n");
+        Check(ShaderCache::ComputeKey(base) != key, "#include 先が変われば別のキー");
+
+        WriteText(dir / "Shader.hlsl", "#include \"Common.hlsli\"\nfloat4 VSMain() : SV_POSITION { return Tint * 2; }\n");
+        std::string changed = ShaderCache::ComputeKey(base);
+        Check(!changed.empty() && changed != key, "ソースが変われば別のキー");
+
+        //互いに #include しあっていても止まる
+        WriteText(dir / "LoopA.hlsli", "#include \"LoopB.hlsli\"\n");
+        WriteText(dir / "LoopB.hlsli", "  #include <LoopA.hlsli>\n");
+        d = base;
+        d.sourcePath = dir / "LoopA.hlsli";
+        Check(!ShaderCache::ComputeKey(d).empty(), "循環する #include でも計算できる");
+
+        //#include 先が無い・ソースが無い
+        WriteText(dir / "Broken.hlsl", "#include \"Missing.hlsli\"\n");
+        d.sourcePath = dir / "Broken.hlsl";
+        Check(ShaderCache::ComputeKey(d).empty(), "#include 先が無ければ空のキー");
+        d.sourcePath = dir / "NotFound.hlsl";
+        Check(ShaderCache::ComputeKey(d).empty(), "ソースが無ければ空のキー");
+    }
+
+    void CheckStore(const fs::path& dir)
+    {
+        std::printf("--- Load / Store\n");
+
+        const fs::path cacheDir = dir / "cache";
+        ShaderCache::Init(cacheDir);
+
+        WriteText(dir / "Store.hlsl", "float4 PSMain() : SV_TARGET { return 1; }\n");
+        ShaderCacheKeyDesc desc;
+        desc.sourcePath = dir / "Store.hlsl";
+        desc.entryPoint = "PSMain";
+        desc.profile = "ps_5_0";
+
+        std::string key1 = ShaderCache::ComputeKey(desc);
+        std::vector<uint8_t> loaded;
+        Check(!ShaderCache::Load(key1, loaded) && ShaderCache::GetMissCount() == 1, "初回はミス");
+
+        std::vector<uint8_t> blob1 = FakeBytecode(0x11, 64);
+        Check(ShaderCache::Store(desc, key1, blob1.data(), blob1.size()), "保存できる");
+        Check(ShaderCache::Load(key1, loaded) && loaded == blob1 && ShaderCache::GetHitCount() == 1, "保存した内容を読み戻せる");
+
+        //ソースを書き換えて保存し直すと、古い .cso は消える
+        WriteText(dir / "Store.hlsl", "float4 PSMain() : SV_TARGET { return 0.5; }\n");
+        std::string key2 = ShaderCache::ComputeKey(desc);
+        std::vector<uint8_t> blob2 = FakeBytecode(0x22, 80);
+        Check(key2 != key1 && ShaderCache::Store(desc, key2, blob2.data(), blob2.size()), "新しいキーで保存できる");
+        Check(!fs::exists(cacheDir / (key1 + ".cso")), "古いキャッシュが消える");
+
+        //フラグ違い（Debug / Release）は別のシェーダーとして両方残る
+        ShaderCacheKeyDesc debugDesc = desc;
+        debugDesc.compileFlags = 0x5;
+        std::string debugKey = ShaderCache::ComputeKey(debugDesc);
+        std::vector<uint8_t> blob3 = FakeBytecode(0x33, 48);
+        ShaderCache::Store(debugDesc, debugKey, blob3.data(), blob3.size());
+        Check(fs::exists(cacheDir / (key2 + ".cso")) && fs::exists(cacheDir / (debugKey + ".cso")), "フラグ違いは両方残る");
+
+        //読み直しても index が残っていて、次の更新で古いものが消える
+        ShaderCache::Init(cacheDir);
+        Check(ShaderCache::Load(key2, loaded) && loaded == blob2, "Init し直しても読める");
+        WriteText(dir / "Store.hlsl", "float4 PSMain() : SV_TARGET { return 0.25; }\n");
+        std::string key3 = ShaderCache::ComputeKey(desc);
+        ShaderCache::Store(desc, key3, blob1.data(), blob1.size());
+        Check(!fs::exists(cacheDir / (key2 + ".cso")), "index.txt から前のキーを引いて消せる");
+
+        //DXBC でないファイルは使わない
+        WriteText(cacheDir / (key3 + ".cso"), "garbage");
+        Check(!ShaderCache::Load(key3, loaded) && loaded.empty(), "壊れたファイルはミス扱い");
+        Check(!ShaderCache::Load("", loaded), "空のキーはミス扱い");
+
+        //一時ファイルが残っていない
+        bool noTemp = true;
+        for (const auto& entry : fs::directory_iterator(cacheDir))
+        {
+            if (entry.path().extension() == ".tmp") { noTemp = false; }
+        }
+        Check(noTemp, "一時ファイルが残らない");
+    }
+}
+
+int main()
+{
+    std::error_code ec;
+    const fs::path dir = fs::temp_directory_path(ec) / "ShaderCacheCheck";
+    fs::remove_all(dir, ec);
+    fs::create_directories(dir, ec);
+
+    CheckHash();
+    CheckKeys(dir);
+    CheckStore(dir);
+
+    fs::remove_all(dir, ec);
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
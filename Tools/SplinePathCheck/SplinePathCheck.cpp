@@ -0,0 +1,124 @@
+﻿//------------------------------------------------------------
+// SplinePath の焼き込み結果を確認するツール（ウィンドウ・GPU 不要）
+// ・表から引いた位置がウェイポイントを通っているか
+// ・表の点の間隔、一定の道のりずつ進めたときの速度のばらつき（0.5% 以内）
+// ・ループしない経路が終点で止まるか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例（開発者コマンドプロンプト）:
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 SplinePathCheck.cpp ..\..\ShootingGame_0519\SplinePath.cpp
+//------------------------------------------------------------
+#include "SplinePath.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what, float value)
+    {
+        std::printf("[%s] %s (%f)\n", ok ? " OK " : "FAIL", what, value);
+        if (!ok) { ++g_failures; }
+    }
+
+    //経路上で点 p に一番近い距離（表を細かく走査する）
+    float DistanceToPath(const SplinePath& path, const XMFLOAT3& p)
+    {
+        float best = 1e30f;
+        XMFLOAT3 pos, dir;
+        size_t seg;
+        for (float s = 0.0f; s <= path.GetLength(); s += 0.05f)
+        {
+            path.Evaluate(s, pos, dir, seg);
+            float d = std::hypot(pos.x - p.x, pos.z - p.z);
+            if (d < best) { best = d; }
+        }
+        return best;
+    }
+}
+
+int main()
+{
+    //GameScene で使っている巡回ルートに近い形
+    std::vector<XMFLOAT3> points =
+    {
+        {   0.0f, 0.0f,   0.0f },
+        { 100.0f, 0.0f,   0.0f },
+        { 100.0f, 0.0f,  80.0f },
+        { -20.0f, 0.0f, 120.0f },
+        { -60.0f, 0.0f,  30.0f },
+    };
+
+    //--------------ループする経路------------------
+    auto loop = SplinePath::Bake(points, true);
+    std::printf("loop: length=%f samples=%zu\n", loop->GetLength(), loop->GetSampleCount());
+
+    float worst = 0.0f;
+    for (const XMFLOAT3& p : points)
+    {
+        float d = DistanceToPath(*loop, p);
+        if (d > worst) { worst = d; }
+    }
+    Check(worst < 0.05f, "waypoints lie on the baked path", worst);
+
+    //表の点どうしの間隔（表の点ちょうどの道のりで引き、隣との距離を比べる）
+    XMFLOAT3 prev, pos, dir;
+    size_t seg;
+    size_t sampleCount = loop->GetSampleCount();
+    float step = loop->GetLength() / static_cast<float>(sampleCount - 1);
+    float minGap = 1e30f;
+    float maxGap = 0.0f;
+    loop->Evaluate(0.0f, prev, dir, seg);
+    for (size_t n = 1; n < sampleCount; ++n)
+    {
+        loop->Evaluate(step * static_cast<float>(n), pos, dir, seg);
+        float gap = std::hypot(pos.x - prev.x, pos.z - prev.z) / step;
+        if (gap < minGap) { minGap = gap; }
+        if (gap > maxGap) { maxGap = gap; }
+        prev = pos;
+    }
+    Check(minGap > 0.995f, "minimum sample spacing within 0.5%", minGap);
+    Check(maxGap < 1.005f, "maximum sample spacing within 0.5%", maxGap);
+
+    //60fps・速度 65 で 2 周ぶん進め、1 フレームの移動量を見る
+    const float dt = 1.0f / 60.0f;
+    const float speed = 65.0f;
+    float s = 0.0f;
+    loop->Evaluate(s, prev, dir, seg);
+
+    float minSpeed = 1e30f;
+    float maxSpeed = 0.0f;
+    int frames = static_cast<int>(2.0f * loop->GetLength() / (speed * dt));
+    for (int i = 0; i < frames; ++i)
+    {
+        s = loop->Wrap(s + speed * dt);
+        loop->Evaluate(s, pos, dir, seg);
+
+        //一周をまたぐフレームも終点 = 始点なので同じように測れる
+        float v = std::hypot(pos.x - prev.x, pos.z - prev.z) / dt;
+        if (v < minSpeed) { minSpeed = v; }
+        if (v > maxSpeed) { maxSpeed = v; }
+        prev = pos;
+    }
+    Check(minSpeed > speed * 0.995f, "minimum per-frame speed within 0.5%", minSpeed);
+    Check(maxSpeed < speed * 1.005f, "maximum per-frame speed within 0.5%", maxSpeed);
+
+    //--------------ループしない経路------------------
+    auto once = SplinePath::Bake(points, false);
+    once->Evaluate(once->Wrap(once->GetLength() * 10.0f), pos, dir, seg);
+    float endError = std::hypot(pos.x - points.back().x, pos.z - points.back().z);
+    Check(endError < 1e-3f, "open path stops at the last waypoint", endError);
+    Check(seg == points.size() - 2, "open path ends on the last segment", static_cast<float>(seg));
+
+    //--------------長さが無い経路------------------
+    auto single = SplinePath::Bake({ { 3.0f, 0.0f, 4.0f } }, true);
+    single->Evaluate(single->Wrap(10.0f), pos, dir, seg);
+    Check(pos.x == 3.0f && pos.z == 4.0f, "single point path stays put", single->GetLength());
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+﻿//------------------------------------------------------------
+// SweptCollision.h の連続衝突判定を確認するツール（ウィンドウ・GPU 不要）
+// 各ケースは手で解いた最初に触れる時刻 t と比べる
+// ・球 vs 球：正面から / かすめる / 届かない / 離れていく
+// ・球 vs AABB：面に正面から / 辺の丸まった部分 / 角の丸まった部分 / 角をかすめて外れる
+// ・球 vs OBB：Y 軸まわりに 45 度回した箱の縦の辺 / 回した面に正面から
+// ・移動開始時点で重なっている（t = 0）
+// ・1 フレームで 30 進む弾が薄い壁・小さい敵を通り抜けない（始点と終点だけの判定では外れるケース）
+// 問題があれば 0 以外で終了する
+//
+// ビルド例（開発者コマンドプロンプト）:
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 /I..\..\ShootingGame_0519\DirectXTK\Inc SweptCollisionCheck.cpp
+//------------------------------------------------------------
+#include "SweptCollision.h"
+#include <cmath>
+#include <cstdio>
+
+using DirectX::SimpleMath::Vector3;
+
+namespace
+{
+    int g_failures = 0;
+
+    //解析解との許容誤差（AABB の辺・角は二分探索なのでその精度も込み）
+    constexpr float kTolerance = 1e-4f;
+
+    void Check(bool ok, const char* what)
+    {
+        std::printf("[%s] %s\n", ok ? " OK " : "FAIL", what);
+        if (!ok) { ++g_failures; }
+    }
+
+    //当たって、t が期待値と一致するか
+    void CheckHit(bool hit, float t, float expected, const char* what)
+    {
+        bool ok = hit && std::fabs(t - expected) <= kTolerance;
+        std::printf("[%s] %s (t = %f, 期待値 %f)\n", ok ? " OK " : "FAIL", what, hit ? t : -1.0f, expected);
+        if (!ok) { ++g_failures; }
+    }
+
+    //当たらないか
+    void CheckMiss(bool hit, float t, const char* what)
+    {
+        std::printf("[%s] %s%s\n", !hit ? " OK " : "FAIL", what, hit ? " (当たった)" : "");
+        if (hit)
+        {
+            std::printf("       t = %f\n", t);
+            ++g_failures;
+        }
+    }
+
+    //--------------球 vs 球------------------
+    void CheckSphere()
+    {
+        std::printf("--- 球 vs 球\n");
+        float t = -1.0f;
+        bool hit;
+
+        //x = -10 -> 10、半径の和 2：中心間が 2 になる x = -2 で触れる -> t = 8 / 20
+        hit = Collision::SweepSphereVsSphere(Vector3(-10, 0, 0), Vector3(10, 0, 0), 1.0f, Vector3(0, 0, 0), 1.0f, t);
+        CheckHit(hit, t, 0.4f, "head-on");
+
+        //y = 1.5 だけずらす：x = -sqrt(4 - 1.5^2) で触れる
+        hit = Collision::SweepSphereVsSphere(Vector3(-10, 1.5f, 0), Vector3(10, 1.5f, 0), 1.0f, Vector3(0, 0, 0), 1.0f, t);
+        CheckHit(hit, t, (10.0f - std::sqrt(4.0f - 1.5f * 1.5f)) / 20.0f, "offset hit");
+
+        //y = 2.01 は半径の和より外
+        hit = Collision::SweepSphereVsSphere(Vector3(-10, 2.01f, 0), Vector3(10, 2.01f, 0), 1.0f, Vector3(0, 0, 0), 1.0f, t);
+        CheckMiss(hit, t, "offset miss");
+
+        //触れる前にフレームが終わる（x = -3 で止まる）
+        hit = Collision::SweepSphereVsSphere(Vector3(-10, 0, 0), Vector3(-3, 0, 0), 1.0f, Vector3(0, 0, 0), 1.0f, t);
+        CheckMiss(hit, t, "stops short");
+
+        //離れていく
+        hit = Collision::SweepSphereVsSphere(Vector3(-3, 0, 0), Vector3(-10, 0, 0), 1.0f, Vector3(0, 0, 0), 1.0f, t);
+        CheckMiss(hit, t, "moving away");
+
+        //最初から重なっている
+        hit = Collision::SweepSphereVsSphere(Vector3(-1.5f, 0, 0), Vector3(-10, 0, 0), 1.0f, Vector3(0, 0, 0), 1.0f, t);
+        CheckHit(hit, t, 0.0f, "start inside");
+    }
+
+    //--------------球 vs AABB------------------
+    void CheckAABB()
+    {
+        std::printf("--- 球 vs AABB\n");
+        const Vector3 mn(-1, -1, -1);
+        const Vector3 mx(1, 1, 1);
+        const float r = 0.5f;
+        float t = -1.0f;
+        bool hit;
+
+        //面に正面から：x = -1.5 で触れる -> t = 8.5 / 20
+        hit = Collision::SweepSphereVsAABB(Vector3(-10, 0, 0), Vector3(10, 0, 0), r, mn, mx, t);
+        CheckHit(hit, t, 8.5f / 20.0f, "face head-on");
+
+        //斜めに面へ：x 方向 20・y 方向 2 動く。x = -1.5 になるのは t = 8.5 / 20 で、その時 y = 0.85（面の範囲内）
+        hit = Collision::SweepSphereVsAABB(Vector3(-10, 0, 0), Vector3(10, 2, 0), r, mn, mx, t);
+        CheckHit(hit, t, 8.5f / 20.0f, "face oblique");
+
+        //辺（x = -1, y = 1 の z 方向の辺）：y = 1.3 で x 方向に動く
+        //(x + 1)^2 + 0.3^2 = 0.5^2 -> x = -1.4 -> t = 8.6 / 20
+        hit = Collision::SweepSphereVsAABB(Vector3(-10, 1.3f, 0), Vector3(10, 1.3f, 0), r, mn, mx, t);
+        CheckHit(hit, t, 8.6f / 20.0f, "edge");
+
+        //角（-1, 1, 1）：y = z = 1.2 で x 方向に動く
+        //(x + 1)^2 + 0.2^2 + 0.2^2 = 0.5^2 -> x = -1 - sqrt(0.17)
+        hit = Collision::SweepSphereVsAABB(Vector3(-10, 1.2f, 1.2f), Vector3(10, 1.2f, 1.2f), r, mn, mx, t);
+        CheckHit(hit, t, (9.0f - std::sqrt(0.17f)) / 20.0f, "corner");
+
+        //y = z = 1.4 はふくらませた箱（1.5）の中を通るが、角からは sqrt(0.32) > 0.5 離れている
+        hit = Collision::SweepSphereVsAABB(Vector3(-10, 1.4f, 1.4f), Vector3(10, 1.4f, 1.4f), r, mn, mx, t);
+        CheckMiss(hit, t, "corner graze miss");
+
+        //辺を斜めに横切る：x, y 方向に同じだけ動き、辺 (x = -1, y = 1) に向かう
+        //ふくらませた箱に入る (-1.5, 1.5) では辺から sqrt(0.5) 離れていて、その後の辺の丸まった部分で触れる
+        //位置 (-3 + 2s, 3 - 2s)：辺までの距離 = |(-2 + 2s, 2 - 2s)| = sqrt(2) * (2 - 2s) = 0.5 -> s = 1 - 0.25 / sqrt(2)
+        hit = Collision::SweepSphereVsAABB(Vector3(-3, 3, 0), Vector3(-1, 1, 0), r, mn, mx, t);
+        CheckHit(hit, t, 1.0f - 0.25f / std::sqrt(2.0f), "edge diagonal");
+
+        //届かない / 離れていく
+        hit = Collision::SweepSphereVsAABB(Vector3(-10, 0, 0), Vector3(-2, 0, 0), r, mn, mx, t);
+        CheckMiss(hit, t, "stops short");
+        hit = Collision::SweepSphereVsAABB(Vector3(-2, 0, 0), Vector3(-10, 0, 0), r, mn, mx, t);
+        CheckMiss(hit, t, "moving away");
+
+        //中心が箱の中
+        hit = Collision::SweepSphereVsAABB(Vector3(0.2f, 0, 0), Vector3(10, 0, 0), r, mn, mx, t);
+        CheckHit(hit, t, 0.0f, "start inside (center in box)");
+
+        //中心は箱の外だが半径の分だけ重なっている
+        hit = Collision::SweepSphereVsAABB(Vector3(-1.3f, 0, 0), Vector3(-10, 0, 0), r, mn, mx, t);
+        CheckHit(hit, t, 0.0f, "start inside (overlapping)");
+
+        //動いていない
+        hit = Collision::SweepSphereVsAABB(Vector3(-5, 0, 0), Vector3(-5, 0, 0), r, mn, mx, t);
+        CheckMiss(hit, t, "not moving, apart");
+    }
+
+    //--------------球 vs OBB------------------
+    void CheckOBB()
+    {
+        std::printf("--- 球 vs OBB\n");
+
+        //Y 軸まわりに 45 度回した 1 辺 2 の立方体
+        const float c = std::sqrt(0.5f);
+        const Vector3 axes[3] = { Vector3(c, 0, -c), Vector3(0, 1, 0), Vector3(c, 0, c) };
+        const Vector3 center(3, 0, 0);
+        const Vector3 half(1, 1, 1);
+        const float r = 0.5f;
+        float t = -1.0f;
+        bool hit;
+
+        //-X 側には縦の辺が sqrt(2) の位置に出ている。x 軸に沿って来ると、そこまでの距離が r になる x で触れる
+        //中心からの距離 sqrt(2) + 0.5 -> 触れる x = 3 - sqrt(2) - 0.5 -> t = (x - (-7)) / 20
+        hit = Collision::SweepSphereVsOBB(Vector3(-7, 0, 0), Vector3(13, 0, 0), r, center, axes, half, t);
+        CheckHit(hit, t, (10.0f - std::sqrt(2.0f) - 0.5f) / 20.0f, "rotated box, vertical edge");
+
+        //回していなければ面で x = 1.5 -> t = 8.5 / 20 なので、回した分だけ早く当たる
+        const Vector3 identity[3] = { Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1) };
+        hit = Collision::SweepSphereVsOBB(Vector3(-7, 0, 0), Vector3(13, 0, 0), r, center, identity, half, t);
+        CheckHit(hit, t, 8.5f / 20.0f, "identity axes match AABB");
+
+        //回した面（-Right 側）に法線の向きから正面で近づく：面までの距離 1 + r で触れる
+        //始点は中心から -Right 方向に 10、終点は +Right 方向に 10 -> t = (10 - 1.5) / 20
+        const Vector3 start = center - axes[0] * 10.0f;
+        const Vector3 end = center + axes[0] * 10.0f;
+        hit = Collision::SweepSphereVsOBB(start, end, r, center, axes, half, t);
+        CheckHit(hit, t, 8.5f / 20.0f, "rotated box, face head-on");
+
+        //回した箱の上を通る（y = 1.6 は上面 + r より上）
+        hit = Collision::SweepSphereVsOBB(Vector3(-7, 1.6f, 0), Vector3(13, 1.6f, 0), r, center, axes, half, t);
+        CheckMiss(hit, t, "rotated box, passes over");
+
+        //中心が箱の中
+        hit = Collision::SweepSphereVsOBB(center, Vector3(13, 0, 0), r, center, axes, half, t);
+        CheckHit(hit, t, 0.0f, "rotated box, start inside");
+    }
+
+    //--------------すり抜け------------------
+    void CheckTunnel()
+    {
+        std::printf("--- 1 フレームで 30 進む弾\n");
+        const float r = 0.1f;
+        const Vector3 p0(-15, 0, 0);
+        const Vector3 p1(15, 0, 0);
+        float t = -1.0f;
+        bool hit;
+
+        //厚さ 0.2 の壁（x = -0.1 .. 0.1）
+        const Vector3 wallMin(-0.1f, -5, -5);
+        const Vector3 wallMax(0.1f, 5, 5);
+
+        //始点と終点だけで調べると、どちらも壁から遠いので当たらない
+        bool discrete = Collision::DistanceSqPointAABB(p0, wallMin, wallMax) <= r * r ||
+                        Collision::DistanceSqPointAABB(p1, wallMin, wallMax) <= r * r;
+        Check(!discrete, "discrete end-point test misses the wall");
+
+        //x = -0.2 で触れる -> t = 14.8 / 30
+        hit = Collision::SweepSphereVsAABB(p0, p1, r, wallMin, wallMax, t);
+        CheckHit(hit, t, 14.8f / 30.0f, "thin wall");
+
+        //半径 0.5 の敵：x = -0.6 で触れる -> t = 14.4 / 30
+        const Vector3 enemy(0, 0, 0);
+        discrete = (p0 - enemy).Dot(p0 - enemy) <= 0.6f * 0.6f || (p1 - enemy).Dot(p1 - enemy) <= 0.6f * 0.6f;
+        Check(!discrete, "discrete end-point test misses the enemy");
+        hit = Collision::SweepSphereVsSphere(p0, p1, r, enemy, 0.5f, t);
+        CheckHit(hit, t, 14.4f / 30.0f, "small enemy");
+
+        //45 度回した薄い壁（厚さ 0.2）：斜めの面までの距離 0.1 + r を 45 度で横切る
+        //x 軸上で壁の面に触れるのは中心からの距離 (0.1 + r) * sqrt(2) -> t = (15 - 0.2 * sqrt(2)) / 30
+        const float c = std::sqrt(0.5f);
+        const Vector3 axes[3] = { Vector3(c, 0, -c), Vector3(0, 1, 0), Vector3(c, 0, c) };
+        hit = Collision::SweepSphereVsOBB(p0, p1, r, Vector3(0, 0, 0), axes, Vector3(0.1f, 5, 5), t);
+        CheckHit(hit, t, (15.0f - 0.2f * std::sqrt(2.0f)) / 30.0f, "rotated thin wall");
+    }
+}
+
+int main()
+{
+    CheckSphere();
+    CheckAABB();
+    CheckOBB();
+    CheckTunnel();
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
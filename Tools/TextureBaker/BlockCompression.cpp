@@ -0,0 +1,588 @@
+﻿#include "BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    //--------------------------------------------------------
+    // 共通
+    //--------------------------------------------------------
+
+    float Clamp(float v, float lo, float hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+    //n 次元の点群の主成分軸（べき乗法）。ばらつきが無ければ false
+    template<int N>
+    bool PrincipalAxis(const float (*px)[4], float mean[N], float axis[N])
+    {
+        for (int c = 0; c < N; ++c)
+        {
+            mean[c] = 0.0f;
+            for (int i = 0; i < 16; ++i) { mean[c] += px[i][c]; }
+            mean[c] /= 16.0f;
+        }
+
+        float cov[N][N] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            float d[N];
+            for (int c = 0; c < N; ++c) { d[c] = px[i][c] - mean[c]; }
+            for (int a = 0; a < N; ++a)
+            {
+                for (int b = 0; b < N; ++b) { cov[a][b] += d[a] * d[b]; }
+            }
+        }
+
+        //対角成分が一番大きい軸から始める
+        int start = 0;
+        for (int c = 1; c < N; ++c)
+        {
+            if (cov[c][c] > cov[start][start]) { start = c; }
+        }
+        if (cov[start][start] < 1.0e-4f) { return false; }
+
+        for (int c = 0; c < N; ++c) { axis[c] = cov[start][c]; }
+
+        for (int iter = 0; iter < 8; ++iter)
+        {
+            float next[N] = {};
+            for (int a = 0; a < N; ++a)
+            {
+                for (int b = 0; b < N; ++b) { next[a] += cov[a][b] * axis[b]; }
+            }
+
+            float len = 0.0f;
+            for (int c = 0; c < N; ++c) { len += next[c] * next[c]; }
+            len = std::sqrt(len);
+            if (len < 1.0e-8f) { return false; }
+
+            for (int c = 0; c < N; ++c) { axis[c] = next[c] / len; }
+        }
+        return true;
+    }
+
+    //主成分軸に沿った両端を端点の初期値にする
+    template<int N>
+    void InitialEndpoints(const float (*px)[4], float e0[4], float e1[4])
+    {
+        float mean[N];
+        float axis[N];
+        if (!PrincipalAxis<N>(px, mean, axis))
+        {
+            for (int c = 0; c < 4; ++c) { e0[c] = e1[c] = (c < N) ? mean[c] : 255.0f; }
+            return;
+        }
+
+        float tMin = 1.0e30f, tMax = -1.0e30f;
+        for (int i = 0; i < 16; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < N; ++c) { t += (px[i][c] - mean[c]) * axis[c]; }
+            tMin = (std::min)(tMin, t);
+            tMax = (std::max)(tMax, t);
+        }
+
+        for (int c = 0; c < 4; ++c)
+        {
+            e0[c] = (c < N) ? Clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f) : 255.0f;
+            e1[c] = (c < N) ? Clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f) : 255.0f;
+        }
+    }
+
+    //重み w[i]（e0 側の割合）が決まったときの端点の最小二乗解
+    //（全画素が同じ重みなら解けないので false）
+    template<int N>
+    bool LeastSquaresEndpoints(const float (*px)[4], const float w[16], float e0[4], float e1[4])
+    {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ax[4] = {}, bx[4] = {};
+        for (int i = 0; i < 16; ++i)
+        {
+            float a = w[i];
+            float b = 1.0f - a;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < N; ++c)
+            {
+                ax[c] += a * px[i][c];
+                bx[c] += b * px[i][c];
+            }
+        }
+
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) < 1.0e-6f) { return false; }
+
+        float inv = 1.0f / det;
+        for (int c = 0; c < N; ++c)
+        {
+            e0[c] = Clamp((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+            e1[c] = Clamp((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    void LoadBlock(const uint8_t rgba[64], float px[16][4])
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int c = 0; c < 4; ++c) { px[i][c] = rgba[i * 4 + c]; }
+        }
+    }
+
+    //--------------------------------------------------------
+    // BC1 の色ブロック（BC3 の色部分も同じ）
+    //--------------------------------------------------------
+
+    uint16_t Pack565(const float c[4])
+    {
+        int r = static_cast<int>(Clamp(c[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+        int g = static_cast<int>(Clamp(c[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+        int b = static_cast<int>(Clamp(c[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void Unpack565(uint16_t v, int out[3])
+    {
+        int r = (v >> 11) & 31;
+        int g = (v >> 5) & 63;
+        int b = v & 31;
+        out[0] = (r << 3) | (r >> 2);
+        out[1] = (g << 2) | (g >> 4);
+        out[2] = (b << 3) | (b >> 2);
+    }
+
+    //4 色モード（c0 > c1）のパレット
+    void ColorPalette(uint16_t c0, uint16_t c1, int pal[4][3])
+    {
+        Unpack565(c0, pal[0]);
+        Unpack565(c1, pal[1]);
+        for (int c = 0; c < 3; ++c)
+        {
+            pal[2][c] = (2 * pal[0][c] + pal[1][c]) / 3;
+            pal[3][c] = (pal[0][c] + 2 * pal[1][c]) / 3;
+        }
+    }
+
+    //端点を量子化してインデックスを決め、誤差を返す
+    float FitColorIndices(const float px[16][4], const float e0[4], const float e1[4],
+        uint16_t& outC0, uint16_t& outC1, uint32_t& outBits, float outWeights[16])
+    {
+        uint16_t c0 = Pack565(e0);
+        uint16_t c1 = Pack565(e1);
+        if (c0 < c1) { std::swap(c0, c1); }
+
+        //同じ色になったら全画素インデックス 0
+        if (c0 == c1)
+        {
+            int pal[3];
+            Unpack565(c0, pal);
+            float err = 0.0f;
+            for (int i = 0; i < 16; ++i)
+            {
+                for (int c = 0; c < 3; ++c) { float d = px[i][c] - pal[c]; err += d * d; }
+                outWeights[i] = 1.0f;
+            }
+            outC0 = c0;
+            outC1 = c1;
+            outBits = 0;
+            return err;
+        }
+
+        int pal[4][3];
+        ColorPalette(c0, c1, pal);
+        static const float kWeight[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+        float err = 0.0f;
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0;
+            float bestErr = 1.0e30f;
+            for (int k = 0; k < 4; ++k)
+            {
+                float e = 0.0f;
+                for (int c = 0; c < 3; ++c) { float d = px[i][c] - pal[k][c]; e += d * d; }
+                if (e < bestErr) { bestErr = e; best = k; }
+            }
+            err += bestErr;
+            bits |= static_cast<uint32_t>(best) << (i * 2);
+            outWeights[i] = kWeight[best];
+        }
+
+        outC0 = c0;
+        outC1 = c1;
+        outBits = bits;
+        return err;
+    }
+
+    void EncodeColorBlock(const float px[16][4], uint8_t out[8])
+    {
+        float e0[4], e1[4];
+        InitialEndpoints<3>(px, e0, e1);
+
+        uint16_t bestC0 = 0, bestC1 = 0;
+        uint32_t bestBits = 0;
+        float bestErr = 1.0e30f;
+
+        //インデックス決定 → 最小二乗で端点を詰め直す、を数回
+        for (int iter = 0; iter < 3; ++iter)
+        {
+            uint16_t c0, c1;
+            uint32_t bits;
+            float weights[16];
+            float err = FitColorIndices(px, e0, e1, c0, c1, bits, weights);
+            if (err < bestErr)
+            {
+                bestErr = err;
+                bestC0 = c0;
+                bestC1 = c1;
+                bestBits = bits;
+            }
+            if (err <= 0.0f || !LeastSquaresEndpoints<3>(px, weights, e0, e1)) { break; }
+        }
+
+        out[0] = static_cast<uint8_t>(bestC0 & 0xFF);
+        out[1] = static_cast<uint8_t>(bestC0 >> 8);
+        out[2] = static_cast<uint8_t>(bestC1 & 0xFF);
+        out[3] = static_cast<uint8_t>(bestC1 >> 8);
+        for (int b = 0; b < 4; ++b) { out[4 + b] = static_cast<uint8_t>(bestBits >> (b * 8)); }
+    }
+
+    void DecodeColorBlock(const uint8_t in[8], uint8_t rgba[64], bool allowPunchThrough)
+    {
+        uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+        uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+        uint32_t bits = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+
+        int pal[4][4];
+        Unpack565(c0, pal[0]);
+        Unpack565(c1, pal[1]);
+        pal[0][3] = pal[1][3] = pal[2][3] = pal[3][3] = 255;
+
+        if (c0 > c1 || !allowPunchThrough)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                pal[2][c] = (2 * pal[0][c] + pal[1][c]) / 3;
+                pal[3][c] = (pal[0][c] + 2 * pal[1][c]) / 3;
+            }
+        }
+        else
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                pal[2][c] = (pal[0][c] + pal[1][c]) / 2;
+                pal[3][c] = 0;
+            }
+            pal[3][3] = 0;
+        }
+
+        for (int i = 0; i < 16; ++i)
+        {
+            int k = (bits >> (i * 2)) & 3;
+            for (int c = 0; c < 4; ++c) { rgba[i * 4 + c] = static_cast<uint8_t>(pal[k][c]); }
+        }
+    }
+
+    //--------------------------------------------------------
+    // BC3 のアルファブロック
+    //--------------------------------------------------------
+
+    void AlphaPalette(int a0, int a1, int pal[8])
+    {
+        pal[0] = a0;
+        pal[1] = a1;
+        if (a0 > a1)
+        {
+            for (int k = 1; k <= 6; ++k) { pal[k + 1] = ((7 - k) * a0 + k * a1) / 7; }
+        }
+        else
+        {
+            for (int k = 1; k <= 4; ++k) { pal[k + 1] = ((5 - k) * a0 + k * a1) / 5; }
+            pal[6] = 0;
+            pal[7] = 255;
+        }
+    }
+
+    float FitAlpha(const float px[16][4], int a0, int a1, uint64_t& outBits)
+    {
+        int pal[8];
+        AlphaPalette(a0, a1, pal);
+
+        float err = 0.0f;
+        uint64_t bits = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0;
+            float bestErr = 1.0e30f;
+            for (int k = 0; k < 8; ++k)
+            {
+                float d = px[i][3] - static_cast<float>(pal[k]);
+                if (d * d < bestErr) { bestErr = d * d; best = k; }
+            }
+            err += bestErr;
+            bits |= static_cast<uint64_t>(best) << (i * 3);
+        }
+        outBits = bits;
+        return err;
+    }
+
+    void EncodeAlphaBlock(const float px[16][4], uint8_t out[8])
+    {
+        int minA = 255, maxA = 0;
+        int minInner = 255, maxInner = 0;  //0 と 255 を除いた範囲（6 段階モード用）
+        for (int i = 0; i < 16; ++i)
+        {
+            int a = static_cast<int>(px[i][3]);
+            minA = (std::min)(minA, a);
+            maxA = (std::max)(maxA, a);
+            if (a != 0 && a != 255)
+            {
+                minInner = (std::min)(minInner, a);
+                maxInner = (std::max)(maxInner, a);
+            }
+        }
+
+        //8 段階モード（a0 > a1）
+        int a0 = maxA, a1 = minA;
+        uint64_t bits = 0;
+        float err = FitAlpha(px, a0, a1, bits);
+
+        //6 段階 + 0/255 モード（a0 <= a1）。完全透明と不透明が混ざるブロック向け
+        if (minInner <= maxInner && (minA == 0 || maxA == 255))
+        {
+            uint64_t bits6 = 0;
+            float err6 = FitAlpha(px, minInner, maxInner, bits6);
+            if (err6 < err)
+            {
+                a0 = minInner;
+                a1 = maxInner;
+                bits = bits6;
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(a0);
+        out[1] = static_cast<uint8_t>(a1);
+        for (int b = 0; b < 6; ++b) { out[2 + b] = static_cast<uint8_t>(bits >> (b * 8)); }
+    }
+
+    void DecodeAlphaBlock(const uint8_t in[8], uint8_t rgba[64])
+    {
+        int pal[8];
+        AlphaPalette(in[0], in[1], pal);
+
+        uint64_t bits = 0;
+        for (int b = 0; b < 6; ++b) { bits |= static_cast<uint64_t>(in[2 + b]) << (b * 8); }
+
+        for (int i = 0; i < 16; ++i)
+        {
+            rgba[i * 4 + 3] = static_cast<uint8_t>(pal[(bits >> (i * 3)) & 7]);
+        }
+    }
+
+    //--------------------------------------------------------
+    // BC7 モード 6
+    //--------------------------------------------------------
+
+    const int kBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct BitWriter
+    {
+        uint8_t* out;
+        int pos = 0;
+
+        void Put(uint32_t value, int count)
+        {
+            for (int i = 0; i < count; ++i, ++pos)
+            {
+                if (value & (1u << i)) { out[pos >> 3] |= static_cast<uint8_t>(1u << (pos & 7)); }
+            }
+        }
+    };
+
+    struct BitReader
+    {
+        const uint8_t* in;
+        int pos = 0;
+
+        uint32_t Get(int count)
+        {
+            uint32_t v = 0;
+            for (int i = 0; i < count; ++i, ++pos)
+            {
+                if (in[pos >> 3] & (1u << (pos & 7))) { v |= 1u << i; }
+            }
+            return v;
+        }
+    };
+
+    //端点 1 つを 7bit × 4 + 共有 p ビットに量子化する（p は誤差の小さい方）
+    void QuantizeMode6Endpoint(const float e[4], int q[4], int& p)
+    {
+        float bestErr = 1.0e30f;
+        for (int tryP = 0; tryP < 2; ++tryP)
+        {
+            int tq[4];
+            float err = 0.0f;
+            for (int c = 0; c < 4; ++c)
+            {
+                int v = static_cast<int>(std::floor((e[c] - tryP) * 0.5f + 0.5f));
+                tq[c] = (std::max)(0, (std::min)(127, v));
+                float d = e[c] - static_cast<float>(tq[c] * 2 + tryP);
+                err += d * d;
+            }
+            if (err < bestErr)
+            {
+                bestErr = err;
+                p = tryP;
+                std::memcpy(q, tq, sizeof(tq));
+            }
+        }
+    }
+
+    float FitMode6(const float px[16][4], const float e0[4], const float e1[4],
+        int q0[4], int q1[4], int& p0, int& p1, int idx[16], float outWeights[16])
+    {
+        QuantizeMode6Endpoint(e0, q0, p0);
+        QuantizeMode6Endpoint(e1, q1, p1);
+
+        int pal[16][4];
+        for (int k = 0; k < 16; ++k)
+        {
+            int w = kBC7Weights4[k];
+            for (int c = 0; c < 4; ++c)
+            {
+                int a = q0[c] * 2 + p0;
+                int b = q1[c] * 2 + p1;
+                pal[k][c] = ((64 - w) * a + w * b + 32) >> 6;
+            }
+        }
+
+        float err = 0.0f;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0;
+            float bestErr = 1.0e30f;
+            for (int k = 0; k < 16; ++k)
+            {
+                float e = 0.0f;
+                for (int c = 0; c < 4; ++c) { float d = px[i][c] - pal[k][c]; e += d * d; }
+                if (e < bestErr) { bestErr = e; best = k; }
+            }
+            err += bestErr;
+            idx[i] = best;
+            outWeights[i] = 1.0f - kBC7Weights4[best] / 64.0f;
+        }
+        return err;
+    }
+}
+
+void EncodeBC1(const uint8_t rgba[64], uint8_t out[8])
+{
+    float px[16][4];
+    LoadBlock(rgba, px);
+    EncodeColorBlock(px, out);
+}
+
+void EncodeBC3(const uint8_t rgba[64], uint8_t out[16])
+{
+    float px[16][4];
+    LoadBlock(rgba, px);
+    EncodeAlphaBlock(px, out);
+    EncodeColorBlock(px, out + 8);
+}
+
+void EncodeBC7(const uint8_t rgba[64], uint8_t out[16])
+{
+    float px[16][4];
+    LoadBlock(rgba, px);
+
+    float e0[4], e1[4];
+    InitialEndpoints<4>(px, e0, e1);
+
+    int bestQ0[4] = {}, bestQ1[4] = {}, bestP0 = 0, bestP1 = 0, bestIdx[16] = {};
+    float bestErr = 1.0e30f;
+
+    for (int iter = 0; iter < 3; ++iter)
+    {
+        int q0[4], q1[4], p0, p1, idx[16];
+        float weights[16];
+        float err = FitMode6(px, e0, e1, q0, q1, p0, p1, idx, weights);
+        if (err < bestErr)
+        {
+            bestErr = err;
+            std::memcpy(bestQ0, q0, sizeof(q0));
+            std::memcpy(bestQ1, q1, sizeof(q1));
+            std::memcpy(bestIdx, idx, sizeof(idx));
+            bestP0 = p0;
+            bestP1 = p1;
+        }
+        if (err <= 0.0f || !LeastSquaresEndpoints<4>(px, weights, e0, e1)) { break; }
+    }
+
+    //先頭画素のインデックスは最上位ビットが 0 でなければならないので、必要なら端点を入れ替える
+    if (bestIdx[0] & 8)
+    {
+        std::swap(bestQ0, bestQ1);
+        std::swap(bestP0, bestP1);
+        for (int i = 0; i < 16; ++i) { bestIdx[i] = 15 - bestIdx[i]; }
+    }
+
+    std::memset(out, 0, 16);
+    BitWriter bw{ out };
+    bw.Put(1u << 6, 7);                     //モード 6
+    for (int c = 0; c < 4; ++c)
+    {
+        bw.Put(static_cast<uint32_t>(bestQ0[c]), 7);
+        bw.Put(static_cast<uint32_t>(bestQ1[c]), 7);
+    }
+    bw.Put(static_cast<uint32_t>(bestP0), 1);
+    bw.Put(static_cast<uint32_t>(bestP1), 1);
+    bw.Put(static_cast<uint32_t>(bestIdx[0]), 3);
+    for (int i = 1; i < 16; ++i) { bw.Put(static_cast<uint32_t>(bestIdx[i]), 4); }
+}
+
+void DecodeBC1(const uint8_t in[8], uint8_t rgba[64])
+{
+    DecodeColorBlock(in, rgba, true);
+}
+
+void DecodeBC3(const uint8_t in[16], uint8_t rgba[64])
+{
+    DecodeColorBlock(in + 8, rgba, false);
+    DecodeAlphaBlock(in, rgba);
+}
+
+void DecodeBC7(const uint8_t in[16], uint8_t rgba[64])
+{
+    std::memset(rgba, 0, 64);
+    if ((in[0] & 0x7F) != 0x40) { return; }
+
+    BitReader br{ in };
+    br.Get(7);
+
+    int e[2][4];
+    for (int c = 0; c < 4; ++c)
+    {
+        e[0][c] = static_cast<int>(br.Get(7));
+        e[1][c] = static_cast<int>(br.Get(7));
+    }
+    int p0 = static_cast<int>(br.Get(1));
+    int p1 = static_cast<int>(br.Get(1));
+    for (int c = 0; c < 4; ++c)
+    {
+        e[0][c] = e[0][c] * 2 + p0;
+        e[1][c] = e[1][c] * 2 + p1;
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        int k = static_cast<int>(br.Get(i == 0 ? 3 : 4));
+        int w = kBC7Weights4[k];
+        for (int c = 0; c < 4; ++c)
+        {
+            rgba[i * 4 + c] = static_cast<uint8_t>(((64 - w) * e[0][c] + w * e[1][c] + 32) >> 6);
+        }
+    }
+}
@@ -0,0 +1,19 @@
+﻿#pragma once
+#include <cstdint>
+
+//------------------------------------------------------------
+// BC1 / BC3 / BC7 のブロック圧縮（CPU のみ・外部ライブラリ不要）
+// ・入力は 4x4 画素の RGBA8（16 画素 × 4 byte、行優先）
+// ・BC1 / BC3 の色は主成分軸で端点を取り、最小二乗で 2 回詰め直す
+// ・BC7 はモード 6（1 サブセット・RGBA 端点・4bit インデックス）だけを使う
+//   （パーティション探索はしないので品質は中程度。UI・エフェクト用途なら十分）
+// ・Decode* は -v 指定時の誤差確認用
+//------------------------------------------------------------
+
+void EncodeBC1(const uint8_t rgba[64], uint8_t out[8]);
+void EncodeBC3(const uint8_t rgba[64], uint8_t out[16]);
+void EncodeBC7(const uint8_t rgba[64], uint8_t out[16]);
+
+void DecodeBC1(const uint8_t in[8], uint8_t rgba[64]);
+void DecodeBC3(const uint8_t in[16], uint8_t rgba[64]);
+void DecodeBC7(const uint8_t in[16], uint8_t rgba[64]);	//モード 6 以外は黒を返す
@@ -0,0 +1,578 @@
+﻿//------------------------------------------------------------
+// PNG / JPEG を DDS（ミップマップ付き・BC1 / BC3 / BC7 圧縮）に焼くツール
+// 実行時は TextureManager が同じ場所にある .dds を優先して読む（元画像より古ければ使わない）
+//
+// ビルド例（Linux）:
+//   g++ -O2 -std=c++17 -pthread TextureBaker.cpp BlockCompression.cpp -lpng -ljpeg -o TextureBaker
+// 実行例:
+//   ./TextureBaker ../../ShootingGame_0519/Asset            （フォルダ以下の .png/.jpg をすべて焼く）
+//   ./TextureBaker -f bc7 -v Asset/Texture/Title/TitleBackGround.png
+//
+// オプション:
+//   -f auto|bc1|bc3|bc7   圧縮形式（auto: 不透明なら BC1、半透明があれば BC7）
+//   --srgb / --linear     色空間を強制する（既定は PNG の sRGB チャンクの有無で決める。WIC と同じ判定）
+//   --no-mips             ミップマップを作らない
+//   -o dir                出力先（既定は元画像と同じフォルダ）
+//   --force               出力が新しくても焼き直す
+//   -v                    ミップ 0 の PSNR を表示する
+//------------------------------------------------------------
+#include "BlockCompression.h"
+#include <png.h>
+#include <jpeglib.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    enum class Format { Auto, BC1, BC3, BC7 };
+
+    struct Options
+    {
+        Format format = Format::Auto;
+        int forceSrgb = -1;         //-1: 画像に従う / 0: linear / 1: sRGB
+        bool mips = true;
+        bool force = false;
+        bool verbose = false;
+        fs::path outDir;
+    };
+
+    struct Image
+    {
+        int width = 0;
+        int height = 0;
+        bool srgb = false;
+        std::vector<uint8_t> rgba;
+    };
+
+    //--------------------------------------------------------
+    // 読み込み
+    //--------------------------------------------------------
+
+    //PNG のチャンクを順に見て sRGB チャンクがあるか調べる
+    bool PngHasSrgbChunk(const fs::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        uint8_t sig[8];
+        if (!file.read(reinterpret_cast<char*>(sig), 8)) { return false; }
+
+        uint8_t head[8];
+        while (file.read(reinterpret_cast<char*>(head), 8))
+        {
+            uint32_t length = (uint32_t(head[0]) << 24) | (head[1] << 16) | (head[2] << 8) | head[3];
+            if (std::memcmp(head + 4, "sRGB", 4) == 0) { return true; }
+            if (std::memcmp(head + 4, "IDAT", 4) == 0) { return false; }   //色情報は IDAT より前にしか来ない
+            file.seekg(length + 4, std::ios::cur);
+        }
+        return false;
+    }
+
+    bool LoadPng(const fs::path& path, Image& out)
+    {
+        png_image png;
+        std::memset(&png, 0, sizeof(png));
+        png.version = PNG_IMAGE_VERSION;
+
+        if (!png_image_begin_read_from_file(&png, path.string().c_str()))
+        {
+            std::fprintf(stderr, "  読み込み失敗: %s (%s)\n", path.string().c_str(), png.message);
+            return false;
+        }
+
+        png.format = PNG_FORMAT_RGBA;
+        out.width = static_cast<int>(png.width);
+        out.height = static_cast<int>(png.height);
+        out.rgba.resize(PNG_IMAGE_SIZE(png));
+
+        if (!png_image_finish_read(&png, nullptr, out.rgba.data(), 0, nullptr))
+        {
+            std::fprintf(stderr, "  読み込み失敗: %s (%s)\n", path.string().c_str(), png.message);
+            png_image_free(&png);
+            return false;
+        }
+
+        out.srgb = PngHasSrgbChunk(path);
+        return true;
+    }
+
+    struct JpegError
+    {
+        jpeg_error_mgr base;
+        std::jmp_buf jump;
+    };
+
+    void OnJpegError(j_common_ptr info)
+    {
+        std::longjmp(reinterpret_cast<JpegError*>(info->err)->jump, 1);
+    }
+
+    bool LoadJpeg(const fs::path& path, Image& out)
+    {
+        FILE* file = std::fopen(path.string().c_str(), "rb");
+        if (!file)
+        {
+            std::fprintf(stderr, "  開けません: %s\n", path.string().c_str());
+            return false;
+        }
+
+        jpeg_decompress_struct info;
+        JpegError err;
+        info.err = jpeg_std_error(&err.base);
+        err.base.error_exit = OnJpegError;
+
+        if (setjmp(err.jump))
+        {
+            std::fprintf(stderr, "  読み込み失敗: %s\n", path.string().c_str());
+            jpeg_destroy_decompress(&info);
+            std::fclose(file);
+            return false;
+        }
+
+        jpeg_create_decompress(&info);
+        jpeg_stdio_src(&info, file);
+        jpeg_read_header(&info, TRUE);
+        info.out_color_space = JCS_RGB;
+        jpeg_start_decompress(&info);
+
+        out.width = static_cast<int>(info.output_width);
+        out.height = static_cast<int>(info.output_height);
+        out.srgb = false;   //WIC も EXIF 無しの JPEG は linear 扱いにする
+        out.rgba.assign(size_t(out.width) * out.height * 4, 255);
+
+        std::vector<uint8_t> row(size_t(out.width) * 3);
+        while (info.output_scanline < info.output_height)
+        {
+            uint8_t* rowPtr = row.data();
+            int y = static_cast<int>(info.output_scanline);
+            jpeg_read_scanlines(&info, &rowPtr, 1);
+
+            uint8_t* dst = &out.rgba[size_t(y) * out.width * 4];
+            for (int x = 0; x < out.width; ++x)
+            {
+                dst[x * 4 + 0] = row[x * 3 + 0];
+                dst[x * 4 + 1] = row[x * 3 + 1];
+                dst[x * 4 + 2] = row[x * 3 + 2];
+            }
+        }
+
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+        std::fclose(file);
+        return true;
+    }
+
+    //--------------------------------------------------------
+    // ミップマップ
+    //--------------------------------------------------------
+
+    float SrgbToLinear(float c)
+    {
+        return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float LinearToSrgb(float c)
+    {
+        return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    }
+
+    //2x2 の box フィルタで半分にする（奇数辺は端を繰り返す）
+    //色はアルファで重み付けし、sRGB なら linear に戻してから平均する
+    Image Downsample(const Image& src, const float toLinear[256])
+    {
+        Image dst;
+        dst.width = (std::max)(1, src.width / 2);
+        dst.height = (std::max)(1, src.height / 2);
+        dst.srgb = src.srgb;
+        dst.rgba.resize(size_t(dst.width) * dst.height * 4);
+
+        for (int y = 0; y < dst.height; ++y)
+        {
+            for (int x = 0; x < dst.width; ++x)
+            {
+                float sum[3] = {};
+                float alphaSum = 0.0f;
+                for (int dy = 0; dy < 2; ++dy)
+                {
+                    for (int dx = 0; dx < 2; ++dx)
+                    {
+                        int sx = (std::min)(x * 2 + dx, src.width - 1);
+                        int sy = (std::min)(y * 2 + dy, src.height - 1);
+                        const uint8_t* p = &src.rgba[(size_t(sy) * src.width + sx) * 4];
+
+                        float a = p[3] / 255.0f;
+                        //全画素が透明でも色が潰れないように、重みにはわずかな下駄を履かせる
+                        float w = a + 1.0e-4f;
+                        for (int c = 0; c < 3; ++c) { sum[c] += toLinear[p[c]] * w; }
+                        alphaSum += w;
+                    }
+                }
+
+                uint8_t* q = &dst.rgba[(size_t(y) * dst.width + x) * 4];
+                for (int c = 0; c < 3; ++c)
+                {
+                    float v = sum[c] / alphaSum;
+                    if (src.srgb) { v = LinearToSrgb(v); }
+                    q[c] = static_cast<uint8_t>(std::clamp(v * 255.0f + 0.5f, 0.0f, 255.0f));
+                }
+                float a = (alphaSum - 4.0e-4f) / 4.0f;
+                q[3] = static_cast<uint8_t>(std::clamp(a * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        }
+        return dst;
+    }
+
+    //--------------------------------------------------------
+    // 圧縮
+    //--------------------------------------------------------
+
+    int BlockBytes(Format f) { return (f == Format::BC1) ? 8 : 16; }
+
+    //端の 4x4 に満たないブロックは最終行・列を繰り返して埋める
+    void FetchBlock(const Image& img, int bx, int by, uint8_t block[64])
+    {
+        for (int y = 0; y < 4; ++y)
+        {
+            int sy = (std::min)(by * 4 + y, img.height - 1);
+            for (int x = 0; x < 4; ++x)
+            {
+                int sx = (std::min)(bx * 4 + x, img.width - 1);
+                std::memcpy(&block[(y * 4 + x) * 4], &img.rgba[(size_t(sy) * img.width + sx) * 4], 4);
+            }
+        }
+    }
+
+    void EncodeBlock(Format f, const uint8_t block[64], uint8_t* out)
+    {
+        switch (f)
+        {
+        case Format::BC1: EncodeBC1(block, out); break;
+        case Format::BC3: EncodeBC3(block, out); break;
+        default:          EncodeBC7(block, out); break;
+        }
+    }
+
+    void DecodeBlock(Format f, const uint8_t* in, uint8_t block[64])
+    {
+        switch (f)
+        {
+        case Format::BC1: DecodeBC1(in, block); break;
+        case Format::BC3: DecodeBC3(in, block); break;
+        default:          DecodeBC7(in, block); break;
+        }
+    }
+
+    //ブロック行単位でスレッドに振り分けて圧縮する
+    std::vector<uint8_t> Compress(const Image& img, Format f)
+    {
+        int blocksX = (img.width + 3) / 4;
+        int blocksY = (img.height + 3) / 4;
+        int bytes = BlockBytes(f);
+        std::vector<uint8_t> out(size_t(blocksX) * blocksY * bytes);
+
+        std::atomic<int> nextRow{ 0 };
+        auto worker = [&]()
+            {
+                uint8_t block[64];
+                for (int by = nextRow++; by < blocksY; by = nextRow++)
+                {
+                    for (int bx = 0; bx < blocksX; ++bx)
+                    {
+                        FetchBlock(img, bx, by, block);
+                        EncodeBlock(f, block, &out[(size_t(by) * blocksX + bx) * bytes]);
+                    }
+                }
+            };
+
+        unsigned threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < threadCount; ++i) { threads.emplace_back(worker); }
+        worker();
+        for (auto& t : threads) { t.join(); }
+
+        return out;
+    }
+
+    double Psnr(const Image& img, const std::vector<uint8_t>& data, Format f)
+    {
+        int blocksX = (img.width + 3) / 4;
+        int blocksY = (img.height + 3) / 4;
+        int bytes = BlockBytes(f);
+
+        double sq = 0.0;
+        size_t samples = 0;
+        uint8_t block[64], decoded[64];
+        for (int by = 0; by < blocksY; ++by)
+        {
+            for (int bx = 0; bx < blocksX; ++bx)
+            {
+                FetchBlock(img, bx, by, block);
+                DecodeBlock(f, &data[(size_t(by) * blocksX + bx) * bytes], decoded);
+                for (int i = 0; i < 64; ++i)
+                {
+                    //BC1 のアルファは 1bit なので比較から外す
+                    if (f == Format::BC1 && (i & 3) == 3) { continue; }
+                    double d = double(block[i]) - decoded[i];
+                    sq += d * d;
+                    ++samples;
+                }
+            }
+        }
+
+        double mse = sq / (std::max)(samples, size_t(1));
+        return (mse <= 0.0) ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    //--------------------------------------------------------
+    // DDS 書き出し
+    //--------------------------------------------------------
+
+    constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+    {
+        return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) | (uint32_t(uint8_t(d)) << 24);
+    }
+
+    uint32_t DxgiFormat(Format f, bool srgb)
+    {
+        switch (f)
+        {
+        case Format::BC1: return srgb ? 72 : 71;    //DXGI_FORMAT_BC1_UNORM(_SRGB)
+        case Format::BC3: return srgb ? 78 : 77;    //DXGI_FORMAT_BC3_UNORM(_SRGB)
+        default:          return srgb ? 99 : 98;    //DXGI_FORMAT_BC7_UNORM(_SRGB)
+        }
+    }
+
+    bool WriteDds(const fs::path& path, int width, int height, Format f, bool srgb,
+        const std::vector<std::vector<uint8_t>>& mips)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) { return false; }
+
+        auto put = [&](uint32_t v) { file.write(reinterpret_cast<const char*>(&v), 4); };
+
+        //BC1 / BC3 の linear は旧来の FourCC で書き、それ以外は DX10 拡張ヘッダを付ける
+        bool dx10 = srgb || f == Format::BC7;
+
+        put(MakeFourCC('D', 'D', 'S', ' '));
+        put(124);                                   //dwSize
+        put(0x1 | 0x2 | 0x4 | 0x1000 | 0x80000 | 0x20000);   //CAPS|HEIGHT|WIDTH|PIXELFORMAT|LINEARSIZE|MIPMAPCOUNT
+        put(uint32_t(height));
+        put(uint32_t(width));
+        put(uint32_t(mips[0].size()));              //dwPitchOrLinearSize
+        put(0);                                     //dwDepth
+        put(uint32_t(mips.size()));                 //dwMipMapCount
+        for (int i = 0; i < 11; ++i) { put(0); }    //dwReserved1
+
+        //DDS_PIXELFORMAT
+        put(32);
+        put(0x4);                                   //DDPF_FOURCC
+        if (dx10) { put(MakeFourCC('D', 'X', '1', '0')); }
+        else { put(f == Format::BC1 ? MakeFourCC('D', 'X', 'T', '1') : MakeFourCC('D', 'X', 'T', '5')); }
+        for (int i = 0; i < 5; ++i) { put(0); }
+
+        put(0x1000 | 0x8 | (mips.size() > 1 ? 0x400000 : 0));   //TEXTURE|COMPLEX|MIPMAP
+        for (int i = 0; i < 4; ++i) { put(0); }     //dwCaps2..4, dwReserved2
+
+        if (dx10)
+        {
+            put(DxgiFormat(f, srgb));
+            put(3);                                 //D3D10_RESOURCE_DIMENSION_TEXTURE2D
+            put(0);                                 //miscFlag
+            put(1);                                 //arraySize
+            put(0);                                 //miscFlags2
+        }
+
+        for (const auto& level : mips)
+        {
+            file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+        }
+        return static_cast<bool>(file);
+    }
+
+    //--------------------------------------------------------
+    // 1 枚分
+    //--------------------------------------------------------
+
+    bool IsSourceImage(const fs::path& path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg";
+    }
+
+    const char* FormatName(Format f)
+    {
+        switch (f)
+        {
+        case Format::BC1: return "BC1";
+        case Format::BC3: return "BC3";
+        case Format::BC7: return "BC7";
+        default:          return "auto";
+        }
+    }
+
+    //0: 焼いた / 1: 最新なので飛ばした / 2: 対象外・失敗
+    int Bake(const fs::path& src, const Options& opt)
+    {
+        fs::path dst = (opt.outDir.empty() ? src.parent_path() : opt.outDir) / src.stem();
+        dst += ".dds";
+
+        std::error_code ec;
+        if (!opt.force && fs::exists(dst, ec) && fs::last_write_time(dst, ec) >= fs::last_write_time(src, ec))
+        {
+            return 1;
+        }
+
+        Image img;
+        std::string ext = src.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        bool loaded = (ext == ".png") ? LoadPng(src, img) : LoadJpeg(src, img);
+        if (!loaded) { return 2; }
+
+        //BC はミップ 0 の辺が 4 の倍数でないと D3D11 が作成を拒否するので、そのまま WIC で読ませる
+        if (img.width % 4 != 0 || img.height % 4 != 0)
+        {
+            std::printf("  skip %s (%dx%d は 4 の倍数ではありません)\n", src.string().c_str(), img.width, img.height);
+            return 2;
+        }
+
+        if (opt.forceSrgb >= 0) { img.srgb = (opt.forceSrgb == 1); }
+
+        Format f = opt.format;
+        if (f == Format::Auto)
+        {
+            bool opaque = true;
+            for (size_t i = 3; i < img.rgba.size(); i += 4)
+            {
+                if (img.rgba[i] != 255) { opaque = false; break; }
+            }
+            f = opaque ? Format::BC1 : Format::BC7;
+        }
+
+        float toLinear[256];
+        for (int i = 0; i < 256; ++i)
+        {
+            toLinear[i] = img.srgb ? SrgbToLinear(i / 255.0f) : i / 255.0f;
+        }
+
+        std::vector<std::vector<uint8_t>> mips;
+        mips.push_back(Compress(img, f));
+        double psnr = opt.verbose ? Psnr(img, mips[0], f) : 0.0;
+
+        size_t sourceBytes = img.rgba.size();
+        size_t bakedBytes = mips[0].size();
+        int width = img.width, height = img.height;
+
+        if (opt.mips)
+        {
+            Image level = img;
+            while (level.width > 1 || level.height > 1)
+            {
+                level = Downsample(level, toLinear);
+                mips.push_back(Compress(level, f));
+                sourceBytes += level.rgba.size();
+                bakedBytes += mips.back().size();
+            }
+        }
+
+        if (!WriteDds(dst, width, height, f, img.srgb, mips))
+        {
+            std::fprintf(stderr, "  書き込み失敗: %s\n", dst.string().c_str());
+            return 2;
+        }
+
+        std::printf("  %s -> %s  %dx%d %s%s mips=%zu  %.1fKB -> %.1fKB",
+            src.filename().string().c_str(), dst.filename().string().c_str(),
+            width, height, FormatName(f), img.srgb ? "_SRGB" : "", mips.size(),
+            sourceBytes / 1024.0, bakedBytes / 1024.0);
+        if (opt.verbose) { std::printf("  PSNR %.2fdB", psnr); }
+        std::printf("\n");
+        return 0;
+    }
+
+    void PrintUsage()
+    {
+        std::printf("usage: TextureBaker [-f auto|bc1|bc3|bc7] [--srgb|--linear] [--no-mips] [-o dir] [--force] [-v] <file|dir>...\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    std::vector<fs::path> inputs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "-f" && i + 1 < argc)
+        {
+            std::string v = argv[++i];
+            if (v == "bc1") { opt.format = Format::BC1; }
+            else if (v == "bc3") { opt.format = Format::BC3; }
+            else if (v == "bc7") { opt.format = Format::BC7; }
+            else if (v == "auto") { opt.format = Format::Auto; }
+            else { PrintUsage(); return 1; }
+        }
+        else if (arg == "--srgb") { opt.forceSrgb = 1; }
+        else if (arg == "--linear") { opt.forceSrgb = 0; }
+        else if (arg == "--no-mips") { opt.mips = false; }
+        else if (arg == "--force") { opt.force = true; }
+        else if (arg == "-v") { opt.verbose = true; }
+        else if (arg == "-o" && i + 1 < argc) { opt.outDir = argv[++i]; }
+        else if (!arg.empty() && arg[0] == '-') { PrintUsage(); return 1; }
+        else { inputs.emplace_back(arg); }
+    }
+
+    if (inputs.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (!opt.outDir.empty()) { fs::create_directories(opt.outDir); }
+
+    //フォルダは再帰的に .png / .jpg / .jpeg を集める
+    std::vector<fs::path> sources;
+    for (const auto& in : inputs)
+    {
+        if (fs::is_directory(in))
+        {
+            for (const auto& entry : fs::recursive_directory_iterator(in))
+            {
+                if (entry.is_regular_file() && IsSourceImage(entry.path())) { sources.push_back(entry.path()); }
+            }
+        }
+        else if (fs::exists(in))
+        {
+            sources.push_back(in);
+        }
+        else
+        {
+            std::fprintf(stderr, "見つかりません: %s\n", in.string().c_str());
+        }
+    }
+    std::sort(sources.begin(), sources.end());
+
+    int baked = 0, upToDate = 0, skipped = 0;
+    for (const auto& src : sources)
+    {
+        switch (Bake(src, opt))
+        {
+        case 0: ++baked; break;
+        case 1: ++upToDate; break;
+        default: ++skipped; break;
+        }
+    }
+
+    std::printf("baked %d, up to date %d, skipped %d\n", baked, upToDate, skipped);
+    return 0;
+}
@@ -0,0 +1,137 @@
+﻿//------------------------------------------------------------
+// モデル頂点の圧縮（VertexPacking）の往復誤差を確認するツール（ウィンドウ・GPU 不要）
+// ・八面体写像の法線が全方向で元の向きを保っているか
+// ・half に丸めた UV の誤差が 0～1 の範囲で成分ごとに半 ulp 以内か
+// ・一様な頂点色が頂点から外れ、ばらつく頂点色は残るか
+// ・ボーンウェイトの合計がちょうど 255 になるか
+// 問題があれば 0 以外で終了する
+//
+// ビルド例（開発者コマンドプロンプト）:
+//   cl /O2 /EHsc /std:c++20 /I..\..\ShootingGame_0519 VertexPackCheck.cpp ..\..\ShootingGame_0519\VertexPacking.cpp
+//------------------------------------------------------------
+#include "VertexPacking.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace
+{
+    int g_failures = 0;
+
+    void Check(bool ok, const char* what, float value)
+    {
+        std::printf("[%s] %s (%g)\n", ok ? " OK " : "FAIL", what, value);
+        if (!ok) { ++g_failures; }
+    }
+
+    //単位球上の一様な向き + 軸方向・折り返しの境目
+    std::vector<SourceVertex> MakeVertices(std::mt19937& rng, size_t count)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> uv(0.0f, 1.0f);
+        std::uniform_real_distribution<float> pos(-500.0f, 500.0f);
+
+        std::vector<SourceVertex> vertices;
+        const XMFLOAT3 special[] =
+        {
+            { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 },
+            { 0.7071f, 0, -0.7071f }, { 0, -0.7071f, -0.7071f }, { 0.577f, 0.577f, -0.577f },
+        };
+        for (const auto& n : special)
+        {
+            SourceVertex v;
+            v.normal = n;
+            vertices.push_back(v);
+        }
+
+        while (vertices.size() < count)
+        {
+            XMFLOAT3 n(unit(rng), unit(rng), unit(rng));
+            float len = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+            if (len < 0.1f || len > 1.0f) { continue; }
+
+            SourceVertex v;
+            v.position = XMFLOAT3(pos(rng), pos(rng), pos(rng));
+            v.normal = XMFLOAT3(n.x / len, n.y / len, n.z / len);
+            v.texcoord = XMFLOAT2(uv(rng), uv(rng));
+            vertices.push_back(v);
+        }
+        return vertices;
+    }
+}
+
+int main()
+{
+    std::mt19937 rng(1234);
+    std::vector<SourceVertex> vertices = MakeVertices(rng, 200000);
+
+    //----------静的メッシュ・一様な頂点色-------------
+    PackedMesh packed = PackVertices(vertices, false);
+    VertexPackError err = MeasurePackError(vertices, packed);
+
+    Check(sizeof(PackedVertex) == 20, "PackedVertex のサイズ", static_cast<float>(sizeof(PackedVertex)));
+    Check(err.position == 0.0f, "位置の誤差", err.position);
+    Check(err.normalDegrees < 0.01f, "法線の最大誤差（度）", err.normalDegrees);
+    //u, v それぞれ半 ulp（0.5～1 で 2^-12）以内なので、UV 空間の距離では √2 倍まで
+    Check(err.texcoord < 3.5e-4f, "UV の最大誤差", err.texcoord);
+    Check(packed.colors.empty(), "一様な頂点色は頂点から外れる", static_cast<float>(packed.colors.size()));
+    Check(packed.skin.empty(), "静的メッシュにボーンストリームは無い", static_cast<float>(packed.skin.size()));
+
+    //----------ばらつく頂点色-------------
+    std::uniform_real_distribution<float> col(0.0f, 1.0f);
+    for (auto& v : vertices) { v.color = XMFLOAT4(col(rng), col(rng), col(rng), 1.0f); }
+    packed = PackVertices(vertices, false);
+    err = MeasurePackError(vertices, packed);
+    Check(packed.colors.size() == vertices.size(), "ばらつく頂点色は残る", static_cast<float>(packed.colors.size()));
+    Check(err.color <= 0.5f / 255.0f + 1.0e-6f, "頂点色の最大誤差", err.color);
+
+    //----------スキンメッシュ-------------
+    std::uniform_int_distribution<int> bone(0, 63);
+    for (auto& v : vertices)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            v.boneIndex[k] = bone(rng);
+            v.boneWeight[k] = col(rng);
+        }
+    }
+    packed = PackVertices(vertices, true);
+    err = MeasurePackError(vertices, packed);
+
+    bool sumsOk = true;
+    bool indicesOk = true;
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        int sum = 0;
+        for (int k = 0; k < 4; ++k)
+        {
+            sum += packed.skin[i].boneWeight[k];
+            if (packed.skin[i].boneIndex[k] != vertices[i].boneIndex[k]) { indicesOk = false; }
+        }
+        if (sum != 255) { sumsOk = false; }
+    }
+    Check(sumsOk, "ボーンウェイトの合計が 255", 255.0f);
+    Check(indicesOk, "ボーンインデックスがそのまま残る", 0.0f);
+    Check(err.boneWeight <= 1.0f / 255.0f, "ボーンウェイトの最大誤差", err.boneWeight);
+
+    //----------half の境界値-------------
+    Check(FloatToHalf(1.0f) == 0x3C00, "half(1.0)", HalfToFloat(FloatToHalf(1.0f)));
+    Check(FloatToHalf(65504.0f) == 0x7BFF, "half の最大値", HalfToFloat(FloatToHalf(65504.0f)));
+    Check(FloatToHalf(1.0e6f) == 0x7C00, "範囲外は無限大", HalfToFloat(FloatToHalf(1.0e6f)));
+    float tiny = 3.0e-6f;
+    Check(std::fabs(HalfToFloat(FloatToHalf(tiny)) - tiny) < 3.0e-8f, "非正規化数の往復", HalfToFloat(FloatToHalf(tiny)));
+    Check(HalfToFloat(FloatToHalf(-0.25f)) == -0.25f, "負の値の往復", HalfToFloat(FloatToHalf(-0.25f)));
+
+    //----------サイズ-------------
+    //圧縮前の VERTEX_3D は 84 byte
+    float ratio = static_cast<float>(sizeof(PackedVertex)) / 84.0f;
+    std::printf("静的メッシュ: 84 -> %zu byte/頂点 (%.0f%%)\n", sizeof(PackedVertex), ratio * 100.0f);
+    std::printf("頂点色あり:   84 -> %zu byte/頂点\n", sizeof(PackedVertex) + sizeof(PackedColor));
+    std::printf("スキンあり:   84 -> %zu byte/頂点\n", sizeof(PackedVertex) + sizeof(PackedSkin));
+
+    std::printf("%s (%d 件の失敗)\n", g_failures == 0 ? "すべて OK" : "失敗あり", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}